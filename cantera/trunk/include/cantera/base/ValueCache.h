@@ -108,7 +108,8 @@ struct CachedValue {
     double state2;
 
     //! A surrogate for the composition. For cached properties of Phase,
-    //! this should be set to Phase::stateMFNumber()
+    //! this should be set to Phase::stateMFNumber(). Properties which depend
+    //! only on temperature may instead use Phase::stateTNumber().
     int stateNum;
 
     //! The value of the cached property
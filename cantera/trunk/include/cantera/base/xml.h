@@ -632,6 +632,33 @@ public:
      */
     void build(std::istream& f);
 
+    //! Create a tree-like representation of a binary CTML file
+    /*!
+     *  Reads a tree written by writeBinary(). The binary form stores the
+     *  already parsed tree (node names, values, attributes and children) as
+     *  length-prefixed strings, so it can be loaded without tokenizing XML
+     *  text or converting a CTI file. get_XML_File() reads files with the
+     *  extension ".ctb" this way.
+     *
+     *  Only the parsing of the input file is avoided. The phase, species
+     *  thermo, kinetics and transport objects are still constructed from the
+     *  tree in the usual way, and this is not affected by the format of the
+     *  input file. To also skip the construction of an ideal gas phase and
+     *  its kinetics and transport managers, use writeBinaryMechanism() and
+     *  readBinaryMechanism() instead.
+     *
+     * @param f   Input stream containing the binary file, opened in
+     *            binary mode
+     */
+    void buildBinary(std::istream& f);
+
+    //! Write the XML tree rooted at this node in the binary form read by
+    //! buildBinary()
+    /*!
+     *  @param s   Output stream, opened in binary mode
+     */
+    void writeBinary(std::ostream& s) const;
+
     //! Copy all of the information in the current XML_Node tree
     //! into the destination XML_Node tree, doing a union operation as
     //! we go
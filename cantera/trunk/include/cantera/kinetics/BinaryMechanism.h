@@ -0,0 +1,85 @@
+/**
+ *  @file BinaryMechanism.h
+ *   Declarations of global routines for saving fully constructed phase,
+ *   kinetics and transport managers to a binary file and creating them
+ *   again from that file (see \ref inputfiles).
+ */
+
+#ifndef CT_BINARYMECHANISM_H
+#define CT_BINARYMECHANISM_H
+
+#include "cantera/thermo/ThermoPhase.h"
+#include "Kinetics.h"
+
+namespace Cantera
+{
+
+class Transport;
+
+//! Write a phase, and optionally its kinetics and transport managers, to a
+//! binary mechanism file.
+/*!
+ * The file holds the data of the constructed objects rather than their input
+ * description: the elements, the species with their composition, standard
+ * state thermo coefficients and gas transport parameters, the state of the
+ * phase, every Reaction object of the kinetics manager with its rate
+ * parameters, and the collision integral and property fits made by the
+ * transport manager (see GasTransport::getFits). readBinaryMechanism()
+ * creates the objects from this data without parsing XML or CTI input and
+ * without fitting the transport properties, which are the main costs of
+ * loading a large mechanism.
+ *
+ * All of the data is stored in three contiguous arrays of doubles, ints and
+ * characters following a fixed-size header, in the native byte order, so that
+ * the file can be memory mapped and read in place. Files are not portable
+ * between platforms with different byte orders or sizes of `int` and
+ * `double`; readBinaryMechanism() detects this and throws an exception.
+ *
+ * Only the common case of a single ideal gas phase is supported:
+ *   - the phase must be an IdealGasPhase whose species use the NASA1, NASA2,
+ *     SHOMATE1, SHOMATE2 or CONSTANT_CP standard state parameterizations,
+ *   - the kinetics manager, if given, must be a GasKinetics manager for
+ *     this phase only, whose reactions were added as Reaction objects (all
+ *     reactions imported from CTML are),
+ *   - the transport manager, if given, must be a MixTransport or
+ *     MultiTransport manager for this phase.
+ *
+ * An exception is thrown for anything else. The XML description of the
+ * phase is not saved, so functions which need it, such as
+ * newTransportMgr(thermo_t*), cannot be used with phases read from a binary
+ * mechanism file.
+ *
+ * @param file    Name of the file to write
+ * @param thermo  Phase to write
+ * @param kin     Kinetics manager for the phase. Not written if 0.
+ * @param tran    Transport manager for the phase. Not written if 0.
+ * @ingroup inputfiles
+ */
+void writeBinaryMechanism(const std::string& file, ThermoPhase& thermo,
+                          Kinetics* kin=0, Transport* tran=0);
+
+//! Create a phase and its kinetics and transport managers from a binary
+//! mechanism file written by writeBinaryMechanism().
+/*!
+ * The file is located using findInputFile() and is memory mapped where the
+ * platform supports it. The objects are constructed directly from the stored
+ * data, and are identical to the objects that were written, up to rounding
+ * in the last bit for a few parameters which are stored internally in a
+ * transformed form (for example, constant heat capacities and the rate
+ * constants of single-rate P-log pressure levels). The caller owns the
+ * returned objects.
+ *
+ * @param file    Name of the binary mechanism file
+ * @param thermo  Output: the new phase
+ * @param kin     Output: the new kinetics manager for `thermo`, or 0 if the
+ *                file has no kinetics data
+ * @param tran    Output: the new transport manager for `thermo`, or 0 if the
+ *                file has no transport data
+ * @ingroup inputfiles
+ */
+void readBinaryMechanism(const std::string& file, ThermoPhase*& thermo,
+                         Kinetics*& kin, Transport*& tran);
+
+}
+
+#endif
@@ -159,6 +159,8 @@ public:
     }
 
 protected:
+    friend class FalloffMgr;
+
     //! parameter a in the 4-parameter Troe falloff function. Dimensionless
     doublereal m_a;
 
@@ -252,6 +254,8 @@ public:
     }
 
 protected:
+    friend class FalloffMgr;
+
     //! parameter a in the 5-parameter SRI falloff function. Dimensionless.
     doublereal m_a;
 
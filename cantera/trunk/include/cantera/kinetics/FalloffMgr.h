@@ -9,12 +9,19 @@
 
 #include "reaction_defs.h"
 #include "FalloffFactory.h"
+#include "cantera/base/smart_ptr.h"
 
 namespace Cantera
 {
 
 /**
  *  A falloff manager that implements any set of falloff functions.
+ *
+ *  The parameters of the Lindemann, Troe and SRI falloff functions are stored
+ *  in separate arrays for each type of falloff function, and the falloff
+ *  functions for all reactions of each type are evaluated in a single loop
+ *  over these arrays. Other falloff functions are evaluated by calling the
+ *  Falloff object created by the FalloffFactory for each reaction.
  *  @ingroup falloffGroup
  */
 class FalloffMgr
@@ -29,11 +36,8 @@ public:
         //else m_factory = f;
     }
 
-    //! Destructor. Deletes all installed falloff function calculators.
+    //! Destructor.
     virtual ~FalloffMgr() {
-        for (size_t i = 0; i < m_falloff.size(); i++) {
-            delete m_falloff[i];
-        }
         //if (m_factory) {
         //FalloffFactory::deleteFalloffFactory();
         //m_factory = 0;
@@ -49,18 +53,15 @@ public:
      * @param c vector of coefficients for the falloff function.
      */
     void install(size_t rxn, int falloffType, int reactionType,
-                 const vector_fp& c) {
-        m_rxn.push_back(rxn);
-        Falloff* f = m_factory->newFalloff(falloffType,c);
-        m_offset.push_back(m_worksize);
-        m_worksize += f->workSize();
-        m_falloff.push_back(f);
-        m_reactionType.push_back(reactionType);
-    }
+                 const vector_fp& c);
 
-    //! Size of the work array required to store intermediate results.
+    //! Size of the work array required to store intermediate results. This
+    //! includes the temperature-dependent values cached by updateTemp(),
+    //! followed by the scratch space used by pr_to_falloff().
     size_t workSize() {
-        return m_worksize;
+        size_t nmax = std::max(m_simple.size(),
+                               std::max(m_troe.size(), m_sri.size()));
+        return cacheSize() + 2 * nmax;
     }
 
     /**
@@ -69,34 +70,86 @@ public:
      * @param t Temperature [K].
      * @param work Work array. Must be dimensioned at least workSize().
      */
-    void updateTemp(doublereal t, doublereal* work) {
-        for (size_t i = 0; i < m_rxn.size(); i++) {
-            m_falloff[i]->updateTemp(t, work + m_offset[i]);
-        }
-    }
+    void updateTemp(doublereal t, doublereal* work);
 
     /**
      * Given a vector of reduced pressures for each falloff reaction,
      * replace each entry by the value of the falloff function.
+     * @param values Reduced pressures, replaced by the falloff functions
+     * @param work Work array filled by updateTemp(). The part of it after
+     *     the temperature-dependent values is used as scratch space, so the
+     *     manager itself keeps no state which changes between calls.
      */
-    void pr_to_falloff(doublereal* values, const doublereal* work) {
-        for (size_t i = 0; i < m_rxn.size(); i++) {
-            double pr = values[m_rxn[i]];
-            if (m_reactionType[i] == FALLOFF_RXN) {
-                // Pr / (1 + Pr) * F
-                values[m_rxn[i]] *=
-                    m_falloff[i]->F(pr, work + m_offset[i]) /(1.0 + pr);
-            } else {
-                // 1 / (1 + Pr) * F
-                values[m_rxn[i]] =
-                    m_falloff[i]->F(pr, work + m_offset[i]) /(1.0 + pr);
-            }
+    void pr_to_falloff(doublereal* values, doublereal* work);
+
+    //! Make `sub` a manager for the subset of the installed reactions for
+    //! which `include[rxn]` is true, where `rxn` is the index given to
+    //! install(). The subset manager has its own layout of the work array,
+    //! which is no larger than that of this manager, so its work array must
+    //! be filled by its own updateTemp() method.
+    void getSubset(const std::vector<bool>& include, FalloffMgr& sub) const;
+
+protected:
+    //! Parameters of the falloff functions of one type, for which the
+    //! falloff functions of all reactions are evaluated together.
+    struct FalloffBatch {
+        //! Number of reactions in the batch
+        size_t size() const {
+            return rxn.size();
         }
+
+        //! Index in the array of reduced pressures of each reaction
+        std::vector<size_t> rxn;
+
+        //! 1.0 for falloff reactions, 0.0 for chemically activated reactions
+        vector_fp falloff;
+
+        //! Parameters of the falloff function. The meaning of each
+        //! parameter depends on the type of the falloff function.
+        vector_fp p0, p1, p2, p3, p4;
+    };
+
+    //! Number of temperature-dependent values stored in the work array
+    size_t cacheSize() const {
+        return m_troe.size() + 2 * m_sri.size() + m_worksize;
     }
 
-protected:
+    //! Add a reaction to the batch `b` and return its index in the batch
+    size_t addToBatch(FalloffBatch& b, size_t rxn, int reactionType);
+
+    //! Copy the reactions of batch `b` for which `include[rxn]` is true to
+    //! `out`, and store their positions in `b` in `index`.
+    static void copyBatch(const FalloffBatch& b,
+                          const std::vector<bool>& include, FalloffBatch& out,
+                          std::vector<size_t>& index);
+
+    //! Replace the reduced pressures of the reactions in batch `b` by the
+    //! value of the falloff function, given the reduced pressures `pr` and
+    //! the values of F for the reactions of the batch. `F` is overwritten.
+    void scatter(const FalloffBatch& b, const doublereal* pr, doublereal* F,
+                 doublereal* values) const;
+
+    //! Reactions with the Lindemann form (F = 1)
+    FalloffBatch m_simple;
+
+    //! Reactions with the Troe falloff function. The parameters are a,
+    //! 1/T3, 1/T1, T2, and 1.0 if T2 is specified (0.0 otherwise).
+    FalloffBatch m_troe;
+
+    //! Reactions with the SRI falloff function. The parameters are a, b,
+    //! 1/c (or 0.0 if c is zero), d, and e.
+    FalloffBatch m_sri;
+
+    //! 1.0 for SRI reactions where c is non-zero, 0.0 otherwise
+    vector_fp m_sriHasC;
+
+    //! Reactions with other falloff functions, which are evaluated by
+    //! calling the Falloff object for each reaction
     std::vector<size_t> m_rxn;
-    std::vector<Falloff*> m_falloff;
+
+    //! Falloff function calculators for the reactions in #m_rxn. These only
+    //! hold parameters, so they are shared between copies of the manager.
+    std::vector<shared_ptr<Falloff> > m_falloff;
     FalloffFactory* m_factory;
     vector_int m_loc;
     std::vector<vector_fp::difference_type> m_offset;
@@ -12,6 +12,7 @@
 #include "BulkKinetics.h"
 #include "ThirdBodyCalc.h"
 #include "FalloffMgr.h"
+#include "RateTable.h"
 #include "Reaction.h"
 
 namespace Cantera
@@ -48,6 +49,61 @@ public:
     virtual void getEquilibriumConstants(doublereal* kc);
     virtual void getFwdRateConstants(doublereal* kfwd);
 
+    using Kinetics::getNetProductionRates;
+
+    //! Species net production rates [kmol/m^3/s]. While a reduced mechanism
+    //! is active (see setDynamicReduction()), only the retained reactions
+    //! contribute.
+    virtual void getNetProductionRates(doublereal* wdot);
+
+    //! Species net production rates for a batch of states.
+    /*!
+     *  For an ideal gas, the states are evaluated in blocks directly from
+     *  `T`, `P` and `Y`, without setting the state of the phase. Within a
+     *  block, the rate constants, equilibrium constants, third-body
+     *  concentrations and rates of progress are stored reaction by reaction
+     *  with the values for the states of the block adjacent to each other,
+     *  so that each step of the calculation is a loop over the states. The
+     *  falloff functions and the P-log and Chebyshev rate constants are
+     *  evaluated one state at a time.
+     *
+     *  If the phase is not an ideal gas, or if rate tabulation or dynamic
+     *  mechanism reduction is in use, the states are evaluated one at a time
+     *  as in Kinetics::getNetProductionRates(size_t, const doublereal*,
+     *  const doublereal*, const doublereal*, doublereal*).
+     */
+    virtual void getNetProductionRates(size_t nStates, const doublereal* T,
+                                       const doublereal* P,
+                                       const doublereal* Y, doublereal* wdot);
+
+    //! @}
+    //! @name Derivatives of Rates of Progress and Production Rates
+    //! @{
+
+    //! Derivatives of the net rates of progress with respect to the species
+    //! concentrations.
+    /*!
+     *  The dependence of the rates of progress on the concentrations through
+     *  the mass-action terms and the enhanced third-body concentrations is
+     *  evaluated analytically, except for the derivative of the falloff
+     *  function with respect to the reduced pressure, which is evaluated by
+     *  a single perturbation of the reduced pressures of all falloff
+     *  reactions. The pressure dependence of P-log and Chebyshev rate
+     *  constants is included by perturbing the pressure. The total molar
+     *  concentration is taken to be the sum of the species concentrations.
+     */
+    virtual void getNetRatesOfProgress_ddC(SparseMatrix& drop);
+
+    //! Derivatives of the net production rates with respect to temperature.
+    /*!
+     *  The temperature derivatives of the forward rate constants and
+     *  equilibrium constants are evaluated by perturbing the temperature of
+     *  the phase (at constant density and composition) and re-evaluating the
+     *  rate constants, which costs approximately one evaluation of the
+     *  production rates. The phase is returned to its original temperature.
+     */
+    virtual void getNetProductionRates_ddT(doublereal* dwdot);
+
     //! @}
     //! @name Reaction Mechanism Setup Routines
     //! @{
@@ -67,9 +123,179 @@ public:
     //! Update properties that depend on concentrations.
     //! Currently the enhanced collision partner concentrations are updated
     //! here, as well as the pressure-dependent portion of P-log and Chebyshev
-    //! reactions.
+    //! reactions. Nothing is recomputed if the temperature, density and
+    //! composition state numbers of the phase have not changed since the
+    //! last call.
     virtual void update_rates_C();
 
+    //! Write a C++ source file containing functions specialized for this
+    //! reaction mechanism.
+    /*!
+     *  The generated functions replace the table-driven parts of the
+     *  evaluation of the rates of progress and production rates with
+     *  straight-line code, in which the stoichiometry is unrolled and the
+     *  Arrhenius parameters are written as constants:
+     *
+     *  - `updateArrheniusRates(T, kf)` sets `kf[i]` for the elementary and
+     *    three-body reactions, as done by update_rates_T().
+     *  - `multiplyReactants(c, r)` and `multiplyRevProducts(c, r)` multiply
+     *    the rates `r` by the concentration products of the reactants and
+     *    of the products of reversible reactions.
+     *  - `getNetProductionRates(ropnet, wdot)` computes the species
+     *    production rates from the net rates of progress.
+     *
+     *  The functions are written inside the namespace `name`, along with the
+     *  constants `nSpecies` and `nReactions`. The remaining parts of the
+     *  calculation (third-body concentrations, falloff and other pressure-
+     *  dependent rates, and equilibrium constants) are not included, and
+     *  can be obtained from this object.
+     *
+     *  @param s     Stream to write the source code to
+     *  @param name  Name of the namespace containing the generated code
+     */
+    void writeSource(std::ostream& s, const std::string& name="mech") const;
+
+    //! Evaluate the temperature-dependent rate parameters by interpolation.
+    /*!
+     *  The forward rate constants of elementary and three-body reactions,
+     *  the low- and high-pressure limits of falloff reactions, and the
+     *  reciprocals of the equilibrium constants are tabulated at points
+     *  uniformly spaced in 1/T between `Tmin` and `Tmax`. For temperatures in
+     *  this range, update_rates_T() then evaluates these quantities by
+     *  interpolation (see RateTable) instead of evaluating the exponentials
+     *  and the thermodynamic properties of the species. Outside of this
+     *  range, the quantities are evaluated directly.
+     *
+     *  The rate constants are stored in a single table covering the whole
+     *  temperature range. The equilibrium constants are not smooth at the
+     *  midpoint temperatures of the species' NASA and Shomate polynomials,
+     *  so they are stored in separate tables for each temperature interval
+     *  between these midpoints, found by binary search. For each table, the
+     *  number of points is doubled, starting from 64 intervals over the
+     *  range from `Tmin` to `Tmax` (or a proportional number for the
+     *  narrower equilibrium constant tables), until the relative
+     *  interpolation error at the midpoints between tabulation points is
+     *  less than `rtol` for all tabulated quantities.
+     *  This method must be called after all reactions have been added to
+     *  the mechanism. The equilibrium constants are assumed to be
+     *  independent of pressure, as is the case for an ideal gas.
+     *
+     *  @param Tmin  Minimum temperature [K]
+     *  @param Tmax  Maximum temperature [K]
+     *  @param rtol  Maximum relative interpolation error
+     */
+    void setRateTabulation(double Tmin, double Tmax, double rtol=1e-8);
+
+    //! Stop using tabulated rate parameters, and release the memory used by
+    //! the table.
+    void clearRateTabulation();
+
+    //! Return true if tabulated rate parameters are in use
+    bool rateTabulation() const {
+        return m_rateTable.nPoints() != 0;
+    }
+
+    //! Return true if the equilibrium constants are tabulated along with the
+    //! rate constants. See setRateTabulation().
+    bool equilibriumTabulation() const {
+        return !m_kcTables.empty();
+    }
+
+    //! Evaluate the rates of progress using a reduced mechanism generated
+    //! for the current state.
+    /*!
+     *  For each state, a skeletal mechanism is identified using the
+     *  directed relation graph with error propagation (DRGEP) method, and
+     *  only the rates of progress of the reactions in the skeletal mechanism
+     *  are evaluated. The rates of progress of the remaining reactions are
+     *  set to zero. The species retained in the skeletal mechanism are those
+     *  for which the overall interaction coefficient with at least one of the
+     *  target species (see getDRGEPCoefficients()) is at least `threshold`.
+     *  A reaction is retained if all of its reactants and products are
+     *  retained.
+     *
+     *  Skeletal mechanisms are stored for each bin of a coarse division of
+     *  the state space, defined by the temperature, the logarithm of the
+     *  pressure, and the base-10 logarithms of the mole fractions of the
+     *  target species, and the analysis is only carried out the first time a
+     *  state in each bin is encountered. At most `maxMechanisms` mechanisms
+     *  are stored; beyond that, the least recently used mechanism is
+     *  replaced.
+     *
+     *  While a reduced mechanism is active, only the retained reactions are
+     *  processed: the rate coefficients (or their interpolation, if rate
+     *  tabulation is in use; see setRateTabulation()), the equilibrium
+     *  constants, the third-body concentrations, the falloff functions, the
+     *  P-log and Chebyshev rates, the concentration products, and the
+     *  species production rates. Checking whether the state is still in the
+     *  bin of the active mechanism takes a few comparisons, and is only done
+     *  when the state of the phase has changed.
+     *
+     *  The reduced mechanism applies to the rates of progress and production
+     *  rates, to the forward and reverse rate constants reported by
+     *  getFwdRateConstants() and getRevRateConstants(), which are zero for
+     *  all reactions which are not retained, and to the derivatives computed
+     *  by getNetRatesOfProgress_ddC() and getNetProductionRates_ddT(). The
+     *  equilibrium constants reported by getEquilibriumConstants() are those
+     *  of the full mechanism.
+     *
+     *  @param targets    Indices of the target species
+     *  @param threshold  Minimum interaction coefficient of the retained
+     *      species. Larger values give smaller mechanisms and larger errors.
+     *  @param deltaT     Width of the temperature bins [K]
+     *  @param deltaLogX  Width of the bins for the logarithm of the pressure
+     *      and the base-10 logarithms of the target mole fractions
+     *  @param maxMechanisms  Maximum number of stored mechanisms
+     */
+    void setDynamicReduction(const std::vector<size_t>& targets,
+                             double threshold, double deltaT=25.0,
+                             double deltaLogX=0.5,
+                             size_t maxMechanisms=1000);
+
+    //! Stop using reduced mechanisms, and discard the stored mechanisms.
+    void clearDynamicReduction();
+
+    //! Return true if dynamic mechanism reduction is in use
+    bool dynamicReduction() const {
+        return !m_drgTargets.empty();
+    }
+
+    //! Number of reduced mechanisms currently stored. See
+    //! setDynamicReduction().
+    size_t nReducedMechanisms() const {
+        return m_reduced.size();
+    }
+
+    //! Get the indices of the reactions included in the reduced mechanism
+    //! for the current state. If dynamic reduction is not in use, all
+    //! reactions are included.
+    void getActiveReactions(std::vector<size_t>& active);
+
+    //! Compute the DRGEP overall interaction coefficients of all species with
+    //! the target species at the current state, using the rates of progress
+    //! of the full mechanism.
+    /*!
+     *  The direct interaction coefficient of species A with species B is
+     *  \f[
+     *      r_{AB} = \frac{|\sum_i \nu_{A,i} \omega_i \delta_{B,i}|}
+     *                    {\max(P_A, C_A)}
+     *  \f]
+     *  where \f$ \omega_i \f$ is the net rate of progress of reaction
+     *  \f$ i \f$, \f$ \delta_{B,i} \f$ is 1 if species B participates in
+     *  reaction \f$ i \f$ and 0 otherwise, and \f$ P_A \f$ and
+     *  \f$ C_A \f$ are the production and consumption rates of species A.
+     *  The overall interaction coefficient of a species is the maximum over
+     *  all paths from any of the target species of the product of the direct
+     *  interaction coefficients along the path. Target species have an
+     *  interaction coefficient of 1.
+     *
+     *  @param targets  Indices of the target species
+     *  @param R        Output vector of length nSpecies() containing the
+     *      overall interaction coefficients
+     */
+    void getDRGEPCoefficients(const std::vector<size_t>& targets,
+                              vector_fp& R);
+
 protected:
     size_t m_nfall;
 
@@ -95,13 +321,65 @@ protected:
     vector_fp m_rfn_high;
 
     doublereal m_pres; //!< Last pressure at which rates were evaluated
+
+    //! Phase at which update_rates_C() was last evaluated. Set to 0 to force
+    //! the concentration-dependent terms to be recomputed.
+    const thermo_t* m_thermo_C;
+
+    //! Phase::stateTNumber(), Phase::stateDNumber() and
+    //! Phase::stateMFNumber() of #m_thermo_C at the last evaluation of
+    //! update_rates_C()
+    int m_stateNum_C[3];
     vector_fp falloff_work;
-    vector_fp concm_3b_values;
-    vector_fp concm_falloff_values;
+
+    //! Effective third-body concentrations of the three-body reactions (in
+    //! the order they were installed in #m_3b_concm), followed by those of
+    //! the falloff reactions.
+    vector_fp m_concm;
+
+    //! Third-body efficiencies of the three-body and falloff reactions,
+    //! combined from #m_3b_concm and #m_falloff_concm, with rows in the same
+    //! order as #m_concm. See ThirdBodyCalc::efficiencies().
+    SparseMatrix m_efficiencies;
+
+    //! Default third-body efficiencies, in the same order as #m_concm
+    vector_fp m_defaultEfficiencies;
     //!@}
 
+    //! Build #m_efficiencies if reactions have been added since it was last
+    //! built.
+    void updateEfficiencies();
+
+    //! Evaluate the falloff reactions, or those of the active reduced
+    //! mechanism, and store their forward rate constants in #m_ropf.
     void processFalloffReactions();
 
+    //! Reduced pressures and falloff factors of the falloff reactions
+    vector_fp m_falloffPr;
+
+    //! The falloff function manager for the active reduced mechanism, or
+    //! #m_falloffn if the full mechanism is active. Its own layout of
+    //! #falloff_work is used.
+    FalloffMgr& activeFalloff() {
+        return (m_activeReduced == npos) ? m_falloffn :
+               m_reduced[m_activeReduced].falloffMgr;
+    }
+
+    //! Evaluate the forward rate constants, including the third-body
+    //! concentrations, falloff functions, perturbation factors, and the mask
+    //! of the active reduced mechanism, in #m_ropf.
+    void updateFwdRateConstants();
+
+    //! Evaluate the net production rates for a block of `nStates` ideal gas
+    //! states. See getNetProductionRates(size_t, const doublereal*, const
+    //! doublereal*, const doublereal*, doublereal*).
+    void evalNetProductionRates(size_t nStates, const doublereal* T,
+                                const doublereal* P, const doublereal* Y,
+                                doublereal* wdot);
+
+    //! Work array for evalNetProductionRates()
+    vector_fp m_batchWork;
+
     void addThreeBodyReaction(ReactionData& r);
     void addFalloffReaction(ReactionData& r);
     void addPlogReaction(ReactionData& r);
@@ -115,6 +393,132 @@ protected:
     //! Update the equilibrium constants in molar units.
     void updateKc();
 
+    //! Evaluate the temperature-dependent rate parameters which can be
+    //! tabulated (see setRateTabulation) directly, at the current
+    //! temperature.
+    void evalRates_T(double T, double logT);
+
+    //! Copy the tabulated rate constants into a single array of length
+    //! the number of columns in #m_rateTable, or the reverse if `unpack` is
+    //! true.
+    void packRates(double* values, bool unpack);
+
+    //! Fill `table` with the rate constants (if `kc` is false) or the
+    //! reciprocal equilibrium constants (if `kc` is true) between `T0` and
+    //! `T1`, with the number of points needed to reach the tolerance `rtol`,
+    //! starting from `nPoints`. See setRateTabulation().
+    void buildRateTable(RateTable& table, double T0, double T1, double rtol,
+                        bool kc, size_t nPoints);
+
+    //! Table of the rate constants
+    RateTable m_rateTable;
+
+    //! Tables of the reciprocal equilibrium constants, covering adjacent
+    //! temperature ranges
+    std::vector<RateTable> m_kcTables;
+
+    //! Work array for interpolated rate parameters
+    vector_fp m_rateTableWork;
+
+    //! Select the reduced mechanism for the current state, generating it if
+    //! necessary. See setDynamicReduction(). Called by update_rates_C()
+    //! when the state has changed.
+    void selectReducedMechanism();
+
+    //! Make reduced mechanism `n` the active mechanism, or the full
+    //! mechanism if `n` is `npos`.
+    void activateReducedMechanism(size_t n);
+
+    //! A skeletal mechanism generated by setDynamicReduction(). The
+    //! reaction-indexed arrays of the kinetics manager keep their full size,
+    //! and all of these structures use the reaction indices of the full
+    //! mechanism.
+    struct ReducedMechanism {
+        //! 1.0 for reactions included in the mechanism, and 0.0 otherwise
+        vector_fp mask;
+        //! Indices of the included reactions
+        std::vector<size_t> reactions;
+        //! Positions of the included reactions in #m_rates
+        std::vector<size_t> rates;
+        //! Indices of the included reversible reactions
+        std::vector<size_t> revindex;
+        //! Positions in #m_3b_concm of the included three-body reactions
+        std::vector<size_t> thirdBody;
+        //! Reaction indices of the entries of #thirdBody
+        std::vector<size_t> thirdBodyRxn;
+        //! Positions in #m_fallindx of the included falloff reactions
+        std::vector<size_t> falloff;
+        //! Positions of the included reactions in #m_plog_rates
+        std::vector<size_t> plog;
+        //! Positions of the included reactions in #m_cheb_rates
+        std::vector<size_t> cheb;
+        //! Columns of #m_rateTable for the included reactions
+        std::vector<size_t> tableColumns;
+        //! Reactant and reversible product stoichiometry of the included
+        //! reactions
+        StoichManagerN reactantStoich, revProductStoich;
+        //! Entries of #m_stoichNet for the included reactions
+        SparseMatrix stoichNet;
+        //! Entries of #m_stoichRevNetT for the included reactions
+        SparseMatrix stoichRevNetT;
+        //! Rows of #m_efficiencies for the included reactions
+        SparseMatrix efficiencies;
+        //! Falloff functions of the included reactions
+        FalloffMgr falloffMgr;
+        //! State bin of the mechanism, in the key format of #m_reducedIndex
+        std::vector<int> bin;
+        //! Bounds of the bin for the temperature, pressure, and the mole
+        //! fractions of the target species
+        vector_fp lower, upper;
+        //! Value of #m_drgClock when the mechanism was last selected
+        size_t lastUsed;
+    };
+
+    //! Return true if the current state is in the bin for which `mech` was
+    //! generated.
+    bool inBin(const ReducedMechanism& mech) const;
+
+    //! Set up the data structures of `mech` for the reactions which include
+    //! only species with interaction coefficients `R` of at least the
+    //! threshold.
+    void buildReducedMechanism(const vector_fp& R,
+                               ReducedMechanism& mech);
+
+    //! Target species for dynamic mechanism reduction
+    std::vector<size_t> m_drgTargets;
+
+    //! Threshold for the DRGEP interaction coefficients
+    double m_drgThreshold;
+
+    //! Width of the temperature bins used to store reduced mechanisms
+    double m_drgDeltaT;
+
+    //! Width of the logarithmic bins used to store reduced mechanisms
+    double m_drgDeltaLogX;
+
+    //! Maximum number of stored reduced mechanisms
+    size_t m_drgMaxMechanisms;
+
+    //! Counter incremented each time a reduced mechanism is selected
+    size_t m_drgClock;
+
+    //! Reduced mechanisms generated for the bins in #m_reducedIndex
+    std::vector<ReducedMechanism> m_reduced;
+
+    //! Map from the state bin to the index in #m_reduced
+    std::map<std::vector<int>, size_t> m_reducedIndex;
+
+    //! Index in #m_reduced of the active reduced mechanism, or `npos` if the
+    //! full mechanism is active
+    size_t m_activeReduced;
+
+    //! True while the full mechanism is being evaluated to generate a
+    //! reduced mechanism
+    bool m_drgAnalysis;
+
+    //! Work array for the state bin
+    std::vector<int> m_drgBin;
+
     bool m_finalized;
 };
 }
@@ -93,6 +93,16 @@ public:
      */
     void integrate0(doublereal t0, doublereal t1);
 
+    //! Use the analytic Jacobian computed by evalJacobian() in the
+    //! integrator, instead of a finite difference approximation.
+    /*!
+     *  Takes effect the next time the integrator is initialized. The default
+     *  is to use finite differences, which are more robust when starting far
+     *  from the pseudo steady state (e.g. from a bare surface), where
+     *  coverages may transiently become slightly negative.
+     */
+    void setAnalyticJacobian(bool analytic);
+
     //! Solve for the pseudo steady-state of the surface problem
     /*!
      * Solve for the steady state of the surface problem.
@@ -136,6 +146,24 @@ public:
     virtual void eval(doublereal t, doublereal* y, doublereal* ydot,
                       doublereal* p);
 
+    //! Evaluate the Jacobian of the coverage equations
+    /*!
+     *  The derivatives of the surface production rates with respect to the
+     *  coverages are evaluated analytically (see
+     *  InterfaceKinetics::getNetProductionRates_ddCoverages), including the
+     *  normalization of the coverages done by updateState().
+     *
+     *  @param t   Time (seconds)
+     *  @param y   Vector containing the current solution vector
+     *  @param ydot   Value of the derivative of the surface coverages at y
+     *  @param ewt  Unused error weights of the integrator
+     *  @param p   Unused parameter pass-through parameter vector
+     *  @param jacCols  Pointers to the columns of the Jacobian
+     */
+    virtual void evalJacobian(double t, double* y, const double* ydot,
+                              const double* ewt, double* p,
+                              double* const* jacCols);
+
     //! Set the initial conditions for the solution vector
     /*!
      *  @param t0  Initial time
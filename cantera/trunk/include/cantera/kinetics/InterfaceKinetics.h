@@ -190,6 +190,39 @@ public:
     virtual void getRevRateConstants(doublereal* krev,
                                      bool doIrreversible = false);
 
+    //! @}
+    //! @name Derivatives of Rates of Progress and Production Rates
+    //! @{
+
+    //! Derivatives of the net rates of progress with respect to the activity
+    //! concentrations of the species.
+    /*!
+     *  Both the mass-action terms and the coverage dependencies of the rate
+     *  constants (see SurfaceArrhenius) are differentiated analytically. For
+     *  the surface species, the activity concentrations are the surface
+     *  concentrations \f$ \theta_k n_0 / \sigma_k \f$, and for ideal
+     *  gases, they are the molar concentrations. Sticking coefficients are
+     *  converted to rate constants which do not depend on the coverages when
+     *  reactions are added, so they require no special treatment. Where the
+     *  net rate of progress of a reaction is set to zero because a phase
+     *  does not exist or is unstable (see setPhaseExistence()), the
+     *  derivatives for that reaction are zero.
+     */
+    virtual void getNetRatesOfProgress_ddC(SparseMatrix& drop);
+
+    //! Derivatives of the net production rates of all kinetic species with
+    //! respect to the coverages of the species in the surface phase.
+    /*!
+     *  On return, `dwdot(k,j)` is the derivative of the net production rate
+     *  of kinetic species `k` with respect to the coverage of species `j` of
+     *  the surface phase, with the concentrations of the species in the
+     *  other phases held constant.
+     *
+     *  @param dwdot  Output sparse matrix. Dimensions: m_kk by the number of
+     *      species in the surface phase.
+     */
+    void getNetProductionRates_ddCoverages(SparseMatrix& dwdot);
+
     //! @}
     //! @name Reaction Mechanism Construction
     //! @{
@@ -280,6 +313,61 @@ public:
     void solvePseudoSteadyStateProblem(int ifuncOverride = -1,
                                        doublereal timeScaleOverride = 1.0);
 
+    //! Solve for the pseudo steady-state coverages of a batch of
+    //! independent surface sites sharing this mechanism
+    /*!
+     * For each site `n`, the bulk phase is set to the temperature `T[n]`,
+     * pressure `P[n]` and mass fractions `Y[n*K]` through `Y[n*K+K-1]`,
+     * where `K` is the number of species in the bulk phase, and the surface
+     * is set to the same temperature and pressure. The pseudo steady-state
+     * coverages are written to `theta[n*S]` through `theta[n*S+S-1]`, where
+     * `S` is the number of surface species. The states of both phases are
+     * restored afterwards.
+     *
+     * The sites are solved together by a damped Newton iteration on the
+     * block diagonal system formed by the site balances. The residual of
+     * each site is the rate of change of the coverages, with the equation
+     * for the species with the largest coverage replaced by the condition
+     * that the coverages sum to one. Its Jacobian block is evaluated
+     * analytically (see getNetProductionRates_ddCoverages()) and factored
+     * independently of the other blocks, and each site leaves the iteration
+     * as soon as its own update has converged. Far from the solution, each
+     * site takes implicit Euler steps of increasing size (pseudo-transient
+     * continuation) before switching to Newton's method.
+     *
+     * The iteration for each site starts from the values supplied in
+     * `theta`, e.g. the solution from the previous time step. If
+     * `warmStart` is true, sites which do not converge from there are
+     * restarted from the solution of the nearest converged site, which for
+     * the neighboring cells of a discretized channel is usually a good
+     * guess. Sites which still do not converge are solved one at a time
+     * with solvePseudoSteadyStateProblem(), starting from the supplied
+     * values.
+     *
+     * If Cantera is built with THREAD_SAFE_CANTERA, the sites are divided
+     * into `nThreads` contiguous blocks which are solved concurrently. Each
+     * worker thread other than the calling one operates on its own copies
+     * of the phases and of this kinetics manager. Otherwise, `nThreads` is
+     * ignored.
+     *
+     * Only kinetics managers with exactly one bulk phase are supported.
+     *
+     * @param nSites    Number of surface sites
+     * @param T         Temperatures [K]. Length: nSites.
+     * @param P         Pressures [Pa]. Length: nSites.
+     * @param Y         Bulk phase mass fractions. Length: nSites * K.
+     * @param theta     On input, initial guesses for the coverages; on
+     *                  output, the pseudo steady-state coverages.
+     *                  Length: nSites * S.
+     * @param warmStart Restart sites which fail to converge from the
+     *                  solution of a neighboring site
+     * @param nThreads  Number of threads to use
+     */
+    void solvePseudoSteadyStateBatch(size_t nSites, const doublereal* T,
+                                     const doublereal* P, const doublereal* Y,
+                                     doublereal* theta, bool warmStart = true,
+                                     size_t nThreads = 1);
+
     void setIOFlag(int ioFlag);
 
     void checkPartialEquil();
@@ -392,10 +480,29 @@ public:
     virtual void determineFwdOrdersBV(ReactionData& rdata, vector_fp& fwdFullorders);
     virtual void determineFwdOrdersBV(ElectrochemicalReaction& r, vector_fp& fwdFullorders);
 
+    //! Reassign the phase pointers, including the pointer to the surface
+    //! phase. See Kinetics::assignShallowPointers().
+    virtual void assignShallowPointers(const std::vector<thermo_t*> & tpVector);
+
 protected:
     void addElementaryReaction(InterfaceReaction& rdata);
     void addGlobalReaction(InterfaceReaction& r);
 
+    //! Newton iteration of solvePseudoSteadyStateBatch() for a contiguous
+    //! block of `nSites` sites, using the phases of this object.
+    /*!
+     *  The arrays `T`, `P`, `Y` and `theta` start at the first site of the
+     *  block. On return, `converged[n]` is nonzero for each site `n` of the
+     *  block whose coverages in `theta` have converged. Errors are returned
+     *  in `errmsg` instead of being thrown, so that this function can be run
+     *  in a worker thread.
+     */
+    void solvePseudoSteadyStateBlock(size_t nSites, const doublereal* T,
+                                     const doublereal* P, const doublereal* Y,
+                                     doublereal* theta, bool warmStart,
+                                     vector_int& converged,
+                                     std::string& errmsg);
+
     //! Temporary work vector of length m_kk
     vector_fp m_grt;
 
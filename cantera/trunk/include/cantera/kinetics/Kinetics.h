@@ -158,6 +158,14 @@ public:
      *  These routines are basically wrappers around the derived copy
      *  constructor.
      *
+     *  The Reaction objects and falloff function parameters are shared with
+     *  the duplicate, and everything else is copied, so that the duplicate
+     *  can be used from a different thread. This includes the stoichiometry
+     *  managers, the stoichiometric matrices and the rate coefficient
+     *  managers, which hold work arrays alongside the mechanism
+     *  parameters, so a duplicate uses about as much memory for the
+     *  mechanism as the original.
+     *
      * @param  tpVector Vector of pointers to ThermoPhase objects. this is the
      *                  #m_thermo vector within this object
      */
@@ -596,6 +604,67 @@ public:
      */
     virtual void getNetProductionRates(doublereal* wdot);
 
+    /**
+     * Species net production rates [kmol/m^3/s] for a batch of states of a
+     * single bulk phase. For each state `n`, the phase is set to the
+     * temperature `T[n]`, pressure `P[n]` and mass fractions
+     * `Y[n*K]` through `Y[n*K+K-1]`, where `K` is the number of species, and
+     * the net production rates are written to `wdot[n*K]` through
+     * `wdot[n*K+K-1]`. The state of the phase is restored afterwards.
+     *
+     * Temperature-dependent rate parameters are only re-evaluated when the
+     * temperature or pressure changes from one state to the next, so
+     * ordering the states by temperature can reduce the cost of the
+     * evaluation.
+     *
+     * @param nStates  Number of states
+     * @param T        Temperatures [K]. Length: nStates.
+     * @param P        Pressures [Pa]. Length: nStates.
+     * @param Y        Mass fractions. Length: nStates * m_kk.
+     * @param wdot     Output net production rates. Length: nStates * m_kk.
+     */
+    virtual void getNetProductionRates(size_t nStates, const doublereal* T,
+                                       const doublereal* P,
+                                       const doublereal* Y, doublereal* wdot);
+
+    //! @}
+    //! @name Derivatives of Rates of Progress and Production Rates
+    //! @{
+
+    /**
+     * Derivatives of the net rates of progress with respect to the activity
+     * concentrations of the species, at constant temperature. On return,
+     * `drop(i,k)` is the derivative of the net rate of progress of reaction
+     * `i` with respect to the activity concentration of species `k`.
+     *
+     * @param drop  Output sparse matrix. Dimensions: m_ii by m_kk.
+     */
+    virtual void getNetRatesOfProgress_ddC(SparseMatrix& drop) {
+        throw NotImplementedError("Kinetics::getNetRatesOfProgress_ddC");
+    }
+
+    /**
+     * Derivatives of the species net production rates with respect to the
+     * activity concentrations of the species, at constant temperature. On
+     * return, `dwdot(k,j)` is the derivative of the net production rate of
+     * species `k` with respect to the activity concentration of species `j`.
+     * The default implementation combines getNetRatesOfProgress_ddC() with
+     * the reaction stoichiometry.
+     *
+     * @param dwdot  Output sparse matrix. Dimensions: m_kk by m_kk.
+     */
+    virtual void getNetProductionRates_ddC(SparseMatrix& dwdot);
+
+    /**
+     * Derivatives of the species net production rates with respect to
+     * temperature, at constant activity concentrations.
+     *
+     * @param dwdot  Output vector. Length: m_kk.
+     */
+    virtual void getNetProductionRates_ddT(doublereal* dwdot) {
+        throw NotImplementedError("Kinetics::getNetProductionRates_ddT");
+    }
+
     //! @}
     //! @name Reaction Mechanism Informational Query Routines
     //! @{
@@ -717,6 +786,15 @@ public:
         return m_productStrings[i];
     }
 
+    /**
+     * Return the Reaction object for reaction *i*. Only reactions added
+     * through addReaction(shared_ptr<Reaction>) are available; an exception
+     * is thrown for reactions added from a ReactionData object.
+     *
+     * @param i   reaction index
+     */
+    shared_ptr<Reaction> reaction(size_t i) const;
+
     /**
      * Return the forward rate constants
      *
@@ -1096,6 +1174,24 @@ protected:
     //! @see skipUndeclaredThirdBodies()
     bool m_skipUndeclaredThirdBodies;
 
+    //! Construct the stoichiometric coefficient matrices m_stoichNet,
+    //! m_stoichNetT and m_stoichRevNetT from the stoichiometry managers, if
+    //! reactions or species have been added since they were last built.
+    void updateStoichMatrices();
+
+    //! Net stoichiometric coefficients (products minus reactants), with one
+    //! row for each species and one column for each reaction. Used to compute
+    //! the species production rates from the net rates of progress.
+    SparseMatrix m_stoichNet;
+
+    //! Transpose of m_stoichNet, with one row for each reaction. Used to
+    //! compute changes in species properties for each reaction.
+    SparseMatrix m_stoichNetT;
+
+    //! Same as m_stoichNetT, except that the products of irreversible
+    //! reactions are not included. See getRevReactionDelta().
+    SparseMatrix m_stoichRevNetT;
+
 private:
     std::map<size_t, std::vector<grouplist_t> > m_rgroups;
     std::map<size_t, std::vector<grouplist_t> > m_pgroups;
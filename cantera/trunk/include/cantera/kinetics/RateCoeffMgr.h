@@ -87,15 +87,465 @@ public:
         }
     }
 
+    /**
+     * Update the concentration-dependent parts of a subset of the rate
+     * coefficients. The subset is specified by the positions of the rate
+     * coefficients in the order in which they were installed (see
+     * reactionIndex()).
+     */
+    void update_C(const doublereal* c, const std::vector<size_t>& index) {
+        for (size_t j = 0; j < index.size(); j++) {
+            m_rates[index[j]].update_C(c);
+        }
+    }
+
+    /**
+     * Write the rate coefficients for a subset of the installed rate
+     * coefficients into array values, in the same way as update(). The
+     * subset is specified as for update_C(const doublereal*, const
+     * std::vector<size_t>&). Entries of values for other reactions are not
+     * modified.
+     */
+    void update(doublereal T, doublereal logT, doublereal* values,
+                const std::vector<size_t>& index) {
+        doublereal recipT = 1.0/T;
+        for (size_t j = 0; j < index.size(); j++) {
+            size_t i = index[j];
+            values[m_rxn[i]] = m_rates[i].updateRC(logT, recipT);
+        }
+    }
+
     size_t nReactions() const {
         return m_rates.size();
     }
 
+    //! Reaction number of the i-th installed rate coefficient
+    size_t reactionIndex(size_t i) const {
+        return m_rxn[i];
+    }
+
+    /**
+     * Append the derivatives of the logarithms of the rate coefficients
+     * with respect to the surface coverages to the triplet list dlogk, for
+     * rate coefficient types which depend on the coverages (see
+     * SurfaceArrhenius::getCoverageDerivatives). The rows of the triplets
+     * are the reaction numbers.
+     */
+    void getCoverageDerivatives(const doublereal* theta, doublereal recipT,
+                                SparseTripletList& dlogk) const {
+        for (size_t i = 0; i != m_rates.size(); i++) {
+            m_rates[i].getCoverageDerivatives(m_rxn[i], theta, recipT, dlogk);
+        }
+    }
+
 protected:
     std::vector<R>             m_rates;
     std::vector<size_t>           m_rxn;
 };
 
+/**
+ * Specialization of Rate1 for modified Arrhenius rate coefficients. Rather
+ * than storing an array of Arrhenius objects, the parameters are stored in
+ * separate contiguous arrays, and the rate coefficients are evaluated in a
+ * sequence of simple loops over these arrays that the compiler is able to
+ * vectorize. The results are then scattered into the output array.
+ */
+template<>
+class Rate1<Arrhenius>
+{
+public:
+    Rate1() {}
+    virtual ~Rate1() {}
+
+    /**
+     * Install a rate coefficient calculator.
+     * @param rxnNumber the reaction number
+     * @param rdata rate coefficient specification for the reaction
+     */
+    size_t install(size_t rxnNumber, const ReactionData& rdata) {
+        if (rdata.rateCoeffType != Arrhenius::type())
+            throw CanteraError("Rate1::install",
+                               "incorrect rate coefficient type: "+int2str(rdata.rateCoeffType) + ". Was Expecting type: "+ int2str(Arrhenius::type()));
+        install(rxnNumber, Arrhenius(rdata));
+        return m_A.size() - 1;
+    }
+
+    /**
+     * Install a rate coefficient calculator.
+     * @param rxnNumber the reaction number
+     * @param rate rate coefficient specification for the reaction
+     */
+    void install(size_t rxnNumber, const Arrhenius& rate) {
+        m_rxn.push_back(rxnNumber);
+        m_A.push_back(rate.preExponentialFactor());
+        m_b.push_back(rate.temperatureExponent());
+        m_E.push_back(rate.activationEnergy_R());
+        m_work.push_back(0.0);
+    }
+
+    //! Arrhenius rate coefficients do not depend on concentration, so this
+    //! method does nothing.
+    void update_C(const doublereal* c) {}
+
+    /**
+     * Write the rate coefficients into array values. Each rate coefficient
+     * is written at the location specified by the reaction number when it
+     * was installed.
+     */
+    void update(doublereal T, doublereal logT, doublereal* values) {
+        doublereal recipT = 1.0/T;
+        size_t n = m_A.size();
+        if (n == 0) {
+            return;
+        }
+        const doublereal* A = &m_A[0];
+        const doublereal* b = &m_b[0];
+        const doublereal* E = &m_E[0];
+        doublereal* w = &m_work[0];
+        for (size_t i = 0; i < n; i++) {
+            w[i] = b[i]*logT - E[i]*recipT;
+        }
+        for (size_t i = 0; i < n; i++) {
+            w[i] = A[i] * std::exp(w[i]);
+        }
+        for (size_t i = 0; i < n; i++) {
+            values[m_rxn[i]] = w[i];
+        }
+    }
+
+    /**
+     * Write the rate coefficients for `nStates` states into array values.
+     * The rate coefficient for reaction `i` in state `n` is written to
+     * `values[i*nStates + n]`. The innermost loop runs over the states.
+     *
+     * @param nStates  Number of states
+     * @param logT     Natural logarithm of the temperature of each state
+     * @param recipT   Reciprocal of the temperature of each state
+     * @param values   Output array, stored reaction by reaction
+     */
+    void update(size_t nStates, const doublereal* logT,
+                const doublereal* recipT, doublereal* values) const {
+        for (size_t i = 0; i < m_A.size(); i++) {
+            doublereal* k = values + m_rxn[i] * nStates;
+            doublereal A = m_A[i];
+            doublereal b = m_b[i];
+            doublereal E = m_E[i];
+            for (size_t n = 0; n < nStates; n++) {
+                k[n] = A * std::exp(b*logT[n] - E*recipT[n]);
+            }
+        }
+    }
+
+    /**
+     * Write the rate coefficients for a subset of the installed rate
+     * coefficients into array values. The subset is specified by the
+     * positions of the rate coefficients in the order in which they were
+     * installed (see reactionIndex()). Entries of values for other reactions
+     * are not modified.
+     */
+    void update(doublereal T, doublereal logT, doublereal* values,
+                const std::vector<size_t>& index) {
+        doublereal recipT = 1.0/T;
+        for (size_t j = 0; j < index.size(); j++) {
+            size_t i = index[j];
+            values[m_rxn[i]] = m_A[i] * std::exp(m_b[i]*logT - m_E[i]*recipT);
+        }
+    }
+
+    size_t nReactions() const {
+        return m_A.size();
+    }
+
+    //! Reaction number of the i-th installed rate coefficient
+    size_t reactionIndex(size_t i) const {
+        return m_rxn[i];
+    }
+
+    /**
+     * Write C++ statements which evaluate the rate coefficients, with the
+     * rate parameters written as numeric constants. The generated code
+     * assigns to the array named `values` and uses a variable named `T`,
+     * which must be defined by the enclosing code. The local variables
+     * `logT` and `recipT` are declared only if some rate coefficient
+     * depends on them.
+     */
+    void writeUpdate(std::ostream& s, const std::string& values) const {
+        bool uselogT = false, userecipT = false;
+        for (size_t i = 0; i < m_A.size(); i++) {
+            uselogT = uselogT || (m_b[i] != 0.0);
+            userecipT = userecipT || (m_E[i] != 0.0);
+        }
+        if (uselogT) {
+            s << "    double logT = std::log(T);" << std::endl;
+        }
+        if (userecipT) {
+            s << "    double recipT = 1.0 / T;" << std::endl;
+        }
+        for (size_t i = 0; i < m_A.size(); i++) {
+            s << "    " << values << "[" << m_rxn[i] << "] = "
+              << fp2str(m_A[i], "%.17g");
+            if (m_b[i] != 0.0 || m_E[i] != 0.0) {
+                s << " * exp(";
+                if (m_b[i] != 0.0) {
+                    s << fp2str(m_b[i], "%.17g") << " * logT";
+                }
+                if (m_E[i] != 0.0) {
+                    s << " - " << fp2str(m_E[i], "%.17g") << " * recipT";
+                }
+                s << ")";
+            }
+            s << ";" << std::endl;
+        }
+    }
+
+protected:
+    //! Pre-exponential factors
+    vector_fp m_A;
+    //! Temperature exponents
+    vector_fp m_b;
+    //! Activation temperatures [K]
+    vector_fp m_E;
+    //! Work array holding the rate coefficients before they are scattered
+    //! into the output array
+    vector_fp m_work;
+    //! Reaction index of each rate coefficient
+    std::vector<size_t> m_rxn;
+};
+
+/**
+ * Specialization of Rate1 for pressure-dependent rate coefficients
+ * interpolated between Arrhenius expressions given at a set of pressures
+ * (see class Plog). The pressures and Arrhenius parameters of all reactions
+ * are stored in flat arrays. Reactions whose rate expressions are given at the
+ * same set of pressures share a pressure grid, so that the search for the
+ * pressures bracketing the current pressure in update_C() is done only once
+ * for each distinct grid. The rate coefficients are then evaluated for all
+ * reactions in a single pass by update().
+ */
+template<>
+class Rate1<Plog>
+{
+public:
+    Rate1() {}
+    virtual ~Rate1() {}
+
+    /**
+     * Install a rate coefficient calculator.
+     * @param rxnNumber the reaction number
+     * @param rdata rate coefficient specification for the reaction
+     */
+    size_t install(size_t rxnNumber, const ReactionData& rdata) {
+        if (rdata.rateCoeffType != Plog::type())
+            throw CanteraError("Rate1::install",
+                               "incorrect rate coefficient type: "+int2str(rdata.rateCoeffType) + ". Was Expecting type: "+ int2str(Plog::type()));
+        install(rxnNumber, Plog(rdata));
+        return m_rxn.size() - 1;
+    }
+
+    /**
+     * Install a rate coefficient calculator.
+     * @param rxnNumber the reaction number
+     * @param rate rate coefficient specification for the reaction
+     */
+    void install(size_t rxnNumber, const Plog& rate) {
+        std::vector<std::pair<double, Arrhenius> > rates = rate.rates();
+
+        // Group the rate expressions by pressure. As in class Plog, the first
+        // and last groups are duplicated at log(P) = -1000 and +1000 to
+        // handle pressures outside the range of the given pressures.
+        vector_fp logP(1, -1000.0);
+        size_t first = m_levelStart.size();
+        for (size_t j = 0; j < rates.size(); j++) {
+            double lp = std::log(rates[j].first);
+            if (j == 0 || lp != logP.back()) {
+                logP.push_back(lp);
+                m_levelStart.push_back(m_A.size());
+                m_levelCount.push_back(0);
+            }
+            const Arrhenius& k = rates[j].second;
+            m_A.push_back(k.preExponentialFactor());
+            m_n.push_back(k.temperatureExponent());
+            m_Ea.push_back(k.activationEnergy_R());
+            m_levelCount.back()++;
+        }
+        logP.push_back(1000.0);
+
+        // For pressures with only one Arrhenius expression, store log(A)
+        for (size_t m = first; m < m_levelStart.size(); m++) {
+            if (m_levelCount[m] == 1) {
+                m_A[m_levelStart[m]] = std::log(m_A[m_levelStart[m]]);
+            }
+        }
+
+        // Entries for the duplicated first and last groups. The entries for
+        // each reaction are ordered by increasing pressure.
+        m_levelStart.insert(m_levelStart.begin() + first, m_levelStart[first]);
+        m_levelCount.insert(m_levelCount.begin() + first, m_levelCount[first]);
+        m_levelStart.push_back(m_levelStart.back());
+        m_levelCount.push_back(m_levelCount.back());
+
+        // Find or add the pressure grid for this reaction
+        size_t g = 0;
+        while (g < m_grids.size() && m_grids[g] != logP) {
+            g++;
+        }
+        if (g == m_grids.size()) {
+            m_grids.push_back(logP);
+            m_gridLower.push_back(npos);
+            m_gridFrac.push_back(0.0);
+        }
+
+        m_rxn.push_back(rxnNumber);
+        m_grid.push_back(g);
+        m_firstLevel.push_back(first);
+        m_level1.push_back(first);
+        m_frac.push_back(0.0);
+        m_logk1.push_back(0.0);
+        m_logk2.push_back(0.0);
+        m_logP = -1000.0;
+    }
+
+    /**
+     * Update the pressure-dependent parts of the rate coefficients.
+     * @param c natural log of the pressure in Pa
+     */
+    void update_C(const doublereal* c) {
+        m_logP = c[0];
+        for (size_t g = 0; g < m_grids.size(); g++) {
+            const vector_fp& logP = m_grids[g];
+            size_t& j = m_gridLower[g];
+            if (j != npos && m_logP > logP[j] && m_logP < logP[j+1]) {
+                continue;
+            }
+            vector_fp::const_iterator iter =
+                std::upper_bound(logP.begin(), logP.end(), m_logP);
+            AssertThrowMsg(iter != logP.end(), "Rate1<Plog>::update_C",
+                           "Pressure out of range: " + fp2str(m_logP));
+            AssertThrowMsg(iter != logP.begin(), "Rate1<Plog>::update_C",
+                           "Pressure out of range: " + fp2str(m_logP));
+            j = (iter - logP.begin()) - 1;
+        }
+        for (size_t g = 0; g < m_grids.size(); g++) {
+            const vector_fp& logP = m_grids[g];
+            size_t j = m_gridLower[g];
+            m_gridFrac[g] = (m_logP - logP[j]) / (logP[j+1] - logP[j]);
+        }
+        for (size_t i = 0; i < m_rxn.size(); i++) {
+            m_level1[i] = m_firstLevel[i] + m_gridLower[m_grid[i]];
+            m_frac[i] = m_gridFrac[m_grid[i]];
+        }
+    }
+
+    /**
+     * Write the rate coefficients into array values. Each rate coefficient
+     * is written at the location specified by the reaction number when it
+     * was installed. update_C() must be called first.
+     */
+    void update(doublereal T, doublereal logT, doublereal* values) {
+        doublereal recipT = 1.0/T;
+        size_t n = m_rxn.size();
+        for (size_t i = 0; i < n; i++) {
+            m_logk1[i] = logRate(m_level1[i], logT, recipT);
+            m_logk2[i] = logRate(m_level1[i] + 1, logT, recipT);
+        }
+        for (size_t i = 0; i < n; i++) {
+            m_logk1[i] = std::exp(m_logk1[i] +
+                                  (m_logk2[i] - m_logk1[i]) * m_frac[i]);
+        }
+        for (size_t i = 0; i < n; i++) {
+            values[m_rxn[i]] = m_logk1[i];
+        }
+    }
+
+    /**
+     * Write the rate coefficients for a subset of the installed rate
+     * coefficients into array values. The subset is specified by the
+     * positions of the rate coefficients in the order in which they were
+     * installed (see reactionIndex()). Entries of values for other reactions
+     * are not modified. update_C() must be called first.
+     */
+    void update(doublereal T, doublereal logT, doublereal* values,
+                const std::vector<size_t>& index) {
+        doublereal recipT = 1.0/T;
+        for (size_t j = 0; j < index.size(); j++) {
+            size_t i = index[j];
+            double logk1 = logRate(m_level1[i], logT, recipT);
+            double logk2 = logRate(m_level1[i] + 1, logT, recipT);
+            values[m_rxn[i]] = std::exp(logk1 + (logk2 - logk1) * m_frac[i]);
+        }
+    }
+
+    size_t nReactions() const {
+        return m_rxn.size();
+    }
+
+    //! Reaction number of the i-th installed rate coefficient
+    size_t reactionIndex(size_t i) const {
+        return m_rxn[i];
+    }
+
+    //! Number of distinct pressure grids used by the installed reactions
+    size_t nPressureGrids() const {
+        return m_grids.size();
+    }
+
+protected:
+    //! Logarithm of the rate coefficient given by the Arrhenius expressions
+    //! at pressure level `m`
+    double logRate(size_t m, double logT, double recipT) const {
+        size_t start = m_levelStart[m];
+        if (m_levelCount[m] == 1) {
+            return m_A[start] + m_n[start] * logT - m_Ea[start] * recipT;
+        }
+        double k = 1e-300; // non-zero to make log(k) finite
+        for (size_t j = start; j < start + m_levelCount[m]; j++) {
+            k += m_A[j] * std::exp(m_n[j] * logT - m_Ea[j] * recipT);
+        }
+        return std::log(k);
+    }
+
+    //! Pre-exponential factors. Stored as log(A) for pressure levels with
+    //! only one Arrhenius expression.
+    vector_fp m_A;
+    vector_fp m_n; //!< Temperature exponents
+    vector_fp m_Ea; //!< Activation temperatures [K]
+
+    //! Index in #m_A of the first Arrhenius expression at each pressure
+    //! level of each reaction
+    std::vector<size_t> m_levelStart;
+
+    //! Number of Arrhenius expressions at each pressure level of each reaction
+    std::vector<size_t> m_levelCount;
+
+    //! Distinct grids of log(P), including the entries at -1000 and +1000
+    std::vector<vector_fp> m_grids;
+
+    //! Index of the grid point below the current pressure, for each grid
+    std::vector<size_t> m_gridLower;
+
+    //! Interpolation fraction of the current pressure, for each grid
+    vector_fp m_gridFrac;
+
+    std::vector<size_t> m_rxn; //!< Reaction index of each rate coefficient
+    std::vector<size_t> m_grid; //!< Pressure grid of each reaction
+
+    //! Index in #m_levelStart of the first pressure level of each reaction
+    std::vector<size_t> m_firstLevel;
+
+    //! Index in #m_levelStart of the pressure level below the current
+    //! pressure, for each reaction
+    std::vector<size_t> m_level1;
+
+    //! Interpolation fraction of the current pressure, for each reaction
+    vector_fp m_frac;
+
+    //! Work arrays for the logarithms of the rate coefficients at the lower
+    //! and upper bracketing pressures
+    vector_fp m_logk1, m_logk2;
+
+    double m_logP; //!< log(p) at the current state
+};
+
 }
 
 #endif
@@ -0,0 +1,119 @@
+/**
+ *  @file RateTable.h
+ *  Tabulation of temperature-dependent rate parameters
+ *  (see \link Cantera::RateTable RateTable\endlink).
+ */
+
+#ifndef CT_RATETABLE_H
+#define CT_RATETABLE_H
+
+#include "cantera/base/ct_defs.h"
+
+namespace Cantera
+{
+
+//! Table of temperature-dependent quantities evaluated by interpolation.
+/*!
+ *  The table stores a set of quantities (the columns of the table) at points
+ *  which are uniformly spaced in 1/T between a minimum and maximum
+ *  temperature. Values at intermediate temperatures are obtained by Lagrange
+ *  interpolation in 1/T, using the #InterpolationPoints nearest points.
+ *
+ *  The values are interpolated directly, rather than in terms of their
+ *  logarithms, so that evaluating the table requires only multiplications
+ *  and additions. For rate constants following modified Arrhenius
+ *  expressions, the number of points needed to reach a given tolerance with
+ *  eight-point interpolation is similar to that needed by cubic
+ *  interpolation of their logarithms.
+ *
+ *  To build a table, call setup(), then setValues() for each of the
+ *  temperatures given by temperature().
+ */
+class RateTable
+{
+public:
+    RateTable();
+
+    //! Number of points used for each interpolation
+    static const size_t InterpolationPoints = 8;
+
+    //! Allocate a table for `nColumns` quantities at `nPoints` temperatures
+    //! between `Tmin` and `Tmax`. Discards any previously stored values.
+    void setup(size_t nColumns, size_t nPoints, double Tmin, double Tmax);
+
+    //! Remove all entries from the table
+    void clear();
+
+    //! Number of tabulated temperatures. Zero if the table is empty.
+    size_t nPoints() const {
+        return m_npoints;
+    }
+
+    //! Number of tabulated quantities
+    size_t nColumns() const {
+        return m_ncols;
+    }
+
+    //! Temperature [K] of tabulation point `j`
+    double temperature(size_t j) const {
+        return 1.0 / (m_xmin + j * m_dx);
+    }
+
+    //! Minimum temperature [K] covered by the table
+    double minTemp() const {
+        return m_Tmin;
+    }
+
+    //! Maximum temperature [K] covered by the table
+    double maxTemp() const {
+        return m_Tmax;
+    }
+
+    //! Return true if the table can be used at temperature `T`
+    bool inRange(double T) const {
+        return m_npoints != 0 && T >= m_Tmin && T <= m_Tmax;
+    }
+
+    //! Set the values of all quantities at tabulation point `j`.
+    //! @param j       Index of the tabulation point
+    //! @param values  Values of the quantities. Length: nColumns().
+    void setValues(size_t j, const double* values);
+
+    //! Evaluate all of the quantities at temperature `T`, which must be
+    //! within the range of the table.
+    //! @param T       Temperature [K]
+    //! @param values  Output array of length nColumns().
+    void interpolate(double T, double* values) const;
+
+    //! Evaluate the quantities in the given columns at temperature `T`,
+    //! which must be within the range of the table. Other entries of
+    //! `values` are not modified.
+    //! @param T        Temperature [K]
+    //! @param values   Output array of length nColumns().
+    //! @param columns  Indices of the columns to evaluate
+    void interpolate(double T, double* values,
+                     const std::vector<size_t>& columns) const;
+
+protected:
+    size_t m_ncols; //!< Number of columns
+    size_t m_npoints; //!< Number of tabulation points
+    double m_Tmin; //!< Minimum temperature
+    double m_Tmax; //!< Maximum temperature
+    double m_xmin; //!< 1/Tmax
+    double m_dx; //!< Spacing of the tabulation points in 1/T
+
+    //! Compute the interpolation weights `w` for temperature `T`, and
+    //! return the index of the first of the tabulation points they apply to.
+    size_t weights(double T, double* w) const;
+
+    //! Tabulated values. The values at point `j` are stored in
+    //! `m_data[j*m_ncols]` through `m_data[(j+1)*m_ncols - 1]`.
+    vector_fp m_data;
+
+    //! Denominators of the Lagrange basis polynomials
+    double m_weights[InterpolationPoints];
+};
+
+}
+
+#endif
@@ -11,6 +11,7 @@
 #include "ReactionData.h"
 #include "cantera/base/ctexceptions.h"
 #include "cantera/base/stringUtils.h"
+#include "cantera/numerics/SparseMatrix.h"
 
 #include <iostream>
 
@@ -198,6 +199,36 @@ public:
         return m_E + m_ecov;
     }
 
+    //! Derivatives of the natural logarithm of the rate constant with
+    //! respect to the surface coverages.
+    /*!
+     *  For each species with a coverage dependency, the triplet (`rxn`,
+     *  `k`, \f$ \partial \ln k_f / \partial \theta_k \f$) is appended
+     *  to `dlogk`, where `k` is the index of the species in the array of
+     *  coverages.
+     *
+     *  @param rxn    Reaction number to use for the row of each triplet
+     *  @param theta  Surface coverages, as passed to update_C()
+     *  @param recipT Reciprocal of the temperature [1/K]
+     *  @param dlogk  List of triplets to append to
+     */
+    void getCoverageDerivatives(size_t rxn, const doublereal* theta,
+                                doublereal recipT,
+                                SparseTripletList& dlogk) const {
+        for (size_t n = 0; n < m_ncov; n++) {
+            dlogk.push_back(SparseTriplet(rxn, m_sp[n],
+                std::log(10.0)*m_ac[n] - m_ec[n]*recipT));
+        }
+        for (size_t n = 0; n < m_nmcov; n++) {
+            // update_C limits the coverage to Tiny, where the derivative of
+            // the limited expression is zero
+            if (theta[m_msp[n]] > Tiny) {
+                dlogk.push_back(SparseTriplet(rxn, m_msp[n],
+                                              m_mc[n] / theta[m_msp[n]]));
+            }
+        }
+    }
+
     //! @deprecated. To be removed after Cantera 2.2
     static bool alwaysComputeRate() {
         return true;
@@ -406,6 +437,10 @@ public:
         return false;
     }
 
+    //! Return the pressures [Pa] and Arrhenius expressions which comprise
+    //! this reaction, in order of increasing pressure.
+    std::vector<std::pair<double, Arrhenius> > rates() const;
+
     //! Check to make sure that the rate expression is finite over a range of
     //! temperatures at each interpolation pressure. This is potentially an
     //! issue when one of the Arrhenius expressions at a particular pressure
@@ -523,7 +558,45 @@ public:
         return false;
     }
 
+    //! Minimum valid temperature [K]
+    double Tmin() const {
+        return Tmin_;
+    }
+
+    //! Maximum valid temperature [K]
+    double Tmax() const {
+        return Tmax_;
+    }
+
+    //! Minimum valid pressure [Pa]
+    double Pmin() const {
+        return Pmin_;
+    }
+
+    //! Maximum valid pressure [Pa]
+    double Pmax() const {
+        return Pmax_;
+    }
+
+    //! Number of points in the pressure direction
+    size_t nPressure() const {
+        return nP_;
+    }
+
+    //! Number of points in the temperature direction
+    size_t nTemperature() const {
+        return nT_;
+    }
+
+    //! Access the Chebyshev coefficients. The coefficient for temperature
+    //! index `t` and pressure index `p` is `coeffs()[nPressure()*t + p]`.
+    const vector_fp& coeffs() const {
+        return chebCoeffs_;
+    }
+
 protected:
+    double Tmin_, Tmax_; //!< valid temperature range
+    double Pmin_, Pmax_; //!< valid pressure range
     double TrNum_, TrDen_; //!< terms appearing in the reduced temperature
     double PrNum_, PrDen_; //!< terms appearing in the reduced pressure
 
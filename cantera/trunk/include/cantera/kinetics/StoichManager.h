@@ -9,6 +9,7 @@
 
 #include "cantera/base/stringUtils.h"
 #include "cantera/base/ctexceptions.h"
+#include "cantera/numerics/SparseMatrix.h"
 
 namespace Cantera
 {
@@ -97,6 +98,16 @@ namespace Cantera
  *  - decrementSpecies(in, out)  : out[k0], out[k1], and out[k2]
  *    are all decremented by in[irxn]
  *
+ *  - derivatives(in, R, jac) : appends the entries (irxn, k0,
+ *    R[irxn] * in[k1] * in[k2]), (irxn, k1, R[irxn] * in[k0] * in[k2]) and
+ *    (irxn, k2, R[irxn] * in[k0] * in[k1]) to the triplet list jac, i.e. the
+ *    derivatives of the product formed by multiply().
+ *
+ *  - stoichCoeffs(coeffs, scale) : appends the entries (k0, irxn, scale),
+ *    (k1, irxn, scale) and (k2, irxn, scale) to the triplet list coeffs.
+ *    This is used to assemble the stoichiometric coefficient matrices as
+ *    SparseMatrix objects (see Kinetics::getNetProductionRates).
+ *
  * The function multiply() is usually used when evaluating the forward and
  * reverse rates of progress of reactions. The rate constants are usually
  * loaded into out[]. Then multiply() is called to add in the dependence of
@@ -135,7 +146,6 @@ static doublereal ppow(doublereal x, doublereal order)
     }
 }
 
-//! @deprecated To be removed after Cantera 2.2
 inline static std::string fmt(const std::string& r, size_t n)
 {
     return r + "[" + int2str(n) + "]";
@@ -173,6 +183,14 @@ public:
         R[m_rxn] *= S[m_ic0];
     }
 
+    void multiply(const doublereal* S, doublereal* R, size_t nStates) const {
+        doublereal* r = R + m_rxn * nStates;
+        const doublereal* s0 = S + m_ic0 * nStates;
+        for (size_t n = 0; n < nStates; n++) {
+            r[n] *= s0[n];
+        }
+    }
+
     void incrementReaction(const doublereal* S, doublereal* R) const {
         R[m_rxn] += S[m_ic0];
     }
@@ -181,6 +199,15 @@ public:
         R[m_rxn] -= S[m_ic0];
     }
 
+    void derivatives(const doublereal* S, const doublereal* R,
+                     SparseTripletList& jac) const {
+        jac.push_back(SparseTriplet(m_rxn, m_ic0, R[m_rxn]));
+    }
+
+    void stoichCoeffs(SparseTripletList& coeffs, doublereal scale) const {
+        coeffs.push_back(SparseTriplet(m_ic0, m_rxn, scale));
+    }
+
     size_t rxnNumber() const {
         return m_rxn;
     }
@@ -191,28 +218,25 @@ public:
         return 1;
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeMultiply(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeMultiply(const std::string& r, std::map<size_t, std::string>& out) const {
         out[m_rxn] = fmt(r, m_ic0);
     }
 
     //! @deprecated To be removed after Cantera 2.2
-    void writeIncrementReaction(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeIncrementReaction(const std::string& r, std::map<size_t, std::string>& out) const {
         out[m_rxn] += " + "+fmt(r, m_ic0);
     }
 
     //! @deprecated To be removed after Cantera 2.2
-    void writeDecrementReaction(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeDecrementReaction(const std::string& r, std::map<size_t, std::string>& out) const {
         out[m_rxn] += " - "+fmt(r, m_ic0);
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeIncrementSpecies(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeIncrementSpecies(const std::string& r, std::map<size_t, std::string>& out) const {
         out[m_ic0] += " + "+fmt(r, m_rxn);
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeDecrementSpecies(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeDecrementSpecies(const std::string& r, std::map<size_t, std::string>& out) const {
         out[m_ic0] += " - "+fmt(r, m_rxn);
     }
 
@@ -255,6 +279,15 @@ public:
         R[m_rxn] *= S[m_ic0] * S[m_ic1];
     }
 
+    void multiply(const doublereal* S, doublereal* R, size_t nStates) const {
+        doublereal* r = R + m_rxn * nStates;
+        const doublereal* s0 = S + m_ic0 * nStates;
+        const doublereal* s1 = S + m_ic1 * nStates;
+        for (size_t n = 0; n < nStates; n++) {
+            r[n] *= s0[n] * s1[n];
+        }
+    }
+
     void incrementReaction(const doublereal* S, doublereal* R) const {
         R[m_rxn] += S[m_ic0] + S[m_ic1];
     }
@@ -263,6 +296,17 @@ public:
         R[m_rxn] -= (S[m_ic0] + S[m_ic1]);
     }
 
+    void derivatives(const doublereal* S, const doublereal* R,
+                     SparseTripletList& jac) const {
+        jac.push_back(SparseTriplet(m_rxn, m_ic0, R[m_rxn] * S[m_ic1]));
+        jac.push_back(SparseTriplet(m_rxn, m_ic1, R[m_rxn] * S[m_ic0]));
+    }
+
+    void stoichCoeffs(SparseTripletList& coeffs, doublereal scale) const {
+        coeffs.push_back(SparseTriplet(m_ic0, m_rxn, scale));
+        coeffs.push_back(SparseTriplet(m_ic1, m_rxn, scale));
+    }
+
     size_t rxnNumber() const {
         return m_rxn;
     }
@@ -273,30 +317,27 @@ public:
         return 2;
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeMultiply(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeMultiply(const std::string& r, std::map<size_t, std::string>& out) const {
         out[m_rxn] = fmt(r, m_ic0) + " * " + fmt(r, m_ic1);
     }
 
     //! @deprecated To be removed after Cantera 2.2
-    void writeIncrementReaction(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeIncrementReaction(const std::string& r, std::map<size_t, std::string>& out) const {
         out[m_rxn] += " + "+fmt(r, m_ic0)+" + "+fmt(r, m_ic1);
     }
 
     //! @deprecated To be removed after Cantera 2.2
-    void writeDecrementReaction(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeDecrementReaction(const std::string& r, std::map<size_t, std::string>& out) const {
         out[m_rxn] += " - "+fmt(r, m_ic0)+" - "+fmt(r, m_ic1);
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeIncrementSpecies(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeIncrementSpecies(const std::string& r, std::map<size_t, std::string>& out) const {
         std::string s = " + "+fmt(r, m_rxn);
         out[m_ic0] += s;
         out[m_ic1] += s;
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeDecrementSpecies(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeDecrementSpecies(const std::string& r, std::map<size_t, std::string>& out) const {
         std::string s = " - "+fmt(r, m_rxn);
         out[m_ic0] += s;
         out[m_ic1] += s;
@@ -345,6 +386,16 @@ public:
         R[m_rxn] *= S[m_ic0] * S[m_ic1] * S[m_ic2];
     }
 
+    void multiply(const doublereal* S, doublereal* R, size_t nStates) const {
+        doublereal* r = R + m_rxn * nStates;
+        const doublereal* s0 = S + m_ic0 * nStates;
+        const doublereal* s1 = S + m_ic1 * nStates;
+        const doublereal* s2 = S + m_ic2 * nStates;
+        for (size_t n = 0; n < nStates; n++) {
+            r[n] *= s0[n] * s1[n] * s2[n];
+        }
+    }
+
     void incrementReaction(const doublereal* S, doublereal* R) const {
         R[m_rxn] += S[m_ic0] + S[m_ic1] + S[m_ic2];
     }
@@ -353,6 +404,22 @@ public:
         R[m_rxn] -= (S[m_ic0] + S[m_ic1] + S[m_ic2]);
     }
 
+    void derivatives(const doublereal* S, const doublereal* R,
+                     SparseTripletList& jac) const {
+        jac.push_back(SparseTriplet(m_rxn, m_ic0,
+                                    R[m_rxn] * S[m_ic1] * S[m_ic2]));
+        jac.push_back(SparseTriplet(m_rxn, m_ic1,
+                                    R[m_rxn] * S[m_ic0] * S[m_ic2]));
+        jac.push_back(SparseTriplet(m_rxn, m_ic2,
+                                    R[m_rxn] * S[m_ic0] * S[m_ic1]));
+    }
+
+    void stoichCoeffs(SparseTripletList& coeffs, doublereal scale) const {
+        coeffs.push_back(SparseTriplet(m_ic0, m_rxn, scale));
+        coeffs.push_back(SparseTriplet(m_ic1, m_rxn, scale));
+        coeffs.push_back(SparseTriplet(m_ic2, m_rxn, scale));
+    }
+
     size_t rxnNumber() const {
         return m_rxn;
     }
@@ -363,31 +430,28 @@ public:
         return 3;
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeMultiply(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeMultiply(const std::string& r, std::map<size_t, std::string>& out) const {
         out[m_rxn] = fmt(r, m_ic0) + " * " + fmt(r, m_ic1) + " * " + fmt(r, m_ic2);
     }
 
     //! @deprecated To be removed after Cantera 2.2
-    void writeIncrementReaction(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeIncrementReaction(const std::string& r, std::map<size_t, std::string>& out) const {
         out[m_rxn] += " + "+fmt(r, m_ic0)+" + "+fmt(r, m_ic1)+" + "+fmt(r, m_ic2);
     }
 
     //! @deprecated To be removed after Cantera 2.2
-    void writeDecrementReaction(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeDecrementReaction(const std::string& r, std::map<size_t, std::string>& out) const {
         out[m_rxn] += " - "+fmt(r, m_ic0)+" - "+fmt(r, m_ic1)+" - "+fmt(r, m_ic2);
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeIncrementSpecies(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeIncrementSpecies(const std::string& r, std::map<size_t, std::string>& out) const {
         std::string s = " + "+fmt(r, m_rxn);
         out[m_ic0] += s;
         out[m_ic1] += s;
         out[m_ic2] += s;
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeDecrementSpecies(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeDecrementSpecies(const std::string& r, std::map<size_t, std::string>& out) const {
         std::string s = " - "+fmt(r, m_rxn);
         out[m_ic0] += s;
         out[m_ic1] += s;
@@ -456,6 +520,21 @@ public:
         }
     }
 
+    void multiply(const doublereal* input, doublereal* output,
+                  size_t nStates) const {
+        doublereal* r = output + m_rxn * nStates;
+        for (size_t n = 0; n < m_n; n++) {
+            doublereal oo = m_order[n];
+            if (oo == 0.0) {
+                continue;
+            }
+            const doublereal* c = input + m_ic[n] * nStates;
+            for (size_t j = 0; j < nStates; j++) {
+                r[j] *= ppow(c[j], oo);
+            }
+        }
+    }
+
     void incrementSpecies(const doublereal* input,
                           doublereal* output) const {
         doublereal x = input[m_rxn];
@@ -484,48 +563,82 @@ public:
             -= m_stoich[n]*input[m_ic[n]];
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeMultiply(const std::string& r, std::map<size_t, std::string>& out) {
+    void derivatives(const doublereal* input, const doublereal* R,
+                     SparseTripletList& jac) const {
+        for (size_t n = 0; n < m_n; n++) {
+            doublereal oo = m_order[n];
+            if (oo == 0.0) {
+                continue;
+            }
+            doublereal x = R[m_rxn] * oo * ppow(input[m_ic[n]], oo - 1.0);
+            for (size_t m = 0; m < m_n; m++) {
+                if (m != n && m_order[m] != 0.0) {
+                    x *= ppow(input[m_ic[m]], m_order[m]);
+                }
+            }
+            jac.push_back(SparseTriplet(m_rxn, m_ic[n], x));
+        }
+    }
+
+    void stoichCoeffs(SparseTripletList& coeffs, doublereal scale) const {
+        for (size_t n = 0; n < m_n; n++) {
+            if (m_stoich[n] != 0.0) {
+                coeffs.push_back(SparseTriplet(m_ic[n], m_rxn,
+                                               scale * m_stoich[n]));
+            }
+        }
+    }
+
+    size_t rxnNumber() const {
+        return m_rxn;
+    }
+
+    //! Write the concentration product applied by multiply(). As in
+    //! multiply(), factors with zero order are omitted, and the others use
+    //! ppow(), which is defined in the code generated by
+    //! GasKinetics::writeSource().
+    void writeMultiply(const std::string& r, std::map<size_t, std::string>& out) const {
         out[m_rxn] = "";
         for (size_t n = 0; n < m_n; n++) {
-            if (m_order[n] == 1.0) {
-                out[m_rxn] += fmt(r, m_ic[n]);
-            } else {
-                out[m_rxn] += "pow("+fmt(r, m_ic[n])+","+fp2str(m_order[n])+")";
+            if (m_order[n] == 0.0) {
+                continue;
             }
-            if (n < m_n-1) {
+            if (!out[m_rxn].empty()) {
                 out[m_rxn] += " * ";
             }
+            out[m_rxn] += "ppow(" + fmt(r, m_ic[n]) + ", " +
+                          fp2str(m_order[n], "%.17g") + ")";
+        }
+        if (out[m_rxn].empty()) {
+            out[m_rxn] = "1.0";
         }
     }
 
     //! @deprecated To be removed after Cantera 2.2
-    void writeIncrementReaction(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeIncrementReaction(const std::string& r, std::map<size_t, std::string>& out) const {
         for (size_t n = 0; n < m_n; n++) {
-            out[m_rxn] += " + "+fp2str(m_stoich[n]) + "*" + fmt(r, m_ic[n]);
+            out[m_rxn] += " + "+fp2str(m_stoich[n], "%.17g") + "*" + fmt(r, m_ic[n]);
         }
     }
 
     //! @deprecated To be removed after Cantera 2.2
-    void writeDecrementReaction(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeDecrementReaction(const std::string& r, std::map<size_t, std::string>& out) const {
         for (size_t n = 0; n < m_n; n++) {
-            out[m_rxn] += " - "+fp2str(m_stoich[n]) + "*" + fmt(r, m_ic[n]);
+            out[m_rxn] += " - "+fp2str(m_stoich[n], "%.17g") + "*" + fmt(r, m_ic[n]);
         }
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeIncrementSpecies(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeIncrementSpecies(const std::string& r, std::map<size_t, std::string>& out) const {
         std::string s = fmt(r, m_rxn);
         for (size_t n = 0; n < m_n; n++) {
-            out[m_ic[n]] += " + "+fp2str(m_stoich[n]) + "*" + s;
+            out[m_ic[n]] += " + "+fp2str(m_stoich[n], "%.17g") + "*" + s;
         }
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeDecrementSpecies(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeDecrementSpecies(const std::string& r, std::map<size_t, std::string>& out) const {
         std::string s = fmt(r, m_rxn);
         for (size_t n = 0; n < m_n; n++) {
-            out[m_ic[n]] += " - "+fp2str(m_stoich[n]) + "*" + s;
+            out[m_ic[n]] += " - "+fp2str(m_stoich[n], "%.17g") + "*" + s;
         }
     }
 
@@ -580,6 +693,16 @@ inline static void _multiply(InputIter begin, InputIter end,
     }
 }
 
+template<class InputIter>
+inline static void _multiply(InputIter begin, InputIter end,
+                             const doublereal* input, doublereal* output,
+                             size_t nStates)
+{
+    for (; begin != end; ++begin) {
+        begin->multiply(input, output, nStates);
+    }
+}
+
 template<class InputIter, class Vec1, class Vec2>
 inline static void _incrementSpecies(InputIter begin,
                                      InputIter end, const Vec1& input, Vec2& output)
@@ -616,7 +739,37 @@ inline static void _decrementReactions(InputIter begin,
     }
 }
 
-//! @deprecated To be removed after Cantera 2.2
+template<class InputIter>
+inline static void _derivatives(InputIter begin, InputIter end,
+                                const doublereal* input, const doublereal* R,
+                                SparseTripletList& jac)
+{
+    for (; begin != end; ++begin) {
+        begin->derivatives(input, R, jac);
+    }
+}
+
+template<class InputIter>
+inline static void _stoichCoeffs(InputIter begin, InputIter end,
+                                 SparseTripletList& coeffs, doublereal scale)
+{
+    for (; begin != end; ++begin) {
+        begin->stoichCoeffs(coeffs, scale);
+    }
+}
+
+template<class Container>
+inline static void _subset(const Container& in, const std::vector<bool>& include,
+                           Container& out)
+{
+    out.clear();
+    for (size_t n = 0; n < in.size(); n++) {
+        if (include[in[n].rxnNumber()]) {
+            out.push_back(in[n]);
+        }
+    }
+}
+
 template<class InputIter>
 inline static void _writeIncrementSpecies(InputIter begin, InputIter end,
         const std::string& r, std::map<size_t, std::string>& out)
@@ -626,7 +779,6 @@ inline static void _writeIncrementSpecies(InputIter begin, InputIter end,
     }
 }
 
-//! @deprecated To be removed after Cantera 2.2
 template<class InputIter>
 inline static void _writeDecrementSpecies(InputIter begin, InputIter end,
         const std::string& r, std::map<size_t, std::string>& out)
@@ -656,7 +808,6 @@ inline static void _writeDecrementReaction(InputIter begin, InputIter end,
     }
 }
 
-//! @deprecated To be removed after Cantera 2.2
 template<class InputIter>
 inline static void _writeMultiply(InputIter begin, InputIter end,
                                   const std::string& r, std::map<size_t, std::string>& out)
@@ -812,6 +963,21 @@ public:
         _multiply(m_cn_list.begin(), m_cn_list.end(), input, output);
     }
 
+    //! Apply multiply() to `nStates` states at once.
+    /*!
+     *  The input values are stored species by species, so that the value
+     *  for species `k` in state `n` is `input[k*nStates + n]`, and the
+     *  output values are stored reaction by reaction in the same way. The
+     *  innermost loops run over the states.
+     */
+    void multiply(const doublereal* input, doublereal* output,
+                  size_t nStates) const {
+        _multiply(m_c1_list.begin(), m_c1_list.end(), input, output, nStates);
+        _multiply(m_c2_list.begin(), m_c2_list.end(), input, output, nStates);
+        _multiply(m_c3_list.begin(), m_c3_list.end(), input, output, nStates);
+        _multiply(m_cn_list.begin(), m_cn_list.end(), input, output, nStates);
+    }
+
     void incrementSpecies(const doublereal* input, doublereal* output) const {
         _incrementSpecies(m_c1_list.begin(), m_c1_list.end(), input, output);
         _incrementSpecies(m_c2_list.begin(), m_c2_list.end(), input, output);
@@ -840,16 +1006,59 @@ public:
         _decrementReactions(m_cn_list.begin(), m_cn_list.end(), input, output);
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeIncrementSpecies(const std::string& r, std::map<size_t, std::string>& out) {
+    //! Derivatives of the concentration products computed by multiply().
+    /*!
+     *  For each reaction i, appends to `jac` the entries (i, k,
+     *  R[i] * d(P_i)/d(input[k])), where P_i is the product of the input
+     *  values raised to the reaction orders, i.e. the factor applied by
+     *  multiply() to the rate for reaction i.
+     */
+    void derivatives(const doublereal* input, const doublereal* R,
+                     SparseTripletList& jac) const {
+        _derivatives(m_c1_list.begin(), m_c1_list.end(), input, R, jac);
+        _derivatives(m_c2_list.begin(), m_c2_list.end(), input, R, jac);
+        _derivatives(m_c3_list.begin(), m_c3_list.end(), input, R, jac);
+        _derivatives(m_cn_list.begin(), m_cn_list.end(), input, R, jac);
+    }
+
+    //! Append the stoichiometric coefficients of all reactions, multiplied
+    //! by `scale`, to `coeffs` as (species, reaction, coefficient) entries.
+    //! Species which participate in a reaction multiple times may have more
+    //! than one entry for that reaction. Species which only affect the
+    //! reaction order (with a stoichiometric coefficient of zero) are
+    //! omitted.
+    void stoichCoeffs(SparseTripletList& coeffs, doublereal scale) const {
+        _stoichCoeffs(m_c1_list.begin(), m_c1_list.end(), coeffs, scale);
+        _stoichCoeffs(m_c2_list.begin(), m_c2_list.end(), coeffs, scale);
+        _stoichCoeffs(m_c3_list.begin(), m_c3_list.end(), coeffs, scale);
+        _stoichCoeffs(m_cn_list.begin(), m_cn_list.end(), coeffs, scale);
+    }
+
+    //! Make `sub` a manager for the subset of the reactions of this manager
+    //! for which `include[rxn]` is true. The reaction numbers are unchanged,
+    //! so `sub` reads and writes the same entries of the input and output
+    //! arrays as this manager, and leaves the entries of the other reactions
+    //! untouched.
+    void getSubset(const std::vector<bool>& include, StoichManagerN& sub) const {
+        _subset(m_c1_list, include, sub.m_c1_list);
+        _subset(m_c2_list, include, sub.m_c2_list);
+        _subset(m_c3_list, include, sub.m_c3_list);
+        _subset(m_cn_list, include, sub.m_cn_list);
+    }
+
+    //! Append C++ expressions for the terms added by incrementSpecies() to
+    //! the entries of `out`, which is indexed by species. `r` is the name of
+    //! the array of rates of progress in the generated code.
+    void writeIncrementSpecies(const std::string& r, std::map<size_t, std::string>& out) const {
         _writeIncrementSpecies(m_c1_list.begin(), m_c1_list.end(), r, out);
         _writeIncrementSpecies(m_c2_list.begin(), m_c2_list.end(), r, out);
         _writeIncrementSpecies(m_c3_list.begin(), m_c3_list.end(), r, out);
         _writeIncrementSpecies(m_cn_list.begin(), m_cn_list.end(), r, out);
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeDecrementSpecies(const std::string& r, std::map<size_t, std::string>& out) {
+    //! Append C++ expressions for the terms subtracted by decrementSpecies()
+    //! to the entries of `out`, which is indexed by species.
+    void writeDecrementSpecies(const std::string& r, std::map<size_t, std::string>& out) const {
         _writeDecrementSpecies(m_c1_list.begin(), m_c1_list.end(), r, out);
         _writeDecrementSpecies(m_c2_list.begin(), m_c2_list.end(), r, out);
         _writeDecrementSpecies(m_c3_list.begin(), m_c3_list.end(), r, out);
@@ -857,7 +1066,7 @@ public:
     }
 
     //! @deprecated To be removed after Cantera 2.2
-    void writeIncrementReaction(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeIncrementReaction(const std::string& r, std::map<size_t, std::string>& out) const {
         _writeIncrementReaction(m_c1_list.begin(), m_c1_list.end(), r, out);
         _writeIncrementReaction(m_c2_list.begin(), m_c2_list.end(), r, out);
         _writeIncrementReaction(m_c3_list.begin(), m_c3_list.end(), r, out);
@@ -865,15 +1074,17 @@ public:
     }
 
     //! @deprecated To be removed after Cantera 2.2
-    void writeDecrementReaction(const std::string& r, std::map<size_t, std::string>& out) {
+    void writeDecrementReaction(const std::string& r, std::map<size_t, std::string>& out) const {
         _writeDecrementReaction(m_c1_list.begin(), m_c1_list.end(), r, out);
         _writeDecrementReaction(m_c2_list.begin(), m_c2_list.end(), r, out);
         _writeDecrementReaction(m_c3_list.begin(), m_c3_list.end(), r, out);
         _writeDecrementReaction(m_cn_list.begin(), m_cn_list.end(), r, out);
     }
 
-    //! @deprecated To be removed after Cantera 2.2
-    void writeMultiply(const std::string& r, std::map<size_t, std::string>& out) {
+    //! Set the entries of `out`, which is indexed by reaction, to C++
+    //! expressions for the concentration products applied by multiply(). `r`
+    //! is the name of the concentration array in the generated code.
+    void writeMultiply(const std::string& r, std::map<size_t, std::string>& out) const {
         _writeMultiply(m_c1_list.begin(), m_c1_list.end(), r, out);
         _writeMultiply(m_c2_list.begin(), m_c2_list.end(), r, out);
         _writeMultiply(m_c3_list.begin(), m_c3_list.end(), r, out);
@@ -6,38 +6,52 @@
 #define CT_THIRDBODYCALC_H
 
 #include "cantera/base/utilities.h"
+#include "cantera/numerics/SparseMatrix.h"
 
 namespace Cantera
 {
 
 //! Calculate and apply third-body effects on reaction rates, including non-
 //! unity third-body efficiencies.
+/*!
+ *  The effective third-body concentration of reaction \f$ i \f$ is
+ *  \f[
+ *      [M]_i = d_i C_{tot} + \sum_k (\epsilon_{ik} - d_i) C_k
+ *  \f]
+ *  where \f$ d_i \f$ is the default efficiency and \f$ \epsilon_{ik} \f$
+ *  are the efficiencies of the species with non-default efficiencies. The
+ *  differences \f$ \epsilon_{ik} - d_i \f$ are stored as a sparse matrix
+ *  with one row for each installed reaction and one column for each species,
+ *  so that the third-body concentrations for all reactions are computed by
+ *  a single sparse matrix-vector product.
+ */
 class ThirdBodyCalc
 {
 public:
+    ThirdBodyCalc() : m_nsp(0) {}
+
     void install(size_t rxnNumber, const std::map<size_t, double>& enhanced,
                  double dflt=1.0) {
+        size_t row = m_reaction_index.size();
         m_reaction_index.push_back(rxnNumber);
         m_default.push_back(dflt);
 
-        m_species.push_back(std::vector<size_t>());
-        m_eff.push_back(vector_fp());
         for (std::map<size_t, double>::const_iterator iter = enhanced.begin();
              iter != enhanced.end();
              ++iter)
         {
-            m_species.back().push_back(iter->first);
-            m_eff.back().push_back(iter->second - dflt);
+            m_triplets.push_back(SparseTriplet(row, iter->first,
+                                               iter->second - dflt));
+            m_nsp = std::max(m_nsp, iter->first + 1);
         }
     }
 
     void update(const vector_fp& conc, double ctot, double* work) {
-        for (size_t i = 0; i < m_species.size(); i++) {
-            double sum = 0.0;
-            for (size_t j = 0; j < m_species[i].size(); j++) {
-                sum += m_eff[i][j] * conc[m_species[i][j]];
-            }
-            work[i] = m_default[i] * ctot + sum;
+        for (size_t i = 0; i < m_default.size(); i++) {
+            work[i] = m_default[i] * ctot;
+        }
+        if (!m_triplets.empty()) {
+            efficiencies().incrementMult(&conc[0], work);
         }
     }
 
@@ -46,19 +60,90 @@ public:
                      output, m_reaction_index.begin());
     }
 
+    //! Add the derivatives of the reaction rates with respect to the species
+    //! concentrations which arise from the third-body concentrations.
+    /*!
+     *  @param dRdM  Derivative of the rate of each reaction with respect to
+     *      its effective third-body concentration, indexed by the reaction
+     *      index given to install().
+     *  @param nsp   Total number of species
+     *  @param jac   Entries (reaction, species, value) are appended here, where
+     *      the reaction index is the one given to install().
+     */
+    void derivatives(const double* dRdM, size_t nsp, SparseTripletList& jac) {
+        const SparseMatrix& eff = efficiencies();
+        for (size_t i = 0; i < m_reaction_index.size(); i++) {
+            size_t irxn = m_reaction_index[i];
+            if (m_default[i] != 0.0) {
+                for (size_t k = 0; k < nsp; k++) {
+                    jac.push_back(SparseTriplet(irxn, k,
+                                                m_default[i] * dRdM[irxn]));
+                }
+            }
+            if (eff.nRows() == 0) {
+                continue;
+            }
+            for (size_t n = eff.rowStart()[i]; n < eff.rowStart()[i+1]; n++) {
+                jac.push_back(SparseTriplet(irxn, eff.colIndex()[n],
+                                            eff.values()[n] * dRdM[irxn]));
+            }
+        }
+    }
+
     size_t workSize() {
         return m_reaction_index.size();
     }
 
+    //! Reaction number of the i-th installed reaction
+    size_t reactionIndex(size_t i) const {
+        return m_reaction_index[i];
+    }
+
+    //! Sparse matrix of the differences between the species efficiencies and
+    //! the default efficiency, with one row for each installed reaction.
+    //! Only species with non-default efficiencies have entries.
+    const SparseMatrix& efficiencies() {
+        if (m_efficiencies.nRows() != m_reaction_index.size()) {
+            m_efficiencies.setFromTriplets(m_reaction_index.size(), m_nsp,
+                                           m_triplets);
+        }
+        return m_efficiencies;
+    }
+
+    //! Append the entries of efficiencies() to `eff`, with `offset` added to
+    //! the row indices.
+    void getEfficiencies(SparseTripletList& eff, size_t offset) const {
+        for (size_t n = 0; n < m_triplets.size(); n++) {
+            eff.push_back(SparseTriplet(m_triplets[n].row + offset,
+                                        m_triplets[n].col,
+                                        m_triplets[n].value));
+        }
+    }
+
+    //! The default efficiency for each installed reaction
+    const vector_fp& defaultEfficiencies() const {
+        return m_default;
+    }
+
+    //! Indices of the installed reactions, as given to install()
+    const std::vector<size_t>& reactionIndex() const {
+        return m_reaction_index;
+    }
+
 protected:
     //! Indices of third-body reactions within the full reaction array
     std::vector<size_t> m_reaction_index;
 
-    //! m_species[i][j] is the index of the j-th species in reaction i.
-    std::vector<std::vector<size_t> > m_species;
+    //! Entries of #m_efficiencies: (installed reaction, species, efficiency
+    //! minus the default efficiency)
+    SparseTripletList m_triplets;
+
+    //! Efficiency matrix, constructed from #m_triplets when needed
+    SparseMatrix m_efficiencies;
 
-    //! m_eff[i][j] is the efficiency of the j-th species in reaction i.
-    std::vector<vector_fp> m_eff;
+    //! Number of columns of the efficiency matrix (one more than the largest
+    //! species index with a non-default efficiency)
+    size_t m_nsp;
 
     //! The default efficiency for each reaction
     vector_fp m_default;
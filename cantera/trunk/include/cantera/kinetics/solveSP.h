@@ -299,11 +299,19 @@ private:
 
     //! Main routine that calculates the current residual and Jacobian
     /*!
+     *  The derivatives of the surface production rates with respect to the
+     *  surface concentrations are evaluated analytically by the
+     *  InterfaceKinetics objects (see
+     *  InterfaceKinetics::getNetRatesOfProgress_ddC). If bulk deposition is
+     *  included in the problem, the Jacobian is instead evaluated by finite
+     *  differences.
+     *
      *  @param jac     Jacobian to be evaluated.
      *  @param resid   output Vector of residuals, length = m_neq
      *  @param CSolnSP  Vector of species concentrations, unknowns in the
-     *                  problem, length = m_neq. These are tweaked in order
-     *                  to derive the columns of the jacobian.
+     *                  problem, length = m_neq. For the finite difference
+     *                  Jacobian, these are tweaked in order to derive the
+     *                  columns of the jacobian.
      *  @param CSolnSPOld Old Vector of species concentrations, unknowns in the
      *                  problem, length = m_neq
      *  @param do_time Calculate a time dependent residual
@@ -447,6 +455,15 @@ private:
      */
     std::vector<size_t> m_kinObjIndex;
 
+    //! Index of the equation for each kinetic species of each
+    //! InterfaceKinetics object
+    /*!
+     *  ieq = m_eqnIndexKinSpecies[isp][ksp], or npos if the kinetic species
+     *  is not one of the unknowns. Used to assemble the Jacobian from the
+     *  derivatives of the production rates computed by the kinetics objects.
+     */
+    std::vector<std::vector<size_t> > m_eqnIndexKinSpecies;
+
     //! Vector containing the indices of the largest species
     //! in each surface phase
     /*!
@@ -17,6 +17,7 @@ namespace Cantera
 {
 
 class FuncData;
+class AdjointSolver;
 
 /**
  * Exception thrown when a CVODES error is encountered.
@@ -73,6 +74,8 @@ public:
         return m_np;
     }
     virtual double sensitivity(size_t k, size_t p);
+    virtual void setAdjoint(bool adjoint, int nsteps=100);
+    virtual void integrateAdjoint(double* lambda, double* dgdp);
 
     //! Returns a string listing the weighted error estimates associated
     //! with each solution component.
@@ -91,6 +94,10 @@ protected:
 private:
     void sensInit(double t0, FuncEval& func);
 
+    //! Start storing checkpoints for adjoint sensitivity analysis, if it is
+    //! enabled
+    void adjointInit(FuncEval& func);
+
     size_t m_neq;
     void* m_cvode_mem;
     double m_t0;
@@ -117,6 +124,20 @@ private:
     //! for at the current integrator time.
     bool m_sens_ok;
 
+    //! True if adjoint sensitivity analysis is enabled
+    bool m_adjoint;
+
+    //! Number of steps between checkpoints for adjoint sensitivity analysis
+    int m_adjointSteps;
+
+    //! The time reached by the internal steps, if adjoint sensitivity
+    //! analysis is enabled
+    double m_tInternal;
+
+    //! Checkpoints of the solution and adjoint integration, if adjoint
+    //! sensitivity analysis is enabled
+    AdjointSolver* m_adj;
+
 };
 
 }    // namespace
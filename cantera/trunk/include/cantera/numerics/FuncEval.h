@@ -48,6 +48,64 @@ public:
     virtual size_t nparams() {
         return 0;
     }
+
+    /**
+     * Evaluate the Jacobian of the right-hand-side function,
+     * \f$ J_{ij} = \partial F_i / \partial y_j \f$. Called by integrators
+     * using the problem type `DENSE + JAC`. The default implementation uses
+     * finite differences, with neq() evaluations of the right-hand side.
+     * The increment in \f$ y_j \f$ is \f$ 1 / w_j \f$, where \f$ w_j \f$
+     * is the integrator's error weight, or \f$ \sqrt{\epsilon}
+     * \max(|y_j|, 1) \f$ if no error weights are given.
+     * @param[in] t time.
+     * @param[in] y solution vector, length neq(). Restored on return.
+     * @param[in] ydot right-hand side evaluated at `y`, length neq()
+     * @param[in] ewt error weights of the integrator, length neq(), or NULL
+     * @param[in] p sensitivity parameter vector, length nparams()
+     * @param[out] jacCols pointers to the columns of the Jacobian, so that
+     *     `jacCols[j][i]` is \f$ J_{ij} \f$
+     */
+    virtual void evalJacobian(double t, double* y, const double* ydot,
+                              const double* ewt, double* p,
+                              double* const* jacCols);
+
+    /**
+     * Evaluate the right-hand side of the adjoint equations,
+     * \f[
+     *     \dot{\vec{\lambda}} = -\left(\frac{\partial \vec{F}}
+     *         {\partial \vec{y}}\right)^T \vec{\lambda}
+     * \f]
+     * Called by integrators which implement adjoint sensitivity analysis.
+     * The default implementation evaluates the Jacobian by finite
+     * differences, using neq() evaluations of the right-hand side.
+     * @param[in] t time.
+     * @param[in] y solution vector, length neq(). Restored on return.
+     * @param[in] lambda adjoint variables, length neq()
+     * @param[out] lambdadot rate of change of the adjoint variables,
+     *     length neq()
+     * @param[in] p sensitivity parameter vector, length nparams()
+     */
+    virtual void evalAdjoint(double t, double* y, const double* lambda,
+                             double* lambdadot, double* p);
+
+    /**
+     * Evaluate the integrand of the adjoint sensitivity quadratures,
+     * \f[
+     *     \dot{q}_j = \vec{\lambda}^T \frac{\partial \vec{F}}{\partial p_j}
+     * \f]
+     * for each sensitivity parameter \f$ p_j \f$. The default
+     * implementation uses finite differences, with one evaluation of the
+     * right-hand side for each parameter.
+     * @param[in] t time.
+     * @param[in] y solution vector, length neq()
+     * @param[in] lambda adjoint variables, length neq()
+     * @param[out] qdot integrands, length nparams()
+     * @param[in] p sensitivity parameter vector, length nparams(). Restored
+     *     on return.
+     */
+    virtual void evalAdjointQuadrature(double t, double* y,
+                                       const double* lambda, double* qdot,
+                                       double* p);
 };
 
 }
@@ -13,6 +13,7 @@
 #include "FuncEval.h"
 
 #include "cantera/base/global.h"
+#include "cantera/base/ctexceptions.h"
 
 namespace Cantera
 {
@@ -204,6 +205,46 @@ public:
         return 0.0;
     }
 
+    //! Enable or disable adjoint sensitivity analysis. Must be called before
+    //! initialize().
+    /*!
+     *  When adjoint sensitivity analysis is enabled, the forward sensitivity
+     *  equations are not integrated, and the forward solution is instead
+     *  stored at checkpoints so that integrateAdjoint() can be called. The
+     *  solution is recomputed between the checkpoints during the adjoint
+     *  integration, so fewer steps between checkpoints use more memory and
+     *  less time.
+     *  @param adjoint  `true` to enable adjoint sensitivity analysis
+     *  @param nsteps   Number of integrator steps between checkpoints
+     */
+    virtual void setAdjoint(bool adjoint, int nsteps=100) {
+        if (adjoint) {
+            warn("setAdjoint");
+        }
+    }
+
+    //! Integrate the adjoint equations backwards from the current time to
+    //! the initial time.
+    /*!
+     *  For a scalar function \f$ g(\vec{y}(t)) \f$ of the solution at the
+     *  current time \f$ t \f$, compute the derivatives of *g* with respect
+     *  to each of the sensitivity parameters and with respect to the initial
+     *  conditions.
+     *
+     *  @param[in,out] lambda  On input, the derivatives of *g* with respect
+     *      to the components of the solution vector at the current time. On
+     *      return, the derivatives of *g* with respect to the initial
+     *      conditions. Length nEquations().
+     *  @param[out] dgdp  Derivatives of *g* with respect to the sensitivity
+     *      parameters. Length FuncEval::nparams() of the integrated system.
+     *
+     *  The forward integration is not affected, and can be continued
+     *  afterwards.
+     */
+    virtual void integrateAdjoint(double* lambda, double* dgdp) {
+        throw NotImplementedError("Integrator::integrateAdjoint");
+    }
+
 private:
 
     doublereal m_dummy;
@@ -0,0 +1,155 @@
+/**
+ *  @file SparseMatrix.h
+ *   Declarations for the class SparseMatrix, a compressed sparse row matrix
+ *   (see class \ref numerics and \link Cantera::SparseMatrix SparseMatrix\endlink).
+ */
+
+#ifndef CT_SPARSEMATRIX_H
+#define CT_SPARSEMATRIX_H
+
+#include "cantera/base/ct_defs.h"
+
+namespace Cantera
+{
+
+class DenseMatrix;
+
+//! A single (row, column, value) entry used to assemble a SparseMatrix.
+struct SparseTriplet {
+    SparseTriplet(size_t i = 0, size_t j = 0, doublereal v = 0.0) :
+        row(i), col(j), value(v) {}
+    size_t row;
+    size_t col;
+    doublereal value;
+};
+
+//! List of entries used to assemble a SparseMatrix
+typedef std::vector<SparseTriplet> SparseTripletList;
+
+//! A matrix stored in compressed sparse row (CSR) format.
+/*!
+ *  Only the nonzero entries are stored. The entries of row \c i are stored in
+ *  positions `rowStart()[i]` through `rowStart()[i+1]-1` of the arrays
+ *  colIndex() and values(), sorted by increasing column index.
+ *
+ *  The usual way to build a matrix is to accumulate a list of triplets and
+ *  call setFromTriplets(). Duplicate entries in the list are summed, so
+ *  contributions to the same element from different sources (e.g. different
+ *  reactions) can be added to the list independently.
+ */
+class SparseMatrix
+{
+public:
+    //! Create an \c 0 by \c 0 matrix
+    SparseMatrix();
+
+    //! Create an empty \c nrows by \c ncols matrix with no nonzero entries
+    SparseMatrix(size_t nrows, size_t ncols);
+
+    //! Resize the matrix, discarding all nonzero entries
+    void resize(size_t nrows, size_t ncols);
+
+    //! Replace the contents of the matrix with the entries in `triplets`.
+    /*!
+     *  Entries with the same row and column are summed.
+     *  @param nrows  Number of rows
+     *  @param ncols  Number of columns
+     *  @param triplets  List of entries. Row and column indices must be less
+     *      than `nrows` and `ncols`, respectively.
+     */
+    void setFromTriplets(size_t nrows, size_t ncols,
+                         const SparseTripletList& triplets);
+
+    //! Set all stored values to zero, keeping the sparsity pattern
+    void zero();
+
+    //! Number of rows
+    size_t nRows() const {
+        return m_nrows;
+    }
+
+    //! Number of columns
+    size_t nColumns() const {
+        return m_ncols;
+    }
+
+    //! Number of stored (structurally nonzero) entries
+    size_t nNonZeros() const {
+        return m_value.size();
+    }
+
+    //! Return the value of element (i,j), which is zero if the element is not
+    //! part of the sparsity pattern.
+    doublereal operator()(size_t i, size_t j) const;
+
+    //! Multiply A*b and write result to prod.
+    /*!
+     *  @param b    Vector to multiply. Length: nColumns()
+     *  @param prod Output vector. Length: nRows()
+     */
+    void mult(const doublereal* b, doublereal* prod) const;
+
+    //! Multiply A*b and add the result to prod.
+    void incrementMult(const doublereal* b, doublereal* prod) const;
+
+    //! Multiply A*B and write the result to prod, where B has `nvec` columns.
+    /*!
+     *  Both B and the product are stored row by row, so that entry (j, n) of
+     *  B is `b[j*nvec + n]`. The inner loop runs over the columns of B,
+     *  which allows several vectors to be multiplied in a single
+     *  vectorizable pass over the nonzero entries of A.
+     *
+     *  @param b    Matrix to multiply. Length: nColumns() * nvec
+     *  @param prod Output matrix. Length: nRows() * nvec
+     *  @param nvec Number of columns of B
+     */
+    void mult(const doublereal* b, doublereal* prod, size_t nvec) const;
+
+    //! Multiply A*B, where B has `nvec` columns, and add the result to prod.
+    //! The storage of B and prod is as for mult(const doublereal*,
+    //! doublereal*, size_t).
+    void incrementMult(const doublereal* b, doublereal* prod,
+                       size_t nvec) const;
+
+    //! Multiply transpose(A)*b and write the result to prod.
+    /*!
+     *  @param b    Vector to multiply. Length: nRows()
+     *  @param prod Output vector. Length: nColumns()
+     */
+    void multTranspose(const doublereal* b, doublereal* prod) const;
+
+    //! Copy the matrix into a dense matrix, which is resized if necessary
+    void copyToDense(DenseMatrix& dense) const;
+
+    //! Offsets of the first entry in each row. Length: nRows() + 1
+    const std::vector<size_t>& rowStart() const {
+        return m_rowStart;
+    }
+
+    //! Column index of each stored entry. Length: nNonZeros()
+    const std::vector<size_t>& colIndex() const {
+        return m_colIndex;
+    }
+
+    //! Stored values. Length: nNonZeros()
+    const vector_fp& values() const {
+        return m_value;
+    }
+
+    //! Modifiable stored values, for updating a matrix with a fixed sparsity
+    //! pattern in place.
+    vector_fp& values() {
+        return m_value;
+    }
+
+protected:
+    size_t m_nrows; //!< Number of rows
+    size_t m_ncols; //!< Number of columns
+    std::vector<size_t> m_rowStart; //!< Row offsets. Length m_nrows + 1
+    std::vector<size_t> m_colIndex; //!< Column index of each entry
+    vector_fp m_value; //!< Value of each entry
+};
+
+}
+
+#endif
@@ -536,6 +536,12 @@ protected:
 
 private:
     vector_fp m_ybar;
+
+    //! Temperatures, pressures and mole fractions at the midpoints, passed
+    //! to Transport::getTransportProperties()
+    vector_fp m_Tmid;
+    vector_fp m_Pmid;
+    vector_fp m_Xmid;
 };
 
 /**
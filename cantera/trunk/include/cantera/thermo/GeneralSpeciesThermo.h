@@ -4,13 +4,15 @@
  *  manager for a phase (see \ref mgrsrefcalc and
  * \link Cantera::GeneralSpeciesThermo GeneralSpeciesThermo\endlink).
  *
- *  Because it is general, it is slow.
+ *  Species with NASA2 parameterizations are evaluated together in a single
+ *  loop; other parameterizations are evaluated species by species.
  */
 #ifndef CT_GENERALSPECIESTHERMO_H
 #define CT_GENERALSPECIESTHERMO_H
 
 #include "SpeciesThermoMgr.h"
 #include "SpeciesThermoInterpType.h"
+#include "cantera/base/smart_ptr.h"
 
 namespace Cantera
 {
@@ -23,6 +25,11 @@ namespace Cantera
  * temperature needed for each species. What it does is to create
  * a vector of SpeciesThermoInterpType objects.
  *
+ * The two-region NASA polynomials (NASA2) used for most gas-phase species
+ * are also stored with one array per coefficient, so that they are
+ * evaluated for all species in a single loop rather than through a virtual
+ * function call per species.
+ *
  * @ingroup mgrsrefcalc
  */
 class GeneralSpeciesThermo : public SpeciesThermo
@@ -33,12 +40,21 @@ public:
 
     //! Copy constructor
     /*!
+     * The SpeciesThermoInterpType objects hold only parameters, so they are
+     * shared with the copy rather than duplicated. A private copy of a
+     * species' parameterization is made if it is later modified (e.g. by
+     * modifyOneHf298()). Parameterizations that refer back to the owning
+     * phase (STITbyPDSS) are always duplicated.
+     *
      * @param b   Object to be copied
      */
     GeneralSpeciesThermo(const GeneralSpeciesThermo& b);
 
     //! Assignment operator
     /*!
+     * Shares the SpeciesThermoInterpType objects in the same way as the
+     * copy constructor.
+     *
      * @param b   Object to be copied
      */
     GeneralSpeciesThermo& operator=(const GeneralSpeciesThermo& b);
@@ -109,6 +125,17 @@ public:
     virtual void update(doublereal T, doublereal* cp_R,
                         doublereal* h_RT, doublereal* s_R) const;
 
+    //! Compute the reference-state properties for all species at each of a
+    //! set of temperatures.
+    /*!
+     * Species with NASA2 parameterizations are evaluated by the batched
+     * form of updateNasa2(), and the other species one temperature at a
+     * time. See SpeciesThermo::update(size_t, const doublereal*,
+     * doublereal*, doublereal*, doublereal*).
+     */
+    virtual void update(size_t nT, const doublereal* T, doublereal* cp_R,
+                        doublereal* h_RT, doublereal* s_R) const;
+
     virtual doublereal minTemp(size_t k=npos) const;
     virtual doublereal maxTemp(size_t k=npos) const;
     virtual doublereal refPressure(size_t k=npos) const;
@@ -124,9 +151,19 @@ public:
 
     virtual void modifyOneHf298(const size_t k, const doublereal Hf298New);
 
+    //! The standard state parameterization of species *k*, or 0 if none has
+    //! been installed
+    const SpeciesThermoInterpType* speciesParameterization(size_t k) const {
+        return provideSTIT(k);
+    }
+
 private:
     //! Provide the SpeciesthermoInterpType object
     /*!
+     * The non-const version first makes a private copy of the object if
+     * it is shared with a copy of this manager, since the returned pointer
+     * may be used to modify it.
+     *
      * @param k  species index
      *
      * @return pointer to the SpeciesThermoInterpType object.
@@ -134,22 +171,89 @@ private:
     SpeciesThermoInterpType* provideSTIT(size_t k);
     const SpeciesThermoInterpType* provideSTIT(size_t k) const;
 
-    void clear(); //<! Delete owned SpeciesThermoInterpType objects.
+    //! Duplicate the SpeciesThermoInterpType objects which can't be shared
+    //! with the object this one was copied from.
+    void duplicateUnshareable();
+
+    //! Copy the coefficients of the NASA2 parameterization at position `i`
+    //! in `m_sp[NASA2]` into the arrays used by updateNasa2().
+    void setNasa2Coeffs(size_t i);
+
+    //! Evaluate the properties of all species with NASA2 parameterizations
+    /*!
+     * The coefficients are stored in one array per coefficient, and the
+     * temperature region is selected without branching, so the loop over
+     * species can be vectorized by the compiler.
+     *
+     * @param tt      Temperature polynomial (see NasaPoly1::updateProperties)
+     * @param cp_R    Vector of Dimensionless heat capacities. (length m_kk).
+     * @param h_RT    Vector of Dimensionless enthalpies. (length m_kk).
+     * @param s_R     Vector of Dimensionless entropies. (length m_kk).
+     */
+    void updateNasa2(const doublereal* tt, doublereal* cp_R,
+                     doublereal* h_RT, doublereal* s_R) const;
+
+    //! Evaluate the properties of all species with NASA2 parameterizations
+    //! at each of a set of temperatures
+    /*!
+     * The coefficients of each species are loaded once for all of the
+     * temperatures, and the inner loop over the temperatures can be
+     * vectorized by the compiler. The arithmetic is the same as in the
+     * single temperature version.
+     *
+     * @param nT      Number of temperatures
+     * @param T       Temperatures (Kelvin). (length nT).
+     * @param cp_R    Dimensionless heat capacities, with the value for
+     *                species `k` at `T[n]` in element `k*nT + n`.
+     * @param h_RT    Dimensionless enthalpies, in the same order as `cp_R`
+     * @param s_R     Dimensionless entropies, in the same order as `cp_R`
+     */
+    void updateNasa2(size_t nT, const doublereal* T, doublereal* cp_R,
+                     doublereal* h_RT, doublereal* s_R) const;
 
 protected:
-    typedef std::map<int, std::vector<SpeciesThermoInterpType*> > STIT_map;
+    typedef std::map<int, std::vector<shared_ptr<SpeciesThermoInterpType> > > STIT_map;
     typedef std::map<int, std::vector<double> > tpoly_map;
     /**
      * This is the main unknown in the object. It contains pointers to
      * SpeciesThermoInterpType objects, sorted by the parameterization type.
-     * This object owns the SpeciesThermoInterpType objects, so they are deleted
-     * in the destructor of this object.
+     * The SpeciesThermoInterpType objects may be shared with copies of this
+     * object.
      */
     STIT_map m_sp;
 
     //! Temperature polynomials for each thermo parameterization
     mutable tpoly_map m_tpoly;
 
+    //! Midpoint temperatures of the species with NASA2 parameterizations, in
+    //! the order of `m_sp[NASA2]`
+    vector_fp m_nasa2_tmid;
+
+    //! Coefficients of the species with NASA2 parameterizations.
+    //! `m_nasa2_coeffs[j][i]` is coefficient `j` of species `i` in
+    //! `m_sp[NASA2]`, where `j` = 0-6 are the coefficients a0-a6 for the
+    //! low temperature region and `j` = 7-13 are those for the high
+    //! temperature region.
+    std::vector<vector_fp> m_nasa2_coeffs;
+
+    //! Species indices of the species with NASA2 parameterizations
+    std::vector<size_t> m_nasa2_index;
+
+    //! True if #m_nasa2_index is a contiguous range of species indices
+    bool m_nasa2_contiguous;
+
+    //! Work arrays for NASA2 species which are not contiguous
+    mutable vector_fp m_nasa2_work;
+
+    //! Work arrays for the properties at a single temperature, used by
+    //! update(size_t, const doublereal*, doublereal*, doublereal*,
+    //! doublereal*)
+    mutable vector_fp m_batch_work;
+
+    //! Temperature polynomials used by updateNasa2(size_t, const
+    //! doublereal*, doublereal*, doublereal*, doublereal*)
+    mutable vector_fp m_batch_tpoly;
+
     std::map<size_t, std::pair<int, size_t> > m_speciesLoc;
 
     //! Maximum value of the lowest temperature
@@ -993,12 +993,11 @@ class WaterProps;
  * \f]
  *
  *  The majority of work for these functions take place in the internal
- *  routines that calculate the first and second derivatives of the log
- *  of the activity coefficients wrt temperature,
- *  s_update_dlnMolalityActCoeff_dT(), s_update_d2lnMolalityActCoeff_dT2(),
- *  and the first
- *  derivative of the log activity coefficients wrt pressure,
- *  s_update_dlnMolalityActCoeff_dP().
+ *  routine s_update_lnMolalityActCoeff(), which calculates the first and
+ *  second derivatives of the log of the activity coefficients wrt
+ *  temperature and the first derivative of the log activity coefficients
+ *  wrt pressure in one pass, together with the activity coefficients
+ *  themselves if they are not yet current.
  *
  * <HR>
  * <H2> %Application within Kinetics Managers </H2>
@@ -2551,6 +2550,63 @@ private:
      */
     Array2D m_Psi_ijk_coeff;
 
+    //! Sparse list of the nonzero ternary interactions in #m_Psi_ijk
+    /*!
+     * Most (i,j,k) triplets have no psi or zeta parameter, so the
+     * ternary sums are carried out only over the triplets that do.
+     * For the species pair (i,j), the species k with a nonzero
+     * interaction are m_PsiIndex_k[m] for
+     *
+     *   m_PsiStart_ij[m_kk*i + j] <= m < m_PsiStart_ij[m_kk*i + j + 1]
+     *
+     * in increasing order of k. A triplet is listed if any of its
+     * temperature coefficients is nonzero, so the temperature and
+     * pressure derivatives of m_Psi_ijk vanish outside the list as well.
+     */
+    std::vector<size_t> m_PsiStart_ij;
+
+    //! Third species index of each entry in the sparse psi list
+    /*!
+     * see m_PsiStart_ij for reference on the indexing into this variable.
+     */
+    std::vector<size_t> m_PsiIndex_k;
+
+    //! Species pairs ij (n = m_kk*i + j) which have entries in the sparse
+    //! psi list, in increasing order
+    std::vector<size_t> m_PsiRows_ij;
+
+    //! Cation-anion pairs with a nonzero binary interaction
+    /*!
+     * Each entry is n = m_kk*i + j with i < j, and m_CounterIJ[n] is the
+     * index of the pair in the binary interaction arrays. A pair is listed
+     * if any of its beta0, beta1, beta2 or Cphi parameters is nonzero, so
+     * BMX, BprimeMX, BphiMX and CMX and their temperature and pressure
+     * derivatives vanish for all other pairs, which are skipped.
+     */
+    std::vector<size_t> m_CationAnionPairs;
+
+    //! Pairs of ions of the same sign with a nonzero binary interaction
+    /*!
+     * Indexed as m_CationAnionPairs. A pair is listed if its theta
+     * parameter is nonzero, or if the magnitudes of the charges differ, in
+     * which case the E-theta term contributes to Phi.
+     */
+    std::vector<size_t> m_LikeChargePairs;
+
+    //! Sparse list of the nonzero lambda interactions in #m_Lambda_nj
+    /*!
+     * For the neutral species n, the species j with a nonzero interaction
+     * are m_LambdaIndex_j[m] for
+     *
+     *   m_LambdaStart_n[n] <= m < m_LambdaStart_n[n+1]
+     *
+     * The rows of the other species are empty.
+     */
+    std::vector<size_t> m_LambdaStart_n;
+
+    //! Second species index of each entry in the sparse lambda list
+    std::vector<size_t> m_LambdaIndex_j;
+
     //! Lambda coefficient for the ij interaction
     /*!
      * Array of 2D data used in the Pitzer/HMW formulation.
@@ -3005,34 +3061,17 @@ private:
     virtual void applyphScale(doublereal* acMolality) const;
 
 private:
-    /*
-     * This function will be called to update the internally stored
-     * natural logarithm of the molality activity coefficients
-     */
-    void s_update_lnMolalityActCoeff() const;
-
-    //! This function calculates the temperature derivative of the
-    //! natural logarithm of the molality activity coefficients.
+    //! Update the internally stored natural logarithms of the molality
+    //! activity coefficients
     /*!
-     * This function does all of the direct work. The solvent activity
-     * coefficient is on the molality scale. It's derivative is too.
-     */
-    void s_update_dlnMolalityActCoeff_dT() const;
-
-    /**
-     * This function calculates the temperature second derivative
-     * of the natural logarithm of the molality activity
-     * coefficients.
-     */
-    void s_update_d2lnMolalityActCoeff_dT2() const;
-
-    /**
-     * This function calculates the pressure derivative of the
-     * natural logarithm of the molality activity coefficients.
+     * If `derivs` is true, their first and second temperature derivatives
+     * and their pressure derivative are updated too. All of the quantities
+     * which are out of date for the current state are computed in a
+     * single pass over the Pitzer sums, and are cached by state.
      *
-     * Assumes that the activity coefficients are current.
+     * @param derivs  Also update the temperature and pressure derivatives
      */
-    void s_update_dlnMolalityActCoeff_dP() const;
+    void s_update_lnMolalityActCoeff(bool derivs = false) const;
 
     //! This function will be called to update the internally stored
     //! natural logarithm of the molality activity coefficients
@@ -3047,38 +3086,46 @@ private:
     void s_updateIMS_lnMolalityActCoeff() const;
 
 private:
-    //! Calculate the Pitzer portion of the activity coefficients.
+    //! Calculate the Pitzer portion of the activity coefficients and of
+    //! their temperature and pressure derivatives.
     /**
      *  This is the main routine in the whole module. It calculates the
      *  molality based activity coefficients for the solutes, and
-     *  the activity of water.
-     */
-    void s_updatePitzer_lnMolalityActCoeff() const;
-
-    //!  Calculates the temperature derivative of the
-    //!  natural logarithm of the molality activity coefficients.
-    /*!
-     * Public function makes sure that all dependent data is
-     * up to date, before calling a private function
-     */
-    void s_updatePitzer_dlnMolalityActCoeff_dT() const;
-
-    /**
-     * This function calculates the temperature second derivative of the
-     * natural logarithm of the molality activity coefficients.
-     *
-     * It is assumed that the Pitzer activity coefficient and first derivative
-     * routine are called immediately preceding the call to this routine.
-     */
-    void s_updatePitzer_d2lnMolalityActCoeff_dT2() const;
-
-    //!  Calculates the Pressure derivative of the
-    //!  natural logarithm of the molality activity coefficients.
-    /*!
-     * It is assumed that the Pitzer activity coefficient and first derivative
-     * routine are called immediately preceding the calling of this routine.
-     */
-    void s_updatePitzer_dlnMolalityActCoeff_dP() const;
+     *  the activity of water, and their first and second temperature
+     *  derivatives and their pressure derivative.
+     *
+     *  The functions of the ionic strength (E-theta, g(x) and h(x)) are
+     *  evaluated along with the activity coefficients, and are reused for
+     *  the derivatives, which rely on the activity coefficients having
+     *  been computed for the current state. All of the requested
+     *  quantities are accumulated in one call to s_updatePitzer_sums().
+     *
+     *  @param values  Calculate the activity coefficients
+     *  @param derivs  Calculate the temperature and pressure derivatives
+     */
+    void s_updatePitzer_lnMolalityActCoeff(bool values, bool derivs) const;
+
+    //! Calculate the binary interaction terms for one derivative of the
+    //! Pitzer parameters
+    /*!
+     * Evaluates BMX, BprimeMX, BphiMX and CMX for the cation-anion pairs
+     * and Phi and Phiphi for the like-charged pairs from the derivatives of
+     * the beta, Cphi and theta parameters. The E-theta terms depend only on
+     * the ionic strength, so they drop out of the derivatives, as does
+     * Phiprime. The functions of the ionic strength from the last
+     * evaluation of the activity coefficients are used.
+     *
+     * @param Is   Ionic strength
+     * @param beta0, beta1, beta2, Cphi, theta  Derivatives of the parameters
+     * @param t    Terms to fill in, with the binary arrays in `BMX`,
+     *             `BprimeMX`, `BphiMX`, `CMX`, `Phi` and `Phiphi`
+     */
+    void s_updatePitzer_binaryDerivs(double Is, const double* beta0,
+                                     const double* beta1, const double* beta2,
+                                     const double* Cphi, const double* theta,
+                                     double* BMX, double* BprimeMX,
+                                     double* BphiMX, double* CMX,
+                                     double* Phi, double* Phiphi) const;
 
     //! Calculates the Pitzer coefficients' dependence on the temperature.
     /*!
@@ -3095,6 +3142,54 @@ private:
      */
     void s_updatePitzer_CoeffWRTemp(int doDerivs = 2) const;
 
+    //! One set of interaction terms for s_updatePitzer_sums()
+    /*!
+     * The logarithms of the activity coefficients and their temperature
+     * and pressure derivatives are sums of the same form over the
+     * interacting pairs and triplets of species, with the interaction
+     * parameters replaced by their derivatives. The binary arrays are
+     * indexed by counterIJ.
+     */
+    struct PitzerTerms {
+        const double* BMX;
+        const double* BprimeMX;
+        const double* BphiMX;
+        const double* CMX;
+        const double* Phi;
+        //! May be null, if Phiprime is zero
+        const double* Phiprime;
+        const double* Phiphi;
+        const double* psi;
+        const Array2D* lambda;
+        const double* mu;
+        //! The Debye-Huckel part of F on input, and F on output
+        double F;
+        //! Output: ln(gamma) for the solutes, indexed by species. The entry
+        //! for the solvent is not modified.
+        double* lnActCoeff;
+        //! Output: the contribution of the interaction terms to
+        //! m (phi - 1) / 2, where phi is the osmotic coefficient
+        double osmotic;
+        //! Scratch: sum of m_i m_j CMX over the cation-anion pairs
+        double sumCMX;
+    };
+
+    //! Evaluate the Pitzer sums for the sets of interaction terms `t`
+    /*!
+     * The sums are carried out over the cation-anion pairs, like-charged
+     * pairs, ternary interactions and lambda interactions in the sparse
+     * lists, rather than over all pairs and triplets of species. Each
+     * pair and triplet is visited once, and its contribution is
+     * accumulated for all of the sets of terms.
+     *
+     * @param molality     Cropped molalities of the species
+     * @param molarcharge  Molar charge of the solution (Pitzer's Z)
+     * @param t            Interaction terms and results. length: nTerms
+     * @param nTerms       Number of sets of terms
+     */
+    void s_updatePitzer_sums(const double* molality, double molarcharge,
+                             PitzerTerms* t, size_t nTerms) const;
+
     //! Calculate the lambda interactions.
     /*!
      *
@@ -3142,6 +3237,23 @@ private:
      */
     void counterIJ_setup() const;
 
+    //! Build the sparse list of nonzero ternary interactions
+    /*!
+     * Fills m_PsiStart_ij and m_PsiIndex_k from the psi coefficients
+     * read in from the input file. Must be called after all of the
+     * interaction parameters have been read in.
+     */
+    void psiSparse_setup();
+
+    //! Build the lists of interacting pairs of species
+    /*!
+     * Fills m_CationAnionPairs, m_LikeChargePairs, m_LambdaStart_n and
+     * m_LambdaIndex_j from the binary and lambda parameters read in from
+     * the input file. Must be called after all of the interaction
+     * parameters have been read in.
+     */
+    void pairLists_setup();
+
     //! Calculate the cropped molalities
     /*!
      * This is an internal routine that calculates values
@@ -882,6 +882,50 @@ public:
      */
     virtual void setToEquilState(const doublereal* lambda_RT);
 
+    //! @name Batch State Inversion
+    //!
+    //! For an ideal gas, the specific enthalpy and internal energy depend only
+    //! on the temperature and the mass fractions. These methods find the
+    //! temperatures of many states (e.g. the cells of a CFD mesh) at once,
+    //! using a Newton iteration on the reference state thermodynamic functions
+    //! which is advanced for all unconverged states together. The state of the
+    //! phase is not changed.
+    //! @{
+
+    //! Find the temperatures of a set of states with given specific
+    //! enthalpies and mass fractions.
+    /*!
+     * @param nStates Number of states
+     * @param h       Specific enthalpies (J/kg). Length nStates.
+     * @param Y       Mass fractions of each state, stored contiguously.
+     *                Each set should sum to one. Length nStates*m_kk.
+     * @param T       On input, the initial guess for each temperature, e.g.
+     *                the temperatures at the previous time step. Values
+     *                which are not positive are replaced by the current
+     *                temperature of the phase. On output, the temperatures
+     *                (K). Length nStates.
+     * @param tol     Convergence tolerance on the temperature (K)
+     */
+    void getTemperatures_HY(size_t nStates, const doublereal* h,
+                            const doublereal* Y, doublereal* T,
+                            doublereal tol = 1.e-4) const;
+
+    //! Find the temperatures of a set of states with given specific
+    //! internal energies and mass fractions.
+    /*!
+     * @param nStates Number of states
+     * @param u       Specific internal energies (J/kg). Length nStates.
+     * @param Y       Mass fractions of each state, stored contiguously.
+     *                Each set should sum to one. Length nStates*m_kk.
+     * @param T       Initial guesses on input and temperatures (K) on
+     *                output, as for getTemperatures_HY(). Length nStates.
+     * @param tol     Convergence tolerance on the temperature (K)
+     */
+    void getTemperatures_UY(size_t nStates, const doublereal* u,
+                            const doublereal* Y, doublereal* T,
+                            doublereal tol = 1.e-4) const;
+    //! @}
+
 protected:
     //! Reference state pressure
     /*!
@@ -924,6 +968,15 @@ private:
      *  (or equivalent) call is made.
      */
     void _updateThermo() const;
+
+    //! Carry out the work in getTemperatures_HY() and getTemperatures_UY().
+    /*!
+     * @param doUV  If true, the targets are internal energies, otherwise they
+     *              are enthalpies.
+     */
+    void solveTemperatures(size_t nStates, const doublereal* e,
+                           const doublereal* Y, doublereal* T,
+                           doublereal tol, bool doUV) const;
 };
 }
 
@@ -175,8 +175,8 @@ protected:
      */
     std::vector<Nasa9Poly1*>m_regionPts;
 
-    //! current region
-    mutable int m_currRegion;
+    //! Index of the temperature region which contains temperature T
+    size_t region(doublereal T) const;
 };
 
 }
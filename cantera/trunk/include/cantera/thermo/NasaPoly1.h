@@ -119,6 +119,11 @@ public:
         return NASA1;
     }
 
+    //! Polynomial coefficients, in the order [a0, a1, a2, a3, a4, a5, a6]
+    const vector_fp& coefficients() const {
+        return m_coeff;
+    }
+
     virtual size_t temperaturePolySize() const { return 6; }
 
     virtual void updateTemperaturePoly(double T, double* T_poly) const {
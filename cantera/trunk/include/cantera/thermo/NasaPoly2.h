@@ -130,6 +130,21 @@ public:
         return NASA2;
     }
 
+    //! Temperature separating the low and high temperature regions
+    doublereal midTemp() const {
+        return m_midT;
+    }
+
+    //! Polynomial for the low temperature region
+    const NasaPoly1& lowPoly() const {
+        return mnp_low;
+    }
+
+    //! Polynomial for the high temperature region
+    const NasaPoly1& highPoly() const {
+        return mnp_high;
+    }
+
     virtual void setIndex(size_t index) {
         SpeciesThermoInterpType::setIndex(index);
         mnp_low.setIndex(index);
@@ -620,7 +620,10 @@ public:
         if (density_ <= 0.0) {
             throw CanteraError("Phase::setDensity()", "density must be positive");
         }
-        m_dens = density_;
+        if (density_ != m_dens) {
+            m_dens = density_;
+            m_stateDNum++;
+        }
     }
 
     //! Set the internally stored molar density (kmol/m^3) of the phase.
@@ -634,7 +637,10 @@ public:
             throw CanteraError("Phase::setTemperature",
                                "temperature must be positive");
         }
-        m_temp = temp;
+        if (temp != m_temp) {
+            m_temp = temp;
+            m_stateTNum++;
+        }
     }
     //@}
 
@@ -810,6 +816,25 @@ public:
         return m_stateNum;
     }
 
+    //! Return the State Temperature Number. This number is incremented
+    //! whenever the temperature of the phase changes.
+    int stateTNumber() const {
+        return m_stateTNum;
+    }
+
+    //! Return the State Density Number. This number is incremented
+    //! whenever the density of the phase changes.
+    /*!
+     * Together with stateTNumber() and stateMFNumber(), this identifies the
+     * state of the phase, so that objects which cache quantities derived
+     * from it (e.g. kinetics and transport managers) can compare integers
+     * rather than the state variables themselves to decide whether the
+     * cached values are still valid.
+     */
+    int stateDNumber() const {
+        return m_stateDNum;
+    }
+
 protected:
     //! Cached for saved calculations within each ThermoPhase.
     /*!
@@ -888,6 +913,14 @@ private:
     //! this int is incremented.
     int m_stateNum;
 
+    //! State Change variable for the temperature. Incremented whenever the
+    //! temperature changes.
+    int m_stateTNum;
+
+    //! State Change variable for the density. Incremented whenever the
+    //! density changes.
+    int m_stateDNum;
+
     //! Vector of the species names
     std::vector<std::string> m_speciesNames;
 
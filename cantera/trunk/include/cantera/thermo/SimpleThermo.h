@@ -185,6 +185,7 @@ public:
         throw CanteraError("install_STIT", "not implemented");
     }
 
+    using SpeciesThermo::update;
     virtual void update(doublereal t, doublereal* cp_R,
                         doublereal* h_RT, doublereal* s_R) const {
         size_t k, ki;
@@ -217,6 +217,23 @@ public:
     virtual void update(doublereal T, doublereal* cp_R,
                         doublereal* h_RT, doublereal* s_R) const=0;
 
+    //! Compute the reference-state properties for all species at each of a
+    //! set of temperatures.
+    /*!
+     * The properties of species `k` at temperature `T[n]` are stored in
+     * element `k*nT + n` of each output array, so that the values for each
+     * species are adjacent. The default implementation calls update() for
+     * each temperature.
+     *
+     * @param nT      Number of temperatures
+     * @param T       Temperatures (Kelvin). (length nT).
+     * @param cp_R    Dimensionless heat capacities. (length m_kk*nT).
+     * @param h_RT    Dimensionless enthalpies. (length m_kk*nT).
+     * @param s_R     Dimensionless entropies. (length m_kk*nT).
+     */
+    virtual void update(size_t nT, const doublereal* T, doublereal* cp_R,
+                        doublereal* h_RT, doublereal* s_R) const;
+
     //! Like update(), but only updates the single species k.
     /*!
      *  The default treatment is to just call update() which means that
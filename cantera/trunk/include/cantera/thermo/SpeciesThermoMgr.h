@@ -88,6 +88,7 @@ public:
         throw CanteraError("install_STIT", "not implemented");
     }
 
+    using SpeciesThermo::update;
     virtual void update(doublereal t, doublereal* cp_R,
                         doublereal* h_RT, doublereal* s_R) const;
 
@@ -126,6 +126,14 @@ public:
     *
     *  These routines are basically wrappers around the derived copy
     *  constructor.
+    *
+    *  Data which is not modified after the phase is set up (the species
+    *  XML data and, for GeneralSpeciesThermo, the species thermo
+    *  parameterizations) is shared with the duplicate, while the state and
+    *  work arrays are copied. Evaluating the shared parameterizations does
+    *  not modify them, and a phase which modifies one (e.g. through
+    *  modifyOneHf298SS()) first makes its own copy of it, so the duplicate
+    *  can be used from a different thread than the original.
     */
     virtual ThermoPhase* duplMyselfAsThermoPhase() const;
 
@@ -190,6 +198,7 @@ public:
     virtual void modifyOneHf298SS(const size_t k, const doublereal Hf298New) {
         m_spthermo->modifyOneHf298(k, Hf298New);
         m_tlast += 0.0001234;
+        m_cache.clear();
     }
 
     //! Maximum temperature for which the thermodynamic data for the species
@@ -1610,11 +1619,16 @@ protected:
      * This is used to access data needed to
      * construct the transport manager and other properties
      * later in the initialization process.
-     * We create a copy of the XML_Node data read in here. Therefore, we own this
-     * data.
+     * We create a copy of the XML_Node data read in here, which is owned by
+     * #m_speciesDataStorage.
      */
     std::vector<const XML_Node*> m_speciesData;
 
+    //! Owning pointers to the species data in #m_speciesData. The data is
+    //! never modified after it is saved, so it is shared with copies of
+    //! this phase.
+    std::vector<shared_ptr<XML_Node> > m_speciesDataStorage;
+
     //! Stored value of the electric potential for this phase
     /*!
      * Units are Volts
@@ -15,7 +15,16 @@ class MMCollisionInt;
 
 //! Class GasTransport implements some functions and properties that are
 //! shared by the MixTransport and MultiTransport classes.
-//! @ingroup tranprops
+/*!
+ * Fitting the collision integrals and the species and species-pair
+ * properties is the main cost of setting up a gas transport manager for a
+ * large mechanism. If the environment variable CANTERA_TRANSPORT_CACHE names
+ * a writable directory, the fits are saved there and reused by later
+ * transport managers, in this or any other process, for phases with the
+ * same species transport data, heat capacities and temperature limits.
+ *
+ * @ingroup tranprops
+ */
 class GasTransport : public Transport
 {
 public:
@@ -107,8 +116,46 @@ public:
      */
     virtual void getMixDiffCoeffsMass(doublereal* const d);
 
+    //! Get the viscosity, thermal conductivity and mixture-averaged
+    //! diffusion coefficients at a set of states
+    /*!
+     * The pure species viscosity and binary diffusion coefficient fits are
+     * evaluated for blocks of up to 16 points together, so that each fit
+     * coefficient is read once per block instead of once per point. The
+     * fit values for a block are stored in #m_fitblock, and the number of
+     * points in a block is reduced for large mechanisms to keep this array
+     * below about 1 MB. The mixing rules are then applied at each point in
+     * turn. See Transport::getTransportProperties.
+     */
+    virtual void getTransportProperties(size_t npoints, const doublereal* T,
+                                        const doublereal* P,
+                                        const doublereal* X, doublereal* visc,
+                                        doublereal* cond, doublereal* dmix);
+
     virtual void init(thermo_t* thermo, int mode=0, int log_level=0);
 
+    virtual void setThermo(thermo_t& thermo);
+
+    //! Get the collision integral and property fits made by init(), packed
+    //! into flat arrays which can be stored and passed to setFits().
+    /*!
+     * @param index  Output sizes of the fits: the fit mode, the number of
+     *     species, then the number of fits and the number of coefficients
+     *     per fit for each of the omega22, A*, B*, C*, viscosity, thermal
+     *     conductivity and binary diffusion coefficient fits, and finally
+     *     the nsp*nsp indices of the collision integral fit used for each
+     *     species pair.
+     * @param coeffs Output fit coefficients, in the order listed above.
+     */
+    void getFits(vector_int& index, vector_fp& coeffs) const;
+
+    //! Use fits from getFits() instead of fitting the collision integrals
+    //! and properties. If called before init(), init() uses these fits;
+    //! otherwise, they replace the current fits. The fits must be for the
+    //! same species data, fit mode and temperature range, which is not
+    //! checked; an exception is thrown if the sizes are inconsistent.
+    void setFits(const vector_int& index, const vector_fp& coeffs);
+
 protected:
     GasTransport(ThermoPhase* thermo=0);
 
@@ -126,6 +173,10 @@ protected:
      *      \phi_{ij} = \frac{ \left[ 1 + \left( \mu_i / \mu_j \right)^{1/2} \left( M_j / M_i \right)^{1/4} \right]^2 }
      *                    {\left[ 8 \left( 1 + M_i / M_j \right) \right]^{1/2}}
      *  \f]
+     *
+     * The factors which depend only on the molecular weights are taken
+     * from #m_phifac, so that each species pair costs one reciprocal square
+     * root viscosity lookup and a few multiplications.
      */
     virtual void updateViscosity_T();
 
@@ -134,6 +185,10 @@ protected:
     //! of pressure.
     virtual void updateSpeciesViscosities();
 
+    //! Set the pure-species viscosities from the values `f` of their fits
+    //! at the current temperature
+    void storeSpeciesViscosities(const doublereal* f);
+
     //! Update the binary diffusion coefficients
     /*!
      * These are evaluated from the polynomial fits of the temperature at the
@@ -141,6 +196,35 @@ protected:
      */
     virtual void updateDiff_T();
 
+    //! Set the binary diffusion coefficients from the values `f` of their
+    //! fits at the current temperature, in the pair order of #m_diffcoeffs
+    void storeBinaryDiffCoeffs(const doublereal* f);
+
+    //! Maximum number of points for which getTransportProperties()
+    //! evaluates the fits together
+    static const size_t FitBlockPoints = 16;
+
+    //! Powers of ln(T), from the zeroth to the fourth, as used by the fits
+    static void logTPowers(doublereal T, doublereal* tpoly);
+
+    //! Evaluate a range of packed polynomial fits at one or more
+    //! temperatures
+    /*!
+     * @param coeffs   Fit coefficients, with coefficient n of fit i in
+     *                 coeffs(i,n). See #m_visccoeffs_pack.
+     * @param first    Index of the first fit to evaluate
+     * @param last     One past the index of the last fit to evaluate
+     * @param npoints  Number of temperatures
+     * @param tpoly    Powers of ln(T) from logTPowers() for each
+     *                 temperature. Length = 5*npoints
+     * @param ldf      Offset between the values for successive temperatures
+     * @param f        Output fit values. Fit i at temperature j is stored
+     *                 in f[j*ldf + i - first].
+     */
+    void evalPackedFits(const Array2D& coeffs, size_t first, size_t last,
+                        size_t npoints, const doublereal* tpoly, size_t ldf,
+                        doublereal* f) const;
+
     //! @name Initialization
     //! @{
 
@@ -204,6 +288,68 @@ protected:
      */
     void fitProperties(MMCollisionInt& integrals);
 
+    //! Fit the binary diffusion coefficients for a subset of species pairs
+    /*!
+     * Fits the pairs (k,j), j >= k, for k = kfirst, kfirst + kstride, ...
+     * into the preallocated #m_diffcoeffs, so that several calls for
+     * different values of kfirst can run concurrently.
+     *
+     * @param integrals  interpolator for the collision integrals
+     * @param tfit       Temperatures at which the fit data is generated
+     * @param tlog       Logarithms of the temperatures in tfit
+     * @param kfirst     First species row to fit
+     * @param kstride    Increment between the species rows fitted
+     * @param pairerr    Output maximum absolute and relative errors of the
+     *                   fit for pair ic, in elements 2*ic and 2*ic+1.
+     * @param errmsg     Set to the error message if the fitting fails
+     */
+    void fitDiffCoeffs(MMCollisionInt& integrals, const vector_fp& tfit,
+                       const vector_fp& tlog, size_t kfirst, size_t kstride,
+                       vector_fp& pairerr, std::string& errmsg);
+
+    //! String identifying all of the inputs to the property fits. Two
+    //! phases with the same key have identical fits. The heat capacities
+    //! at the fit temperatures are included as a 64-bit digest.
+    std::string fitCacheKey();
+
+    //! Read the fits made by setupMM() from a cache file.
+    /*!
+     * @param path  Name of the cache file
+     * @param key   Key of the fits, from fitCacheKey()
+     * @returns true if the file exists and holds valid fits for this key
+     */
+    bool readFitCache(const std::string& path, const std::string& key);
+
+    //! Write the fits made by setupMM() to a cache file. Failure to write
+    //! the file is not an error.
+    void writeFitCache(const std::string& path, const std::string& key) const;
+
+    //! Replace the fits made by setupMM(), after checking that the numbers
+    //! of fits match this phase.
+    /*!
+     * @returns false, without changing the current fits, if the sizes are
+     *     inconsistent
+     */
+    bool assignFits(const std::vector<vector_int>& poly,
+                    const std::vector<vector_fp>& omega22,
+                    const std::vector<vector_fp>& astar,
+                    const std::vector<vector_fp>& bstar,
+                    const std::vector<vector_fp>& cstar,
+                    const std::vector<vector_fp>& visc,
+                    const std::vector<vector_fp>& cond,
+                    const std::vector<vector_fp>& diff);
+
+    //! Replace the fits made by setupMM() with fits packed by getFits()
+    //! @returns false if the sizes are inconsistent
+    bool unpackFits(const vector_int& index, const vector_fp& coeffs);
+
+    //! Copy the viscosity and binary diffusion coefficient fits into the
+    //! packed arrays used to evaluate them.
+    /*!
+     * Must be called whenever #m_visccoeffs or #m_diffcoeffs change.
+     */
+    void packFitCoeffs();
+
     //! Second-order correction to the binary diffusion coefficients
     /*!
      * Calculate second-order corrections to binary diffusion coefficient pair
@@ -236,6 +382,11 @@ protected:
     //! fractions are >= *Tiny*. Length = m_kk.
     vector_fp m_molefracs;
 
+    //! Phase::stateMFNumber() of the phase at which #m_molefracs was last
+    //! updated. update_C() does nothing if this is unchanged. Set to -2 to
+    //! force the mole fractions to be updated.
+    int m_stateMF;
+
     //! Internal storage for the viscosity of the mixture  (kg /m /s)
     doublereal m_viscmix;
 
@@ -270,6 +421,11 @@ protected:
     //! viscosity as a function of temperature.
     std::vector<vector_fp> m_visccoeffs;
 
+    //! Viscosity fit coefficients packed by coefficient. Column n holds
+    //! coefficient n of every species, so that all species can be evaluated
+    //! together in loops over contiguous memory. size = m_nsp * (degree+1)
+    Array2D m_visccoeffs_pack;
+
     //! Local copy of the species molecular weights.
     vector_fp m_mw;
 
@@ -288,6 +444,17 @@ protected:
      */
     DenseMatrix m_wratkj1;
 
+    //! Temperature-independent factors of the Wilke weighting functions,
+    //! packed for the species pairs (j,k) with j <= k in row-major order.
+    /*!
+     *  @code
+     *  m_phifac(p,0) = (mw[j]/mw[k])^(1/4)
+     *  m_phifac(p,1) = 1.0 / sqrt(8.0 * (1.0 + mw[k]/mw[j]))
+     *  m_phifac(p,2) = mw[k]/mw[j]
+     *  @endcode
+     */
+    Array2D m_phifac;
+
     //! vector of square root of species viscosities sqrt(kg /m /s). These are
     //! used in Wilke's rule to calculate the viscosity of the solution.
     //! length = m_kk.
@@ -334,6 +501,19 @@ protected:
      */
     std::vector<vector_fp> m_diffcoeffs;
 
+    //! Binary diffusion coefficient fits packed by coefficient. Column n
+    //! holds coefficient n of every species pair, in the same pair order
+    //! as #m_diffcoeffs. size = npairs * (degree+1)
+    Array2D m_diffcoeffs_pack;
+
+    //! Work space for evaluating the packed fits. Length is the larger of
+    //! the number of species and the number of species pairs.
+    vector_fp m_fitwork;
+
+    //! Fit values and powers of ln(T) for a block of points evaluated by
+    //! getTransportProperties()
+    vector_fp m_fitblock;
+
     //! Matrix of binary diffusion coefficients at the reference pressure and
     //! the current temperature Size is nsp x nsp.
     DenseMatrix m_bdiff;
@@ -384,6 +564,13 @@ protected:
      */
     std::vector<vector_fp> m_cstar_poly;
 
+    //! Fits given to setFits() before init(), to be used by setupMM().
+    //! See getFits() for the layout.
+    vector_int m_presetFitIndex;
+
+    //! Fit coefficients given to setFits() before init()
+    vector_fp m_presetFitCoeffs;
+
     //! Rotational relaxation number for each species
     /*!
      * length is the number of species in the phase. units are dimensionless
@@ -100,6 +100,25 @@ public:
      */
     virtual doublereal thermalConductivity();
 
+    //! Get the viscosity, thermal conductivity and mixture-averaged
+    //! diffusion coefficients at a set of states
+    /*!
+     * The species viscosity and binary diffusion coefficient fits are
+     * evaluated for blocks of up to #FitBlockPoints points together. The
+     * binary diffusion coefficients are evaluated one row of species pairs
+     * at a time and added directly to the sums in the mixture rule for
+     * both species of each pair, so the storage needed is proportional to
+     * the number of species, and only one division is done for each pair.
+     * Likewise, the Wilke weighting functions are not stored. The results
+     * agree with those of viscosity(), thermalConductivity() and
+     * getMixDiffCoeffs() to within rounding error. The cached properties of
+     * this object are not modified. See Transport::getTransportProperties.
+     */
+    virtual void getTransportProperties(size_t npoints, const doublereal* T,
+                                        const doublereal* P,
+                                        const doublereal* X, doublereal* visc,
+                                        doublereal* cond, doublereal* dmix);
+
     //! Get the Electrical mobilities (m^2/V/s).
     /*!
      *   This function returns the mobilities. In some formulations
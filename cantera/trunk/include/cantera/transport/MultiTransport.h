@@ -117,6 +117,46 @@ public:
 
     virtual void init(ThermoPhase* thermo, int mode=0, int log_level=0);
 
+    //! Solve the L matrix equation iteratively instead of by LU factorization
+    /*!
+     * The system for the thermal conductivity and thermal diffusion
+     * coefficients is solved with restarted GMRES using a diagonal
+     * preconditioner, starting from the previous solution. Each iteration
+     * costs one product with the L matrix, so the cost grows as the square
+     * of the number of species rather than the cube. If the iteration does
+     * not converge within the allowed number of iterations, the direct
+     * solution is used instead.
+     *
+     * getMultiDiffCoeffs() is controlled separately by
+     * setMultiDiffSeries().
+     *
+     * @param rtol  Tolerance on the residual norm relative to the norm of
+     *              the right-hand side. A value of zero (the default)
+     *              selects the direct LU solution.
+     * @param maxIterations  Maximum number of GMRES iterations
+     */
+    void setIterativeSolver(doublereal rtol, int maxIterations = 200);
+
+    //! Evaluate the multicomponent diffusion coefficients with a convergent
+    //! series instead of inverting the L00,00 block
+    /*!
+     * The flux diffusion matrix is expanded in the series of Giovangigli
+     * (Impact Comput. Sci. Eng. 3:244-276, 1991), which splits the
+     * Stefan-Maxwell matrix into its diagonal and off-diagonal parts. The
+     * first two terms cost O(K^2) operations for K species; each further
+     * term costs one dense matrix product, about the same as the direct
+     * inversion. The series is therefore worthwhile with a loose tolerance,
+     * where one or two terms suffice. Terms are added until the largest
+     * element of the last term is smaller than `rtol` times the largest
+     * element of the sum. If this does not happen within `maxTerms` terms,
+     * the L00,00 block is inverted instead.
+     *
+     * @param rtol  Relative truncation tolerance. A value of zero (the
+     *              default) selects the direct inversion.
+     * @param maxTerms  Maximum number of terms in the series
+     */
+    void setMultiDiffSeries(doublereal rtol, size_t maxTerms = 3);
+
 protected:
     //! Update basic temperature-dependent quantities if the temperature has changed.
     void update_T();
@@ -200,6 +240,51 @@ protected:
     }
 
     virtual void solveLMatrixEquation();
+
+    //! Solve the L matrix equation for m_a with preconditioned GMRES
+    /*!
+     * @returns true if the relative residual tolerance was met.
+     */
+    bool solveLMatrixGMRES();
+
+    //! Evaluate the multicomponent diffusion coefficients from the truncated
+    //! series. See setMultiDiffSeries().
+    /*!
+     * @returns true if the series converged within the allowed number of
+     *     terms, in which case `d` has been filled in.
+     */
+    bool multiDiffSeries(size_t ld, doublereal* d);
+
+    //! Relative residual tolerance for the iterative L matrix solution.
+    //! Zero selects the direct LU solution.
+    doublereal m_iter_rtol;
+
+    //! Maximum number of GMRES iterations
+    int m_iter_max;
+
+    //! Krylov basis vectors, stored as columns
+    DenseMatrix m_krylov;
+
+    //! Hessenberg matrix from the Arnoldi process
+    DenseMatrix m_hess;
+
+    //! Diagonal preconditioner and work space for GMRES
+    vector_fp m_precon, m_gmres_r, m_gmres_z, m_gmres_g, m_gmres_cs, m_gmres_sn;
+
+    //! Relative truncation tolerance for the diffusion series. Zero selects
+    //! the direct inversion.
+    doublereal m_series_rtol;
+
+    //! Maximum number of terms in the diffusion series
+    size_t m_series_max;
+
+    //! Off-diagonal part of the Stefan-Maxwell matrix, the current series
+    //! term, its product with #m_zmat, and the sum of the series
+    DenseMatrix m_zmat, m_sterm, m_sprod, m_dflux;
+
+    //! Work space for the diffusion series
+    vector_fp m_swork;
+
     DenseMatrix incl;
     bool m_debug;
 };
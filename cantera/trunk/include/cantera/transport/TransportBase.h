@@ -670,6 +670,34 @@ public:
         throw NotImplementedError("Transport::getMixDiffCoeffsMass");
     }
 
+    //! Get the viscosity, thermal conductivity and mixture-averaged
+    //! diffusion coefficients at a set of states
+    /*!
+     * This lets a caller such as a 1D flow domain evaluate the transport
+     * properties for a block of points in one call. The state of the
+     * associated phase is set in turn to each of the given states, and is
+     * left at the last one. Properties whose output array is NULL are not
+     * computed. The gas transport managers evaluate their temperature
+     * fits for blocks of points together (see
+     * GasTransport::getTransportProperties and
+     * MixTransport::getTransportProperties).
+     *
+     * @param npoints  Number of states
+     * @param T        Temperatures (K). Length = npoints
+     * @param P        Pressures (Pa). Length = npoints
+     * @param X        Mole fractions. The values for point j start at
+     *                 X[j*nsp]. Length = npoints * nsp
+     * @param visc     Output viscosities (Pa s). Length = npoints
+     * @param cond     Output thermal conductivities (W/m/K).
+     *                 Length = npoints
+     * @param dmix     Output mixture-averaged diffusion coefficients
+     *                 (m^2/s), laid out in the same way as X
+     */
+    virtual void getTransportProperties(size_t npoints, const doublereal* T,
+                                        const doublereal* P,
+                                        const doublereal* X, doublereal* visc,
+                                        doublereal* cond, doublereal* dmix);
+
     //! Set model parameters for derived classes
     /*!
      *  This method may be derived in subclasses to set model-specific
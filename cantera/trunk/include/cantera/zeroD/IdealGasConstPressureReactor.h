@@ -45,7 +45,17 @@ public:
     //! of a homogeneous phase species, or the name of a surface species.
     virtual size_t componentIndex(const std::string& nm) const;
 
+    virtual bool analyticJacobianAdjoint() const {
+        return isolated();
+    }
+
+    virtual void evalJacobianAdjoint(double t, const double* lambda,
+                                     double* jtl, double* params);
+
 protected:
+    virtual void getProductionAdjoint(const double* lambda, double* lamw,
+                                      double* lams);
+
     vector_fp m_hk; //!< Species molar enthalpies
 };
 }
@@ -40,7 +40,17 @@ public:
 
     virtual size_t componentIndex(const std::string& nm) const;
 
+    virtual bool analyticJacobianAdjoint() const {
+        return isolated();
+    }
+
+    virtual void evalJacobianAdjoint(double t, const double* lambda,
+                                     double* jtl, double* params);
+
 protected:
+    virtual void getProductionAdjoint(const double* lambda, double* lamw,
+                                      double* lams);
+
     vector_fp m_uk; //!< Species molar internal energies
 };
 
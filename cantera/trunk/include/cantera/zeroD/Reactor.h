@@ -9,6 +9,7 @@
 
 #include "ReactorBase.h"
 #include "cantera/kinetics/Kinetics.h"
+#include "cantera/numerics/SparseMatrix.h"
 
 namespace Cantera
 {
@@ -146,7 +147,84 @@ public:
     //! name of a homogeneous phase species, or the name of a surface species.
     virtual size_t componentIndex(const std::string& nm) const;
 
+    //! @name Adjoint sensitivity analysis
+    //! Products of the transposed derivatives of the governing equations with
+    //! a vector of adjoint variables, used by ReactorNet::evalAdjoint() and
+    //! ReactorNet::evalAdjointQuadrature(). The reactor must be in the state
+    //! set by the most recent call to updateState().
+    //! @{
+
+    //! Returns `true` if evalJacobianAdjoint() is implemented for this
+    //! reactor in its current configuration.
+    virtual bool analyticJacobianAdjoint() const {
+        return false;
+    }
+
+    /*!
+     * Evaluate the product of the transpose of this reactor's block of the
+     * Jacobian of the governing equations with the adjoint variables,
+     * \f$ (\partial \vec{F} / \partial \vec{y})^T \vec{\lambda} \f$.
+     * Only available if analyticJacobianAdjoint() returns `true`, which
+     * requires that the reactor is not coupled to any other reactor.
+     * @param[in] t time.
+     * @param[in] lambda adjoint variables, length neq()
+     * @param[out] jtl product of the Jacobian transpose with *lambda*,
+     *     length neq()
+     * @param[in] params sensitivity parameter vector
+     */
+    virtual void evalJacobianAdjoint(double t, const double* lambda,
+                                     double* jtl, double* params);
+
+    /*!
+     * Evaluate \f$ q_n = \vec{\lambda}^T \partial \vec{F} / \partial p_n
+     * \f$ for each sensitivity parameter of this reactor and its walls. The
+     * governing equations are linear in the rate multipliers, so the
+     * derivative with respect to the multiplier of reaction *i* is the
+     * stoichiometry of reaction *i* times its unperturbed net rate of
+     * progress.
+     * @param[in] t time.
+     * @param[in] lambda adjoint variables, length neq()
+     * @param[out] q products with the parameter derivatives, length
+     *     nSensParams()
+     */
+    virtual void evalParamAdjoint(double t, const double* lambda, double* q);
+    //! @}
+
 protected:
+    //! Compute the derivatives of \f$ \vec{\lambda}^T \vec{F} \f$ with
+    //! respect to the gas phase production rates, `lamw[k]`, and the surface
+    //! production rates of the gas phase species, `lams[k]`.
+    virtual void getProductionAdjoint(const double* lambda, double* lamw,
+                                      double* lams);
+
+    //! Implementation of getProductionAdjoint() for the terms common to all
+    //! reactors with the mass fractions starting at *offset* in the state
+    //! vector and the total mass as the first state variable.
+    void getSpeciesProductionAdjoint(const double* lambda, size_t offset,
+                                     double* lamw, double* lams);
+
+    //! Add the terms of \f$ (\partial \vec{F} / \partial \vec{y})^T
+    //! \vec{\lambda} \f$ due to the dependence of the gas phase production
+    //! rates on temperature and species concentrations, for an ideal gas.
+    /*!
+     *  @param lamw  derivatives of \f$ \vec{\lambda}^T \vec{F} \f$ with
+     *      respect to the production rates, from getProductionAdjoint()
+     *  @param dTdy  derivatives of the temperature with respect to the
+     *      state variables, length neq()
+     *  @param drhody  derivatives of the density with respect to the state
+     *      variables at constant mass fractions, length neq()
+     *  @param offset  index of the first mass fraction in the state vector
+     *  @param[in,out] jtl  product being accumulated, length neq()
+     */
+    void addProductionRateAdjoint(const double* lamw, const double* dTdy,
+                                  const double* drhody, size_t offset,
+                                  double* jtl);
+
+    //! Returns `true` if the governing equations of this reactor do not
+    //! depend on the state of any other reactor and there is no surface
+    //! chemistry, so that its block of the Jacobian can be evaluated alone.
+    bool isolated() const;
+
     //! Set reaction rate multipliers based on the sensitivity variables in
     //! *params*.
     virtual void applySensitivity(double* params);
@@ -198,6 +276,10 @@ protected:
     std::vector<size_t> m_pnum;
     std::vector<size_t> m_nsens_wall;
     vector_fp m_mult_save;
+
+    //! Derivatives of the production rates with respect to the species
+    //! concentrations. Used by addProductionRateAdjoint().
+    SparseMatrix m_dwdot;
 };
 }
 
@@ -178,6 +178,82 @@ public:
         return sensitivity(k, p);
     }
 
+    //! Enable or disable adjoint sensitivity analysis.
+    /*!
+     *  In adjoint mode, the forward sensitivity equations are not integrated.
+     *  Instead, the solution is stored at checkpoints during the integration,
+     *  and getAdjointSensitivities() computes the sensitivities of a single
+     *  scalar function of the final state with respect to all of the
+     *  sensitivity parameters by integrating the adjoint equations backwards
+     *  in time. Each call to getAdjointSensitivities() recomputes the
+     *  solution from the checkpoints and integrates the adjoint equations
+     *  using the sensitivity tolerances (see setSensitivityTolerances()).
+     *
+     *  The right-hand side of the adjoint equations needs the product of the
+     *  transposed Jacobian with the adjoint variables. This is evaluated
+     *  analytically if Reactor::analyticJacobianAdjoint() is `true` for all
+     *  of the reactors in the network (IdealGasReactor and
+     *  IdealGasConstPressureReactor objects which are not coupled to other
+     *  reactors). Otherwise, it is evaluated by finite differences, using
+     *  neq() evaluations of the governing equations each time.
+     *
+     *  The derivatives of the governing equations with respect to the
+     *  parameters are evaluated exactly for all reactor types except
+     *  FlowReactor, which uses finite differences with one evaluation of the
+     *  governing equations for each parameter at each quadrature point. For
+     *  a FlowReactor, the cost of getAdjointSensitivities() therefore grows
+     *  linearly with the number of sensitivity parameters, as it does for
+     *  forward sensitivity analysis. For all other reactor types, the cost is
+     *  a small multiple of that of the forward integration.
+     *
+     *  The forward integration can be continued after calling
+     *  getAdjointSensitivities(). Takes effect the next time the network is
+     *  initialized.
+     *
+     *  @param adjoint `true` to enable adjoint sensitivity analysis
+     *  @param nsteps  Number of integrator steps between stored checkpoints
+     */
+    void setAdjointSensitivity(bool adjoint=true, int nsteps=100) {
+        m_adjoint = adjoint;
+        m_adjointSteps = nsteps;
+        m_init = false;
+    }
+
+    //! Returns `true` if adjoint sensitivity analysis is enabled.
+    bool adjointSensitivity() const {
+        return m_adjoint;
+    }
+
+    //! Compute the sensitivities of a scalar function of the current state
+    //! with respect to the sensitivity parameters, using the adjoint method.
+    /*!
+     *  Given the derivatives of a function \f$ g(\vec{y}) \f$ with respect
+     *  to each component of the global state vector at the current time,
+     *  compute \f$ dg/dp_i \f$ for each sensitivity parameter \f$ p_i \f$
+     *  (unnormalized, see sensitivity()). Adjoint sensitivity analysis must
+     *  have been enabled with setAdjointSensitivity() before the network was
+     *  advanced to the current time. May be called several times, for
+     *  different functions *g* or at different times. See
+     *  setAdjointSensitivity() for the cost of this calculation.
+     *
+     *  @param[in] dgdy  Derivatives of *g* with respect to the components of
+     *      the state vector. Length neq().
+     *  @param[out] dgdp  Derivatives of *g* with respect to the sensitivity
+     *      parameters, in the order in which they were added. Length
+     *      nparams().
+     */
+    void getAdjointSensitivities(const double* dgdy, double* dgdp);
+
+    //! Compute the normalized sensitivities of the *k*-th solution component
+    //! at the current time with respect to all of the sensitivity parameters,
+    //! using the adjoint method.
+    /*!
+     *  The results are normalized in the same way as sensitivity(), and are
+     *  returned in the order in which the parameters were added. Length of
+     *  `sens`: nparams().
+     */
+    void getAdjointSensitivities(size_t k, double* sens);
+
     //! Evaluate the Jacobian matrix for the reactor network.
     /*!
      *  @param[in] t Time at which to evaluate the Jacobian
@@ -201,6 +277,20 @@ public:
         return m_ntotpar;
     }
 
+    //! Evaluate the right-hand side of the adjoint equations. The product
+    //! with the Jacobian transpose is evaluated analytically if
+    //! Reactor::analyticJacobianAdjoint() is `true` for all of the reactors
+    //! in the network, and by finite differences otherwise.
+    virtual void evalAdjoint(double t, double* y, const double* lambda,
+                             double* lambdadot, double* p);
+
+    //! Evaluate the integrands of the adjoint sensitivity quadratures, using
+    //! Reactor::evalParamAdjoint(), or finite differences with nparams()
+    //! evaluations of the governing equations for a FlowReactor.
+    virtual void evalAdjointQuadrature(double t, double* y,
+                                       const double* lambda, double* qdot,
+                                       double* p);
+
     //! Return the index corresponding to the component named *component* in the
     //! reactor with index *reactor* in the global state vector for the
     //! reactor network.
@@ -270,6 +360,13 @@ protected:
     vector_fp m_ydot;
 
     std::vector<bool> m_iown;
+
+    //! True if adjoint sensitivity analysis is enabled
+    bool m_adjoint;
+
+    //! Number of integrator steps between checkpoints for adjoint
+    //! sensitivity analysis
+    int m_adjointSteps;
 };
 }
 
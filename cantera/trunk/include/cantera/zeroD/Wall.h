@@ -175,6 +175,17 @@ public:
             return m_pright.size();
         }
     }
+
+    //! Indices of the reactions on the left (`lr = 0`) or right (`lr = 1`)
+    //! side of the wall which are sensitivity parameters, in the order of
+    //! the parameters.
+    const std::vector<size_t>& sensitivityReactions(int lr) const {
+        if (lr == 0) {
+            return m_pleft;
+        } else {
+            return m_pright;
+        }
+    }
     void addSensitivityReaction(int leftright, size_t rxn);
     void setSensitivityParameters(int lr, double* params);
     void resetSensitivityParameters(int lr);
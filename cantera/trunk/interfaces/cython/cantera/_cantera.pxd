@@ -352,6 +352,11 @@ cdef extern from "cantera/zeroD/ReactorNet.h":
         double sensitivity(string&, size_t, int) except +
         size_t nparams()
         string sensitivityParameterName(size_t) except +
+        size_t globalComponentIndex(string&, size_t) except +
+        void setAdjointSensitivity(cbool, int)
+        cbool adjointSensitivity()
+        void getAdjointSensitivities(double*, double*) except +
+        void getAdjointSensitivities(size_t, double*) except +
 
 
 cdef extern from "cantera/thermo/ThermoFactory.h" namespace "Cantera":
@@ -902,6 +902,58 @@ cdef class ReactorNet:
                 data[k,p] = self.net.sensitivity(k,p)
         return data
 
+    property adjoint_sensitivity:
+        """
+        If *True*, sensitivities are computed using the adjoint method (see
+        `adjoint_sensitivities`) instead of by integrating the forward
+        sensitivity equations. Must be set before the network is advanced.
+        The default is *False*.
+        """
+        def __get__(self):
+            return pybool(self.net.adjointSensitivity())
+        def __set__(self, pybool v):
+            self.net.setAdjointSensitivity(v, 100)
+
+    def adjoint_sensitivities(self, component, int r=0):
+        """
+        Returns the normalized sensitivities of the solution variable
+        *component* in reactor *r* at the current time with respect to all of
+        the registered parameters, computed by integrating the adjoint
+        equations backwards in time. *component* can be a string or an
+        integer index into the global state vector. The sensitivities are
+        normalized as described in `sensitivities`. Requires that
+        `adjoint_sensitivity` was set to *True* before the network was
+        advanced.
+        """
+        cdef size_t k
+        if isinstance(component, int):
+            k = component
+        else:
+            k = self.net.globalComponentIndex(stringify(component), r)
+        cdef np.ndarray[np.double_t, ndim=1] data = \
+                np.empty(self.n_sensitivity_params)
+        if self.n_sensitivity_params:
+            self.net.getAdjointSensitivities(k, &data[0])
+        return data
+
+    def adjoint_gradient(self, dgdy):
+        """
+        Returns the derivatives of a scalar function *g* of the current state
+        with respect to each of the registered parameters, computed using the
+        adjoint method. *dgdy* is the derivative of *g* with respect to each
+        of the state variables (see `sensitivities` for their order).
+        """
+        cdef np.ndarray[np.double_t, ndim=1] y = \
+                np.ascontiguousarray(dgdy, dtype=np.double)
+        if len(y) != self.n_vars:
+            raise ValueError('Expected an array of length {0}, got {1}'.format(
+                self.n_vars, len(y)))
+        cdef np.ndarray[np.double_t, ndim=1] data = \
+                np.empty(self.n_sensitivity_params)
+        if self.n_sensitivity_params:
+            self.net.getAdjointSensitivities(&y[0], &data[0])
+        return data
+
     def sensitivity_parameter_name(self, int p):
         """
         Name of the sensitivity parameter with index *p*.
@@ -964,6 +964,48 @@ class TestReactorSensitivities(utilities.CanteraTest):
             self.assertNear(np.linalg.norm(S[Ns:K2,1]), 0.0, atol=1e-5)
             self.assertNear(np.linalg.norm(S[K2+Ns:,0]), 0.0, atol=1e-5)
 
+    def test_adjoint_sensitivities(self):
+        gas = ct.Solution('h2o2.xml')
+        params = [2, 10, 18, 19]
+
+        def setup(adjoint):
+            gas.TPX = 900, 101325, 'H2:0.1, OH:1e-7, O2:0.1, AR:1e-5'
+            r = ct.IdealGasReactor(gas)
+            net = ct.ReactorNet([r])
+            net.rtol_sensitivity = 1e-7
+            net.atol_sensitivity = 1e-9
+            net.adjoint_sensitivity = adjoint
+            for p in params:
+                r.add_sensitivity_reaction(p)
+            return r, net
+
+        r1, net1 = setup(False)
+        while r1.T < 905:
+            net1.step(1.0)
+        S1 = net1.sensitivities()
+        T1 = r1.T
+
+        r2, net2 = setup(True)
+        self.assertTrue(net2.adjoint_sensitivity)
+        net2.advance(net1.time)
+        self.assertNear(T1, r2.T, 1e-6)
+
+        for name in ('temperature', 'H2O', 'OH'):
+            k = r1.component_index(name)
+            S2 = net2.adjoint_sensitivities(name)
+            self.assertArrayNear(S1[k], S2, 5e-3, 1e-6)
+
+        # unnormalized gradient of a linear combination of the state
+        k1 = r2.component_index('H2O')
+        k2 = r2.component_index('temperature')
+        dgdy = np.zeros(net2.n_vars)
+        dgdy[k1] = 2.0
+        dgdy[k2] = 0.5
+        grad = net2.adjoint_gradient(dgdy)
+        Y = gas.Y[gas.species_index('H2O')]
+        ref = 2.0 * S1[k1] * Y + 0.5 * S1[k2] * r2.T
+        self.assertArrayNear(grad, ref, 5e-3, 1e-9)
+
     def _test_parameter_order1(self, reactorClass):
         # Single reactor, changing the order in which parameters are added
         gas = ct.Solution('h2o2.xml')
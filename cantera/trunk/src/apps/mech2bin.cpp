@@ -0,0 +1,56 @@
+/*
+ *  mech2bin input_file phase_id output_file [transport_model]
+ *
+ *  Constructs an ideal gas phase, its kinetics manager and, if a transport
+ *  model (Mix, Multi, CK_Mix or CK_Multi) is given, its transport manager
+ *  from a CTI or CTML input file, and saves the constructed objects to a
+ *  binary mechanism file which can be loaded with readBinaryMechanism()
+ *  without parsing the input or fitting the transport properties.
+ *
+ *  Shell Return Values
+ *    0 = The file was written
+ *    1 = Invalid arguments, or an error occurred
+ */
+
+#include "cantera/kinetics/BinaryMechanism.h"
+#include "cantera/kinetics/KineticsFactory.h"
+#include "cantera/thermo/ThermoFactory.h"
+#include "cantera/transport/TransportFactory.h"
+
+#include <iostream>
+#include <memory>
+
+using namespace Cantera;
+
+static void printUsage()
+{
+    std::cout << "usage: mech2bin input_file phase_id output_file "
+              "[transport_model]" << std::endl;
+    std::cout << "    transport_model is one of Mix, Multi, CK_Mix or "
+              "CK_Multi" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4 || argc > 5) {
+        printUsage();
+        return 1;
+    }
+    try {
+        std::auto_ptr<ThermoPhase> thermo(newPhase(argv[1], argv[2]));
+        std::vector<ThermoPhase*> phases(1, thermo.get());
+        std::auto_ptr<Kinetics> kin(newKineticsMgr(thermo->xml(), phases));
+        std::auto_ptr<Transport> tran;
+        if (argc == 5) {
+            tran.reset(newTransportMgr(argv[4], thermo.get()));
+        }
+        writeBinaryMechanism(argv[3], *thermo, kin.get(), tran.get());
+        std::cout << "Wrote " << thermo->nSpecies() << " species and "
+                  << kin->nReactions() << " reactions to " << argv[3]
+                  << std::endl;
+    } catch (CanteraError& err) {
+        std::cerr << err.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
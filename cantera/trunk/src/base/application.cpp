@@ -257,7 +257,16 @@ XML_Node* Application::get_XML_File(const std::string& file, int debug)
         ext = "";
     }
     XML_Node* x = new XML_Node("doc");
-    if (ext != ".xml" && ext != ".ctml") {
+    if (ext == ".ctb") {
+        // Pre-parsed binary CTML file written by XML_Node::writeBinary
+        std::ifstream s(path.c_str(), std::ios::binary);
+        if (s) {
+            x->buildBinary(s);
+        } else {
+            throw CanteraError("get_XML_File",
+                "cannot open "+file+" for reading.");
+        }
+    } else if (ext != ".xml" && ext != ".ctml") {
         // Assume that we are trying to open a cti file. Do the conversion to XML.
         std::stringstream phase_xml(ctml::ct2ctml_string(path));
         x->build(phase_xml);
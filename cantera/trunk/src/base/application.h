@@ -295,6 +295,10 @@ public:
      *  file has already been processed, then just the pointer will
      *  be returned.
      *
+     *  Files with the extension ".ctb" are binary CTML files written by
+     *  XML_Node::writeBinary(), which are loaded without parsing XML text
+     *  or converting CTI input.
+     *
      * @param file String containing the relative or absolute file name
      * @param debug Debug flag
      */
@@ -796,6 +796,116 @@ void XML_Node::build(std::istream& f)
     }
 }
 
+//! Identifier written at the start of binary CTML files
+static const char binaryCtmlHeader[8] = {'C', 'T', 'M', 'L', 'B', 'I', 'N', '1'};
+
+//! Write an unsigned 32-bit integer in little-endian byte order
+static void writeBinaryInt(std::ostream& s, size_t n)
+{
+    char b[4];
+    for (int i = 0; i < 4; i++) {
+        b[i] = static_cast<char>((n >> (8*i)) & 0xff);
+    }
+    s.write(b, 4);
+}
+
+static void writeBinaryString(std::ostream& s, const std::string& str)
+{
+    writeBinaryInt(s, str.size());
+    s.write(str.data(), str.size());
+}
+
+//! Write the name, value, line number, attributes and children of a node
+static void writeBinaryNode(std::ostream& s, const XML_Node& node)
+{
+    writeBinaryString(s, node.name());
+    writeBinaryString(s, node.value());
+    writeBinaryInt(s, node.lineNumber());
+    const map<string, string>& attribs = node.attribsConst();
+    writeBinaryInt(s, attribs.size());
+    for (map<string, string>::const_iterator iter = attribs.begin();
+         iter != attribs.end(); ++iter) {
+        writeBinaryString(s, iter->first);
+        writeBinaryString(s, iter->second);
+    }
+    const vector<XML_Node*>& children = node.children();
+    writeBinaryInt(s, children.size());
+    for (size_t i = 0; i < children.size(); i++) {
+        writeBinaryNode(s, *children[i]);
+    }
+}
+
+//! Sequential reader for the contents of a binary CTML file
+class BinaryCtmlReader
+{
+public:
+    BinaryCtmlReader(const std::string& buf, size_t pos) : m_buf(buf), m_pos(pos) {}
+
+    size_t readInt() {
+        require(4);
+        size_t n = 0;
+        for (int i = 0; i < 4; i++) {
+            n |= static_cast<size_t>(static_cast<unsigned char>(m_buf[m_pos+i])) << (8*i);
+        }
+        m_pos += 4;
+        return n;
+    }
+
+    std::string readString() {
+        size_t n = readInt();
+        require(n);
+        m_pos += n;
+        return m_buf.substr(m_pos - n, n);
+    }
+
+    //! Read the contents of a node written by writeBinaryNode()
+    void readNode(XML_Node& node) {
+        node.addValue(readString());
+        node.setLineNumber(static_cast<int>(readInt()));
+        size_t nAttribs = readInt();
+        for (size_t i = 0; i < nAttribs; i++) {
+            string key = readString();
+            node.addAttribute(key, readString());
+        }
+        size_t nChildren = readInt();
+        for (size_t i = 0; i < nChildren; i++) {
+            readNode(node.addChild(readString()));
+        }
+    }
+
+private:
+    void require(size_t n) {
+        if (m_pos + n > m_buf.size()) {
+            throw CanteraError("XML_Node::buildBinary",
+                               "Unexpected end of binary CTML data");
+        }
+    }
+
+    const std::string& m_buf;
+    size_t m_pos;
+};
+
+void XML_Node::buildBinary(std::istream& f)
+{
+    std::stringstream contents;
+    contents << f.rdbuf();
+    const std::string buf = contents.str();
+    if (buf.compare(0, sizeof(binaryCtmlHeader),
+                    string(binaryCtmlHeader, sizeof(binaryCtmlHeader))) != 0) {
+        throw CanteraError("XML_Node::buildBinary",
+                           "Input is not a binary CTML file");
+    }
+    BinaryCtmlReader r(buf, sizeof(binaryCtmlHeader));
+    setName(r.readString());
+    r.readNode(*this);
+}
+
+void XML_Node::writeBinary(std::ostream& s) const
+{
+    s.write(binaryCtmlHeader, sizeof(binaryCtmlHeader));
+    writeBinaryNode(s, *this);
+}
+
 void XML_Node::copyUnion(XML_Node* const node_dest) const
 {
     XML_Node* sc, *dc;
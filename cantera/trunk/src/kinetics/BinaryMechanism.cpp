@@ -0,0 +1,789 @@
+/**
+ *  @file BinaryMechanism.cpp
+ *   Definitions of global routines for saving fully constructed phase,
+ *   kinetics and transport managers to a binary file and creating them
+ *   again from that file (see \ref inputfiles).
+ */
+
+#include "cantera/kinetics/BinaryMechanism.h"
+#include "cantera/kinetics/GasKinetics.h"
+#include "cantera/kinetics/Reaction.h"
+#include "cantera/thermo/IdealGasPhase.h"
+#include "cantera/thermo/Species.h"
+#include "cantera/thermo/GeneralSpeciesThermo.h"
+#include "cantera/thermo/NasaPoly1.h"
+#include "cantera/thermo/NasaPoly2.h"
+#include "cantera/thermo/ShomatePoly.h"
+#include "cantera/thermo/ConstCpPoly.h"
+#include "cantera/thermo/SpeciesThermoFactory.h"
+#include "cantera/transport/MixTransport.h"
+#include "cantera/transport/MultiTransport.h"
+#include "cantera/transport/TransportData.h"
+#include "cantera/base/stringUtils.h"
+
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace Cantera
+{
+
+//! Format version of binary mechanism files
+static const int binaryMechanismVersion = 1;
+
+//! Value used to detect files written with a different byte order
+static const int binaryMechanismByteOrder = 0x01020304;
+
+//! Fixed-size header at the start of a binary mechanism file. It is followed
+//! by #nDoubles doubles, #nInts ints and #nChars characters. The size of the
+//! header is a multiple of 8 bytes, so the doubles are aligned in a memory
+//! mapped file.
+struct BinaryMechanismHeader {
+    char magic[8]; //!< "CTBMECH1"
+    int byteOrder; //!< #binaryMechanismByteOrder
+    int version; //!< #binaryMechanismVersion
+    int sizeofInt;
+    int sizeofDouble;
+    int nDoubles;
+    int nInts;
+    int nChars;
+    int reserved;
+};
+
+static const char binaryMechanismMagic[8] = {'C','T','B','M','E','C','H','1'};
+
+//! Bits of the flags stored for each reaction
+static const int ReversibleFlag = 1;
+static const int DuplicateFlag = 2;
+static const int NonreactantOrdersFlag = 4;
+static const int NegativeOrdersFlag = 8;
+static const int NegativeAFlag = 16;
+
+//! Collects the contents of a binary mechanism file. Strings are stored as
+//! their length in the int array followed by their characters in the
+//! character array.
+class BinaryMechanismWriter
+{
+public:
+    void addDouble(double x) {
+        m_doubles.push_back(x);
+    }
+
+    void addInt(int n) {
+        m_ints.push_back(n);
+    }
+
+    void addSize(size_t n) {
+        if (n > 0x7fffffff) {
+            throw CanteraError("writeBinaryMechanism",
+                               "Array too large for a binary mechanism file");
+        }
+        m_ints.push_back(static_cast<int>(n));
+    }
+
+    void addString(const std::string& s) {
+        addSize(s.size());
+        m_chars += s;
+    }
+
+    void addComposition(const Composition& c) {
+        addSize(c.size());
+        for (Composition::const_iterator iter = c.begin(); iter != c.end();
+             ++iter) {
+            addString(iter->first);
+            addDouble(iter->second);
+        }
+    }
+
+    void addArrhenius(const Arrhenius& rate) {
+        addDouble(rate.preExponentialFactor());
+        addDouble(rate.temperatureExponent());
+        addDouble(rate.activationEnergy_R());
+    }
+
+    void write(const std::string& file) {
+        BinaryMechanismHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, binaryMechanismMagic, sizeof(h.magic));
+        h.byteOrder = binaryMechanismByteOrder;
+        h.version = binaryMechanismVersion;
+        h.sizeofInt = sizeof(int);
+        h.sizeofDouble = sizeof(double);
+        h.nDoubles = checkedInt(m_doubles.size());
+        h.nInts = checkedInt(m_ints.size());
+        h.nChars = checkedInt(m_chars.size());
+
+        std::ofstream out(file.c_str(), std::ios::binary);
+        if (!out) {
+            throw CanteraError("writeBinaryMechanism",
+                               "Unable to open file '" + file + "'");
+        }
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        if (!m_doubles.empty()) {
+            out.write(reinterpret_cast<const char*>(&m_doubles[0]),
+                      m_doubles.size() * sizeof(double));
+        }
+        if (!m_ints.empty()) {
+            out.write(reinterpret_cast<const char*>(&m_ints[0]),
+                      m_ints.size() * sizeof(int));
+        }
+        out.write(m_chars.data(), m_chars.size());
+        if (!out) {
+            throw CanteraError("writeBinaryMechanism",
+                               "Error writing file '" + file + "'");
+        }
+    }
+
+private:
+    int checkedInt(size_t n) {
+        if (n > 0x7fffffff) {
+            throw CanteraError("writeBinaryMechanism",
+                               "Mechanism too large for a binary mechanism file");
+        }
+        return static_cast<int>(n);
+    }
+
+    vector_fp m_doubles;
+    vector_int m_ints;
+    std::string m_chars;
+};
+
+//! Sequential reader for the arrays of a binary mechanism file, which reads
+//! them in place
+class BinaryMechanismReader
+{
+public:
+    BinaryMechanismReader(const char* buf, size_t size, const std::string& file)
+        : m_doubles(0), m_ints(0), m_chars(0)
+        , m_nDoubles(0), m_nInts(0), m_nChars(0)
+        , m_iDouble(0), m_iInt(0), m_iChar(0)
+    {
+        BinaryMechanismHeader h;
+        if (size < sizeof(h)) {
+            throw CanteraError("readBinaryMechanism",
+                               "'" + file + "' is not a binary mechanism file");
+        }
+        memcpy(&h, buf, sizeof(h));
+        if (memcmp(h.magic, binaryMechanismMagic, sizeof(h.magic)) != 0) {
+            throw CanteraError("readBinaryMechanism",
+                               "'" + file + "' is not a binary mechanism file");
+        }
+        if (h.byteOrder != binaryMechanismByteOrder ||
+            h.sizeofInt != sizeof(int) || h.sizeofDouble != sizeof(double)) {
+            throw CanteraError("readBinaryMechanism", "'" + file + "' was "
+                               "written on a platform with a different byte "
+                               "order or data sizes");
+        }
+        if (h.version != binaryMechanismVersion) {
+            throw CanteraError("readBinaryMechanism", "'" + file + "' has "
+                               "unsupported format version " + int2str(h.version));
+        }
+        if (h.nDoubles < 0 || h.nInts < 0 || h.nChars < 0 ||
+            size != sizeof(h) + h.nDoubles * sizeof(double) +
+                    h.nInts * sizeof(int) + h.nChars) {
+            throw CanteraError("readBinaryMechanism",
+                               "'" + file + "' is truncated or corrupt");
+        }
+        m_nDoubles = h.nDoubles;
+        m_nInts = h.nInts;
+        m_nChars = h.nChars;
+        m_doubles = reinterpret_cast<const double*>(buf + sizeof(h));
+        m_ints = reinterpret_cast<const int*>(m_doubles + m_nDoubles);
+        m_chars = reinterpret_cast<const char*>(m_ints + m_nInts);
+    }
+
+    double readDouble() {
+        return *readDoubles(1);
+    }
+
+    //! Pointer to the next `n` doubles, which remain valid while the file
+    //! is open
+    const double* readDoubles(size_t n) {
+        if (m_iDouble + n > m_nDoubles) {
+            truncated();
+        }
+        m_iDouble += n;
+        return m_doubles + m_iDouble - n;
+    }
+
+    int readInt() {
+        if (m_iInt + 1 > m_nInts) {
+            truncated();
+        }
+        return m_ints[m_iInt++];
+    }
+
+    //! Pointer to the next `n` ints
+    const int* readInts(size_t n) {
+        if (m_iInt + n > m_nInts) {
+            truncated();
+        }
+        m_iInt += n;
+        return m_ints + m_iInt - n;
+    }
+
+    size_t readSize() {
+        int n = readInt();
+        if (n < 0) {
+            truncated();
+        }
+        return static_cast<size_t>(n);
+    }
+
+    std::string readString() {
+        size_t n = readSize();
+        if (m_iChar + n > m_nChars) {
+            truncated();
+        }
+        m_iChar += n;
+        return std::string(m_chars + m_iChar - n, n);
+    }
+
+    Composition readComposition() {
+        Composition c;
+        size_t n = readSize();
+        for (size_t i = 0; i < n; i++) {
+            std::string name = readString();
+            c[name] = readDouble();
+        }
+        return c;
+    }
+
+    Arrhenius readArrhenius() {
+        const double* p = readDoubles(3);
+        return Arrhenius(p[0], p[1], p[2]);
+    }
+
+    //! True if all of the data has been read
+    bool finished() const {
+        return m_iDouble == m_nDoubles && m_iInt == m_nInts &&
+               m_iChar == m_nChars;
+    }
+
+private:
+    void truncated() {
+        throw CanteraError("readBinaryMechanism",
+                           "Unexpected end of binary mechanism data");
+    }
+
+    const double* m_doubles;
+    const int* m_ints;
+    const char* m_chars;
+    size_t m_nDoubles, m_nInts, m_nChars;
+    size_t m_iDouble, m_iInt, m_iChar;
+};
+
+//! Read-only contents of a file, which are memory mapped if possible and
+//! otherwise read into a buffer aligned for doubles
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& path) : m_data(0), m_size(0),
+        m_mapped(false)
+    {
+#ifndef _WIN32
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            struct stat st;
+            if (fstat(fd, &st) == 0 && st.st_size > 0) {
+                void* p = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED) {
+                    m_data = static_cast<const char*>(p);
+                    m_size = st.st_size;
+                    m_mapped = true;
+                }
+            }
+            close(fd);
+        }
+        if (m_mapped) {
+            return;
+        }
+#endif
+        std::ifstream in(path.c_str(), std::ios::binary);
+        if (!in) {
+            throw CanteraError("readBinaryMechanism",
+                               "Unable to open file '" + path + "'");
+        }
+        in.seekg(0, std::ios::end);
+        m_size = static_cast<size_t>(in.tellg());
+        in.seekg(0, std::ios::beg);
+        m_buffer.resize(m_size / sizeof(double) + 1);
+        in.read(reinterpret_cast<char*>(&m_buffer[0]), m_size);
+        if (!in) {
+            throw CanteraError("readBinaryMechanism",
+                               "Error reading file '" + path + "'");
+        }
+        m_data = reinterpret_cast<const char*>(&m_buffer[0]);
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (m_mapped) {
+            munmap(const_cast<char*>(m_data), m_size);
+        }
+#endif
+    }
+
+    const char* data() const {
+        return m_data;
+    }
+
+    size_t size() const {
+        return m_size;
+    }
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    const char* m_data;
+    size_t m_size;
+    bool m_mapped;
+    vector_fp m_buffer;
+};
+
+//! Get the parameters of a species standard state parameterization in the
+//! form accepted by newSpeciesThermoInterpType()
+static void getThermoParameters(const SpeciesThermoInterpType& st, int& type,
+                                double& tlow, double& thigh, double& pref,
+                                vector_fp& coeffs)
+{
+    // ShomatePoly and ShomatePoly2 report the same type, so the class is
+    // used to determine the parameterization
+    if (dynamic_cast<const NasaPoly1*>(&st)) {
+        type = NASA1;
+        coeffs.resize(7);
+    } else if (dynamic_cast<const NasaPoly2*>(&st)) {
+        type = NASA2;
+        coeffs.resize(15);
+    } else if (dynamic_cast<const ShomatePoly*>(&st)) {
+        type = SHOMATE1;
+        coeffs.resize(7);
+    } else if (dynamic_cast<const ShomatePoly2*>(&st)) {
+        type = SHOMATE2;
+        coeffs.resize(15);
+    } else if (dynamic_cast<const ConstCpPoly*>(&st)) {
+        type = CONSTANT_CP;
+        coeffs.resize(4);
+    } else {
+        throw CanteraError("writeBinaryMechanism", "Unsupported species "
+                           "thermo type " + int2str(st.reportType()));
+    }
+    size_t index;
+    int reportedType;
+    st.reportParameters(index, reportedType, tlow, thigh, pref, &coeffs[0]);
+}
+
+static void writeThirdBody(BinaryMechanismWriter& w, const ThirdBody& tb)
+{
+    w.addDouble(tb.default_efficiency);
+    w.addComposition(tb.efficiencies);
+}
+
+static void readThirdBody(BinaryMechanismReader& r, ThirdBody& tb)
+{
+    tb.default_efficiency = r.readDouble();
+    tb.efficiencies = r.readComposition();
+}
+
+static void writeReaction(BinaryMechanismWriter& w, const Reaction& R)
+{
+    int type = R.reaction_type;
+    const ElementaryReaction* er = dynamic_cast<const ElementaryReaction*>(&R);
+    const ThirdBodyReaction* tr = dynamic_cast<const ThirdBodyReaction*>(&R);
+    const FalloffReaction* fr = dynamic_cast<const FalloffReaction*>(&R);
+    const PlogReaction* pr = dynamic_cast<const PlogReaction*>(&R);
+    const ChebyshevReaction* cr = dynamic_cast<const ChebyshevReaction*>(&R);
+    bool ok = (type == ELEMENTARY_RXN && er && !tr) ||
+              (type == THREE_BODY_RXN && tr) ||
+              ((type == FALLOFF_RXN || type == CHEMACT_RXN) && fr) ||
+              (type == PLOG_RXN && pr) || (type == CHEBYSHEV_RXN && cr);
+    if (!ok) {
+        throw CanteraError("writeBinaryMechanism", "Unsupported reaction "
+                           "type " + int2str(type) + " for reaction '" +
+                           R.equation() + "'");
+    }
+
+    int flags = 0;
+    if (R.reversible) {
+        flags |= ReversibleFlag;
+    }
+    if (R.duplicate) {
+        flags |= DuplicateFlag;
+    }
+    if (R.allow_nonreactant_orders) {
+        flags |= NonreactantOrdersFlag;
+    }
+    if (R.allow_negative_orders) {
+        flags |= NegativeOrdersFlag;
+    }
+    if (er && er->allow_negative_pre_exponential_factor) {
+        flags |= NegativeAFlag;
+    }
+    w.addInt(type);
+    w.addInt(flags);
+    w.addString(R.id);
+    w.addComposition(R.reactants);
+    w.addComposition(R.products);
+    w.addComposition(R.orders);
+
+    if (er) {
+        w.addArrhenius(er->rate);
+        if (tr) {
+            writeThirdBody(w, tr->third_body);
+        }
+    } else if (fr) {
+        w.addArrhenius(fr->low_rate);
+        w.addArrhenius(fr->high_rate);
+        writeThirdBody(w, fr->third_body);
+        w.addInt(fr->falloff_type);
+        w.addSize(fr->falloff_parameters.size());
+        for (size_t i = 0; i < fr->falloff_parameters.size(); i++) {
+            w.addDouble(fr->falloff_parameters[i]);
+        }
+    } else if (pr) {
+        std::vector<std::pair<double, Arrhenius> > rates = pr->rate.rates();
+        w.addSize(rates.size());
+        for (size_t i = 0; i < rates.size(); i++) {
+            w.addDouble(rates[i].first);
+            w.addArrhenius(rates[i].second);
+        }
+    } else {
+        const ChebyshevRate& rate = cr->rate;
+        w.addDouble(rate.Tmin());
+        w.addDouble(rate.Tmax());
+        w.addDouble(rate.Pmin());
+        w.addDouble(rate.Pmax());
+        w.addSize(rate.nTemperature());
+        w.addSize(rate.nPressure());
+        const vector_fp& coeffs = rate.coeffs();
+        for (size_t i = 0; i < coeffs.size(); i++) {
+            w.addDouble(coeffs[i]);
+        }
+    }
+}
+
+static shared_ptr<Reaction> readReaction(BinaryMechanismReader& r)
+{
+    int type = r.readInt();
+    int flags = r.readInt();
+    shared_ptr<Reaction> R;
+    if (type == ELEMENTARY_RXN || type == THREE_BODY_RXN) {
+        ElementaryReaction* er;
+        if (type == ELEMENTARY_RXN) {
+            er = new ElementaryReaction();
+        } else {
+            er = new ThirdBodyReaction();
+        }
+        R.reset(er);
+        er->allow_negative_pre_exponential_factor = (flags & NegativeAFlag);
+    } else if (type == FALLOFF_RXN) {
+        R.reset(new FalloffReaction());
+    } else if (type == CHEMACT_RXN) {
+        R.reset(new ChemicallyActivatedReaction());
+    } else if (type == PLOG_RXN) {
+        R.reset(new PlogReaction());
+    } else if (type == CHEBYSHEV_RXN) {
+        R.reset(new ChebyshevReaction());
+    } else {
+        throw CanteraError("readBinaryMechanism",
+                           "Unknown reaction type " + int2str(type));
+    }
+    R->reversible = (flags & ReversibleFlag);
+    R->duplicate = (flags & DuplicateFlag);
+    R->allow_nonreactant_orders = (flags & NonreactantOrdersFlag);
+    R->allow_negative_orders = (flags & NegativeOrdersFlag);
+    R->id = r.readString();
+    R->reactants = r.readComposition();
+    R->products = r.readComposition();
+    R->orders = r.readComposition();
+
+    if (type == ELEMENTARY_RXN || type == THREE_BODY_RXN) {
+        ElementaryReaction& er = dynamic_cast<ElementaryReaction&>(*R);
+        er.rate = r.readArrhenius();
+        if (type == THREE_BODY_RXN) {
+            readThirdBody(r, dynamic_cast<ThirdBodyReaction&>(*R).third_body);
+        }
+    } else if (type == FALLOFF_RXN || type == CHEMACT_RXN) {
+        FalloffReaction& fr = dynamic_cast<FalloffReaction&>(*R);
+        fr.low_rate = r.readArrhenius();
+        fr.high_rate = r.readArrhenius();
+        readThirdBody(r, fr.third_body);
+        fr.falloff_type = r.readInt();
+        size_t n = r.readSize();
+        const double* params = r.readDoubles(n);
+        fr.falloff_parameters.assign(params, params + n);
+    } else if (type == PLOG_RXN) {
+        std::multimap<double, Arrhenius> rates;
+        size_t n = r.readSize();
+        for (size_t i = 0; i < n; i++) {
+            double P = r.readDouble();
+            rates.insert(std::make_pair(P, r.readArrhenius()));
+        }
+        dynamic_cast<PlogReaction&>(*R).rate = Plog(rates);
+    } else {
+        const double* lim = r.readDoubles(4);
+        size_t nT = r.readSize();
+        size_t nP = r.readSize();
+        const double* c = r.readDoubles(nT*nP);
+        Array2D coeffs(nT, nP);
+        for (size_t t = 0; t < nT; t++) {
+            for (size_t p = 0; p < nP; p++) {
+                coeffs(t,p) = c[nP*t + p];
+            }
+        }
+        dynamic_cast<ChebyshevReaction&>(*R).rate =
+            ChebyshevRate(lim[2], lim[3], lim[0], lim[1], coeffs);
+    }
+    return R;
+}
+
+void writeBinaryMechanism(const std::string& file, ThermoPhase& thermo,
+                          Kinetics* kin, Transport* tran)
+{
+    if (thermo.eosType() != cIdealGas) {
+        throw CanteraError("writeBinaryMechanism", "Only IdealGasPhase "
+                           "phases can be written to a binary mechanism file");
+    }
+    const GeneralSpeciesThermo* spthermo =
+        dynamic_cast<const GeneralSpeciesThermo*>(&thermo.speciesThermo());
+    if (!spthermo) {
+        throw CanteraError("writeBinaryMechanism",
+                           "Unsupported species thermo manager");
+    }
+    BinaryMechanismWriter w;
+
+    // phase
+    w.addString(thermo.id());
+    w.addString(thermo.name());
+    w.addSize(thermo.nDim());
+    w.addSize(thermo.nElements());
+    for (size_t m = 0; m < thermo.nElements(); m++) {
+        w.addString(thermo.elementName(m));
+        w.addDouble(thermo.atomicWeight(m));
+        w.addInt(thermo.atomicNumber(m));
+        w.addDouble(thermo.entropyElement298(m));
+        w.addInt(thermo.elementType(m));
+    }
+
+    // species
+    size_t nsp = thermo.nSpecies();
+    w.addSize(nsp);
+    vector_fp coeffs;
+    for (size_t k = 0; k < nsp; k++) {
+        const Species& s = thermo.species(thermo.speciesName(k));
+        w.addString(s.name);
+        w.addComposition(s.composition);
+        w.addDouble(s.charge);
+        w.addDouble(s.size);
+
+        int type;
+        double tlow, thigh, pref;
+        const SpeciesThermoInterpType* st = spthermo->speciesParameterization(k);
+        if (!st) {
+            throw CanteraError("writeBinaryMechanism",
+                               "No thermo for species " + s.name);
+        }
+        getThermoParameters(*st, type, tlow, thigh, pref, coeffs);
+        w.addInt(type);
+        w.addDouble(tlow);
+        w.addDouble(thigh);
+        w.addDouble(pref);
+        w.addSize(coeffs.size());
+        for (size_t i = 0; i < coeffs.size(); i++) {
+            w.addDouble(coeffs[i]);
+        }
+
+        const GasTransportData* tr =
+            dynamic_cast<const GasTransportData*>(s.transport.get());
+        w.addInt(tr != 0);
+        if (tr) {
+            w.addString(tr->geometry);
+            w.addDouble(tr->diameter);
+            w.addDouble(tr->well_depth);
+            w.addDouble(tr->dipole);
+            w.addDouble(tr->polarizability);
+            w.addDouble(tr->rotational_relaxation);
+            w.addDouble(tr->acentric_factor);
+        }
+    }
+
+    // state
+    w.addDouble(thermo.temperature());
+    w.addDouble(thermo.density());
+    const double* Y = thermo.massFractions();
+    for (size_t k = 0; k < nsp; k++) {
+        w.addDouble(Y[k]);
+    }
+
+    // kinetics
+    w.addInt(kin != 0);
+    if (kin) {
+        if (kin->type() != cGasKinetics || kin->nPhases() != 1 ||
+            &kin->thermo(0) != &thermo) {
+            throw CanteraError("writeBinaryMechanism", "Only GasKinetics "
+                               "managers for the given phase can be written "
+                               "to a binary mechanism file");
+        }
+        w.addSize(kin->nReactions());
+        for (size_t i = 0; i < kin->nReactions(); i++) {
+            writeReaction(w, *kin->reaction(i));
+        }
+    }
+
+    // transport
+    w.addInt(tran != 0);
+    if (tran) {
+        GasTransport* gtr = dynamic_cast<GasTransport*>(tran);
+        int model = tran->model();
+        if (!gtr || &tran->thermo() != &thermo ||
+            (model != cMixtureAveraged && model != CK_MixtureAveraged &&
+             model != cMulticomponent && model != CK_Multicomponent)) {
+            throw CanteraError("writeBinaryMechanism", "Only mixture-averaged "
+                               "and multicomponent transport managers for "
+                               "the given phase can be written to a binary "
+                               "mechanism file");
+        }
+        vector_int fitIndex;
+        vector_fp fitCoeffs;
+        gtr->getFits(fitIndex, fitCoeffs);
+        w.addInt(model);
+        w.addSize(fitIndex.size());
+        for (size_t i = 0; i < fitIndex.size(); i++) {
+            w.addInt(fitIndex[i]);
+        }
+        w.addSize(fitCoeffs.size());
+        for (size_t i = 0; i < fitCoeffs.size(); i++) {
+            w.addDouble(fitCoeffs[i]);
+        }
+    }
+    w.write(file);
+}
+
+void readBinaryMechanism(const std::string& file, ThermoPhase*& thermo,
+                         Kinetics*& kin, Transport*& tran)
+{
+    std::string path = findInputFile(file);
+    MappedFile mapped(path);
+    BinaryMechanismReader r(mapped.data(), mapped.size(), path);
+    thermo = 0;
+    kin = 0;
+    tran = 0;
+    try {
+        // phase
+        thermo = new IdealGasPhase();
+        thermo->setID(r.readString());
+        thermo->setName(r.readString());
+        thermo->setNDim(r.readSize());
+        size_t nel = r.readSize();
+        for (size_t m = 0; m < nel; m++) {
+            std::string symbol = r.readString();
+            double weight = r.readDouble();
+            int atomicNumber = r.readInt();
+            double entropy298 = r.readDouble();
+            thermo->addElement(symbol, weight, atomicNumber, entropy298,
+                               r.readInt());
+        }
+
+        // species
+        size_t nsp = r.readSize();
+        for (size_t k = 0; k < nsp; k++) {
+            std::string name = r.readString();
+            Composition comp = r.readComposition();
+            double charge = r.readDouble();
+            double size = r.readDouble();
+            int type = r.readInt();
+            const double* lim = r.readDoubles(3);
+            size_t ncoeffs = r.readSize();
+            const double* coeffs = r.readDoubles(ncoeffs);
+            Species sp(name, comp,
+                       newSpeciesThermoInterpType(type, lim[0], lim[1], lim[2],
+                                                  coeffs),
+                       charge, size);
+            if (r.readInt()) {
+                GasTransportData* tr = new GasTransportData;
+                sp.transport.reset(tr);
+                tr->name = name;
+                tr->geometry = r.readString();
+                const double* p = r.readDoubles(6);
+                tr->diameter = p[0];
+                tr->well_depth = p[1];
+                tr->dipole = p[2];
+                tr->polarizability = p[3];
+                tr->rotational_relaxation = p[4];
+                tr->acentric_factor = p[5];
+            }
+            thermo->addSpecies(sp);
+        }
+        thermo->initThermo();
+
+        // state
+        double T = r.readDouble();
+        double rho = r.readDouble();
+        thermo->setMassFractions_NoNorm(r.readDoubles(nsp));
+        thermo->setTemperature(T);
+        thermo->setDensity(rho);
+        thermo->setReferenceComposition(0);
+
+        // kinetics
+        if (r.readInt()) {
+            kin = new GasKinetics();
+            kin->addPhase(*thermo);
+            kin->init();
+            size_t nrxn = r.readSize();
+            for (size_t i = 0; i < nrxn; i++) {
+                kin->addReaction(readReaction(r));
+            }
+            kin->finalize();
+        }
+
+        // transport
+        if (r.readInt()) {
+            int model = r.readInt();
+            size_t n = r.readSize();
+            const int* p = r.readInts(n);
+            vector_int fitIndex(p, p + n);
+            n = r.readSize();
+            const double* c = r.readDoubles(n);
+            vector_fp fitCoeffs(c, c + n);
+            if (fitIndex.empty()) {
+                throw CanteraError("readBinaryMechanism",
+                                   "Missing transport fit data");
+            }
+            GasTransport* gtr;
+            if (model == cMixtureAveraged || model == CK_MixtureAveraged) {
+                gtr = new MixTransport();
+            } else if (model == cMulticomponent || model == CK_Multicomponent) {
+                gtr = new MultiTransport();
+            } else {
+                throw CanteraError("readBinaryMechanism",
+                                   "Unknown transport model " + int2str(model));
+            }
+            tran = gtr;
+            gtr->setFits(fitIndex, fitCoeffs);
+            gtr->init(thermo, fitIndex[0]);
+        }
+        if (!r.finished()) {
+            throw CanteraError("readBinaryMechanism",
+                               "Unexpected data at the end of '" + path + "'");
+        }
+    } catch (...) {
+        delete tran;
+        delete kin;
+        delete thermo;
+        thermo = 0;
+        kin = 0;
+        tran = 0;
+        throw;
+    }
+}
+
+}
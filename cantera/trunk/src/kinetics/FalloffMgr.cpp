@@ -0,0 +1,219 @@
+/**
+ *  @file FalloffMgr.cpp
+ */
+
+#include "cantera/kinetics/FalloffMgr.h"
+#include "cantera/kinetics/Falloff.h"
+
+namespace Cantera
+{
+
+size_t FalloffMgr::addToBatch(FalloffBatch& b, size_t rxn, int reactionType)
+{
+    b.rxn.push_back(rxn);
+    b.falloff.push_back(reactionType == FALLOFF_RXN ? 1.0 : 0.0);
+    return b.rxn.size() - 1;
+}
+
+void FalloffMgr::install(size_t rxn, int falloffType, int reactionType,
+                         const vector_fp& c)
+{
+    Falloff* f = m_factory->newFalloff(falloffType,c);
+    if (!f) {
+        throw CanteraError("FalloffMgr::install",
+                           "Unknown falloff type: " + int2str(falloffType));
+    }
+    if (falloffType == SIMPLE_FALLOFF) {
+        addToBatch(m_simple, rxn, reactionType);
+        delete f;
+    } else if (falloffType == TROE_FALLOFF) {
+        const Troe* troe = dynamic_cast<const Troe*>(f);
+        addToBatch(m_troe, rxn, reactionType);
+        m_troe.p0.push_back(troe->m_a);
+        m_troe.p1.push_back(troe->m_rt3);
+        m_troe.p2.push_back(troe->m_rt1);
+        m_troe.p3.push_back(troe->m_t2);
+        m_troe.p4.push_back(troe->m_t2 ? 1.0 : 0.0);
+        delete f;
+    } else if (falloffType == SRI_FALLOFF) {
+        const SRI* sri = dynamic_cast<const SRI*>(f);
+        addToBatch(m_sri, rxn, reactionType);
+        m_sri.p0.push_back(sri->m_a);
+        m_sri.p1.push_back(sri->m_b);
+        m_sri.p2.push_back(sri->m_c != 0.0 ? 1.0 / sri->m_c : 0.0);
+        m_sri.p3.push_back(sri->m_d);
+        m_sri.p4.push_back(sri->m_e);
+        m_sriHasC.push_back(sri->m_c != 0.0 ? 1.0 : 0.0);
+        delete f;
+    } else {
+        m_rxn.push_back(rxn);
+        m_offset.push_back(m_worksize);
+        m_worksize += f->workSize();
+        m_falloff.push_back(shared_ptr<Falloff>(f));
+        m_reactionType.push_back(reactionType);
+    }
+}
+
+void FalloffMgr::copyBatch(const FalloffBatch& b,
+                           const std::vector<bool>& include, FalloffBatch& out,
+                           std::vector<size_t>& index)
+{
+    out = FalloffBatch();
+    index.clear();
+    for (size_t j = 0; j < b.size(); j++) {
+        if (!include[b.rxn[j]]) {
+            continue;
+        }
+        index.push_back(j);
+        out.rxn.push_back(b.rxn[j]);
+        out.falloff.push_back(b.falloff[j]);
+        if (!b.p0.empty()) {
+            out.p0.push_back(b.p0[j]);
+            out.p1.push_back(b.p1[j]);
+            out.p2.push_back(b.p2[j]);
+            out.p3.push_back(b.p3[j]);
+            out.p4.push_back(b.p4[j]);
+        }
+    }
+}
+
+void FalloffMgr::getSubset(const std::vector<bool>& include,
+                           FalloffMgr& sub) const
+{
+    std::vector<size_t> index;
+    copyBatch(m_simple, include, sub.m_simple, index);
+    copyBatch(m_troe, include, sub.m_troe, index);
+    copyBatch(m_sri, include, sub.m_sri, index);
+    sub.m_sriHasC.clear();
+    for (size_t j = 0; j < index.size(); j++) {
+        sub.m_sriHasC.push_back(m_sriHasC[index[j]]);
+    }
+
+    sub.m_rxn.clear();
+    sub.m_offset.clear();
+    sub.m_falloff.clear();
+    sub.m_reactionType.clear();
+    sub.m_worksize = 0;
+    for (size_t i = 0; i < m_rxn.size(); i++) {
+        if (include[m_rxn[i]]) {
+            sub.m_rxn.push_back(m_rxn[i]);
+            sub.m_offset.push_back(sub.m_worksize);
+            sub.m_worksize += m_falloff[i]->workSize();
+            sub.m_falloff.push_back(m_falloff[i]);
+            sub.m_reactionType.push_back(m_reactionType[i]);
+        }
+    }
+}
+
+void FalloffMgr::updateTemp(doublereal t, doublereal* work)
+{
+    doublereal recipT = 1.0 / t;
+    doublereal logT = std::log(t);
+
+    // Troe: work[j] = log10(Fcent)
+    size_t nTroe = m_troe.size();
+    for (size_t j = 0; j < nTroe; j++) {
+        doublereal a = m_troe.p0[j];
+        doublereal Fcent = (1.0 - a) * exp(-t * m_troe.p1[j])
+                           + a * exp(-t * m_troe.p2[j])
+                           + m_troe.p4[j] * exp(-m_troe.p3[j] * recipT);
+        work[j] = log10(std::max(Fcent, SmallNumber));
+    }
+
+    // SRI: work[nTroe + j] = a exp(-b/T) + exp(-T/c), and
+    // work[nTroe + nSRI + j] = d T^e
+    size_t nSRI = m_sri.size();
+    doublereal* X = work + nTroe;
+    doublereal* Y = X + nSRI;
+    for (size_t j = 0; j < nSRI; j++) {
+        X[j] = m_sri.p0[j] * exp(-m_sri.p1[j] * recipT)
+               + m_sriHasC[j] * exp(-t * m_sri.p2[j]);
+        Y[j] = m_sri.p3[j] * exp(m_sri.p4[j] * logT);
+    }
+
+    doublereal* w = Y + nSRI;
+    for (size_t i = 0; i < m_rxn.size(); i++) {
+        m_falloff[i]->updateTemp(t, w + m_offset[i]);
+    }
+}
+
+void FalloffMgr::scatter(const FalloffBatch& b, const doublereal* pr,
+                         doublereal* F, doublereal* values) const
+{
+    size_t n = b.size();
+    for (size_t j = 0; j < n; j++) {
+        // Pr / (1 + Pr) * F for falloff reactions, and
+        // 1 / (1 + Pr) * F for chemically activated reactions
+        F[j] *= (b.falloff[j] * pr[j] + (1.0 - b.falloff[j])) / (1.0 + pr[j]);
+    }
+    for (size_t j = 0; j < n; j++) {
+        values[b.rxn[j]] = F[j];
+    }
+}
+
+void FalloffMgr::pr_to_falloff(doublereal* values, doublereal* work)
+{
+    // scratch space for the reduced pressures and falloff functions of the
+    // reactions in one batch
+    doublereal* pr = work + cacheSize();
+    doublereal* F = pr + std::max(m_simple.size(),
+                                  std::max(m_troe.size(), m_sri.size()));
+
+    // Lindemann
+    size_t n = m_simple.size();
+    for (size_t j = 0; j < n; j++) {
+        pr[j] = values[m_simple.rxn[j]];
+        F[j] = 1.0;
+    }
+    scatter(m_simple, pr, F, values);
+
+    // Troe
+    n = m_troe.size();
+    for (size_t j = 0; j < n; j++) {
+        pr[j] = values[m_troe.rxn[j]];
+    }
+    for (size_t j = 0; j < n; j++) {
+        doublereal logFcent = work[j];
+        doublereal lpr = log10(std::max(pr[j], SmallNumber));
+        doublereal cc = -0.4 - 0.67 * logFcent;
+        doublereal nn = 0.75 - 1.27 * logFcent;
+        doublereal f1 = (lpr + cc) / (nn - 0.14 * (lpr + cc));
+        F[j] = logFcent / (1.0 + f1 * f1);
+    }
+    for (size_t j = 0; j < n; j++) {
+        F[j] = pow(10.0, F[j]);
+    }
+    scatter(m_troe, pr, F, values);
+
+    // SRI
+    size_t nTroe = n;
+    n = m_sri.size();
+    const doublereal* X = work + nTroe;
+    const doublereal* Y = X + n;
+    for (size_t j = 0; j < n; j++) {
+        pr[j] = values[m_sri.rxn[j]];
+    }
+    for (size_t j = 0; j < n; j++) {
+        doublereal lpr = log10(std::max(pr[j], SmallNumber));
+        doublereal xx = 1.0 / (1.0 + lpr * lpr);
+        F[j] = pow(X[j], xx) * Y[j];
+    }
+    scatter(m_sri, pr, F, values);
+
+    // Other falloff functions
+    const doublereal* w = Y + n;
+    for (size_t i = 0; i < m_rxn.size(); i++) {
+        double pr = values[m_rxn[i]];
+        if (m_reactionType[i] == FALLOFF_RXN) {
+            // Pr / (1 + Pr) * F
+            values[m_rxn[i]] *=
+                m_falloff[i]->F(pr, w + m_offset[i]) /(1.0 + pr);
+        } else {
+            // 1 / (1 + Pr) * F
+            values[m_rxn[i]] =
+                m_falloff[i]->F(pr, w + m_offset[i]) /(1.0 + pr);
+        }
+    }
+}
+
+}
@@ -7,18 +7,32 @@
 // Copyright 2001  California Institute of Technology
 
 #include "cantera/kinetics/GasKinetics.h"
+#include "cantera/thermo/SpeciesThermo.h"
+#include "cantera/thermo/speciesThermoTypes.h"
+
+#include <set>
+#include <queue>
 
 using namespace std;
 
 namespace Cantera
 {
+
 GasKinetics::GasKinetics(thermo_t* thermo) :
     BulkKinetics(thermo),
     m_nfall(0),
     m_logp_ref(0.0),
     m_logc_ref(0.0),
     m_logStandConc(0.0),
-    m_pres(0.0)
+    m_pres(0.0),
+    m_thermo_C(0),
+    m_drgThreshold(0.0),
+    m_drgDeltaT(25.0),
+    m_drgDeltaLogX(0.5),
+    m_drgMaxMechanisms(1000),
+    m_drgClock(0),
+    m_activeReduced(npos),
+    m_drgAnalysis(false)
 {
 }
 
@@ -36,30 +50,61 @@ void GasKinetics::update_rates_T()
     m_logStandConc = log(thermo().standardConcentration());
     doublereal logT = log(T);
 
+    const ReducedMechanism* mech = (m_activeReduced == npos) ? 0 :
+                                   &m_reduced[m_activeReduced];
     if (T != m_temp) {
-        if (!m_rfn.empty()) {
-            m_rates.update(T, logT, &m_rfn[0]);
-        }
-
-        if (!m_rfn_low.empty()) {
-            m_falloff_low_rates.update(T, logT, &m_rfn_low[0]);
-            m_falloff_high_rates.update(T, logT, &m_rfn_high[0]);
+        if (m_rateTable.inRange(T)) {
+            if (mech) {
+                m_rateTable.interpolate(T, &m_rateTableWork[0],
+                                        mech->tableColumns);
+            } else {
+                m_rateTable.interpolate(T, &m_rateTableWork[0]);
+            }
+            packRates(&m_rateTableWork[0], true);
+            // find the table of equilibrium constants covering T
+            size_t lo = 0, hi = m_kcTables.size();
+            while (lo < hi) {
+                size_t mid = (lo + hi) / 2;
+                if (m_kcTables[mid].maxTemp() < T) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            if (lo < m_kcTables.size() && m_kcTables[lo].inRange(T)) {
+                if (mech) {
+                    m_kcTables[lo].interpolate(T, &m_rkcn[0], mech->revindex);
+                } else {
+                    m_kcTables[lo].interpolate(T, &m_rkcn[0]);
+                }
+            } else {
+                updateKc();
+            }
+        } else {
+            evalRates_T(T, logT);
         }
         if (!falloff_work.empty()) {
-            m_falloffn.updateTemp(T, &falloff_work[0]);
+            activeFalloff().updateTemp(T, &falloff_work[0]);
         }
-        updateKc();
         m_ROP_ok = false;
     }
 
     if (T != m_temp || P != m_pres) {
         if (m_plog_rates.nReactions()) {
-            m_plog_rates.update(T, logT, &m_rfn[0]);
+            if (mech) {
+                m_plog_rates.update(T, logT, &m_rfn[0], mech->plog);
+            } else {
+                m_plog_rates.update(T, logT, &m_rfn[0]);
+            }
             m_ROP_ok = false;
         }
 
         if (m_cheb_rates.nReactions()) {
-            m_cheb_rates.update(T, logT, &m_rfn[0]);
+            if (mech) {
+                m_cheb_rates.update(T, logT, &m_rfn[0], mech->cheb);
+            } else {
+                m_cheb_rates.update(T, logT, &m_rfn[0]);
+            }
             m_ROP_ok = false;
         }
     }
@@ -67,19 +112,201 @@ void GasKinetics::update_rates_T()
     m_temp = T;
 }
 
+void GasKinetics::evalRates_T(double T, double logT)
+{
+    if (m_activeReduced != npos) {
+        const ReducedMechanism& mech = m_reduced[m_activeReduced];
+        m_rates.update(T, logT, &m_rfn[0], mech.rates);
+        if (!mech.falloff.empty()) {
+            // the falloff rates are installed in the order of m_fallindx
+            m_falloff_low_rates.update(T, logT, &m_rfn_low[0], mech.falloff);
+            m_falloff_high_rates.update(T, logT, &m_rfn_high[0], mech.falloff);
+        }
+        updateKc();
+        return;
+    } else if (!m_rfn.empty()) {
+        m_rates.update(T, logT, &m_rfn[0]);
+    }
+
+    if (!m_rfn_low.empty()) {
+        m_falloff_low_rates.update(T, logT, &m_rfn_low[0]);
+        m_falloff_high_rates.update(T, logT, &m_rfn_high[0]);
+    }
+    updateKc();
+}
+
+void GasKinetics::packRates(double* values, bool unpack)
+{
+    double* rfn = values;
+    double* rfn_low = rfn + m_ii;
+    double* rfn_high = rfn_low + m_nfall;
+    if (unpack) {
+        copy(rfn, rfn_low, m_rfn.begin());
+        copy(rfn_low, rfn_high, m_rfn_low.begin());
+        copy(rfn_high, rfn_high + m_nfall, m_rfn_high.begin());
+    } else {
+        copy(m_rfn.begin(), m_rfn.begin() + m_ii, rfn);
+        copy(m_rfn_low.begin(), m_rfn_low.end(), rfn_low);
+        copy(m_rfn_high.begin(), m_rfn_high.end(), rfn_high);
+    }
+}
+
+void GasKinetics::setRateTabulation(double Tmin, double Tmax, double rtol)
+{
+    // The standard state thermodynamic properties, and therefore the
+    // equilibrium constants, have discontinuous derivatives at the midpoint
+    // temperatures of two-region polynomial fits. Use a separate table of
+    // the equilibrium constants for each temperature range between these
+    // points, so that the interpolation stencils don't span the
+    // discontinuities.
+    std::set<double> breaks;
+    breaks.insert(Tmin);
+    breaks.insert(Tmax);
+    SpeciesThermo& spthermo = thermo().speciesThermo();
+    vector_fp c(500);
+    for (size_t k = 0; k < thermo().nSpecies(); k++) {
+        int type = spthermo.reportType(k);
+        if (type == NASA2 || type == SHOMATE2) {
+            double minT, maxT, pref;
+            spthermo.reportParams(k, type, &c[0], minT, maxT, pref);
+            if (c[0] > Tmin && c[0] < Tmax) {
+                breaks.insert(c[0]);
+            }
+        }
+    }
+
+    // tabulate the rates for the full mechanism
+    activateReducedMechanism(npos);
+    clearRateTabulation();
+    m_rateTableWork.resize(m_ii + 2 * m_nfall);
+    vector_fp state;
+    thermo().saveState(state);
+    try {
+        buildRateTable(m_rateTable, Tmin, Tmax, rtol, false, 65);
+
+        // Start each table of equilibrium constants with about the same
+        // spacing as the initial table of rate constants, so that narrow
+        // intervals between midpoint temperatures use few points.
+        m_kcTables.resize(breaks.size() - 1);
+        std::set<double>::const_iterator iter = breaks.begin();
+        for (size_t n = 0; n < m_kcTables.size(); n++) {
+            double T0 = *iter;
+            double T1 = *(++iter);
+            double frac = (1.0 / T0 - 1.0 / T1) / (1.0 / Tmin - 1.0 / Tmax);
+            size_t nPoints = std::max(RateTable::InterpolationPoints,
+                static_cast<size_t>(64 * frac) + 1);
+            buildRateTable(m_kcTables[n], T0, T1, rtol, true, nPoints);
+        }
+    } catch (CanteraError&) {
+        thermo().restoreState(state);
+        clearRateTabulation();
+        throw;
+    }
+
+    thermo().restoreState(state);
+    // force the rates to be re-evaluated at the current state
+    m_temp = 0.0;
+}
+
+void GasKinetics::buildRateTable(RateTable& table, double T0, double T1,
+                                 double rtol, bool kc, size_t nPoints)
+{
+    size_t ncols = (kc) ? m_ii : m_ii + 2 * m_nfall;
+    vector_fp exact(ncols), approx(ncols);
+    while (true) {
+        table.setup(ncols, nPoints, T0, T1);
+        for (size_t j = 0; j < nPoints; j++) {
+            // The polynomial fits are not exactly continuous, so evaluate
+            // the end points of the equilibrium constant tables just inside
+            // the interval, using the fits for this interval.
+            double T = table.temperature(j);
+            if (kc && j == 0) {
+                T *= 1.0 - 1e-12;
+            } else if (kc && j == nPoints - 1) {
+                T *= 1.0 + 1e-12;
+            }
+            thermo().setTemperature(T);
+            m_logStandConc = log(thermo().standardConcentration());
+            evalRates_T(T, log(T));
+            if (kc) {
+                copy(m_rkcn.begin(), m_rkcn.begin() + m_ii, exact.begin());
+            } else {
+                packRates(&exact[0], false);
+            }
+            table.setValues(j, &exact[0]);
+        }
+
+        // Check the interpolation error midway between the tabulation points
+        double maxErr = 0.0;
+        for (size_t j = 0; j < nPoints - 1; j++) {
+            double T = 2.0 / (1.0 / table.temperature(j) +
+                              1.0 / table.temperature(j+1));
+            thermo().setTemperature(T);
+            m_logStandConc = log(thermo().standardConcentration());
+            evalRates_T(T, log(T));
+            if (kc) {
+                copy(m_rkcn.begin(), m_rkcn.begin() + m_ii, exact.begin());
+            } else {
+                packRates(&exact[0], false);
+            }
+            table.interpolate(T, &approx[0]);
+            for (size_t n = 0; n < ncols; n++) {
+                double err = std::abs(approx[n] - exact[n]);
+                if (err != 0.0) {
+                    maxErr = std::max(maxErr, err / std::abs(exact[n]));
+                }
+            }
+        }
+        if (maxErr <= rtol) {
+            return;
+        } else if (nPoints > 20000) {
+            throw CanteraError("GasKinetics::setRateTabulation",
+                "Unable to reach the requested tolerance between " +
+                fp2str(T0) + " K and " + fp2str(T1) + " K. Maximum "
+                "relative error is " + fp2str(maxErr) + " with " +
+                int2str(nPoints) + " points.");
+        }
+        nPoints = 2 * nPoints - 1;
+    }
+}
+
+void GasKinetics::clearRateTabulation()
+{
+    m_rateTable.clear();
+    m_kcTables.clear();
+    m_rateTableWork.clear();
+    m_temp = 0.0;
+}
+
 void GasKinetics::update_rates_C()
 {
+    const thermo_t& th = thermo();
+    if (m_thermo_C == &th && m_stateNum_C[0] == th.stateTNumber() &&
+        m_stateNum_C[1] == th.stateDNumber() &&
+        m_stateNum_C[2] == th.stateMFNumber()) {
+        return;
+    }
+    if (dynamicReduction() && !m_drgAnalysis) {
+        selectReducedMechanism();
+    }
+    m_thermo_C = &th;
+    m_stateNum_C[0] = th.stateTNumber();
+    m_stateNum_C[1] = th.stateDNumber();
+    m_stateNum_C[2] = th.stateMFNumber();
+
     thermo().getActivityConcentrations(&m_conc[0]);
     doublereal ctot = thermo().molarDensity();
 
-    // 3-body reactions
-    if (!concm_3b_values.empty()) {
-        m_3b_concm.update(m_conc, ctot, &concm_3b_values[0]);
-    }
-
-    // Falloff reactions
-    if (!concm_falloff_values.empty()) {
-        m_falloff_concm.update(m_conc, ctot, &concm_falloff_values[0]);
+    // Third-body concentrations for 3-body and falloff reactions
+    updateEfficiencies();
+    const ReducedMechanism* mech = (m_activeReduced == npos) ? 0 :
+                                   &m_reduced[m_activeReduced];
+    if (!m_concm.empty()) {
+        for (size_t i = 0; i < m_concm.size(); i++) {
+            m_concm[i] = m_defaultEfficiencies[i] * ctot;
+        }
+        const SparseMatrix& eff = (mech) ? mech->efficiencies : m_efficiencies;
+        eff.incrementMult(&m_conc[0], &m_concm[0]);
     }
 
     // P-log reactions
@@ -91,23 +318,53 @@ void GasKinetics::update_rates_C()
     // Chebyshev reactions
     if (m_cheb_rates.nReactions()) {
         double log10P = log10(thermo().pressure());
-        m_cheb_rates.update_C(&log10P);
+        if (mech) {
+            m_cheb_rates.update_C(&log10P, mech->cheb);
+        } else {
+            m_cheb_rates.update_C(&log10P);
+        }
     }
 
     m_ROP_ok = false;
 }
 
+void GasKinetics::updateEfficiencies()
+{
+    size_t n3b = m_3b_concm.workSize();
+    size_t nrows = n3b + m_falloff_concm.workSize();
+    if (m_efficiencies.nRows() == nrows && m_efficiencies.nColumns() == m_kk
+        && m_concm.size() == nrows) {
+        return;
+    }
+    SparseTripletList eff;
+    m_3b_concm.getEfficiencies(eff, 0);
+    m_falloff_concm.getEfficiencies(eff, n3b);
+    m_efficiencies.setFromTriplets(nrows, m_kk, eff);
+    m_defaultEfficiencies = m_3b_concm.defaultEfficiencies();
+    m_defaultEfficiencies.insert(m_defaultEfficiencies.end(),
+                                 m_falloff_concm.defaultEfficiencies().begin(),
+                                 m_falloff_concm.defaultEfficiencies().end());
+    m_concm.resize(nrows);
+}
+
 void GasKinetics::updateKc()
 {
     thermo().getStandardChemPotentials(&m_grt[0]);
-    fill(m_rkcn.begin(), m_rkcn.end(), 0.0);
 
-    // compute Delta G^0 for all reversible reactions
-    getRevReactionDelta(&m_grt[0], &m_rkcn[0]);
+    // compute Delta G^0 for all reversible reactions, or those of the
+    // active reduced mechanism
+    if (m_activeReduced == npos) {
+        fill(m_rkcn.begin(), m_rkcn.end(), 0.0);
+        getRevReactionDelta(&m_grt[0], &m_rkcn[0]);
+    } else {
+        m_reduced[m_activeReduced].stoichRevNetT.mult(&m_grt[0], &m_rkcn[0]);
+    }
 
+    const std::vector<size_t>& revindex = (m_activeReduced == npos) ?
+        m_revindex : m_reduced[m_activeReduced].revindex;
     doublereal rrt = 1.0/(GasConstant * thermo().temperature());
-    for (size_t i = 0; i < m_revindex.size(); i++) {
-        size_t irxn = m_revindex[i];
+    for (size_t i = 0; i < revindex.size(); i++) {
+        size_t irxn = revindex[i];
         m_rkcn[irxn] = std::min(exp(m_rkcn[irxn]*rrt - m_dn[irxn]*m_logStandConc),
                                 BigNumber);
     }
@@ -138,28 +395,34 @@ void GasKinetics::getEquilibriumConstants(doublereal* kc)
 
 void GasKinetics::processFalloffReactions()
 {
-    // use m_ropr for temporary storage of reduced pressure
-    vector_fp& pr = m_ropr;
-
-    for (size_t i = 0; i < m_nfall; i++) {
-        pr[i] = concm_falloff_values[i] * m_rfn_low[i] / (m_rfn_high[i] + SmallNumber);
+    m_falloffPr.resize(m_nfall);
+    vector_fp& pr = m_falloffPr;
+
+    // positions of the falloff reactions to evaluate, if not all of them
+    const std::vector<size_t>* index = (m_activeReduced == npos) ? 0 :
+                                       &m_reduced[m_activeReduced].falloff;
+    size_t nf = (index) ? index->size() : m_nfall;
+
+    size_t n3b = m_3b_concm.workSize();
+    for (size_t j = 0; j < nf; j++) {
+        size_t i = (index) ? (*index)[j] : j;
+        pr[i] = m_concm[n3b + i] * m_rfn_low[i] / (m_rfn_high[i] + SmallNumber);
         AssertFinite(pr[i], "GasKinetics::processFalloffReactions",
                      "pr[" + int2str(i) + "] is not finite.");
     }
 
     double* work = (falloff_work.empty()) ? 0 : &falloff_work[0];
-    m_falloffn.pr_to_falloff(&pr[0], work);
+    activeFalloff().pr_to_falloff(&pr[0], work);
 
-    for (size_t i = 0; i < m_nfall; i++) {
+    for (size_t j = 0; j < nf; j++) {
+        size_t i = (index) ? (*index)[j] : j;
         if (m_rxntype[m_fallindx[i]] == FALLOFF_RXN) {
             pr[i] *= m_rfn_high[i];
         } else { // CHEMACT_RXN
             pr[i] *= m_rfn_low[i];
         }
+        m_ropf[m_fallindx[i]] = pr[i];
     }
-
-    scatter_copy(pr.begin(), pr.begin() + m_nfall,
-                 m_ropf.begin(), m_fallindx.begin());
 }
 
 void GasKinetics::updateROP()
@@ -171,21 +434,27 @@ void GasKinetics::updateROP()
         return;
     }
 
-    // copy rate coefficients into ropf
-    copy(m_rfn.begin(), m_rfn.end(), m_ropf.begin());
+    updateFwdRateConstants();
 
-    // multiply ropf by enhanced 3b conc for all 3b rxns
-    if (!concm_3b_values.empty()) {
-        m_3b_concm.multiply(&m_ropf[0], &concm_3b_values[0]);
-    }
-
-    if (m_nfall) {
-        processFalloffReactions();
+    if (m_activeReduced != npos) {
+        // Only the entries for the included reactions are computed. The
+        // others were set to zero when the mechanism was activated.
+        const ReducedMechanism& mech = m_reduced[m_activeReduced];
+        const std::vector<size_t>& rxns = mech.reactions;
+        for (size_t j = 0; j < rxns.size(); j++) {
+            size_t i = rxns[j];
+            m_ropr[i] = m_ropf[i] * m_rkcn[i];
+        }
+        mech.reactantStoich.multiply(&m_conc[0], &m_ropf[0]);
+        mech.revProductStoich.multiply(&m_conc[0], &m_ropr[0]);
+        for (size_t j = 0; j < rxns.size(); j++) {
+            size_t i = rxns[j];
+            m_ropnet[i] = m_ropf[i] - m_ropr[i];
+        }
+        m_ROP_ok = true;
+        return;
     }
 
-    // multiply by perturbation factor
-    multiply_each(m_ropf.begin(), m_ropf.end(), m_perturb.begin());
-
     // copy the forward rates to the reverse rates
     copy(m_ropf.begin(), m_ropf.end(), m_ropr.begin());
 
@@ -215,17 +484,589 @@ void GasKinetics::updateROP()
     m_ROP_ok = true;
 }
 
-void GasKinetics::getFwdRateConstants(doublereal* kfwd)
+void GasKinetics::getNetProductionRates(size_t nStates, const doublereal* T,
+                                        const doublereal* P,
+                                        const doublereal* Y, doublereal* wdot)
 {
-    update_rates_C();
-    update_rates_T();
+    if (nPhases() != 1 || thermo().eosType() != cIdealGas ||
+            rateTabulation() || dynamicReduction()) {
+        Kinetics::getNetProductionRates(nStates, T, P, Y, wdot);
+        return;
+    }
+    updateStoichMatrices();
+    updateEfficiencies();
+
+    // Small blocks keep the work arrays in cache
+    const size_t blockSize = 32;
+    for (size_t n = 0; n < nStates; n += blockSize) {
+        size_t nb = std::min(blockSize, nStates - n);
+        evalNetProductionRates(nb, T + n, P + n, Y + n*m_kk, wdot + n*m_kk);
+    }
+
+    // The P-log and Chebyshev rate managers now hold the pressure-dependent
+    // parameters for the last state of the batch, so force the rates at the
+    // state of the phase to be recomputed.
+    if (m_plog_rates.nReactions() || m_cheb_rates.nReactions()) {
+        m_temp = 0.0;
+        m_thermo_C = 0;
+    }
+}
+
+void GasKinetics::evalNetProductionRates(size_t nStates, const doublereal* T,
+                                         const doublereal* P,
+                                         const doublereal* Y,
+                                         doublereal* wdot)
+{
+    // Values which depend on the state are stored with the values for the
+    // states of the block adjacent to each other, e.g. the rate constant of
+    // reaction i for state n is ropf[i*nb + n].
+    size_t nb = nStates;
+    size_t nconcm = m_concm.size();
+    size_t n3b = m_3b_concm.workSize();
+    size_t nfwork = falloff_work.size();
+    m_batchWork.resize(4*nb + 5*m_kk*nb + 3*m_ii*nb + (nconcm + 3*m_nfall)*nb
+                       + m_ii + m_nfall + nfwork);
+    double* logT = &m_batchWork[0];
+    double* recipT = logT + nb;
+    double* ctot = recipT + nb;
+    double* logc0 = ctot + nb;
+    double* conc = logc0 + nb;
+    double* grt = conc + m_kk*nb;
+    double* rkcn = grt + m_kk*nb;
+    double* ropf = rkcn + m_ii*nb;
+    double* ropr = ropf + m_ii*nb;
+    double* concm = ropr + m_ii*nb;
+    double* rlow = concm + nconcm*nb;
+    double* rhigh = rlow + m_nfall*nb;
+    double* pr = rhigh + m_nfall*nb;
+    double* cp_R = pr + m_nfall*nb;
+    double* h_RT = cp_R + m_kk*nb;
+    double* s_R = h_RT + m_kk*nb;
+    double* kstate = s_R + m_kk*nb;
+    double* prstate = kstate + m_ii;
+    double* fwork = (nfwork) ? prstate + m_nfall : 0;
+
+    // Concentrations and reference state Gibbs functions, computed as for
+    // an IdealGasPhase set to each state with setState_TPY
+    const vector_fp& mw = thermo().molecularWeights();
+    SpeciesThermo& spthermo = thermo().speciesThermo();
+    double logp0 = log(spthermo.refPressure());
+    for (size_t n = 0; n < nb; n++) {
+        const double* y = Y + n*m_kk;
+        double ysum = 0.0;
+        for (size_t k = 0; k < m_kk; k++) {
+            ysum += std::max(y[k], 0.0);
+        }
+        double rmmw = 0.0;
+        for (size_t k = 0; k < m_kk; k++) {
+            double ym = std::max(y[k], 0.0) / ysum / mw[k];
+            conc[k*nb + n] = ym;
+            rmmw += ym;
+        }
+        double rho = P[n] / (rmmw * GasConstant * T[n]);
+        for (size_t k = 0; k < m_kk; k++) {
+            conc[k*nb + n] *= rho;
+        }
+        ctot[n] = rho * rmmw;
+        logT[n] = log(T[n]);
+        recipT[n] = 1.0 / T[n];
+        logc0[n] = logp0 - log(GasConstant * T[n]);
+    }
+    spthermo.update(nb, T, cp_R, h_RT, s_R);
+    for (size_t j = 0; j < m_kk*nb; j++) {
+        grt[j] = h_RT[j] - s_R[j];
+    }
+
+    // Reciprocals of the equilibrium constants of the reversible reactions
+    m_stoichRevNetT.mult(grt, rkcn, nb);
+    for (size_t j = 0; j < m_revindex.size(); j++) {
+        size_t i = m_revindex[j];
+        double* r = rkcn + i*nb;
+        for (size_t n = 0; n < nb; n++) {
+            r[n] = std::min(exp(r[n] - m_dn[i]*logc0[n]), BigNumber);
+        }
+    }
+    for (size_t j = 0; j < m_irrev.size(); j++) {
+        fill(rkcn + m_irrev[j]*nb, rkcn + (m_irrev[j] + 1)*nb, 0.0);
+    }
+
+    // Rate constants
+    fill(ropf, ropf + m_ii*nb, 0.0);
+    m_rates.update(nb, logT, recipT, ropf);
+    if (m_nfall) {
+        m_falloff_low_rates.update(nb, logT, recipT, rlow);
+        m_falloff_high_rates.update(nb, logT, recipT, rhigh);
+    }
+    size_t nplog = m_plog_rates.nReactions();
+    size_t ncheb = m_cheb_rates.nReactions();
+    for (size_t n = 0; n < nb && (nplog || ncheb); n++) {
+        if (nplog) {
+            double logP = log(P[n]);
+            m_plog_rates.update_C(&logP);
+            m_plog_rates.update(T[n], logT[n], kstate);
+        }
+        if (ncheb) {
+            double log10P = log10(P[n]);
+            m_cheb_rates.update_C(&log10P);
+            m_cheb_rates.update(T[n], logT[n], kstate);
+        }
+        for (size_t j = 0; j < nplog; j++) {
+            size_t i = m_plog_rates.reactionIndex(j);
+            ropf[i*nb + n] = kstate[i];
+        }
+        for (size_t j = 0; j < ncheb; j++) {
+            size_t i = m_cheb_rates.reactionIndex(j);
+            ropf[i*nb + n] = kstate[i];
+        }
+    }
+
+    // Third-body concentrations of the three-body and falloff reactions
+    for (size_t j = 0; j < nconcm; j++) {
+        double* c = concm + j*nb;
+        for (size_t n = 0; n < nb; n++) {
+            c[n] = m_defaultEfficiencies[j] * ctot[n];
+        }
+    }
+    m_efficiencies.incrementMult(conc, concm, nb);
+    const std::vector<size_t>& index3b = m_3b_concm.reactionIndex();
+    for (size_t j = 0; j < n3b; j++) {
+        double* r = ropf + index3b[j]*nb;
+        const double* c = concm + j*nb;
+        for (size_t n = 0; n < nb; n++) {
+            r[n] *= c[n];
+        }
+    }
+
+    // Falloff reactions, as in processFalloffReactions()
+    for (size_t i = 0; i < m_nfall; i++) {
+        const double* c = concm + (n3b + i)*nb;
+        for (size_t n = 0; n < nb; n++) {
+            size_t m = i*nb + n;
+            pr[m] = c[n] * rlow[m] / (rhigh[m] + SmallNumber);
+        }
+    }
+    for (size_t n = 0; n < nb && m_nfall; n++) {
+        for (size_t i = 0; i < m_nfall; i++) {
+            prstate[i] = pr[i*nb + n];
+        }
+        m_falloffn.updateTemp(T[n], fwork);
+        m_falloffn.pr_to_falloff(prstate, fwork);
+        for (size_t i = 0; i < m_nfall; i++) {
+            pr[i*nb + n] = prstate[i];
+        }
+    }
+    for (size_t i = 0; i < m_nfall; i++) {
+        const double* k = (m_rxntype[m_fallindx[i]] == FALLOFF_RXN) ?
+                          rhigh + i*nb : rlow + i*nb;
+        double* r = ropf + m_fallindx[i]*nb;
+        for (size_t n = 0; n < nb; n++) {
+            r[n] = pr[i*nb + n] * k[n];
+        }
+    }
+
+    // Rates of progress
+    for (size_t i = 0; i < m_ii; i++) {
+        double* rf = ropf + i*nb;
+        double* rr = ropr + i*nb;
+        const double* kc = rkcn + i*nb;
+        for (size_t n = 0; n < nb; n++) {
+            rf[n] *= m_perturb[i];
+            rr[n] = rf[n] * kc[n];
+        }
+    }
+    m_reactantStoich.multiply(conc, ropf, nb);
+    m_revProductStoich.multiply(conc, ropr, nb);
+    for (size_t m = 0; m < m_ii*nb; m++) {
+        ropf[m] -= ropr[m];
+    }
+
+    // Net production rates, reusing grt for the values stored species by
+    // species
+    m_stoichNet.mult(ropf, grt, nb);
+    for (size_t n = 0; n < nb; n++) {
+        for (size_t k = 0; k < m_kk; k++) {
+            wdot[n*m_kk + k] = grt[k*nb + n];
+        }
+    }
+}
+
+void GasKinetics::setDynamicReduction(const std::vector<size_t>& targets,
+                                      double threshold, double deltaT,
+                                      double deltaLogX,
+                                      size_t maxMechanisms)
+{
+    if (targets.empty()) {
+        throw CanteraError("GasKinetics::setDynamicReduction",
+                           "No target species specified.");
+    }
+    for (size_t i = 0; i < targets.size(); i++) {
+        checkSpeciesIndex(targets[i]);
+    }
+    if (deltaT <= 0.0 || deltaLogX <= 0.0) {
+        throw CanteraError("GasKinetics::setDynamicReduction",
+                           "Bin widths must be positive.");
+    }
+    if (maxMechanisms == 0) {
+        throw CanteraError("GasKinetics::setDynamicReduction",
+                           "At least one mechanism must be stored.");
+    }
+    clearDynamicReduction();
+    m_drgTargets = targets;
+    m_drgThreshold = threshold;
+    m_drgDeltaT = deltaT;
+    m_drgDeltaLogX = deltaLogX;
+    m_drgMaxMechanisms = maxMechanisms;
+}
+
+void GasKinetics::clearDynamicReduction()
+{
+    activateReducedMechanism(npos);
+    m_drgTargets.clear();
+    m_reduced.clear();
+    m_reducedIndex.clear();
+    // the mechanism is selected when the state is next updated
+    m_thermo_C = 0;
+}
+
+void GasKinetics::getActiveReactions(std::vector<size_t>& active)
+{
+    active.clear();
+    if (dynamicReduction()) {
+        update_rates_C();
+    }
+    for (size_t i = 0; i < m_ii; i++) {
+        if (m_activeReduced == npos || m_reduced[m_activeReduced].mask[i]) {
+            active.push_back(i);
+        }
+    }
+}
+
+void GasKinetics::getDRGEPCoefficients(const std::vector<size_t>& targets,
+                                       vector_fp& R)
+{
+    // Net rates of progress of the full mechanism
+    activateReducedMechanism(npos);
+    bool analysis = m_drgAnalysis;
+    m_drgAnalysis = true;
+    updateROP();
+    m_drgAnalysis = analysis;
+    // the mechanism for the current state is selected on the next update
+    m_thermo_C = 0;
+    updateStoichMatrices();
+    const std::vector<size_t>& rows = m_stoichNetT.rowStart();
+    const std::vector<size_t>& cols = m_stoichNetT.colIndex();
+    const vector_fp& nu = m_stoichNetT.values();
+
+    // Production and consumption rates of each species
+    vector_fp P(m_kk, 0.0), C(m_kk, 0.0);
+    for (size_t i = 0; i < m_ii; i++) {
+        for (size_t n = rows[i]; n < rows[i+1]; n++) {
+            double v = nu[n] * m_ropnet[i];
+            if (v > 0) {
+                P[cols[n]] += v;
+            } else {
+                C[cols[n]] -= v;
+            }
+        }
+    }
+
+    // Numerators of the direct interaction coefficients, for each pair of
+    // species which participate in a common reaction
+    std::vector<std::map<size_t, double> > rAB(m_kk);
+    for (size_t i = 0; i < m_ii; i++) {
+        size_t start = rows[i];
+        size_t end = rows[i+1];
+        for (size_t n = start; n < end; n++) {
+            double v = nu[n] * m_ropnet[i];
+            std::map<size_t, double>& row = rAB[cols[n]];
+            for (size_t m = start; m < end; m++) {
+                if (m != n) {
+                    row[cols[m]] += v;
+                }
+            }
+        }
+    }
+
+    // Find the path from a target species with the largest product of
+    // direct interaction coefficients to each species, using a variant of
+    // Dijkstra's algorithm.
+    R.assign(m_kk, 0.0);
+    std::priority_queue<std::pair<double, size_t> > queue;
+    for (size_t j = 0; j < targets.size(); j++) {
+        checkSpeciesIndex(targets[j]);
+        R[targets[j]] = 1.0;
+        queue.push(std::make_pair(1.0, targets[j]));
+    }
+    while (!queue.empty()) {
+        double RA = queue.top().first;
+        size_t A = queue.top().second;
+        queue.pop();
+        double denom = std::max(P[A], C[A]);
+        if (RA < R[A] || denom == 0.0) {
+            continue;
+        }
+        for (std::map<size_t, double>::const_iterator iter = rAB[A].begin();
+             iter != rAB[A].end(); ++iter) {
+            double RB = RA * std::min(std::abs(iter->second) / denom, 1.0);
+            if (RB > R[iter->first]) {
+                R[iter->first] = RB;
+                queue.push(std::make_pair(RB, iter->first));
+            }
+        }
+    }
+}
+
+void GasKinetics::selectReducedMechanism()
+{
+    if (!m_reduced.empty() && m_reduced[0].mask.size() != m_ii) {
+        // reactions have been added since the mechanisms were generated
+        activateReducedMechanism(npos);
+        m_reduced.clear();
+        m_reducedIndex.clear();
+    }
+
+    // Usually, the state is still in the bin of the active mechanism
+    if (m_activeReduced != npos && inBin(m_reduced[m_activeReduced])) {
+        m_reduced[m_activeReduced].lastUsed = ++m_drgClock;
+        return;
+    }
+
+    // Determine the state bin
+    const double logXmin = -30.0;
+    m_drgBin.resize(2 + m_drgTargets.size());
+    m_drgBin[0] = static_cast<int>(floor(thermo().temperature() / m_drgDeltaT));
+    m_drgBin[1] = static_cast<int>(floor(log(thermo().pressure()) / m_drgDeltaLogX));
+    for (size_t j = 0; j < m_drgTargets.size(); j++) {
+        double X = thermo().moleFraction(m_drgTargets[j]);
+        double logX = (X > 0.0) ? std::max(log10(X), logXmin) : logXmin;
+        m_drgBin[j+2] = static_cast<int>(floor(logX / m_drgDeltaLogX));
+    }
+
+    std::map<std::vector<int>, size_t>::const_iterator iter =
+        m_reducedIndex.find(m_drgBin);
+    if (iter != m_reducedIndex.end()) {
+        m_reduced[iter->second].lastUsed = ++m_drgClock;
+        activateReducedMechanism(iter->second);
+        return;
+    }
+
+    // Generate the reduced mechanism for this bin, replacing the least
+    // recently used mechanism if the maximum number are already stored
+    vector_fp R;
+    getDRGEPCoefficients(m_drgTargets, R);
+    size_t n = m_reduced.size();
+    if (n < m_drgMaxMechanisms) {
+        m_reduced.push_back(ReducedMechanism());
+    } else {
+        n = 0;
+        for (size_t j = 1; j < m_reduced.size(); j++) {
+            if (m_reduced[j].lastUsed < m_reduced[n].lastUsed) {
+                n = j;
+            }
+        }
+        m_reducedIndex.erase(m_reduced[n].bin);
+        m_reduced[n] = ReducedMechanism();
+    }
+    ReducedMechanism& mech = m_reduced[n];
+    buildReducedMechanism(R, mech);
+
+    // Bounds of the bin, matching the binning above
+    size_t nb = m_drgBin.size();
+    mech.bin = m_drgBin;
+    mech.lower.resize(nb);
+    mech.upper.resize(nb);
+    mech.lower[0] = m_drgBin[0] * m_drgDeltaT;
+    mech.upper[0] = (m_drgBin[0] + 1) * m_drgDeltaT;
+    mech.lower[1] = exp(m_drgBin[1] * m_drgDeltaLogX);
+    mech.upper[1] = exp((m_drgBin[1] + 1) * m_drgDeltaLogX);
+    for (size_t j = 2; j < nb; j++) {
+        double logX = m_drgBin[j] * m_drgDeltaLogX;
+        // the lowest bin also contains the mole fractions below the cutoff
+        mech.lower[j] = (logX <= logXmin) ? -BigNumber : pow(10.0, logX);
+        mech.upper[j] = pow(10.0, (m_drgBin[j] + 1) * m_drgDeltaLogX);
+    }
+    mech.lastUsed = ++m_drgClock;
+    m_reducedIndex[m_drgBin] = n;
+
+    // the mechanism in slot n may have been active before it was replaced
+    m_activeReduced = npos;
+    activateReducedMechanism(n);
+}
+
+bool GasKinetics::inBin(const ReducedMechanism& mech) const
+{
+    double T = thermo().temperature();
+    double P = thermo().pressure();
+    if (T < mech.lower[0] || T >= mech.upper[0] ||
+        P < mech.lower[1] || P >= mech.upper[1]) {
+        return false;
+    }
+    for (size_t j = 0; j < m_drgTargets.size(); j++) {
+        double X = thermo().moleFraction(m_drgTargets[j]);
+        if (X < mech.lower[j+2] || X >= mech.upper[j+2]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Copy the entries of `A` in the rows and columns for which `rows` and
+//! `cols` are true (or all rows or columns, if null) to `sub`, which has the
+//! same size as `A`.
+static void getSparseSubset(const SparseMatrix& A,
+                            const std::vector<bool>* rows,
+                            const std::vector<bool>* cols,
+                            SparseMatrix& sub)
+{
+    SparseTripletList entries;
+    const std::vector<size_t>& start = A.rowStart();
+    for (size_t i = 0; i < A.nRows(); i++) {
+        if (rows && !(*rows)[i]) {
+            continue;
+        }
+        for (size_t n = start[i]; n < start[i+1]; n++) {
+            size_t j = A.colIndex()[n];
+            if (!cols || (*cols)[j]) {
+                entries.push_back(SparseTriplet(i, j, A.values()[n]));
+            }
+        }
+    }
+    sub.setFromTriplets(A.nRows(), A.nColumns(), entries);
+}
+
+void GasKinetics::buildReducedMechanism(const vector_fp& R,
+                                        ReducedMechanism& mech)
+{
+    // A reaction is included if all of its species are important
+    updateStoichMatrices();
+    const std::vector<size_t>& rows = m_stoichNetT.rowStart();
+    const std::vector<size_t>& cols = m_stoichNetT.colIndex();
+    std::vector<bool> include(m_ii, true);
+    for (size_t i = 0; i < m_ii; i++) {
+        for (size_t n = rows[i]; n < rows[i+1]; n++) {
+            if (R[cols[n]] < m_drgThreshold) {
+                include[i] = false;
+                break;
+            }
+        }
+    }
+
+    mech.mask.assign(m_ii, 0.0);
+    for (size_t i = 0; i < m_ii; i++) {
+        if (include[i]) {
+            mech.mask[i] = 1.0;
+            mech.reactions.push_back(i);
+            mech.tableColumns.push_back(i);
+        }
+    }
+    for (size_t n = 0; n < m_rates.nReactions(); n++) {
+        if (include[m_rates.reactionIndex(n)]) {
+            mech.rates.push_back(n);
+        }
+    }
+    for (size_t n = 0; n < m_revindex.size(); n++) {
+        if (include[m_revindex[n]]) {
+            mech.revindex.push_back(m_revindex[n]);
+        }
+    }
+    for (size_t n = 0; n < m_3b_concm.workSize(); n++) {
+        size_t irxn = m_3b_concm.reactionIndex(n);
+        if (include[irxn]) {
+            mech.thirdBody.push_back(n);
+            mech.thirdBodyRxn.push_back(irxn);
+        }
+    }
+    std::vector<bool> fallInclude(m_nfall);
+    for (size_t n = 0; n < m_nfall; n++) {
+        fallInclude[n] = include[m_fallindx[n]];
+        if (fallInclude[n]) {
+            mech.falloff.push_back(n);
+            // low- and high-pressure limits in the rate table
+            mech.tableColumns.push_back(m_ii + n);
+            mech.tableColumns.push_back(m_ii + m_nfall + n);
+        }
+    }
+    for (size_t n = 0; n < m_plog_rates.nReactions(); n++) {
+        if (include[m_plog_rates.reactionIndex(n)]) {
+            mech.plog.push_back(n);
+        }
+    }
+    for (size_t n = 0; n < m_cheb_rates.nReactions(); n++) {
+        if (include[m_cheb_rates.reactionIndex(n)]) {
+            mech.cheb.push_back(n);
+        }
+    }
+
+    m_reactantStoich.getSubset(include, mech.reactantStoich);
+    m_revProductStoich.getSubset(include, mech.revProductStoich);
+    getSparseSubset(m_stoichNet, 0, &include, mech.stoichNet);
+    getSparseSubset(m_stoichRevNetT, &include, 0, mech.stoichRevNetT);
+
+    // rows of m_efficiencies are the three-body reactions, followed by the
+    // falloff reactions
+    updateEfficiencies();
+    size_t n3b = m_3b_concm.workSize();
+    std::vector<bool> effInclude(n3b + m_nfall);
+    for (size_t n = 0; n < n3b; n++) {
+        effInclude[n] = include[m_3b_concm.reactionIndex(n)];
+    }
+    for (size_t n = 0; n < m_nfall; n++) {
+        effInclude[n3b + n] = fallInclude[n];
+    }
+    getSparseSubset(m_efficiencies, &effInclude, 0, mech.efficiencies);
+
+    m_falloffn.getSubset(fallInclude, mech.falloffMgr);
+}
+
+void GasKinetics::activateReducedMechanism(size_t n)
+{
+    if (n == m_activeReduced) {
+        return;
+    }
+    m_activeReduced = n;
+    if (n != npos) {
+        // Only the entries for the included reactions are updated while this
+        // mechanism is active, so zero the others
+        fill(m_rfn.begin(), m_rfn.end(), 0.0);
+        fill(m_rkcn.begin(), m_rkcn.end(), 0.0);
+        fill(m_ropf.begin(), m_ropf.end(), 0.0);
+        fill(m_ropr.begin(), m_ropr.end(), 0.0);
+        fill(m_ropnet.begin(), m_ropnet.end(), 0.0);
+        fill(m_rateTableWork.begin(), m_rateTableWork.end(), 0.0);
+    }
+    // force the rate coefficients and third-body concentrations to be
+    // re-evaluated
+    m_temp = 0.0;
+    m_ROP_ok = false;
+    m_thermo_C = 0;
+}
+
+void GasKinetics::updateFwdRateConstants()
+{
+    if (m_activeReduced != npos) {
+        const ReducedMechanism& mech = m_reduced[m_activeReduced];
+        const std::vector<size_t>& rxns = mech.reactions;
+        for (size_t j = 0; j < rxns.size(); j++) {
+            m_ropf[rxns[j]] = m_rfn[rxns[j]];
+        }
+        for (size_t j = 0; j < mech.thirdBody.size(); j++) {
+            m_ropf[mech.thirdBodyRxn[j]] *= m_concm[mech.thirdBody[j]];
+        }
+        if (!mech.falloff.empty()) {
+            processFalloffReactions();
+        }
+        for (size_t j = 0; j < rxns.size(); j++) {
+            m_ropf[rxns[j]] *= m_perturb[rxns[j]];
+        }
+        return;
+    }
 
     // copy rate coefficients into ropf
     copy(m_rfn.begin(), m_rfn.end(), m_ropf.begin());
 
     // multiply ropf by enhanced 3b conc for all 3b rxns
-    if (!concm_3b_values.empty()) {
-        m_3b_concm.multiply(&m_ropf[0], &concm_3b_values[0]);
+    if (m_3b_concm.workSize()) {
+        m_3b_concm.multiply(&m_ropf[0], &m_concm[0]);
     }
 
     if (m_nfall) {
@@ -234,10 +1075,250 @@ void GasKinetics::getFwdRateConstants(doublereal* kfwd)
 
     // multiply by perturbation factor
     multiply_each(m_ropf.begin(), m_ropf.end(), m_perturb.begin());
+}
+
+void GasKinetics::getFwdRateConstants(doublereal* kfwd)
+{
+    update_rates_C();
+    update_rates_T();
+    updateFwdRateConstants();
 
     for (size_t i = 0; i < m_ii; i++) {
         kfwd[i] = m_ropf[i];
     }
+
+    // m_ropf no longer contains the forward rates of progress
+    m_ROP_ok = false;
+}
+
+void GasKinetics::getNetProductionRates(doublereal* wdot)
+{
+    if (m_activeReduced == npos && !dynamicReduction()) {
+        Kinetics::getNetProductionRates(wdot);
+        return;
+    }
+    // updateROP() may select a different mechanism
+    updateROP();
+    if (m_activeReduced != npos) {
+        m_reduced[m_activeReduced].stoichNet.mult(&m_ropnet[0], wdot);
+    } else {
+        updateStoichMatrices();
+        m_stoichNet.mult(&m_ropnet[0], wdot);
+    }
+}
+
+void GasKinetics::getNetRatesOfProgress_ddC(SparseMatrix& drop)
+{
+    // forward rate constants, including third-body and falloff effects
+    vector_fp kf(m_ii);
+    getFwdRateConstants(&kf[0]);
+
+    SparseTripletList jac;
+
+    // mass-action dependence of the forward rates of progress
+    m_reactantStoich.derivatives(&m_conc[0], &kf[0], jac);
+
+    // mass-action dependence of the reverse rates of progress
+    vector_fp kr(m_ii);
+    for (size_t i = 0; i < m_ii; i++) {
+        kr[i] = - kf[i] * m_rkcn[i];
+    }
+    m_revProductStoich.derivatives(&m_conc[0], &kr[0], jac);
+
+    bool pdep = m_plog_rates.nReactions() || m_cheb_rates.nReactions();
+    size_t n3b = m_3b_concm.workSize();
+    if (n3b || m_nfall || pdep) {
+        // derivative of the net rate of progress with respect to the forward
+        // rate constant
+        vector_fp dqdk(m_ii, 1.0);
+        vector_fp qr(m_rkcn.begin(), m_rkcn.begin() + m_ii);
+        m_reactantStoich.multiply(&m_conc[0], &dqdk[0]);
+        m_revProductStoich.multiply(&m_conc[0], &qr[0]);
+        for (size_t i = 0; i < m_ii; i++) {
+            dqdk[i] = m_perturb[i] * (dqdk[i] - qr[i]);
+        }
+        if (m_activeReduced != npos) {
+            multiply_each(dqdk.begin(), dqdk.end(),
+                          m_reduced[m_activeReduced].mask.begin());
+        }
+
+        // three-body reactions, where k = k_0 [M]
+        if (n3b) {
+            vector_fp dRdM(m_rfn.begin(), m_rfn.end());
+            multiply_each(dRdM.begin(), dRdM.end(), dqdk.begin());
+            m_3b_concm.derivatives(&dRdM[0], m_kk, jac);
+        }
+
+        // falloff reactions, where k depends on [M] through the reduced
+        // pressure Pr = k_0 [M] / k_inf
+        if (m_nfall) {
+            vector_fp pr(m_nfall), dpr(m_nfall), dRdM(m_nfall);
+            for (size_t i = 0; i < m_nfall; i++) {
+                pr[i] = m_concm[n3b + i] * m_rfn_low[i] /
+                        (m_rfn_high[i] + SmallNumber);
+                dpr[i] = pr[i] * 1e-7 + 1e-14;
+                dRdM[i] = pr[i] + dpr[i];
+            }
+            double* work = (falloff_work.empty()) ? 0 : &falloff_work[0];
+            activeFalloff().pr_to_falloff(&pr[0], work);
+            activeFalloff().pr_to_falloff(&dRdM[0], work);
+            for (size_t i = 0; i < m_nfall; i++) {
+                size_t irxn = m_fallindx[i];
+                double scale = (m_rxntype[irxn] == FALLOFF_RXN) ?
+                               m_rfn_high[i] : m_rfn_low[i];
+                // dk/dM = scale * dF/dPr * dPr/dM
+                dRdM[i] = scale * (dRdM[i] - pr[i]) / dpr[i] * m_rfn_low[i] /
+                          (m_rfn_high[i] + SmallNumber) * dqdk[irxn];
+            }
+            size_t nstart = jac.size();
+            m_falloff_concm.derivatives(&dRdM[0], m_kk, jac);
+            // convert from falloff reaction index to global reaction index
+            for (size_t n = nstart; n < jac.size(); n++) {
+                jac[n].row = m_fallindx[jac[n].row];
+            }
+        }
+
+        // P-log and Chebyshev reactions, where k depends on the pressure, and
+        // P = RT * sum(C_k)
+        if (pdep) {
+            double T = thermo().temperature();
+            double logT = log(T);
+            double P = thermo().pressure();
+            double dP = 1e-7 * P;
+            vector_fp rfn(m_rfn);
+            double logP = log(P + dP);
+            double log10P = log10(P + dP);
+            const ReducedMechanism* mech = (m_activeReduced == npos) ? 0 :
+                                           &m_reduced[m_activeReduced];
+            if (m_plog_rates.nReactions()) {
+                m_plog_rates.update_C(&logP);
+                if (mech) {
+                    m_plog_rates.update(T, logT, &rfn[0], mech->plog);
+                } else {
+                    m_plog_rates.update(T, logT, &rfn[0]);
+                }
+                logP = log(P);
+                m_plog_rates.update_C(&logP);
+            }
+            if (m_cheb_rates.nReactions()) {
+                if (mech) {
+                    m_cheb_rates.update_C(&log10P, mech->cheb);
+                    m_cheb_rates.update(T, logT, &rfn[0], mech->cheb);
+                    log10P = log10(P);
+                    m_cheb_rates.update_C(&log10P, mech->cheb);
+                } else {
+                    m_cheb_rates.update_C(&log10P);
+                    m_cheb_rates.update(T, logT, &rfn[0]);
+                    log10P = log10(P);
+                    m_cheb_rates.update_C(&log10P);
+                }
+            }
+            for (size_t i = 0; i < m_ii; i++) {
+                if (rfn[i] != m_rfn[i]) {
+                    double dRdC = (rfn[i] - m_rfn[i]) / dP * GasConstant * T *
+                                  dqdk[i];
+                    for (size_t k = 0; k < m_kk; k++) {
+                        jac.push_back(SparseTriplet(i, k, dRdC));
+                    }
+                }
+            }
+        }
+    }
+
+    drop.setFromTriplets(m_ii, m_kk, jac);
+}
+
+void GasKinetics::getNetProductionRates_ddT(doublereal* dwdot)
+{
+    double T = thermo().temperature();
+    double dT = 1e-6 * T;
+
+    vector_fp kf(m_ii), kf1(m_ii), rkc(m_ii);
+    getFwdRateConstants(&kf[0]);
+    copy(m_rkcn.begin(), m_rkcn.begin() + m_ii, rkc.begin());
+
+    // Perturb the temperature at constant density and composition. The
+    // perturbed state may lie in a different bin, so keep the reduced
+    // mechanism selected for the unperturbed state.
+    thermo().setTemperature(T + dT);
+    bool analysis = m_drgAnalysis;
+    m_drgAnalysis = true;
+    getFwdRateConstants(&kf1[0]);
+    m_drgAnalysis = analysis;
+    vector_fp dq(m_ii, 1.0);
+    vector_fp qr(m_ii, 1.0);
+    for (size_t i = 0; i < m_ii; i++) {
+        qr[i] = (kf1[i] * m_rkcn[i] - kf[i] * rkc[i]) / dT;
+        dq[i] = (kf1[i] - kf[i]) / dT;
+    }
+    thermo().setTemperature(T);
+
+    m_reactantStoich.multiply(&m_conc[0], &dq[0]);
+    m_revProductStoich.multiply(&m_conc[0], &qr[0]);
+    for (size_t i = 0; i < m_ii; i++) {
+        dq[i] -= qr[i];
+    }
+
+    updateStoichMatrices();
+    m_stoichNet.mult(&dq[0], dwdot);
+}
+
+void GasKinetics::writeSource(std::ostream& s, const std::string& name) const
+{
+    s << "// Kinetics functions for a mechanism with " << m_kk
+      << " species and " << m_ii << " reactions." << endl
+      << "// Generated by Cantera::GasKinetics::writeSource." << endl << endl
+      << "#include <cmath>" << endl
+      << "#include <cstddef>" << endl << endl
+      << "namespace " << name << endl << "{" << endl << endl
+      << "using std::exp;" << endl
+      << "using std::pow;" << endl << endl
+      << "// Concentrations raised to non-integer reaction orders are taken to"
+      << endl << "// be zero for non-positive concentrations" << endl
+      << "inline double ppow(double x, double order)" << endl << "{" << endl
+      << "    return (x > 0.0) ? pow(x, order) : 0.0;" << endl
+      << "}" << endl << endl
+      << "const size_t nSpecies = " << m_kk << ";" << endl
+      << "const size_t nReactions = " << m_ii << ";" << endl << endl;
+
+    s << "void updateArrheniusRates(double T, double* kf)" << endl << "{" << endl;
+    m_rates.writeUpdate(s, "kf");
+    s << "}" << endl << endl;
+
+    map<size_t, string> out;
+    m_reactantStoich.writeMultiply("c", out);
+    s << "void multiplyReactants(const double* c, double* r)" << endl << "{" << endl;
+    for (map<size_t, string>::const_iterator iter = out.begin();
+         iter != out.end(); ++iter) {
+        s << "    r[" << iter->first << "] *= " << iter->second << ";" << endl;
+    }
+    s << "}" << endl << endl;
+
+    out.clear();
+    m_revProductStoich.writeMultiply("c", out);
+    s << "void multiplyRevProducts(const double* c, double* r)" << endl << "{" << endl;
+    for (map<size_t, string>::const_iterator iter = out.begin();
+         iter != out.end(); ++iter) {
+        s << "    r[" << iter->first << "] *= " << iter->second << ";" << endl;
+    }
+    s << "}" << endl << endl;
+
+    out.clear();
+    m_revProductStoich.writeIncrementSpecies("ropnet", out);
+    m_irrevProductStoich.writeIncrementSpecies("ropnet", out);
+    m_reactantStoich.writeDecrementSpecies("ropnet", out);
+    s << "void getNetProductionRates(const double* ropnet, double* wdot)" << endl
+      << "{" << endl;
+    for (size_t k = 0; k < m_kk; k++) {
+        map<size_t, string>::const_iterator iter = out.find(k);
+        if (iter == out.end()) {
+            s << "    wdot[" << k << "] = 0.0;" << endl;
+        } else {
+            s << "    wdot[" << k << "] =" << wrapString(iter->second) << ";" << endl;
+        }
+    }
+    s << "}" << endl << endl
+      << "} // namespace " << name << endl;
 }
 
 void GasKinetics::addReaction(ReactionData& r)
@@ -265,6 +1346,7 @@ void GasKinetics::addReaction(ReactionData& r)
 
     // operations common to all reaction types
     BulkKinetics::addReaction(r);
+    m_thermo_C = 0;
 }
 
 void GasKinetics::addReaction(shared_ptr<Reaction> r)
@@ -293,6 +1375,7 @@ void GasKinetics::addReaction(shared_ptr<Reaction> r)
 
     // operations common to all reaction types
     BulkKinetics::addReaction(r);
+    m_thermo_C = 0;
 }
 
 void GasKinetics::addFalloffReaction(ReactionData& r)
@@ -408,8 +1491,8 @@ void GasKinetics::finalize()
 {
     BulkKinetics::finalize();
     falloff_work.resize(m_falloffn.workSize());
-    concm_3b_values.resize(m_3b_concm.workSize());
-    concm_falloff_values.resize(m_falloff_concm.workSize());
+    updateEfficiencies();
+    m_thermo_C = 0;
 }
 
 bool GasKinetics::ready() const
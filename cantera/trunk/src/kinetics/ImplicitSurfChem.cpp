@@ -141,6 +141,11 @@ void ImplicitSurfChem::integrate0(doublereal t0, doublereal t1)
     updateState(m_integ->solution());
 }
 
+void ImplicitSurfChem::setAnalyticJacobian(bool analytic)
+{
+    m_integ->setProblemType(analytic ? DENSE + JAC : DENSE + NOJAC);
+}
+
 void ImplicitSurfChem::updateState(doublereal* c)
 {
     size_t loc = 0;
@@ -164,13 +169,67 @@ void ImplicitSurfChem::eval(doublereal time, doublereal* y,
         loc = 0;
         for (size_t k = 1; k < m_nsp[n]; k++) {
             ydot[k + loc] = m_work[kstart + k] * rs0 * m_surf[n]->size(k);
-            sum -= ydot[k];
+            sum -= ydot[k + loc];
         }
         ydot[loc] = sum;
         loc += m_nsp[n];
     }
 }
 
+void ImplicitSurfChem::evalJacobian(double t, double* y, const double* ydot,
+                                    const double* ewt, double* p,
+                                    double* const* jacCols)
+{
+    updateState(y);
+    for (size_t j = 0; j < m_nv; j++) {
+        std::fill(jacCols[j], jacCols[j] + m_nv, 0.0);
+    }
+
+    SparseMatrix dwdot;
+    vector_fp dFdtheta, theta;
+    size_t loc = 0;
+    for (size_t n = 0; n < m_nsurf; n++) {
+        size_t nsp = m_nsp[n];
+        doublereal rs0 = 1.0/m_surf[n]->siteDensity();
+        size_t kstart = m_vecKinPtrs[n]->kineticsSpeciesIndex(0, m_surfindex[n]);
+        m_vecKinPtrs[n]->getNetProductionRates_ddCoverages(dwdot);
+
+        // derivatives of ydot[k] with respect to the normalized coverages,
+        // for k > 0
+        dFdtheta.assign(nsp * nsp, 0.0);
+        const std::vector<size_t>& start = dwdot.rowStart();
+        const std::vector<size_t>& col = dwdot.colIndex();
+        const vector_fp& value = dwdot.values();
+        for (size_t k = 1; k < nsp; k++) {
+            for (size_t i = start[kstart + k]; i < start[kstart + k + 1]; i++) {
+                dFdtheta[k * nsp + col[i]] = value[i] * rs0 * m_surf[n]->size(k);
+            }
+        }
+
+        // updateState() sets theta_j = y_j / sum(y), so
+        // d(theta_j)/d(y_m) = (delta_jm - theta_j) / sum(y)
+        theta.resize(nsp);
+        m_surf[n]->getCoverages(DATA_PTR(theta));
+        doublereal sum = 0.0;
+        for (size_t j = 0; j < nsp; j++) {
+            sum += y[loc + j];
+        }
+        for (size_t k = 1; k < nsp; k++) {
+            doublereal dot = 0.0;
+            for (size_t j = 0; j < nsp; j++) {
+                dot += dFdtheta[k * nsp + j] * theta[j];
+            }
+            for (size_t m = 0; m < nsp; m++) {
+                double d = (dFdtheta[k * nsp + m] - dot) / sum;
+                jacCols[loc + m][loc + k] = d;
+                // ydot[loc] = - sum of the other ydot
+                jacCols[loc + m][loc] -= d;
+            }
+        }
+        loc += nsp;
+    }
+}
+
 void ImplicitSurfChem::solvePseudoSteadyStateProblem(int ifuncOverride,
         doublereal timeScaleOverride)
 {
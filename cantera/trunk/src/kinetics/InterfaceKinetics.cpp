@@ -9,15 +9,47 @@
 #include "cantera/kinetics/ReactionData.h"
 #include "cantera/kinetics/RateCoeffMgr.h"
 #include "cantera/kinetics/ImplicitSurfChem.h"
+#include "cantera/kinetics/solveSP.h"
 #include "cantera/thermo/SurfPhase.h"
+#include "cantera/numerics/ctlapack.h"
 
 #include <cstdio>
 
+#ifdef THREAD_SAFE_CANTERA
+#include <boost/bind/bind.hpp>
+#include <boost/thread/thread.hpp>
+#endif
+
 using namespace std;
 
 namespace Cantera
 {
 
+//! Damping factor for the Newton update `dx` of the coverages `x`, where the
+//! new coverages are `x - damp*dx`. This is the step control used by solveSP,
+//! without the limit on the growth of the factor between calls, so that it
+//! can be applied to several sites (and threads) independently. Coverages
+//! which are already zero do not limit the step; they are cropped instead.
+static doublereal coverageDamping(const doublereal* x, const doublereal* dx,
+                                  size_t n)
+{
+    const doublereal APPROACH = 0.80;
+    doublereal damp = 1.0;
+    for (size_t k = 0; k < n; k++) {
+        doublereal xnew = x[k] - damp * dx[k];
+        doublereal xtop = 1.0 - 0.1*fabs(1.0-x[k]);
+        doublereal xbot = fabs(x[k]*0.1) - 1.0e-16;
+        if (xnew > xtop) {
+            damp = - APPROACH * (1.0 - x[k]) / dx[k];
+        } else if (xnew < xbot && x[k] > 0.0) {
+            damp = APPROACH * x[k] / dx[k];
+        } else if (xnew > 3.0*std::max(x[k], 1.0E-10)) {
+            damp = - 2.0 * std::max(x[k], 1.0E-10) / dx[k];
+        }
+    }
+    return std::max(damp, 1e-2);
+}
+
 InterfaceKinetics::InterfaceKinetics(thermo_t* thermo) :
     m_redo_rates(false),
     m_nirrev(0),
@@ -56,7 +88,9 @@ InterfaceKinetics::~InterfaceKinetics()
     }
 }
 
-InterfaceKinetics::InterfaceKinetics(const InterfaceKinetics& right)
+InterfaceKinetics::InterfaceKinetics(const InterfaceKinetics& right) :
+    m_surf(0),
+    m_integrator(0)
 {
     /*
      * Call the assignment operator
@@ -92,7 +126,10 @@ InterfaceKinetics& InterfaceKinetics::operator=(const InterfaceKinetics& right)
     deltaElectricEnergy_   = right.deltaElectricEnergy_;
     m_E                    = right.m_E;
     m_surf                 = right.m_surf;  //DANGER - shallow copy
-    m_integrator           = right.m_integrator;  //DANGER - shallow copy
+    // The surface solver refers to the phases of 'right', so it is not
+    // shared; a new one is created when it is needed.
+    delete m_integrator;
+    m_integrator = 0;
     m_beta                 = right.m_beta;
     m_ctrxn                = right.m_ctrxn;
     m_ctrxn_BVform         = right.m_ctrxn_BVform;
@@ -160,6 +197,16 @@ Kinetics* InterfaceKinetics::duplMyselfAsKinetics(const std::vector<thermo_t*> &
     return iK;
 }
 
+void InterfaceKinetics::assignShallowPointers(const std::vector<thermo_t*> & tpVector)
+{
+    Kinetics::assignShallowPointers(tpVector);
+    if (m_surf) {
+        m_surf = dynamic_cast<SurfPhase*>(&thermo(reactionPhaseIndex()));
+    }
+    delete m_integrator;
+    m_integrator = 0;
+}
+
 void InterfaceKinetics::setElectricPotential(int n, doublereal V)
 {
     thermo(n).setElectricPotential(V);
@@ -509,6 +556,92 @@ void InterfaceKinetics::getRevRateConstants(doublereal* krev, bool doIrreversibl
     }
 }
 
+void InterfaceKinetics::getNetRatesOfProgress_ddC(SparseMatrix& drop)
+{
+    updateROP();
+
+    // forward and reverse rate constants
+    vector_fp kf(m_ii), kr(m_ii);
+    for (size_t i = 0; i < m_ii; i++) {
+        kf[i] = m_rfn[i] * m_perturb[i];
+        kr[i] = - kf[i] * m_rkcn[i];
+    }
+
+    SparseTripletList jac;
+
+    // mass-action dependence of the forward and reverse rates of progress
+    m_reactantStoich.derivatives(DATA_PTR(m_actConc), DATA_PTR(kf), jac);
+    m_revProductStoich.derivatives(DATA_PTR(m_actConc), DATA_PTR(kr), jac);
+
+    // coverage dependence of the rate constants, which affects the forward
+    // and reverse rates of progress in the same proportion
+    if (m_has_coverage_dependence) {
+        vector_fp theta(m_surf->nSpecies());
+        m_surf->getCoverages(DATA_PTR(theta));
+        SparseTripletList dlogk;
+        m_rates.getCoverageDerivatives(DATA_PTR(theta), 1.0/m_temp, dlogk);
+
+        // net rates of progress, before any modification for nonexistent
+        // phases
+        vector_fp qf(kf), qr(m_ii);
+        for (size_t i = 0; i < m_ii; i++) {
+            qr[i] = - kr[i];
+        }
+        m_reactantStoich.multiply(DATA_PTR(m_actConc), DATA_PTR(qf));
+        m_revProductStoich.multiply(DATA_PTR(m_actConc), DATA_PTR(qr));
+
+        size_t kstart = m_start[reactionPhaseIndex()];
+        for (size_t n = 0; n < dlogk.size(); n++) {
+            size_t i = dlogk[n].row;
+            size_t k = dlogk[n].col;
+            // d(theta_k)/d(C_k) = sigma_k / n_0
+            double dthetadC = m_surf->size(k) / m_surf->siteDensity();
+            jac.push_back(SparseTriplet(i, kstart + k,
+                dlogk[n].value * dthetadC * (qf[i] - qr[i])));
+        }
+    }
+
+    drop.setFromTriplets(m_ii, m_kk, jac);
+
+    // reactions switched off by updateROP() because of nonexistent or
+    // unstable phases
+    if (m_phaseExistsCheck) {
+        const std::vector<size_t>& start = drop.rowStart();
+        vector_fp& value = drop.values();
+        for (size_t i = 0; i < m_ii; i++) {
+            if (m_ropnet[i] == 0.0) {
+                for (size_t n = start[i]; n < start[i+1]; n++) {
+                    value[n] = 0.0;
+                }
+            }
+        }
+    }
+}
+
+void InterfaceKinetics::getNetProductionRates_ddCoverages(SparseMatrix& dwdot)
+{
+    SparseMatrix dwdotdC;
+    getNetProductionRates_ddC(dwdotdC);
+
+    // d(C_k)/d(theta_k) = n_0 / sigma_k
+    size_t kstart = m_start[reactionPhaseIndex()];
+    size_t nsurf = m_surf->nSpecies();
+    const std::vector<size_t>& start = dwdotdC.rowStart();
+    const std::vector<size_t>& col = dwdotdC.colIndex();
+    const vector_fp& value = dwdotdC.values();
+    SparseTripletList jac;
+    for (size_t k = 0; k < m_kk; k++) {
+        for (size_t n = start[k]; n < start[k+1]; n++) {
+            if (col[n] >= kstart && col[n] < kstart + nsurf) {
+                size_t j = col[n] - kstart;
+                jac.push_back(SparseTriplet(k, j, value[n] *
+                    m_surf->siteDensity() / m_surf->size(j)));
+            }
+        }
+    }
+    dwdot.setFromTriplets(m_kk, nsurf, jac);
+}
+
 void InterfaceKinetics::updateROP()
 {
     // evaluate rate constants and equilibrium constants at temperature and phi (electric potential)
@@ -969,7 +1102,15 @@ void InterfaceKinetics::addReaction(shared_ptr<Reaction> r_base)
     for (map<string, CoverageDependency>::const_iterator iter = r.coverage_deps.begin();
          iter != r.coverage_deps.end();
          ++iter) {
-        size_t k = kineticsSpeciesIndex(iter->first);
+        // coverage dependencies are evaluated using the array of coverages
+        // of the surface phase
+        size_t k = thermo(reactionPhaseIndex()).speciesIndex(iter->first);
+        if (k == npos) {
+            throw CanteraError("InterfaceKinetics::addReaction",
+                "Coverage dependency on species '" + iter->first + "', which "
+                "is not in the surface phase, in reaction '" +
+                r.equation() + "'");
+        }
         rate.addCoverageDependence(k, iter->second.a, iter->second.m, iter->second.E);
     }
 
@@ -1194,6 +1335,268 @@ void InterfaceKinetics::solvePseudoSteadyStateProblem(
     m_integrator->solvePseudoSteadyStateProblem(ifuncOverride, timeScaleOverride);
 }
 
+void InterfaceKinetics::solvePseudoSteadyStateBatch(
+    size_t nSites, const doublereal* T, const doublereal* P,
+    const doublereal* Y, doublereal* theta, bool warmStart, size_t nThreads)
+{
+    if (nPhases() != 2) {
+        throw CanteraError("InterfaceKinetics::solvePseudoSteadyStateBatch",
+                           "Only kinetics managers with a single bulk phase "
+                           "are supported.");
+    }
+    size_t isurf = reactionPhaseIndex();
+    thermo_t& bulk = thermo(isurf == 0 ? 1 : 0);
+    thermo_t& surf = thermo(isurf);
+    size_t kb = bulk.nSpecies();
+    size_t ks = surf.nSpecies();
+
+    // keep the supplied initial guesses for the sites which do not converge
+    vector_fp theta0(theta, theta + nSites*ks);
+    vector_int converged(nSites, 0);
+    vector_fp bulkState, surfState;
+    bulk.saveState(bulkState);
+    surf.saveState(surfState);
+
+    nThreads = std::max<size_t>(std::min(nThreads, nSites), 1);
+#ifndef THREAD_SAFE_CANTERA
+    nThreads = 1;
+#endif
+    std::vector<std::string> errmsg(nThreads);
+    if (nThreads == 1) {
+        solvePseudoSteadyStateBlock(nSites, T, P, Y, theta, warmStart,
+                                    converged, errmsg[0]);
+    } else {
+#ifdef THREAD_SAFE_CANTERA
+        // The calling thread works on this object. Each of the other workers
+        // gets its own copies of the phases and of this kinetics manager.
+        std::vector<InterfaceKinetics*> kin(nThreads, this);
+        std::vector<thermo_t*> copies;
+        for (size_t i = 1; i < nThreads; i++) {
+            std::vector<thermo_t*> phases;
+            for (size_t m = 0; m < nPhases(); m++) {
+                phases.push_back(thermo(m).duplMyselfAsThermoPhase());
+                copies.push_back(phases.back());
+            }
+            kin[i] = dynamic_cast<InterfaceKinetics*>(
+                         duplMyselfAsKinetics(phases));
+        }
+        std::vector<vector_int> blockConverged(nThreads);
+        boost::thread_group workers;
+        for (size_t i = 1; i < nThreads; i++) {
+            size_t first = i*nSites/nThreads;
+            workers.create_thread(boost::bind(
+                &InterfaceKinetics::solvePseudoSteadyStateBlock, kin[i],
+                (i+1)*nSites/nThreads - first, T + first, P + first,
+                Y + first*kb, theta + first*ks, warmStart,
+                boost::ref(blockConverged[i]), boost::ref(errmsg[i])));
+        }
+        solvePseudoSteadyStateBlock(nSites/nThreads, T, P, Y, theta,
+                                    warmStart, blockConverged[0], errmsg[0]);
+        workers.join_all();
+        for (size_t i = 0; i < nThreads; i++) {
+            std::copy(blockConverged[i].begin(), blockConverged[i].end(),
+                      converged.begin() + i*nSites/nThreads);
+        }
+        for (size_t i = 1; i < nThreads; i++) {
+            delete kin[i];
+        }
+        for (size_t i = 0; i < copies.size(); i++) {
+            delete copies[i];
+        }
+#endif
+    }
+    for (size_t i = 0; i < nThreads; i++) {
+        if (!errmsg[i].empty()) {
+            bulk.restoreState(bulkState);
+            surf.restoreState(surfState);
+            throw CanteraError("InterfaceKinetics::solvePseudoSteadyStateBatch",
+                               errmsg[i]);
+        }
+    }
+
+    // Sites for which the Newton iteration failed are solved one at a time
+    // by the more robust (but much slower) surface problem solver.
+    for (size_t n = 0; n < nSites; n++) {
+        if (!converged[n]) {
+            bulk.setState_TPY(T[n], P[n], Y + n*kb);
+            surf.setState_TP(T[n], P[n]);
+            m_surf->setCoverages(&theta0[n*ks]);
+            solvePseudoSteadyStateProblem();
+            m_surf->getCoverages(theta + n*ks);
+        }
+    }
+    bulk.restoreState(bulkState);
+    surf.restoreState(surfState);
+}
+
+void InterfaceKinetics::solvePseudoSteadyStateBlock(
+    size_t nSites, const doublereal* T, const doublereal* P,
+    const doublereal* Y, doublereal* theta, bool warmStart,
+    vector_int& converged, std::string& errmsg)
+{
+    const int maxIter = 100;
+    const doublereal rtol = 1.0E-7;
+    const doublereal atol = 1.0E-14;
+    try {
+        size_t isurf = reactionPhaseIndex();
+        thermo_t& bulk = thermo(isurf == 0 ? 1 : 0);
+        size_t kb = bulk.nSpecies();
+        size_t ks = m_surf->nSpecies();
+        size_t kstart = m_start[isurf];
+        doublereal n0 = m_surf->siteDensity();
+
+        // Residuals and Jacobian blocks (column major) of the active sites
+        vector_fp resid(nSites*ks);
+        vector_fp jac(nSites*ks*ks);
+        // Inverse of the pseudo time step of each site. Negative until the
+        // first step, zero once the site has switched to Newton's method.
+        vector_fp invDt(nSites);
+        vector_fp invDt0(nSites);
+        // Largest rate of change of the coverages of each site
+        vector_fp fnorm(nSites);
+        vector_int ipiv(ks);
+        vector_fp wdot(m_kk);
+        SparseMatrix dwdot;
+        converged.assign(nSites, 0);
+
+        for (int pass = 0; pass < (warmStart ? 2 : 1); pass++) {
+            // Sites in the iteration
+            std::vector<size_t> active;
+            for (size_t i = 0; i < nSites; i++) {
+                if (converged[i]) {
+                    continue;
+                } else if (pass == 0) {
+                    invDt[i] = -1.0;
+                    active.push_back(i);
+                    continue;
+                }
+                // Restart from the solution of the nearest converged site
+                for (size_t d = 1; d < nSites; d++) {
+                    size_t j = npos;
+                    if (i >= d && converged[i-d]) {
+                        j = i - d;
+                    } else if (i + d < nSites && converged[i+d]) {
+                        j = i + d;
+                    }
+                    if (j != npos) {
+                        std::copy(theta + j*ks, theta + (j+1)*ks,
+                                  theta + i*ks);
+                        invDt[i] = -1.0;
+                        active.push_back(i);
+                        break;
+                    }
+                }
+            }
+
+            for (int iter = 0; iter < maxIter && !active.empty(); iter++) {
+                // Evaluate the residuals and the Jacobians of all active
+                // sites. The rates of change of the coverages are used for
+                // all species except the one with the largest coverage, for
+                // which the sum of the coverages is constrained instead.
+                for (size_t m = 0; m < active.size(); m++) {
+                    size_t n = active[m];
+                    doublereal* th = theta + n*ks;
+                    doublereal* f = &resid[m*ks];
+                    doublereal* J = &jac[m*ks*ks];
+                    bulk.setState_TPY(T[n], P[n], Y + n*kb);
+                    m_surf->setState_TP(T[n], P[n]);
+                    m_surf->setCoveragesNoNorm(th);
+                    getNetProductionRates(&wdot[0]);
+                    getNetProductionRates_ddCoverages(dwdot);
+                    const std::vector<size_t>& start = dwdot.rowStart();
+                    const std::vector<size_t>& col = dwdot.colIndex();
+                    const vector_fp& value = dwdot.values();
+                    std::fill(J, J + ks*ks, 0.0);
+                    for (size_t k = 0; k < ks; k++) {
+                        doublereal scale = m_surf->size(k) / n0;
+                        f[k] = wdot[kstart+k] * scale;
+                        for (size_t i = start[kstart+k];
+                             i < start[kstart+k+1]; i++) {
+                            J[k + ks*col[i]] = value[i] * scale;
+                        }
+                    }
+                    size_t kmax = std::max_element(th, th + ks) - th;
+                    f[kmax] = -1.0;
+                    for (size_t j = 0; j < ks; j++) {
+                        f[kmax] += th[j];
+                        J[kmax + ks*j] = 1.0;
+                    }
+
+                    // Pseudo-transient continuation: take implicit Euler
+                    // steps, starting from the time scale of the fastest
+                    // species. The step grows as the rates of change
+                    // decrease, until it is large enough to switch to
+                    // Newton's method. Damped steps shrink it again.
+                    doublereal fmax = 0.0;
+                    for (size_t k = 0; k < ks; k++) {
+                        if (k != kmax) {
+                            fmax = std::max(fmax, fabs(f[k]));
+                        }
+                    }
+                    if (invDt[n] < 0.0) {
+                        invDt[n] = 0.0;
+                        for (size_t k = 0; k < ks; k++) {
+                            if (k != kmax) {
+                                invDt[n] = std::max(invDt[n],
+                                                    fabs(J[k + ks*k]));
+                            }
+                        }
+                        invDt0[n] = invDt[n];
+                    } else if (invDt[n] > 0.0 && fnorm[n] > 0.0) {
+                        invDt[n] *= 0.25 * std::min(fmax / fnorm[n], 1.0);
+                        if (invDt[n] < 1.0E-8 * invDt0[n]) {
+                            invDt[n] = 0.0;
+                        }
+                    }
+                    fnorm[n] = fmax;
+                    for (size_t k = 0; k < ks; k++) {
+                        if (k != kmax) {
+                            J[k + ks*k] -= invDt[n];
+                        }
+                    }
+                }
+
+                // Factor and solve each block independently, and update the
+                // coverages. Sites with a singular Jacobian are dropped.
+                std::vector<size_t> next;
+                for (size_t m = 0; m < active.size(); m++) {
+                    size_t n = active[m];
+                    doublereal* th = theta + n*ks;
+                    doublereal* dx = &resid[m*ks];
+                    doublereal* J = &jac[m*ks*ks];
+                    int info = 0;
+                    ct_dgetrf(ks, ks, J, ks, &ipiv[0], info);
+                    if (info == 0) {
+                        ct_dgetrs(ctlapack::NoTranspose, ks, 1, J, ks,
+                                  &ipiv[0], dx, ks, info);
+                    }
+                    if (info != 0) {
+                        continue;
+                    }
+                    doublereal damp = coverageDamping(th, dx, ks);
+                    doublereal norm = 0.0;
+                    for (size_t k = 0; k < ks; k++) {
+                        norm = std::max(norm, fabs(dx[k]) /
+                                        (rtol * th[k] + atol));
+                        th[k] = std::max(0.0, th[k] - damp * dx[k]);
+                    }
+                    if (damp == 1.0 && invDt[n] == 0.0 && norm <= 1.0) {
+                        converged[n] = 1;
+                        continue;
+                    } else if (damp < 1.0) {
+                        invDt[n] = std::max(4.0 * invDt[n], 1.0E-8 * invDt0[n]);
+                    }
+                    next.push_back(n);
+                }
+                active.swap(next);
+            }
+        }
+    } catch (CanteraError& err) {
+        // exceptions cannot propagate out of a worker thread
+        errmsg = err.getMessage();
+    }
+}
+
 void InterfaceKinetics::setPhaseExistence(const size_t iphase, const int exists)
 {
     if (iphase >= m_thermo.size()) {
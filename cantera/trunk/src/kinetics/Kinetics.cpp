@@ -78,6 +78,9 @@ Kinetics& Kinetics::operator=(const Kinetics& right)
     m_ropr = right.m_ropr;
     m_ropnet = right.m_ropnet;
     m_skipUndeclaredSpecies = right.m_skipUndeclaredSpecies;
+    m_stoichNet = right.m_stoichNet;
+    m_stoichNetT = right.m_stoichNetT;
+    m_stoichRevNetT = right.m_stoichRevNetT;
 
     return *this;
 }
@@ -453,23 +456,39 @@ void Kinetics::getNetRatesOfProgress(doublereal* netROP)
     std::copy(m_ropnet.begin(), m_ropnet.end(), netROP);
 }
 
+void Kinetics::updateStoichMatrices()
+{
+    if (m_stoichNet.nRows() == m_kk && m_stoichNet.nColumns() == m_ii) {
+        return;
+    }
+    SparseTripletList coeffs, revCoeffs;
+    m_revProductStoich.stoichCoeffs(coeffs, 1.0);
+    m_reactantStoich.stoichCoeffs(coeffs, -1.0);
+    revCoeffs = coeffs;
+    m_irrevProductStoich.stoichCoeffs(coeffs, 1.0);
+    m_stoichNet.setFromTriplets(m_kk, m_ii, coeffs);
+
+    for (size_t n = 0; n < coeffs.size(); n++) {
+        std::swap(coeffs[n].row, coeffs[n].col);
+    }
+    m_stoichNetT.setFromTriplets(m_ii, m_kk, coeffs);
+
+    for (size_t n = 0; n < revCoeffs.size(); n++) {
+        std::swap(revCoeffs[n].row, revCoeffs[n].col);
+    }
+    m_stoichRevNetT.setFromTriplets(m_ii, m_kk, revCoeffs);
+}
+
 void Kinetics::getReactionDelta(const double* prop, double* deltaProp)
 {
-    fill(deltaProp, deltaProp + m_ii, 0.0);
-    // products add
-    m_revProductStoich.incrementReactions(prop, deltaProp);
-    m_irrevProductStoich.incrementReactions(prop, deltaProp);
-    // reactants subtract
-    m_reactantStoich.decrementReactions(prop, deltaProp);
+    updateStoichMatrices();
+    m_stoichNetT.mult(prop, deltaProp);
 }
 
 void Kinetics::getRevReactionDelta(const double* prop, double* deltaProp)
 {
-    fill(deltaProp, deltaProp + m_ii, 0.0);
-    // products add
-    m_revProductStoich.incrementReactions(prop, deltaProp);
-    // reactants subtract
-    m_reactantStoich.decrementReactions(prop, deltaProp);
+    updateStoichMatrices();
+    m_stoichRevNetT.mult(prop, deltaProp);
 }
 
 void Kinetics::getCreationRates(double* cdot)
@@ -502,12 +521,52 @@ void Kinetics::getNetProductionRates(doublereal* net)
 {
     updateROP();
 
-    fill(net, net + m_kk, 0.0);
-    // products are created for positive net rate of progress
-    m_revProductStoich.incrementSpecies(&m_ropnet[0], net);
-    m_irrevProductStoich.incrementSpecies(&m_ropnet[0], net);
-    // reactants are destroyed for positive net rate of progress
-    m_reactantStoich.decrementSpecies(&m_ropnet[0], net);
+    updateStoichMatrices();
+    m_stoichNet.mult(&m_ropnet[0], net);
+}
+
+void Kinetics::getNetProductionRates(size_t nStates, const doublereal* T,
+                                     const doublereal* P, const doublereal* Y,
+                                     doublereal* wdot)
+{
+    if (nPhases() != 1) {
+        throw CanteraError("Kinetics::getNetProductionRates",
+                           "Evaluation of multiple states is only supported "
+                           "for kinetics managers with a single phase.");
+    }
+    thermo_t& phase = thermo(0);
+    vector_fp state;
+    phase.saveState(state);
+    for (size_t n = 0; n < nStates; n++) {
+        phase.setState_TPY(T[n], P[n], Y + n*m_kk);
+        getNetProductionRates(wdot + n*m_kk);
+    }
+    phase.restoreState(state);
+}
+
+void Kinetics::getNetProductionRates_ddC(SparseMatrix& dwdot)
+{
+    updateStoichMatrices();
+    SparseMatrix drop;
+    getNetRatesOfProgress_ddC(drop);
+
+    // dwdot = N * drop, where N is the net stoichiometric coefficient matrix
+    SparseTripletList jac;
+    const vector<size_t>& start = drop.rowStart();
+    const vector<size_t>& col = drop.colIndex();
+    const vector_fp& value = drop.values();
+    const vector<size_t>& nuStart = m_stoichNetT.rowStart();
+    const vector<size_t>& nuSpecies = m_stoichNetT.colIndex();
+    const vector_fp& nu = m_stoichNetT.values();
+    for (size_t i = 0; i < m_ii; i++) {
+        for (size_t n = start[i]; n < start[i+1]; n++) {
+            for (size_t m = nuStart[i]; m < nuStart[i+1]; m++) {
+                jac.push_back(SparseTriplet(nuSpecies[m], col[n],
+                                            nu[m] * value[n]));
+            }
+        }
+    }
+    dwdot.setFromTriplets(m_kk, m_kk, jac);
 }
 
 void Kinetics::addPhase(thermo_t& thermo)
@@ -769,6 +828,16 @@ void Kinetics::addReaction(shared_ptr<Reaction> r)
     m_ropnet.push_back(0.0);
 }
 
+shared_ptr<Reaction> Kinetics::reaction(size_t i) const
+{
+    checkReactionIndex(i);
+    if (m_reactions.size() != nReactions()) {
+        throw CanteraError("Kinetics::reaction", "Reaction objects are not "
+                           "available for reactions added from ReactionData");
+    }
+    return m_reactions[i];
+}
+
 
 void Kinetics::installGroups(size_t irxn, const vector<grouplist_t>& r,
                              const vector<grouplist_t>& p)
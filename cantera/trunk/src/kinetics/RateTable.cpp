@@ -0,0 +1,129 @@
+//! @file RateTable.cpp
+
+#include "cantera/kinetics/RateTable.h"
+#include "cantera/base/ctexceptions.h"
+#include "cantera/base/stringUtils.h"
+
+using namespace std;
+
+namespace Cantera
+{
+
+const size_t RateTable::InterpolationPoints;
+
+RateTable::RateTable() :
+    m_ncols(0),
+    m_npoints(0),
+    m_Tmin(0.0),
+    m_Tmax(0.0),
+    m_xmin(0.0),
+    m_dx(0.0)
+{
+}
+
+void RateTable::setup(size_t nColumns, size_t nPoints, double Tmin,
+                      double Tmax)
+{
+    if (nPoints < InterpolationPoints) {
+        throw CanteraError("RateTable::setup", "At least " +
+                           int2str(InterpolationPoints) + " points are "
+                           "required, but only " + int2str(nPoints) +
+                           " were requested.");
+    }
+    if (Tmin <= 0.0 || Tmax <= Tmin) {
+        throw CanteraError("RateTable::setup", "Invalid temperature range: " +
+                           fp2str(Tmin) + " to " + fp2str(Tmax));
+    }
+    m_ncols = nColumns;
+    m_npoints = nPoints;
+    m_Tmin = Tmin;
+    m_Tmax = Tmax;
+    m_xmin = 1.0 / Tmax;
+    m_dx = (1.0 / Tmin - 1.0 / Tmax) / (nPoints - 1);
+    m_data.assign(nColumns * nPoints, 0.0);
+
+    // Denominators of the Lagrange basis polynomials for equally spaced
+    // points, 1/(i! (n-1-i)! (-1)^(n-1-i))
+    for (size_t i = 0; i < InterpolationPoints; i++) {
+        double d = 1.0;
+        for (size_t m = 0; m < InterpolationPoints; m++) {
+            if (m != i) {
+                d *= static_cast<double>(i) - static_cast<double>(m);
+            }
+        }
+        m_weights[i] = 1.0 / d;
+    }
+}
+
+void RateTable::clear()
+{
+    m_ncols = 0;
+    m_npoints = 0;
+    m_data.clear();
+}
+
+void RateTable::setValues(size_t j, const double* values)
+{
+    copy(values, values + m_ncols, m_data.begin() + j * m_ncols);
+}
+
+size_t RateTable::weights(double T, double* w) const
+{
+    // Position in the table, and the first of the points used for
+    // interpolation
+    const int np = static_cast<int>(InterpolationPoints);
+    double u = (1.0 / T - m_xmin) / m_dx;
+    int n = static_cast<int>(u) - (np / 2 - 1);
+    n = std::max(0, std::min(n, static_cast<int>(m_npoints) - np));
+    double s = u - n;
+
+    // Lagrange interpolation weights for the points n through n + np - 1
+    double left[InterpolationPoints], right[InterpolationPoints];
+    left[0] = 1.0;
+    right[np-1] = 1.0;
+    for (int i = 1; i < np; i++) {
+        left[i] = left[i-1] * (s - (i - 1));
+        right[np-1-i] = right[np-i] * (s - (np - i));
+    }
+    for (int i = 0; i < np; i++) {
+        w[i] = m_weights[i] * left[i] * right[i];
+    }
+    return n;
+}
+
+void RateTable::interpolate(double T, double* values) const
+{
+    const int np = static_cast<int>(InterpolationPoints);
+    double w[InterpolationPoints];
+    size_t n = weights(T, w);
+    const double* y[InterpolationPoints];
+    y[0] = &m_data[n * m_ncols];
+    for (int i = 1; i < np; i++) {
+        y[i] = y[i-1] + m_ncols;
+    }
+    for (size_t c = 0; c < m_ncols; c++) {
+        double v = 0.0;
+        for (int i = 0; i < np; i++) {
+            v += w[i] * y[i][c];
+        }
+        values[c] = v;
+    }
+}
+
+void RateTable::interpolate(double T, double* values,
+                            const std::vector<size_t>& columns) const
+{
+    const int np = static_cast<int>(InterpolationPoints);
+    double w[InterpolationPoints];
+    const double* y = &m_data[weights(T, w) * m_ncols];
+    for (size_t j = 0; j < columns.size(); j++) {
+        size_t c = columns[j];
+        double v = 0.0;
+        for (int i = 0; i < np; i++) {
+            v += w[i] * y[i * m_ncols + c];
+        }
+        values[c] = v;
+    }
+}
+
+}
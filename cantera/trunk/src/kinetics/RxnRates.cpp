@@ -257,6 +257,24 @@ Plog::Plog(const std::multimap<double, Arrhenius>& rates)
     Ea2_.resize(maxRates_);
 }
 
+std::vector<std::pair<double, Arrhenius> > Plog::rates() const
+{
+    std::vector<std::pair<double, Arrhenius> > R;
+    // Skip the duplicated groups for P -> 0 and P -> infinity
+    std::map<double, std::pair<size_t, size_t> >::const_iterator iter;
+    for (iter = ++pressures_.begin(); iter->first < 1000; iter++) {
+        size_t start = iter->second.first;
+        size_t stop = iter->second.second;
+        for (size_t i = start; i < stop; i++) {
+            // A is stored as log(A) for pressures with a single rate expression
+            double A = (stop - start == 1) ? std::exp(A_[i]) : A_[i];
+            R.push_back(std::make_pair(std::exp(iter->first),
+                                       Arrhenius(A, n_[i], Ea_[i])));
+        }
+    }
+    return R;
+}
+
 void Plog::validate(const std::string& equation)
 {
     double T[] = {200.0, 500.0, 1000.0, 2000.0, 5000.0, 10000.0};
@@ -280,7 +298,11 @@ void Plog::validate(const std::string& equation)
 }
 
 ChebyshevRate::ChebyshevRate(const ReactionData& rdata)
-    : nP_(rdata.chebDegreeP)
+    : Tmin_(rdata.chebTmin)
+    , Tmax_(rdata.chebTmax)
+    , Pmin_(rdata.chebPmin)
+    , Pmax_(rdata.chebPmax)
+    , nP_(rdata.chebDegreeP)
     , nT_(rdata.chebDegreeT)
     , chebCoeffs_(rdata.chebCoeffs)
     , dotProd_(rdata.chebDegreeT)
@@ -298,7 +320,11 @@ ChebyshevRate::ChebyshevRate(const ReactionData& rdata)
 
 ChebyshevRate::ChebyshevRate(double Pmin, double Pmax, double Tmin, double Tmax,
                              const Array2D& coeffs)
-    : nP_(coeffs.nColumns())
+    : Tmin_(Tmin)
+    , Tmax_(Tmax)
+    , Pmin_(Pmin)
+    , Pmax_(Pmax)
+    , nP_(coeffs.nColumns())
     , nT_(coeffs.nRows())
     , chebCoeffs_(coeffs.nColumns() * coeffs.nRows(), 0.0)
     , dotProd_(coeffs.nRows())
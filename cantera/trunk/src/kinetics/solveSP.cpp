@@ -117,6 +117,23 @@ solveSP::solveSP(ImplicitSurfChem* surfChemPtr, int bulkFunc) :
         }
     }
 
+    m_eqnIndexKinSpecies.resize(m_numSurfPhases);
+    for (isp = 0; isp < m_numSurfPhases; isp++) {
+        InterfaceKinetics* kin = m_objects[isp];
+        m_eqnIndexKinSpecies[isp].assign(kin->nTotalSpecies(), npos);
+        for (size_t jsp = 0; jsp < m_numSurfPhases; jsp++) {
+            for (size_t ip = 0; ip < kin->nPhases(); ip++) {
+                if (&kin->thermo(ip) == m_ptrsSurfPhase[jsp]) {
+                    kstart = kin->kineticsSpeciesIndex(0, ip);
+                    for (k = 0; k < m_nSpeciesSurfPhase[jsp]; k++) {
+                        m_eqnIndexKinSpecies[isp][kstart + k] =
+                            m_eqnIndexStartSolnPhase[jsp] + k;
+                    }
+                }
+            }
+        }
+    }
+
     // Dimension solution vector
     size_t dim1 = std::max<size_t>(1, m_neq);
     m_CSolnSP.resize(dim1, 0.0);
@@ -565,6 +582,52 @@ void solveSP::resjac_eval(SquareMatrix& jac,
      * Calculate the residual
      */
     fun_eval(resid, CSoln, CSolnOld, do_time, deltaT);
+
+    if (m_bulkFunc != BULK_DEPOSITION) {
+        /*
+         * Assemble the Jacobian from the analytic derivatives of the net
+         * production rates. fun_eval() has set the state of the surface
+         * phases to CSoln.
+         */
+        jac.zero();
+        SparseMatrix dwdot;
+        size_t kindexSP = 0;
+        for (jsp = 0; jsp < m_numSurfPhases; jsp++) {
+            nsp = m_nSpeciesSurfPhase[jsp];
+            InterfaceKinetics* kinPtr = m_objects[jsp];
+            size_t kstart = kinPtr->kineticsSpeciesIndex(0,
+                                kinPtr->surfacePhaseIndex());
+            const std::vector<size_t>& eqn = m_eqnIndexKinSpecies[jsp];
+            kinPtr->getNetProductionRates_ddC(dwdot);
+            const std::vector<size_t>& start = dwdot.rowStart();
+            const std::vector<size_t>& col = dwdot.colIndex();
+            const vector_fp& value = dwdot.values();
+            for (kCol = 0; kCol < nsp; kCol++) {
+                size_t irow = kindexSP + kCol;
+                for (size_t n = start[kstart + kCol];
+                     n < start[kstart + kCol + 1]; n++) {
+                    if (eqn[col[n]] != npos) {
+                        jac(irow, eqn[col[n]]) -= value[n];
+                    }
+                }
+                if (do_time) {
+                    jac(irow, irow) += 1.0 / deltaT;
+                }
+            }
+            // The equation for the largest species is replaced by the site
+            // conservation equation
+            size_t kspecial = kindexSP + m_spSurfLarge[jsp];
+            for (i = 0; i < m_neq; i++) {
+                jac(kspecial, i) = 0.0;
+            }
+            for (kCol = 0; kCol < nsp; kCol++) {
+                jac(kspecial, kindexSP + kCol) = -1.0;
+            }
+            kindexSP += nsp;
+        }
+        return;
+    }
+
     /*
      * Now we will look over the columns perturbing each unknown.
      */
@@ -0,0 +1,337 @@
+//! @file AdjointSolver.cpp
+
+#include "AdjointSolver.h"
+#include "cantera/numerics/Integrator.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace Cantera
+{
+
+AdjointSolver::AdjointSolver(FuncEval& func, int nsteps) :
+    m_func(func),
+    m_neq(func.neq()),
+    m_np(func.nparams()),
+    m_nsteps(nsteps),
+    m_stepCount(0),
+    m_reltol(1.0e-9),
+    m_reltolsens(1.0e-5),
+    m_abstolsens(1.0e-4),
+    m_hmax(0.0),
+    m_abstol(m_neq, 1.0e-15),
+    m_tf(0.0),
+    m_ktop(0),
+    m_lastUsed(0),
+    m_recompute(*this),
+    m_forward(0),
+    m_backward(0),
+    m_params(m_np, 1.0),
+    m_lambda0(m_neq),
+    m_q(m_np),
+    m_y(m_neq),
+    m_ydot(m_neq),
+    m_qdot(m_np),
+    m_ewt(m_neq),
+    m_jac(m_neq * m_neq),
+    m_jacCols(m_neq)
+{
+    if (nsteps < 1) {
+        throw CanteraError("AdjointSolver::AdjointSolver",
+                           "The number of steps between checkpoints must be "
+                           "positive.");
+    }
+    for (size_t j = 0; j < m_neq; j++) {
+        m_jacCols[j] = &m_jac[j * m_neq];
+    }
+    m_forward = newAuxIntegrator();
+    m_backward = newAuxIntegrator();
+    m_backward->setProblemType(DENSE + JAC);
+}
+
+AdjointSolver::~AdjointSolver()
+{
+    delete m_forward;
+    delete m_backward;
+}
+
+Integrator* AdjointSolver::newAuxIntegrator()
+{
+    Integrator* integ = newIntegrator("CVODE");
+    integ->setMethod(BDF_Method);
+    integ->setProblemType(DENSE + NOJAC);
+    integ->setIterator(Newton_Iter);
+    return integ;
+}
+
+void AdjointSolver::setTolerances(double reltol, const vector_fp& abstol)
+{
+    m_reltol = reltol;
+    m_abstol = abstol;
+    m_abstol.resize(m_neq, abstol.empty() ? 1.0e-15 : abstol.back());
+}
+
+void AdjointSolver::setSensitivityTolerances(double reltol, double abstol)
+{
+    m_reltolsens = reltol;
+    m_abstolsens = abstol;
+}
+
+void AdjointSolver::setMaxStepSize(double hmax)
+{
+    m_hmax = hmax;
+}
+
+void AdjointSolver::start(double t0, const double* y0)
+{
+    m_ckTime.assign(1, t0);
+    m_ckState.assign(1, vector_fp(y0, y0 + m_neq));
+    m_stepCount = 0;
+    m_intervals[0].checkpoint = npos;
+    m_intervals[1].checkpoint = npos;
+}
+
+void AdjointSolver::addStep(double t, const double* y)
+{
+    m_stepCount++;
+    if (m_stepCount % m_nsteps == 0) {
+        m_ckTime.push_back(t);
+        m_ckState.push_back(vector_fp(y, y + m_neq));
+    }
+}
+
+void AdjointSolver::Recompute::eval(double t, double* y, double* ydot,
+                                    double* p)
+{
+    m_parent.m_func.eval(t, y, ydot, m_parent.params());
+}
+
+void AdjointSolver::Recompute::getInitialConditions(double t0, size_t leny,
+                                                    double* y)
+{
+    const vector_fp& yk = m_parent.m_ckState[m_checkpoint];
+    copy(yk.begin(), yk.end(), y);
+}
+
+const AdjointSolver::Interval& AdjointSolver::interval(size_t k)
+{
+    for (size_t j = 0; j < 2; j++) {
+        if (m_intervals[j].checkpoint == k) {
+            m_lastUsed = j;
+            return m_intervals[j];
+        }
+    }
+
+    // Replace the least recently used interval
+    m_lastUsed = 1 - m_lastUsed;
+    Interval& iv = m_intervals[m_lastUsed];
+    iv.checkpoint = npos;
+    iv.time.clear();
+    iv.y.clear();
+    iv.ydot.clear();
+
+    double tend = (k == m_ktop) ? m_tf : m_ckTime[k+1];
+    m_recompute.m_checkpoint = k;
+    m_forward->setTolerances(m_reltol, m_neq, &m_abstol[0]);
+    if (m_hmax > 0.0) {
+        m_forward->setMaxStepSize(m_hmax);
+    }
+    m_forward->initialize(m_ckTime[k], m_recompute);
+    double t = m_ckTime[k];
+    const double* y = &m_ckState[k][0];
+    while (true) {
+        iv.time.push_back(t);
+        iv.y.insert(iv.y.end(), y, y + m_neq);
+        copy(y, y + m_neq, m_y.begin());
+        m_func.eval(t, &m_y[0], &m_ydot[0], params());
+        iv.ydot.insert(iv.ydot.end(), m_ydot.begin(), m_ydot.end());
+        if (t >= tend) {
+            break;
+        }
+        t = m_forward->step(tend);
+        y = m_forward->solution();
+    }
+    iv.checkpoint = k;
+    return iv;
+}
+
+size_t AdjointSolver::intervalIndex(double t) const
+{
+    size_t k = lower_bound(m_ckTime.begin(), m_ckTime.begin() + m_ktop + 1, t)
+               - m_ckTime.begin();
+    return (k == 0) ? 0 : k - 1;
+}
+
+size_t AdjointSolver::stepIndex(const Interval& iv, double t) const
+{
+    size_t i = lower_bound(iv.time.begin(), iv.time.end(), t)
+               - iv.time.begin();
+    i = std::min(std::max<size_t>(i, 1), iv.time.size() - 1);
+    return i - 1;
+}
+
+void AdjointSolver::interpolate(double t, double* y)
+{
+    const Interval& iv = interval(intervalIndex(t));
+    if (t < iv.time[0]) {
+        // The last step of the adjoint integration may pass the initial
+        // time. The first forward steps can be very short, so extrapolate
+        // linearly instead of with the Hermite polynomial.
+        for (size_t n = 0; n < m_neq; n++) {
+            y[n] = iv.y[n] + (t - iv.time[0]) * iv.ydot[n];
+        }
+        return;
+    }
+    size_t i = stepIndex(iv, t);
+    double h = iv.time[i+1] - iv.time[i];
+    double x = (t - iv.time[i]) / h;
+    double h00 = (1 + 2*x) * (1 - x) * (1 - x);
+    double h10 = h * x * (1 - x) * (1 - x);
+    double h01 = x * x * (3 - 2*x);
+    double h11 = h * x * x * (x - 1);
+    const double* y0 = &iv.y[i * m_neq];
+    const double* y1 = y0 + m_neq;
+    const double* f0 = &iv.ydot[i * m_neq];
+    const double* f1 = f0 + m_neq;
+    for (size_t n = 0; n < m_neq; n++) {
+        y[n] = h00 * y0[n] + h10 * f0[n] + h01 * y1[n] + h11 * f1[n];
+    }
+}
+
+void AdjointSolver::eval(double s, double* lambda, double* lambdadot,
+                         double* p)
+{
+    double t = m_tf - s;
+    interpolate(t, &m_y[0]);
+    m_func.evalAdjoint(t, &m_y[0], lambda, lambdadot, params());
+    for (size_t n = 0; n < m_neq; n++) {
+        lambdadot[n] = -lambdadot[n];
+    }
+}
+
+void AdjointSolver::getInitialConditions(double s0, size_t leny,
+                                         double* lambda)
+{
+    copy(m_lambda0.begin(), m_lambda0.end(), lambda);
+}
+
+void AdjointSolver::evalJacobian(double s, double* lambda,
+                                 const double* lambdadot, const double* ewt,
+                                 double* p, double* const* jacCols)
+{
+    // The increments in the forward solution are based on its tolerances,
+    // not on the error weights of the adjoint variables
+    double t = m_tf - s;
+    interpolate(t, &m_y[0]);
+    for (size_t n = 0; n < m_neq; n++) {
+        m_ewt[n] = 1.0 / (m_reltol * fabs(m_y[n]) + m_abstol[n]);
+    }
+    m_func.eval(t, &m_y[0], &m_ydot[0], params());
+    m_func.evalJacobian(t, &m_y[0], &m_ydot[0], &m_ewt[0], params(),
+                        &m_jacCols[0]);
+
+    // d(J^T lambda)_i / d(lambda_j) = J_ji
+    for (size_t j = 0; j < m_neq; j++) {
+        for (size_t i = 0; i < m_neq; i++) {
+            jacCols[j][i] = m_jacCols[i][j];
+        }
+    }
+}
+
+void AdjointSolver::addQuadratures(double tlo, double thi, double s0,
+                                   double s1, const vector_fp& lambda0,
+                                   const vector_fp& ldot0,
+                                   const vector_fp& lambda1,
+                                   const vector_fp& ldot1)
+{
+    // Three-point Gauss-Legendre rule on [-1, 1]
+    static const double xg[3] = {-0.774596669241483377, 0.0,
+                                 0.774596669241483377};
+    static const double wg[3] = {5.0/9.0, 8.0/9.0, 5.0/9.0};
+    vector_fp lambda(m_neq);
+    double hs = s1 - s0;
+
+    // Integrate over each step of the forward solution in (tlo, thi)
+    double t = thi;
+    while (t > tlo) {
+        const Interval& iv = interval(intervalIndex(t));
+        double ta = std::max(iv.time[stepIndex(iv, t)], tlo);
+        double tmid = 0.5 * (t + ta);
+        double half = 0.5 * (t - ta);
+        for (size_t g = 0; g < 3; g++) {
+            double tg = tmid + half * xg[g];
+            double x = (m_tf - tg - s0) / hs;
+            double h00 = (1 + 2*x) * (1 - x) * (1 - x);
+            double h10 = hs * x * (1 - x) * (1 - x);
+            double h01 = x * x * (3 - 2*x);
+            double h11 = hs * x * x * (x - 1);
+            for (size_t n = 0; n < m_neq; n++) {
+                lambda[n] = h00 * lambda0[n] + h10 * ldot0[n] +
+                            h01 * lambda1[n] + h11 * ldot1[n];
+            }
+            interpolate(tg, &m_y[0]);
+            m_func.evalAdjointQuadrature(tg, &m_y[0], &lambda[0], &m_qdot[0],
+                                         params());
+            for (size_t j = 0; j < m_np; j++) {
+                m_q[j] += wg[g] * half * m_qdot[j];
+            }
+        }
+        t = ta;
+    }
+}
+
+void AdjointSolver::solve(double tf, double* lambda, double* dgdp)
+{
+    if (m_ckTime.empty()) {
+        throw CanteraError("AdjointSolver::solve",
+                           "The forward integration has not been started.");
+    }
+    double t0 = m_ckTime[0];
+    fill(m_q.begin(), m_q.end(), 0.0);
+    if (tf <= t0) {
+        // The solution has not been advanced, so g depends only on the
+        // initial conditions.
+        copy(m_q.begin(), m_q.end(), dgdp);
+        return;
+    }
+
+    m_tf = tf;
+    m_ktop = lower_bound(m_ckTime.begin(), m_ckTime.end(), tf)
+             - m_ckTime.begin() - 1;
+    // Steps added since the last call may have changed the last interval
+    m_intervals[0].checkpoint = npos;
+    m_intervals[1].checkpoint = npos;
+
+    copy(lambda, lambda + m_neq, m_lambda0.begin());
+    m_backward->setTolerances(m_reltolsens, m_abstolsens);
+    m_backward->initialize(0.0, *this);
+
+    // Integrate in the reversed time s = tf - t, from s = 0 to s = tf - t0,
+    // one step at a time, adding the quadratures over each step
+    double send = tf - t0;
+    vector_fp lambda0(m_lambda0), ldot0(m_neq), lambda1(m_neq), ldot1(m_neq);
+    eval(0.0, &lambda0[0], &ldot0[0], 0);
+    double s0 = 0.0;
+    while (true) {
+        double s1 = m_backward->step(send);
+        copy(m_backward->solution(), m_backward->solution() + m_neq,
+             lambda1.begin());
+        eval(s1, &lambda1[0], &ldot1[0], 0);
+        addQuadratures(tf - std::min(s1, send), tf - s0, s0, s1,
+                       lambda0, ldot0, lambda1, ldot1);
+        if (s1 >= send) {
+            break;
+        }
+        s0 = s1;
+        lambda0.swap(lambda1);
+        ldot0.swap(ldot1);
+    }
+
+    // Interpolate the adjoint variables back to the initial time
+    m_backward->integrate(send);
+    copy(m_backward->solution(), m_backward->solution() + m_neq, lambda);
+    copy(m_q.begin(), m_q.end(), dgdp);
+}
+
+}
@@ -0,0 +1,190 @@
+/**
+ *  @file AdjointSolver.h
+ *  Checkpointed adjoint sensitivity analysis, used by the ODE integrators
+ *  (see \ref odeGroup)
+ */
+
+#ifndef CT_ADJOINTSOLVER_H
+#define CT_ADJOINTSOLVER_H
+
+#include "cantera/numerics/FuncEval.h"
+
+namespace Cantera
+{
+
+class Integrator;
+
+//! Adjoint sensitivity analysis for the solution of an ODE integrator.
+/*!
+ *  The integrator which owns this object calls addStep() after each of its
+ *  internal time steps, and every *nsteps* steps the solution is stored as a
+ *  checkpoint. solve() integrates the adjoint equations
+ *  \f[
+ *      \dot{\vec{\lambda}} = -J^T \vec{\lambda}, \qquad
+ *      \frac{dg}{dp_j} = \int_{t_0}^{t_f} \vec{\lambda}^T
+ *          \frac{\partial \vec{F}}{\partial p_j} \, dt
+ *  \f]
+ *  backwards from the current time to the initial time with a separate
+ *  integrator. The forward solution needed by the adjoint equations is
+ *  recomputed from each checkpoint in turn, and is interpolated between the
+ *  steps of the recomputed solution with cubic Hermite polynomials. The
+ *  quadratures are evaluated with three-point Gauss-Legendre rules on each
+ *  step of the recomputed forward solution.
+ *
+ *  The integrator doing the forward integration is not used by solve(), so
+ *  the forward integration can be continued afterwards, and solve() may be
+ *  called again at a later time.
+ *
+ *  The right-hand side of the adjoint equations and the integrands of the
+ *  quadratures are evaluated with FuncEval::evalAdjoint() and
+ *  FuncEval::evalAdjointQuadrature(). The Jacobian of the adjoint equations
+ *  is the transpose of FuncEval::evalJacobian().
+ *
+ *  @ingroup odeGroup
+ */
+class AdjointSolver : public FuncEval
+{
+public:
+    //! Constructor.
+    /*!
+     *  @param func    Right-hand side of the forward problem
+     *  @param nsteps  Number of forward integrator steps between checkpoints
+     */
+    AdjointSolver(FuncEval& func, int nsteps);
+    virtual ~AdjointSolver();
+
+    //! Set the error tolerances used to recompute the forward solution.
+    //! These should be the tolerances of the forward integration.
+    void setTolerances(double reltol, const vector_fp& abstol);
+
+    //! Set the error tolerances for the adjoint variables
+    void setSensitivityTolerances(double reltol, double abstol);
+
+    //! Set the maximum step size used to recompute the forward solution
+    void setMaxStepSize(double hmax);
+
+    //! Discard all checkpoints and start a new forward solution at time
+    //! *t0*, with initial state *y0*.
+    void start(double t0, const double* y0);
+
+    //! Register an internal step of the forward integration, which reached
+    //! time *t* with solution *y*.
+    void addStep(double t, const double* y);
+
+    //! Number of stored checkpoints, including the initial state
+    size_t nCheckpoints() const {
+        return m_ckTime.size();
+    }
+
+    //! Integrate the adjoint equations backwards from time *tf* to the
+    //! initial time. See Integrator::integrateAdjoint() for a description of
+    //! the arguments.
+    void solve(double tf, double* lambda, double* dgdp);
+
+    //! @name Right-hand side of the adjoint equations
+    //!
+    //! The adjoint equations are integrated in the reversed time
+    //! \f$ s = t_f - t \f$.
+    //! @{
+    virtual void eval(double s, double* lambda, double* lambdadot,
+                      double* p);
+    virtual void getInitialConditions(double s0, size_t leny,
+                                      double* lambda);
+    virtual size_t neq() {
+        return m_neq;
+    }
+    virtual void evalJacobian(double s, double* lambda,
+                              const double* lambdadot, const double* ewt,
+                              double* p, double* const* jacCols);
+    //! @}
+
+private:
+    //! The forward solution recomputed from one checkpoint
+    struct Interval {
+        Interval() : checkpoint(npos) {}
+        size_t checkpoint; //!< Index of the checkpoint, or npos if unused
+        vector_fp time; //!< Times of the steps
+        vector_fp y; //!< Solution at each step, `neq` values per step
+        vector_fp ydot; //!< Right-hand side at each step
+    };
+
+    //! Right-hand side of the forward problem, with initial conditions taken
+    //! from a checkpoint
+    class Recompute : public FuncEval
+    {
+    public:
+        explicit Recompute(AdjointSolver& parent) : m_parent(parent) {}
+        virtual void eval(double t, double* y, double* ydot, double* p);
+        virtual void getInitialConditions(double t0, size_t leny, double* y);
+        virtual size_t neq() {
+            return m_parent.m_neq;
+        }
+        size_t m_checkpoint;
+    private:
+        AdjointSolver& m_parent;
+    };
+    friend class Recompute;
+
+    //! Create an integrator for one of the auxiliary problems
+    Integrator* newAuxIntegrator();
+
+    //! The sensitivity parameter vector passed to #m_func
+    double* params() {
+        return m_params.empty() ? 0 : &m_params[0];
+    }
+
+    //! The forward solution recomputed from checkpoint *k*. Keeps the two
+    //! most recently used intervals, since steps of the adjoint integration
+    //! which cross a checkpoint need both of them.
+    const Interval& interval(size_t k);
+
+    //! Index of the checkpoint interval containing time *t*
+    size_t intervalIndex(double t) const;
+
+    //! Index of the step *i* of the forward solution such that
+    //! `iv.time[i] < t <= iv.time[i+1]`, or the first or last step if *t* is
+    //! outside the recomputed interval
+    size_t stepIndex(const Interval& iv, double t) const;
+
+    //! Interpolate the forward solution to time *t*, or extrapolate it if
+    //! *t* is before the initial time
+    void interpolate(double t, double* y);
+
+    //! Add the quadratures over `(tlo, thi)` to #m_q. The adjoint variables
+    //! are interpolated from their values and derivatives at the reversed
+    //! times *s0* and *s1*.
+    void addQuadratures(double tlo, double thi, double s0, double s1,
+                        const vector_fp& lambda0, const vector_fp& ldot0,
+                        const vector_fp& lambda1, const vector_fp& ldot1);
+
+    FuncEval& m_func; //!< Right-hand side of the forward problem
+    size_t m_neq;
+    size_t m_np;
+    int m_nsteps; //!< Number of steps between checkpoints
+    int m_stepCount; //!< Number of forward steps since start()
+
+    double m_reltol, m_reltolsens, m_abstolsens, m_hmax;
+    vector_fp m_abstol;
+
+    vector_fp m_ckTime; //!< Times of the checkpoints
+    std::vector<vector_fp> m_ckState; //!< Solution at each checkpoint
+
+    double m_tf; //!< Final time of the current adjoint integration
+    size_t m_ktop; //!< Index of the last checkpoint before #m_tf
+    Interval m_intervals[2];
+    size_t m_lastUsed; //!< Index in #m_intervals of the last used interval
+
+    Recompute m_recompute;
+    Integrator* m_forward; //!< Integrator for recomputing the solution
+    Integrator* m_backward; //!< Integrator for the adjoint equations
+
+    vector_fp m_params; //!< Sensitivity parameter values (all 1.0)
+    vector_fp m_lambda0; //!< Initial conditions of the adjoint variables
+    vector_fp m_q; //!< Sensitivity quadratures
+    vector_fp m_y, m_ydot, m_qdot, m_ewt, m_jac; //!< Work arrays
+    std::vector<double*> m_jacCols;
+};
+
+}
+
+#endif
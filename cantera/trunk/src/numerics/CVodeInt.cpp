@@ -5,6 +5,7 @@
 // Copyright 2001  California Institute of Technology
 
 #include "CVodeInt.h"
+#include "AdjointSolver.h"
 using namespace std;
 
 // cvode includes
@@ -39,8 +40,10 @@ extern "C" {
     }
 
     /**
-     *  Function called by cvode to evaluate the Jacobian matrix.
-     *  (temporary)
+     *  Function called by cvode to evaluate the Jacobian matrix, when the
+     *  problem type is DENSE + JAC. The Jacobian is evaluated by
+     *  FuncEval::evalJacobian, using the error weights to set the finite
+     *  difference increments if it is not overridden.
      *  @ingroup odeGroup
      */
     static void cvode_jac(integer N, DenseMat J, RhsFn f, void* f_data,
@@ -48,29 +51,9 @@ extern "C" {
                           void* jac_data, long int* nfePtr, N_Vector vtemp1, N_Vector vtemp2,
                           N_Vector vtemp3)
     {
-        // get pointers to start of data
-        double* ydata = N_VDATA(y);
-        double* fydata = N_VDATA(fy);
-        double* ewtdata = N_VDATA(ewt);
-        double* ydot = N_VDATA(vtemp1);
-
         Cantera::FuncEval* func = (Cantera::FuncEval*)f_data;
-
-        int i,j;
-        double* col_j;
-        double ysave, dy;
-        for (j=0; j < N; j++) {
-            col_j = (J->data)[j];
-            ysave = ydata[j];
-            dy = 1.0/ewtdata[j];
-            ydata[j] = ysave + dy;
-            dy = ydata[j] - ysave;
-            func->eval(t, ydata, ydot, NULL);
-            for (i=0; i < N; i++) {
-                col_j[i] = (ydot[i] - fydata[i])/dy;
-            }
-            ydata[j] = ysave;
-        }
+        func->evalJacobian(t, N_VDATA(y), N_VDATA(fy), N_VDATA(ewt), NULL,
+                           J->data);
     }
 }
 
@@ -90,7 +73,14 @@ CVodeInt::CVodeInt() : m_neq(0),
     m_abstols(1.e-15),
     m_nabs(0),
     m_hmax(0.0),
-    m_maxsteps(20000)
+    m_maxsteps(20000),
+    m_time(0.0),
+    m_tInternal(0.0),
+    m_reltolsens(1.0e-5),
+    m_abstolsens(1.0e-4),
+    m_adjoint(false),
+    m_adjointSteps(100),
+    m_adj(0)
 {
     m_ropt.resize(OPT_SIZE,0.0);
     m_iopt = new long[OPT_SIZE];
@@ -109,6 +99,7 @@ CVodeInt::~CVodeInt()
         N_VFree(m_abstol);
     }
     delete[] m_iopt;
+    delete m_adj;
 }
 
 double& CVodeInt::solution(size_t k)
@@ -143,6 +134,12 @@ void CVodeInt::setTolerances(double reltol, double abstol)
     m_abstols = abstol;
 }
 
+void CVodeInt::setSensitivityTolerances(double reltol, double abstol)
+{
+    m_reltolsens = reltol;
+    m_abstolsens = abstol;
+}
+
 void CVodeInt::setProblemType(int probtype)
 {
     m_type = probtype;
@@ -243,6 +240,7 @@ void CVodeInt::initialize(double t0, FuncEval& func)
     } else {
         throw CVodeErr("unsupported option");
     }
+    adjointInit(func);
 }
 
 void CVodeInt::reinitialize(double t0, FuncEval& func)
@@ -286,16 +284,59 @@ void CVodeInt::reinitialize(double t0, FuncEval& func)
     } else {
         throw CVodeErr("unsupported option");
     }
+    adjointInit(func);
+}
+
+void CVodeInt::adjointInit(FuncEval& func)
+{
+    m_time = m_t0;
+    m_tInternal = m_t0;
+    delete m_adj;
+    m_adj = 0;
+    if (!m_adjoint) {
+        return;
+    }
+    m_adj = new AdjointSolver(func, m_adjointSteps);
+    vector_fp abstol(m_neq, m_abstols);
+    if (m_itol) {
+        for (int i = 0; i < m_neq; i++) {
+            abstol[i] = N_VIth(m_abstol, i);
+        }
+    }
+    m_adj->setTolerances(m_reltol, abstol);
+    m_adj->setSensitivityTolerances(m_reltolsens, m_abstolsens);
+    m_adj->setMaxStepSize(m_hmax);
+    m_adj->start(m_t0, N_VDATA(m_y));
 }
 
 void CVodeInt::integrate(double tout)
 {
     double t;
     int flag;
-    flag = CVode(m_cvode_mem, tout, m_y, &t, NORMAL);
-    if (flag != SUCCESS) {
-        throw CVodeErr(" CVode error encountered. Error code: " + int2str(flag));
+    if (m_adjoint) {
+        // Take single steps so that the solution can be checkpointed, then
+        // interpolate to tout
+        while (m_tInternal < tout) {
+            flag = CVode(m_cvode_mem, tout, m_y, &t, ONE_STEP);
+            if (flag != SUCCESS) {
+                throw CVodeErr(" CVode error encountered. Error code: " +
+                               int2str(flag));
+            }
+            m_tInternal = t;
+            m_adj->addStep(t, N_VDATA(m_y));
+        }
+        flag = CVodeDky(m_cvode_mem, tout, 0, m_y);
+        if (flag != OKAY) {
+            throw CVodeErr(" CVodeDky error encountered. Error code: " +
+                           int2str(flag));
+        }
+    } else {
+        flag = CVode(m_cvode_mem, tout, m_y, &t, NORMAL);
+        if (flag != SUCCESS) {
+            throw CVodeErr(" CVode error encountered. Error code: " + int2str(flag));
+        }
     }
+    m_time = tout;
 }
 
 double CVodeInt::step(double tout)
@@ -306,9 +347,29 @@ double CVodeInt::step(double tout)
     if (flag != SUCCESS) {
         throw CVodeErr(" CVode error encountered. Error code: " + int2str(flag));
     }
+    if (m_adjoint) {
+        m_tInternal = t;
+        m_adj->addStep(t, N_VDATA(m_y));
+    }
+    m_time = t;
     return t;
 }
 
+void CVodeInt::setAdjoint(bool adjoint, int nsteps)
+{
+    m_adjoint = adjoint;
+    m_adjointSteps = nsteps;
+}
+
+void CVodeInt::integrateAdjoint(double* lambda, double* dgdp)
+{
+    if (!m_adj) {
+        throw CVodeErr("integrateAdjoint: adjoint sensitivity analysis "
+                       "must be enabled before initializing the integrator");
+    }
+    m_adj->solve(m_time, lambda, dgdp);
+}
+
 int CVodeInt::nEvals() const
 {
     return m_iopt[NFE];
@@ -15,6 +15,8 @@
 namespace Cantera
 {
 
+class AdjointSolver;
+
 /**
  * Exception thrown when a CVODE error is encountered.
  */
@@ -42,6 +44,7 @@ public:
     virtual ~CVodeInt();
     virtual void setTolerances(double reltol, size_t n, double* abstol);
     virtual void setTolerances(double reltol, double abstol);
+    virtual void setSensitivityTolerances(double reltol, double abstol);
     virtual void setProblemType(int probtype);
     virtual void initialize(double t0, FuncEval& func);
     virtual void reinitialize(double t0, FuncEval& func);
@@ -62,8 +65,14 @@ public:
     virtual void setMinStepSize(double hmin);
     virtual void setMaxSteps(int nmax);
     virtual void setMaxErrTestFails(int nmax) {}
+    virtual void setAdjoint(bool adjoint, int nsteps=100);
+    virtual void integrateAdjoint(double* lambda, double* dgdp);
 
 private:
+    //! Start storing checkpoints for adjoint sensitivity analysis, if it is
+    //! enabled
+    void adjointInit(FuncEval& func);
+
     int m_neq;
     void* m_cvode_mem;
     double m_t0;
@@ -82,6 +91,20 @@ private:
     vector_fp m_ropt;
     long int* m_iopt;
     void* m_data;
+
+    double m_time; //!< The time of the solution in #m_y
+    double m_tInternal; //!< The time reached by the internal steps
+    double m_reltolsens, m_abstolsens;
+
+    //! True if adjoint sensitivity analysis is enabled
+    bool m_adjoint;
+
+    //! Number of steps between checkpoints for adjoint sensitivity analysis
+    int m_adjointSteps;
+
+    //! Checkpoints of the solution and adjoint integration, if adjoint
+    //! sensitivity analysis is enabled
+    AdjointSolver* m_adj;
 };
 
 }    // namespace
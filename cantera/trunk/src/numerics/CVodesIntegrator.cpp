@@ -5,6 +5,7 @@
 // Copyright 2001  California Institute of Technology
 #include "cantera/numerics/CVodesIntegrator.h"
 #include "cantera/base/stringUtils.h"
+#include "AdjointSolver.h"
 
 #include <iostream>
 using namespace std;
@@ -27,6 +28,12 @@ using namespace std;
 #define CV_SS 1
 #define CV_SV 2
 
+#if SUNDIALS_VERSION < 25
+typedef int sd_size_t;
+#else
+typedef long int sd_size_t;
+#endif
+
 #include <sstream>
 
 namespace Cantera
@@ -38,10 +45,13 @@ public:
     FuncData(FuncEval* f, int npar = 0) {
         m_pars.resize(npar, 1.0);
         m_func = f;
+        m_cvode_mem = 0;
     }
     virtual ~FuncData() {}
     vector_fp m_pars;
     FuncEval* m_func;
+    //! The cvodes solver, used to get the error weights for the Jacobian
+    void* m_cvode_mem;
 };
 
 extern "C" {
@@ -78,6 +88,29 @@ extern "C" {
         return 0; // successful evaluation
     }
 
+    //! Function called by cvodes to evaluate the Jacobian when the problem
+    //! type is DENSE + JAC. The current error weights are passed to
+    //! FuncEval::evalJacobian, in the work vector `tmp1`.
+    static int cvodes_jac(sd_size_t N, realtype t, N_Vector y, N_Vector fy,
+                          DlsMat Jac, void* f_data, N_Vector tmp1,
+                          N_Vector tmp2, N_Vector tmp3)
+    {
+        try {
+            Cantera::FuncData* d = (Cantera::FuncData*)f_data;
+            double* p = (d->m_pars.size() == 0) ? NULL : DATA_PTR(d->m_pars);
+            CVodeGetErrWeights(d->m_cvode_mem, tmp1);
+            d->m_func->evalJacobian(t, NV_DATA_S(y), NV_DATA_S(fy),
+                                    NV_DATA_S(tmp1), p, Jac->cols);
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+            return 1; // possibly recoverable error
+        } catch (...) {
+            std::cerr << "cvodes_jac: unhandled exception" << std::endl;
+            return -1; // unrecoverable error
+        }
+        return 0; // successful evaluation
+    }
+
     //! Function called by CVodes when an error is encountered instead of
     //! writing to stdout. Here, save the error message provided by CVodes so
     //! that it can be included in the subsequently raised CanteraError.
@@ -113,14 +146,18 @@ CVodesIntegrator::CVodesIntegrator() :
     m_fdata(0),
     m_np(0),
     m_mupper(0), m_mlower(0),
-    m_sens_ok(false)
+    m_sens_ok(false),
+    m_adjoint(false),
+    m_adjointSteps(100),
+    m_tInternal(0.0),
+    m_adj(0)
 {
 }
 
 CVodesIntegrator::~CVodesIntegrator()
 {
     if (m_cvode_mem) {
-        if (m_np > 0) {
+        if (m_np > 0 && !m_adjoint) {
             CVodeSensFree(m_cvode_mem);
         }
         CVodeFree(&m_cvode_mem);
@@ -132,6 +169,7 @@ CVodesIntegrator::~CVodesIntegrator()
         N_VDestroy_Serial(m_abstol);
     }
     delete m_fdata;
+    delete m_adj;
 }
 
 double& CVodesIntegrator::solution(size_t k)
@@ -326,17 +364,23 @@ void CVodesIntegrator::initialize(double t0, FuncEval& func)
     // pass a pointer to func in m_data
     delete m_fdata;
     m_fdata = new FuncData(&func, func.nparams());
+    m_fdata->m_cvode_mem = m_cvode_mem;
 
     flag = CVodeSetUserData(m_cvode_mem, (void*)m_fdata);
     if (flag != CV_SUCCESS) {
         throw CVodesErr("CVodeSetUserData failed.");
     }
-    if (func.nparams() > 0) {
+    if (m_adjoint) {
+        // Store the forward solution at checkpoints instead of integrating
+        // the forward sensitivity equations
+        m_np = func.nparams();
+    } else if (func.nparams() > 0) {
         sensInit(t0, func);
         flag = CVodeSetSensParams(m_cvode_mem, DATA_PTR(m_fdata->m_pars),
                                   NULL, NULL);
     }
     applyOptions();
+    adjointInit(func);
 }
 
 
@@ -353,17 +397,42 @@ void CVodesIntegrator::reinitialize(double t0, FuncEval& func)
         throw CVodesErr("CVodeReInit failed. result = "+int2str(result));
     }
     applyOptions();
+    adjointInit(func);
+}
+
+void CVodesIntegrator::adjointInit(FuncEval& func)
+{
+    m_tInternal = m_t0;
+    delete m_adj;
+    m_adj = 0;
+    if (!m_adjoint) {
+        return;
+    }
+    m_adj = new AdjointSolver(func, m_adjointSteps);
+    vector_fp abstol(m_neq, m_abstols);
+    if (m_itol == CV_SV) {
+        for (size_t i = 0; i < m_neq; i++) {
+            abstol[i] = NV_Ith_S(m_abstol, i);
+        }
+    }
+    m_adj->setTolerances(m_reltol, abstol);
+    m_adj->setSensitivityTolerances(m_reltolsens, m_abstolsens);
+    m_adj->setMaxStepSize(m_hmax);
+    m_adj->start(m_t0, NV_DATA_S(m_y));
 }
 
 void CVodesIntegrator::applyOptions()
 {
-    if (m_type == DENSE + NOJAC) {
+    if (m_type == DENSE + NOJAC || m_type == DENSE + JAC) {
         long int N = m_neq;
         #if SUNDIALS_USE_LAPACK
             CVLapackDense(m_cvode_mem, N);
         #else
             CVDense(m_cvode_mem, N);
         #endif
+        if (m_type == DENSE + JAC) {
+            CVDlsSetDenseJacFn(m_cvode_mem, cvodes_jac);
+        }
     } else if (m_type == DIAG) {
         CVDiag(m_cvode_mem);
     } else if (m_type == GMRES) {
@@ -400,7 +469,23 @@ void CVodesIntegrator::applyOptions()
 
 void CVodesIntegrator::integrate(double tout)
 {
-    int flag = CVode(m_cvode_mem, tout, m_y, &m_time, CV_NORMAL);
+    int flag = CV_SUCCESS;
+    if (m_adjoint) {
+        // Take single steps so that the solution can be checkpointed, then
+        // interpolate to tout
+        while (m_tInternal < tout && flag == CV_SUCCESS) {
+            flag = CVode(m_cvode_mem, tout, m_y, &m_tInternal, CV_ONE_STEP);
+            if (flag == CV_SUCCESS) {
+                m_adj->addStep(m_tInternal, NV_DATA_S(m_y));
+            }
+        }
+        if (flag == CV_SUCCESS) {
+            flag = CVodeGetDky(m_cvode_mem, tout, 0, m_y);
+            m_time = tout;
+        }
+    } else {
+        flag = CVode(m_cvode_mem, tout, m_y, &m_time, CV_NORMAL);
+    }
     if (flag != CV_SUCCESS) {
         throw CVodesErr("CVodes error encountered. Error code: " + int2str(flag) + "\n" + m_error_message +
                         "\nComponents with largest weighted error estimates:\n" + getErrorInfo(10));
@@ -410,12 +495,17 @@ void CVodesIntegrator::integrate(double tout)
 
 double CVodesIntegrator::step(double tout)
 {
-    int flag = CVode(m_cvode_mem, tout, m_y, &m_time, CV_ONE_STEP);
+    int flag;
+    flag = CVode(m_cvode_mem, tout, m_y, &m_time, CV_ONE_STEP);
     if (flag != CV_SUCCESS) {
         throw CVodesErr("CVodes error encountered. Error code: " + int2str(flag) + "\n" + m_error_message +
                         "\nComponents with largest weighted error estimates:\n" + getErrorInfo(10));
 
     }
+    if (m_adjoint) {
+        m_tInternal = m_time;
+        m_adj->addStep(m_time, NV_DATA_S(m_y));
+    }
     m_sens_ok = false;
     return m_time;
 }
@@ -433,6 +523,11 @@ double CVodesIntegrator::sensitivity(size_t k, size_t p)
         // calls to CVodeGetSens are only allowed after a successful time step.
         return 0.0;
     }
+    if (m_adjoint) {
+        throw CVodesErr("sensitivity: forward sensitivities are not "
+                        "available when adjoint sensitivity analysis is "
+                        "enabled");
+    }
     if (!m_sens_ok && m_np) {
         int flag = CVodeGetSens(m_cvode_mem, &m_time, m_yS);
         if (flag != CV_SUCCESS) {
@@ -450,6 +545,21 @@ double CVodesIntegrator::sensitivity(size_t k, size_t p)
     return NV_Ith_S(m_yS[p],k);
 }
 
+void CVodesIntegrator::setAdjoint(bool adjoint, int nsteps)
+{
+    m_adjoint = adjoint;
+    m_adjointSteps = nsteps;
+}
+
+void CVodesIntegrator::integrateAdjoint(double* lambda, double* dgdp)
+{
+    if (!m_adj) {
+        throw CVodesErr("integrateAdjoint: adjoint sensitivity analysis "
+                        "must be enabled before initializing the integrator");
+    }
+    m_adj->solve(m_time, lambda, dgdp);
+}
+
 string CVodesIntegrator::getErrorInfo(int N)
 {
     N_Vector errs = N_VNew_Serial(m_neq);
@@ -0,0 +1,81 @@
+//! @file FuncEval.cpp
+
+#include "cantera/numerics/FuncEval.h"
+
+#include <cfloat>
+
+using namespace std;
+
+namespace Cantera
+{
+
+void FuncEval::evalJacobian(double t, double* y, const double* ydot,
+                            const double* ewt, double* p,
+                            double* const* jacCols)
+{
+    size_t n = neq();
+    vector_fp f1(n);
+    double sqrtEps = sqrt(DBL_EPSILON);
+    for (size_t j = 0; j < n; j++) {
+        double ysave = y[j];
+        if (ewt) {
+            y[j] = ysave + 1.0 / ewt[j];
+        } else {
+            y[j] = ysave + sqrtEps * std::max(fabs(ysave), 1.0);
+        }
+        double dy = y[j] - ysave;
+        eval(t, y, &f1[0], p);
+        y[j] = ysave;
+        for (size_t i = 0; i < n; i++) {
+            jacCols[j][i] = (f1[i] - ydot[i]) / dy;
+        }
+    }
+}
+
+void FuncEval::evalAdjoint(double t, double* y, const double* lambda,
+                           double* lambdadot, double* p)
+{
+    size_t n = neq();
+    vector_fp f0(n), f1(n);
+    eval(t, y, &f0[0], p);
+    double sqrtEps = sqrt(DBL_EPSILON);
+    for (size_t j = 0; j < n; j++) {
+        double ysave = y[j];
+        y[j] = ysave + sqrtEps * std::max(fabs(ysave), 1.0);
+        double dy = y[j] - ysave;
+        eval(t, y, &f1[0], p);
+        y[j] = ysave;
+
+        // -(column j of the Jacobian) . lambda
+        double sum = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            sum += (f1[i] - f0[i]) * lambda[i];
+        }
+        lambdadot[j] = -sum / dy;
+    }
+}
+
+void FuncEval::evalAdjointQuadrature(double t, double* y,
+                                     const double* lambda, double* qdot,
+                                     double* p)
+{
+    size_t n = neq();
+    vector_fp f0(n), f1(n);
+    eval(t, y, &f0[0], p);
+    double sqrtEps = sqrt(DBL_EPSILON);
+    for (size_t j = 0; j < nparams(); j++) {
+        double psave = p[j];
+        p[j] = psave + sqrtEps * std::max(fabs(psave), 1.0);
+        double dp = p[j] - psave;
+        eval(t, y, &f1[0], p);
+        p[j] = psave;
+
+        double sum = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            sum += (f1[i] - f0[i]) * lambda[i];
+        }
+        qdot[j] = sum / dp;
+    }
+}
+
+}
@@ -0,0 +1,184 @@
+/**
+ *  @file SparseMatrix.cpp
+ *
+ *  Matrices stored in compressed sparse row format.
+ */
+
+#include "cantera/numerics/SparseMatrix.h"
+#include "cantera/numerics/DenseMatrix.h"
+#include "cantera/base/ctexceptions.h"
+#include "cantera/base/stringUtils.h"
+
+using namespace std;
+
+namespace Cantera
+{
+
+SparseMatrix::SparseMatrix() :
+    m_nrows(0),
+    m_ncols(0),
+    m_rowStart(1, 0)
+{
+}
+
+SparseMatrix::SparseMatrix(size_t nrows, size_t ncols) :
+    m_nrows(nrows),
+    m_ncols(ncols),
+    m_rowStart(nrows + 1, 0)
+{
+}
+
+void SparseMatrix::resize(size_t nrows, size_t ncols)
+{
+    m_nrows = nrows;
+    m_ncols = ncols;
+    m_rowStart.assign(nrows + 1, 0);
+    m_colIndex.clear();
+    m_value.clear();
+}
+
+void SparseMatrix::setFromTriplets(size_t nrows, size_t ncols,
+                                   const SparseTripletList& triplets)
+{
+    m_nrows = nrows;
+    m_ncols = ncols;
+
+    // Count the entries in each row, then use a counting sort to bucket the
+    // entries by row.
+    vector<size_t> start(nrows + 1, 0);
+    for (size_t n = 0; n < triplets.size(); n++) {
+        if (triplets[n].row >= nrows || triplets[n].col >= ncols) {
+            throw CanteraError("SparseMatrix::setFromTriplets",
+                "Entry (" + int2str(triplets[n].row) + ", " +
+                int2str(triplets[n].col) + ") is outside of a " +
+                int2str(nrows) + " x " + int2str(ncols) + " matrix");
+        }
+        start[triplets[n].row + 1]++;
+    }
+    for (size_t i = 0; i < nrows; i++) {
+        start[i+1] += start[i];
+    }
+    vector<size_t> next(start.begin(), start.end() - 1);
+    vector<size_t> cols(triplets.size());
+    vector_fp vals(triplets.size());
+    for (size_t n = 0; n < triplets.size(); n++) {
+        size_t pos = next[triplets[n].row]++;
+        cols[pos] = triplets[n].col;
+        vals[pos] = triplets[n].value;
+    }
+
+    // Sort each row by column (rows are short, so use an insertion sort) and
+    // merge duplicate entries.
+    m_rowStart.assign(nrows + 1, 0);
+    m_colIndex.clear();
+    m_value.clear();
+    m_colIndex.reserve(triplets.size());
+    m_value.reserve(triplets.size());
+    for (size_t i = 0; i < nrows; i++) {
+        for (size_t n = start[i] + 1; n < start[i+1]; n++) {
+            size_t c = cols[n];
+            double v = vals[n];
+            size_t m = n;
+            while (m > start[i] && cols[m-1] > c) {
+                cols[m] = cols[m-1];
+                vals[m] = vals[m-1];
+                m--;
+            }
+            cols[m] = c;
+            vals[m] = v;
+        }
+        for (size_t n = start[i]; n < start[i+1]; n++) {
+            if (m_colIndex.size() > m_rowStart[i] &&
+                    m_colIndex.back() == cols[n]) {
+                m_value.back() += vals[n];
+            } else {
+                m_colIndex.push_back(cols[n]);
+                m_value.push_back(vals[n]);
+            }
+        }
+        m_rowStart[i+1] = m_colIndex.size();
+    }
+}
+
+void SparseMatrix::zero()
+{
+    std::fill(m_value.begin(), m_value.end(), 0.0);
+}
+
+doublereal SparseMatrix::operator()(size_t i, size_t j) const
+{
+    vector<size_t>::const_iterator begin = m_colIndex.begin() + m_rowStart[i];
+    vector<size_t>::const_iterator end = m_colIndex.begin() + m_rowStart[i+1];
+    vector<size_t>::const_iterator loc = std::lower_bound(begin, end, j);
+    if (loc != end && *loc == j) {
+        return m_value[loc - m_colIndex.begin()];
+    } else {
+        return 0.0;
+    }
+}
+
+void SparseMatrix::mult(const doublereal* b, doublereal* prod) const
+{
+    for (size_t i = 0; i < m_nrows; i++) {
+        double sum = 0.0;
+        for (size_t n = m_rowStart[i]; n < m_rowStart[i+1]; n++) {
+            sum += m_value[n] * b[m_colIndex[n]];
+        }
+        prod[i] = sum;
+    }
+}
+
+void SparseMatrix::incrementMult(const doublereal* b, doublereal* prod) const
+{
+    for (size_t i = 0; i < m_nrows; i++) {
+        double sum = 0.0;
+        for (size_t n = m_rowStart[i]; n < m_rowStart[i+1]; n++) {
+            sum += m_value[n] * b[m_colIndex[n]];
+        }
+        prod[i] += sum;
+    }
+}
+
+void SparseMatrix::mult(const doublereal* b, doublereal* prod,
+                        size_t nvec) const
+{
+    std::fill(prod, prod + m_nrows * nvec, 0.0);
+    incrementMult(b, prod, nvec);
+}
+
+void SparseMatrix::incrementMult(const doublereal* b, doublereal* prod,
+                                 size_t nvec) const
+{
+    for (size_t i = 0; i < m_nrows; i++) {
+        double* p = prod + i * nvec;
+        for (size_t n = m_rowStart[i]; n < m_rowStart[i+1]; n++) {
+            const double* bj = b + m_colIndex[n] * nvec;
+            double a = m_value[n];
+            for (size_t j = 0; j < nvec; j++) {
+                p[j] += a * bj[j];
+            }
+        }
+    }
+}
+
+void SparseMatrix::multTranspose(const doublereal* b, doublereal* prod) const
+{
+    std::fill(prod, prod + m_ncols, 0.0);
+    for (size_t i = 0; i < m_nrows; i++) {
+        for (size_t n = m_rowStart[i]; n < m_rowStart[i+1]; n++) {
+            prod[m_colIndex[n]] += m_value[n] * b[i];
+        }
+    }
+}
+
+void SparseMatrix::copyToDense(DenseMatrix& dense) const
+{
+    dense.resize(m_nrows, m_ncols, 0.0);
+    for (size_t i = 0; i < m_nrows; i++) {
+        for (size_t n = m_rowStart[i]; n < m_rowStart[i+1]; n++) {
+            dense(i, m_colIndex[n]) = m_value[n];
+        }
+    }
+}
+
+}
@@ -112,6 +112,9 @@ void StFlow::resize(size_t ncomponents, size_t points)
     m_cp.resize(m_points, 0.0);
     m_visc.resize(m_points, 0.0);
     m_tcon.resize(m_points, 0.0);
+    m_Tmid.resize(m_points);
+    m_Pmid.resize(m_points);
+    m_Xmid.resize(m_nsp*m_points);
 
     if (m_transport_option ==  c_Mixav_Transport) {
         m_diff.resize(m_nsp*m_points);
@@ -478,11 +481,22 @@ void StFlow::eval(size_t jg, doublereal* xg,
 void StFlow::updateTransport(doublereal* x, size_t j0, size_t j1)
 {
     if (m_transport_option == c_Mixav_Transport) {
+        // evaluate the properties at all of the midpoints in one call, so
+        // that the transport manager can evaluate its fits for blocks of
+        // points together
+        size_t np = j1 - j0;
         for (size_t j = j0; j < j1; j++) {
             setGasAtMidpoint(x,j);
-            m_visc[j] = (m_dovisc ? m_trans->viscosity() : 0.0);
-            m_trans->getMixDiffCoeffs(DATA_PTR(m_diff) + j*m_nsp);
-            m_tcon[j] = m_trans->thermalConductivity();
+            m_Tmid[j-j0] = m_thermo->temperature();
+            m_Pmid[j-j0] = m_press;
+            m_thermo->getMoleFractions(&m_Xmid[(j-j0)*m_nsp]);
+        }
+        m_trans->getTransportProperties(np, DATA_PTR(m_Tmid),
+                                        DATA_PTR(m_Pmid), DATA_PTR(m_Xmid),
+                                        m_dovisc ? &m_visc[j0] : 0,
+                                        &m_tcon[j0], &m_diff[j0*m_nsp]);
+        if (!m_dovisc) {
+            std::fill(m_visc.begin() + j0, m_visc.begin() + j1, 0.0);
         }
     } else if (m_transport_option == c_Multi_Transport) {
         for (size_t j = j0; j < j1; j++) {
@@ -8,10 +8,13 @@
 
 #include "cantera/thermo/GeneralSpeciesThermo.h"
 #include "cantera/thermo/SpeciesThermoFactory.h"
+#include "cantera/thermo/NasaPoly2.h"
 
 namespace Cantera
 {
 GeneralSpeciesThermo::GeneralSpeciesThermo() :
+    m_nasa2_coeffs(14),
+    m_nasa2_contiguous(true),
     m_tlow_max(0.0),
     m_thigh_min(1.0E30),
     m_p0(OneAtm)
@@ -20,22 +23,19 @@ GeneralSpeciesThermo::GeneralSpeciesThermo() :
 
 GeneralSpeciesThermo::GeneralSpeciesThermo(const GeneralSpeciesThermo& b) :
     SpeciesThermo(b),
+    m_sp(b.m_sp),
     m_tpoly(b.m_tpoly),
+    m_nasa2_tmid(b.m_nasa2_tmid),
+    m_nasa2_coeffs(b.m_nasa2_coeffs),
+    m_nasa2_index(b.m_nasa2_index),
+    m_nasa2_contiguous(b.m_nasa2_contiguous),
+    m_nasa2_work(b.m_nasa2_work),
     m_speciesLoc(b.m_speciesLoc),
     m_tlow_max(b.m_tlow_max),
     m_thigh_min(b.m_thigh_min),
     m_p0(b.m_p0)
 {
-    clear();
-    // Copy SpeciesThermoInterpTypes from 'b'
-    for (STIT_map::const_iterator iter = b.m_sp.begin();
-         iter != b.m_sp.end();
-         iter++) {
-        for (size_t k = 0; k < iter->second.size(); k++) {
-            const SpeciesThermoInterpType* spec = iter->second[k];
-            m_sp[iter->first].push_back(spec->duplMyselfAsSpeciesThermoInterpType());
-        }
-    }
+    duplicateUnshareable();
 }
 
 GeneralSpeciesThermo&
@@ -46,18 +46,14 @@ GeneralSpeciesThermo::operator=(const GeneralSpeciesThermo& b)
     }
 
     SpeciesThermo::operator=(b);
-    clear();
-    // Copy SpeciesThermoInterpType objects from 'b'
-    for (STIT_map::const_iterator iter = b.m_sp.begin();
-         iter != b.m_sp.end();
-         iter++) {
-        for (size_t k = 0; k < iter->second.size(); k++) {
-            const SpeciesThermoInterpType* spec = iter->second[k];
-            m_sp[iter->first].push_back(spec->duplMyselfAsSpeciesThermoInterpType());
-        }
-    }
-
+    m_sp = b.m_sp;
+    duplicateUnshareable();
     m_tpoly = b.m_tpoly;
+    m_nasa2_tmid = b.m_nasa2_tmid;
+    m_nasa2_coeffs = b.m_nasa2_coeffs;
+    m_nasa2_index = b.m_nasa2_index;
+    m_nasa2_contiguous = b.m_nasa2_contiguous;
+    m_nasa2_work = b.m_nasa2_work;
     m_speciesLoc = b.m_speciesLoc;
     m_tlow_max = b.m_tlow_max;
     m_thigh_min = b.m_thigh_min;
@@ -68,7 +64,6 @@ GeneralSpeciesThermo::operator=(const GeneralSpeciesThermo& b)
 
 GeneralSpeciesThermo::~GeneralSpeciesThermo()
 {
-    clear();
 }
 
 SpeciesThermo*
@@ -77,16 +72,18 @@ GeneralSpeciesThermo::duplMyselfAsSpeciesThermo() const
     return new GeneralSpeciesThermo(*this);
 }
 
-void GeneralSpeciesThermo::clear()
+void GeneralSpeciesThermo::duplicateUnshareable()
 {
-    for (STIT_map::const_iterator iter = m_sp.begin();
-         iter != m_sp.end();
-         iter++) {
+    // STITbyPDSS objects hold pointers to the VPSSMgr and PDSS objects of
+    // the owning phase, which are reset by VPSSMgr::initAllPtrs.
+    for (STIT_map::iterator iter = m_sp.begin(); iter != m_sp.end(); iter++) {
         for (size_t k = 0; k < iter->second.size(); k++) {
-            delete iter->second[k];
+            shared_ptr<SpeciesThermoInterpType>& spec = iter->second[k];
+            if (dynamic_cast<STITbyPDSS*>(spec.get())) {
+                spec.reset(spec->duplMyselfAsSpeciesThermoInterpType());
+            }
         }
     }
-    m_sp.clear();
 }
 
 void GeneralSpeciesThermo::install(const std::string& name,
@@ -124,10 +121,21 @@ void GeneralSpeciesThermo::install_STIT(SpeciesThermoInterpType* stit_ptr)
 
     int type = stit_ptr->reportType();
     m_speciesLoc[index] = std::make_pair(type, m_sp[type].size());
-    m_sp[type].push_back(stit_ptr);
+    m_sp[type].push_back(shared_ptr<SpeciesThermoInterpType>(stit_ptr));
     if (m_sp[type].size() == 1) {
         m_tpoly[type].resize(stit_ptr->temperaturePolySize());
     }
+    if (type == NASA2) {
+        m_nasa2_index.push_back(index);
+        m_nasa2_contiguous = m_nasa2_contiguous &&
+            index == m_nasa2_index[0] + m_nasa2_index.size() - 1;
+        m_nasa2_tmid.push_back(0.0);
+        for (size_t j = 0; j < 14; j++) {
+            m_nasa2_coeffs[j].push_back(0.0);
+        }
+        m_nasa2_work.resize(3 * m_nasa2_index.size());
+        setNasa2Coeffs(m_nasa2_index.size() - 1);
+    }
 
     // Calculate max and min T
     m_tlow_max = std::max(stit_ptr->minTemp(), m_tlow_max);
@@ -135,6 +143,22 @@ void GeneralSpeciesThermo::install_STIT(SpeciesThermoInterpType* stit_ptr)
     markInstalled(index);
 }
 
+void GeneralSpeciesThermo::setNasa2Coeffs(size_t i)
+{
+    const NasaPoly2* poly = dynamic_cast<const NasaPoly2*>(m_sp[NASA2][i].get());
+    if (!poly) {
+        throw CanteraError("GeneralSpeciesThermo::setNasa2Coeffs",
+                           "Parameterization of type NASA2 is not NasaPoly2");
+    }
+    m_nasa2_tmid[i] = poly->midTemp();
+    const vector_fp& low = poly->lowPoly().coefficients();
+    const vector_fp& high = poly->highPoly().coefficients();
+    for (size_t j = 0; j < 7; j++) {
+        m_nasa2_coeffs[j][i] = low[j];
+        m_nasa2_coeffs[j+7][i] = high[j];
+    }
+}
+
 void GeneralSpeciesThermo::installPDSShandler(size_t k, PDSS* PDSS_ptr,
         VPSSMgr* vpssmgr_ptr)
 {
@@ -157,15 +181,150 @@ void GeneralSpeciesThermo::update(doublereal t, doublereal* cp_R,
     STIT_map::const_iterator iter = m_sp.begin();
     tpoly_map::iterator jter = m_tpoly.begin();
     for (; iter != m_sp.end(); iter++, jter++) {
-        const std::vector<SpeciesThermoInterpType*>& species = iter->second;
+        const std::vector<shared_ptr<SpeciesThermoInterpType> >& species = iter->second;
         double* tpoly = &jter->second[0];
         species[0]->updateTemperaturePoly(t, tpoly);
+        if (iter->first == NASA2) {
+            updateNasa2(tpoly, cp_R, h_RT, s_R);
+            continue;
+        }
         for (size_t k = 0; k < species.size(); k++) {
             species[k]->updateProperties(tpoly, cp_R, h_RT, s_R);
         }
     }
 }
 
+void GeneralSpeciesThermo::update(size_t nT, const doublereal* T,
+                                  doublereal* cp_R, doublereal* h_RT,
+                                  doublereal* s_R) const
+{
+    size_t kk = m_speciesLoc.size();
+    if (nT == 0 || kk == 0) {
+        return;
+    }
+    m_batch_work.resize(3*kk);
+    double* cp = &m_batch_work[0];
+    double* h = cp + kk;
+    double* s = h + kk;
+    STIT_map::const_iterator iter = m_sp.begin();
+    tpoly_map::iterator jter = m_tpoly.begin();
+    for (; iter != m_sp.end(); iter++, jter++) {
+        if (iter->first == NASA2) {
+            updateNasa2(nT, T, cp_R, h_RT, s_R);
+            continue;
+        }
+        const std::vector<shared_ptr<SpeciesThermoInterpType> >& species = iter->second;
+        double* tpoly = &jter->second[0];
+        for (size_t n = 0; n < nT; n++) {
+            species[0]->updateTemperaturePoly(T[n], tpoly);
+            for (size_t i = 0; i < species.size(); i++) {
+                species[i]->updateProperties(tpoly, cp, h, s);
+                size_t k = species[i]->speciesIndex();
+                cp_R[k*nT + n] = cp[k];
+                h_RT[k*nT + n] = h[k];
+                s_R[k*nT + n] = s[k];
+            }
+        }
+    }
+}
+
+void GeneralSpeciesThermo::updateNasa2(size_t nT, const doublereal* T,
+                                       doublereal* cp_R, doublereal* h_RT,
+                                       doublereal* s_R) const
+{
+    // Temperature polynomials, as in NasaPoly1::updateTemperaturePoly
+    m_batch_tpoly.resize(6*nT);
+    double* tt[6];
+    for (size_t j = 0; j < 6; j++) {
+        tt[j] = &m_batch_tpoly[j*nT];
+    }
+    for (size_t n = 0; n < nT; n++) {
+        tt[0][n] = T[n];
+        tt[1][n] = T[n] * T[n];
+        tt[2][n] = tt[1][n] * T[n];
+        tt[3][n] = tt[2][n] * T[n];
+        tt[4][n] = 1.0 / T[n];
+        tt[5][n] = std::log(T[n]);
+    }
+
+    for (size_t i = 0; i < m_nasa2_index.size(); i++) {
+        size_t k = m_nasa2_index[i];
+        double tmid = m_nasa2_tmid[i];
+        doublereal low[7], high[7];
+        for (size_t j = 0; j < 7; j++) {
+            low[j] = m_nasa2_coeffs[j][i];
+            high[j] = m_nasa2_coeffs[j+7][i];
+        }
+        double* cp = cp_R + k*nT;
+        double* h = h_RT + k*nT;
+        double* s = s_R + k*nT;
+        for (size_t n = 0; n < nT; n++) {
+            bool hi = (tt[0][n] > tmid);
+            doublereal a[7];
+            for (size_t j = 0; j < 7; j++) {
+                a[j] = hi ? high[j] : low[j];
+            }
+            doublereal ct0 = a[0];
+            doublereal ct1 = a[1] * tt[0][n];
+            doublereal ct2 = a[2] * tt[1][n];
+            doublereal ct3 = a[3] * tt[2][n];
+            doublereal ct4 = a[4] * tt[3][n];
+            cp[n] = ct0 + ct1 + ct2 + ct3 + ct4;
+            h[n] = ct0 + 0.5*ct1 + 1.0/3.0*ct2 + 0.25*ct3 + 0.2*ct4
+                   + a[5] * tt[4][n];
+            s[n] = ct0*tt[5][n] + ct1 + 0.5*ct2 + 1.0/3.0*ct3 + 0.25*ct4
+                   + a[6];
+        }
+    }
+}
+
+void GeneralSpeciesThermo::updateNasa2(const doublereal* tt, doublereal* cp_R,
+                                       doublereal* h_RT, doublereal* s_R) const
+{
+    size_t n = m_nasa2_index.size();
+    double* cp = &m_nasa2_work[0];
+    double* h = cp + n;
+    double* s = h + n;
+    if (m_nasa2_contiguous) {
+        cp = cp_R + m_nasa2_index[0];
+        h = h_RT + m_nasa2_index[0];
+        s = s_R + m_nasa2_index[0];
+    }
+
+    const double* tmid = &m_nasa2_tmid[0];
+    const double* c[14];
+    for (size_t j = 0; j < 14; j++) {
+        c[j] = &m_nasa2_coeffs[j][0];
+    }
+    // Both sets of coefficients are loaded and the one for the current
+    // temperature region is selected, which the compiler can vectorize. The
+    // arithmetic is the same as in NasaPoly1::updateProperties.
+    for (size_t i = 0; i < n; i++) {
+        bool high = (tt[0] > tmid[i]);
+        doublereal a[7];
+        for (size_t j = 0; j < 7; j++) {
+            a[j] = high ? c[j+7][i] : c[j][i];
+        }
+        doublereal ct0 = a[0];
+        doublereal ct1 = a[1] * tt[0];
+        doublereal ct2 = a[2] * tt[1];
+        doublereal ct3 = a[3] * tt[2];
+        doublereal ct4 = a[4] * tt[3];
+        cp[i] = ct0 + ct1 + ct2 + ct3 + ct4;
+        h[i] = ct0 + 0.5*ct1 + 1.0/3.0*ct2 + 0.25*ct3 + 0.2*ct4 + a[5] * tt[4];
+        s[i] = ct0*tt[5] + ct1 + 0.5*ct2 + 1.0/3.0*ct3 + 0.25*ct4 + a[6];
+    }
+
+    if (!m_nasa2_contiguous) {
+        for (size_t i = 0; i < n; i++) {
+            size_t k = m_nasa2_index[i];
+            cp_R[k] = cp[i];
+            h_RT[k] = h[i];
+            s_R[k] = s[i];
+        }
+    }
+}
+
 int GeneralSpeciesThermo::reportType(size_t index) const
 {
     const SpeciesThermoInterpType* sp = provideSTIT(index);
@@ -228,19 +387,24 @@ doublereal GeneralSpeciesThermo::refPressure(size_t k) const
 
 SpeciesThermoInterpType* GeneralSpeciesThermo::provideSTIT(size_t k)
 {
-    try {
-        const std::pair<int, size_t>& loc = getValue(m_speciesLoc, k);
-        return getValue(m_sp, loc.first)[loc.second];
-    } catch (std::out_of_range&) {
+    std::map<size_t, std::pair<int, size_t> >::const_iterator loc =
+        m_speciesLoc.find(k);
+    if (loc == m_speciesLoc.end()) {
         return 0;
     }
+    shared_ptr<SpeciesThermoInterpType>& sp =
+        m_sp[loc->second.first][loc->second.second];
+    if (sp.use_count() > 1) {
+        sp.reset(sp->duplMyselfAsSpeciesThermoInterpType());
+    }
+    return sp.get();
 }
 
 const SpeciesThermoInterpType* GeneralSpeciesThermo::provideSTIT(size_t k) const
 {
     try {
         const std::pair<int, size_t>& loc = getValue(m_speciesLoc, k);
-        return getValue(m_sp, loc.first)[loc.second];
+        return getValue(m_sp, loc.first)[loc.second].get();
     } catch (std::out_of_range&) {
         return 0;
     }
@@ -262,6 +426,10 @@ void GeneralSpeciesThermo::modifyOneHf298(const size_t k, const doublereal Hf298
     SpeciesThermoInterpType* sp_ptr = provideSTIT(k);
     if (sp_ptr) {
         sp_ptr->modifyOneHf298(k, Hf298New);
+        const std::pair<int, size_t>& loc = getValue(m_speciesLoc, k);
+        if (loc.first == NASA2) {
+            setNasa2Coeffs(loc.second);
+        }
     }
 }
 
@@ -295,6 +295,13 @@ HMWSoln& HMWSoln::operator=(const HMWSoln& b)
         m_Psi_ijk_LL          = b.m_Psi_ijk_LL;
         m_Psi_ijk_P           = b.m_Psi_ijk_P;
         m_Psi_ijk_coeff       = b.m_Psi_ijk_coeff;
+        m_PsiStart_ij         = b.m_PsiStart_ij;
+        m_PsiIndex_k          = b.m_PsiIndex_k;
+        m_PsiRows_ij          = b.m_PsiRows_ij;
+        m_CationAnionPairs    = b.m_CationAnionPairs;
+        m_LikeChargePairs     = b.m_LikeChargePairs;
+        m_LambdaStart_n       = b.m_LambdaStart_n;
+        m_LambdaIndex_j       = b.m_LambdaIndex_j;
         m_Lambda_nj           = b.m_Lambda_nj;
         m_Lambda_nj_L         = b.m_Lambda_nj_L;
         m_Lambda_nj_LL        = b.m_Lambda_nj_LL;
@@ -730,8 +737,7 @@ void HMWSoln::getPartialMolarEnthalpies(doublereal* hbar) const
      * Update the activity coefficients, This also update the
      * internally stored molalities.
      */
-    s_update_lnMolalityActCoeff();
-    s_update_dlnMolalityActCoeff_dT();
+    s_update_lnMolalityActCoeff(true);
     double RTT = RT * T;
     for (size_t k = 0; k < m_kk; k++) {
         hbar[k] -= RTT * m_dlnActCoeffMolaldT_Scaled[k];
@@ -753,10 +759,10 @@ void HMWSoln::getPartialMolarEntropies(doublereal* sbar) const
         sbar[k] *= R;
     }
     /*
-     * Update the activity coefficients, This also update the
-     * internally stored molalities.
+     * Update the activity coefficients and their derivatives. This also
+     * updates the internally stored molalities.
      */
-    s_update_lnMolalityActCoeff();
+    s_update_lnMolalityActCoeff(true);
     /*
      * First we will add in the obvious dependence on the T
      * term out front of the log activity term
@@ -772,11 +778,8 @@ void HMWSoln::getPartialMolarEntropies(doublereal* sbar) const
     mm = std::max(SmallNumber, xmolSolvent);
     sbar[m_indexSolvent] -= R *(log(mm) + m_lnActCoeffMolal_Scaled[m_indexSolvent]);
     /*
-     * Check to see whether activity coefficients are temperature
-     * dependent. If they are, then calculate the their temperature
-     * derivatives and add them into the result.
+     * Add in the temperature derivatives of the activity coefficients
      */
-    s_update_dlnMolalityActCoeff_dT();
     double RT = R * temperature();
     for (size_t k = 0; k < m_kk; k++) {
         sbar[k] -= RT * m_dlnActCoeffMolaldT_Scaled[k];
@@ -792,8 +795,7 @@ void HMWSoln::getPartialMolarVolumes(doublereal* vbar) const
     /*
      * Update the derivatives wrt the activity coefficients.
      */
-    s_update_lnMolalityActCoeff();
-    s_update_dlnMolalityActCoeff_dP();
+    s_update_lnMolalityActCoeff(true);
     double T = temperature();
     double RT = GasConstant * T;
     for (size_t k = 0; k < m_kk; k++) {
@@ -816,9 +818,7 @@ void HMWSoln::getPartialMolarCp(doublereal* cpbar) const
      * Update the activity coefficients, This also update the
      * internally stored molalities.
      */
-    s_update_lnMolalityActCoeff();
-    s_update_dlnMolalityActCoeff_dT();
-    s_update_d2lnMolalityActCoeff_dT2();
+    s_update_lnMolalityActCoeff(true);
     double T = temperature();
     double RT = GasConstant * T;
     double RTT = RT * T;
@@ -1128,99 +1128,137 @@ void HMWSoln::initLengths()
     CROP_speciesCropped_.resize(m_kk, 0);
 
     counterIJ_setup();
+    psiSparse_setup();
+    pairLists_setup();
 }
 
-void HMWSoln::s_update_lnMolalityActCoeff() const
+void HMWSoln::s_update_lnMolalityActCoeff(bool derivs) const
 {
     static const int cacheId = m_cache.getId();
+    static const int derivCacheId = m_cache.getId();
     CachedScalar cached = m_cache.getScalar(cacheId);
-    if( cached.validate(temperature(), pressure(), stateMFNumber()) ) {
+    bool values = !cached.validate(temperature(), pressure(), stateMFNumber());
+    if (derivs) {
+        CachedScalar cachedDerivs = m_cache.getScalar(derivCacheId);
+        derivs = !cachedDerivs.validate(temperature(), pressure(), stateMFNumber());
+    }
+    if (!values && !derivs) {
         return;
     }
 
-    /*
-     * Calculate the molalities. Currently, the molalities
-     * may not be current with respect to the contents of the
-     * State objects' data.
-     */
-    calcMolalities();
-    /*
-     *  Calculate a cropped set of molalities that will be used
-     *  in all activity coefficient calculations.
-     */
-    calcMolalitiesCropped();
+    if (values) {
+        /*
+         * Calculate the molalities. Currently, the molalities
+         * may not be current with respect to the contents of the
+         * State objects' data.
+         */
+        calcMolalities();
+        /*
+         *  Calculate a cropped set of molalities that will be used
+         *  in all activity coefficient calculations.
+         */
+        calcMolalitiesCropped();
 
-    /*
-     * Calculate the stoichiometric ionic charge. This isn't used in the
-     * Pitzer formulation.
-     */
-    m_IionicMolalityStoich = 0.0;
-    for (size_t k = 0; k < m_kk; k++) {
-        double z_k = charge(k);
-        double zs_k1 =  m_speciesCharge_Stoich[k];
-        if (z_k == zs_k1) {
-            m_IionicMolalityStoich += m_molalities[k] * z_k * z_k;
-        } else {
-            double zs_k2 = z_k - zs_k1;
-            m_IionicMolalityStoich
-            += m_molalities[k] * (zs_k1 * zs_k1 + zs_k2 * zs_k2);
+        /*
+         * Calculate the stoichiometric ionic charge. This isn't used in the
+         * Pitzer formulation.
+         */
+        m_IionicMolalityStoich = 0.0;
+        for (size_t k = 0; k < m_kk; k++) {
+            double z_k = charge(k);
+            double zs_k1 =  m_speciesCharge_Stoich[k];
+            if (z_k == zs_k1) {
+                m_IionicMolalityStoich += m_molalities[k] * z_k * z_k;
+            } else {
+                double zs_k2 = z_k - zs_k1;
+                m_IionicMolalityStoich
+                += m_molalities[k] * (zs_k1 * zs_k1 + zs_k2 * zs_k2);
+            }
         }
-    }
 
-    /*
-     * Update the temperature dependence of the pitzer coefficients
-     * and their derivatives
-     */
-    s_updatePitzer_CoeffWRTemp();
+        /*
+         * Update the temperature dependence of the pitzer coefficients
+         * and their derivatives
+         */
+        s_updatePitzer_CoeffWRTemp();
 
-    /*
-     * Calculate the IMS cutoff factors
-     */
-    s_updateIMS_lnMolalityActCoeff();
+        /*
+         * Calculate the IMS cutoff factors
+         */
+        s_updateIMS_lnMolalityActCoeff();
+    }
 
     /*
-     * Now do the main calculation.
+     * Now do the main calculation, for the activity coefficients and
+     * their derivatives together.
      */
-    s_updatePitzer_lnMolalityActCoeff();
+    s_updatePitzer_lnMolalityActCoeff(values, derivs);
 
-    double xmolSolvent = moleFraction(m_indexSolvent);
-    double xx = std::max(m_xmolSolventMIN, xmolSolvent);
-    double lnActCoeffMolal0 = - log(xx) + (xx - 1.0)/xx;
-    double lnxs = log(xx);
-
-    for (size_t k = 1; k < m_kk; k++) {
-        CROP_speciesCropped_[k] = 0;
-        m_lnActCoeffMolal_Unscaled[k] += IMS_lnActCoeffMolal_[k];
-        if (m_lnActCoeffMolal_Unscaled[k] > (CROP_ln_gamma_k_max- 2.5 *lnxs)) {
-            CROP_speciesCropped_[k] = 2;
-            m_lnActCoeffMolal_Unscaled[k] = CROP_ln_gamma_k_max - 2.5 * lnxs;
+    if (values) {
+        double xmolSolvent = moleFraction(m_indexSolvent);
+        double xx = std::max(m_xmolSolventMIN, xmolSolvent);
+        double lnActCoeffMolal0 = - log(xx) + (xx - 1.0)/xx;
+        double lnxs = log(xx);
+
+        for (size_t k = 1; k < m_kk; k++) {
+            CROP_speciesCropped_[k] = 0;
+            m_lnActCoeffMolal_Unscaled[k] += IMS_lnActCoeffMolal_[k];
+            if (m_lnActCoeffMolal_Unscaled[k] > (CROP_ln_gamma_k_max- 2.5 *lnxs)) {
+                CROP_speciesCropped_[k] = 2;
+                m_lnActCoeffMolal_Unscaled[k] = CROP_ln_gamma_k_max - 2.5 * lnxs;
+            }
+            if (m_lnActCoeffMolal_Unscaled[k] < (CROP_ln_gamma_k_min - 2.5 *lnxs)) {
+                // -1.0 and -1.5 caused multiple solutions
+                CROP_speciesCropped_[k] = 2;
+                m_lnActCoeffMolal_Unscaled[k] = CROP_ln_gamma_k_min - 2.5 * lnxs;
+            }
         }
-        if (m_lnActCoeffMolal_Unscaled[k] < (CROP_ln_gamma_k_min - 2.5 *lnxs)) {
-            // -1.0 and -1.5 caused multiple solutions
-            CROP_speciesCropped_[k] = 2;
-            m_lnActCoeffMolal_Unscaled[k] = CROP_ln_gamma_k_min - 2.5 * lnxs;
+        CROP_speciesCropped_[0] = 0;
+        m_lnActCoeffMolal_Unscaled[0] += (IMS_lnActCoeffMolal_[0] - lnActCoeffMolal0);
+        if (m_lnActCoeffMolal_Unscaled[0] < CROP_ln_gamma_o_min) {
+            CROP_speciesCropped_[0] = 2;
+            m_lnActCoeffMolal_Unscaled[0] = CROP_ln_gamma_o_min;
         }
-    }
-    CROP_speciesCropped_[0] = 0;
-    m_lnActCoeffMolal_Unscaled[0] += (IMS_lnActCoeffMolal_[0] - lnActCoeffMolal0);
-    if (m_lnActCoeffMolal_Unscaled[0] < CROP_ln_gamma_o_min) {
-        CROP_speciesCropped_[0] = 2;
-        m_lnActCoeffMolal_Unscaled[0] = CROP_ln_gamma_o_min;
-    }
-    if (m_lnActCoeffMolal_Unscaled[0] > CROP_ln_gamma_o_max) {
-        CROP_speciesCropped_[0] = 2;
-        // -0.5 caused multiple solutions
-        m_lnActCoeffMolal_Unscaled[0] = CROP_ln_gamma_o_max;
-    }
-    if (m_lnActCoeffMolal_Unscaled[0] > CROP_ln_gamma_o_max - 0.5 * lnxs) {
-        CROP_speciesCropped_[0] = 2;
-        m_lnActCoeffMolal_Unscaled[0] = CROP_ln_gamma_o_max - 0.5 * lnxs;
+        if (m_lnActCoeffMolal_Unscaled[0] > CROP_ln_gamma_o_max) {
+            CROP_speciesCropped_[0] = 2;
+            // -0.5 caused multiple solutions
+            m_lnActCoeffMolal_Unscaled[0] = CROP_ln_gamma_o_max;
+        }
+        if (m_lnActCoeffMolal_Unscaled[0] > CROP_ln_gamma_o_max - 0.5 * lnxs) {
+            CROP_speciesCropped_[0] = 2;
+            m_lnActCoeffMolal_Unscaled[0] = CROP_ln_gamma_o_max - 0.5 * lnxs;
+        }
+
+        /*
+         * Now do the pH Scaling
+         */
+        s_updateScaling_pHScaling();
     }
 
-    /*
-     * Now do the pH Scaling
-     */
-    s_updateScaling_pHScaling();
+    if (derivs) {
+        /*
+         * The derivatives of the cropped activity coefficients are zero
+         */
+        for (size_t k = 1; k < m_kk; k++) {
+            if (CROP_speciesCropped_[k] == 2) {
+                m_dlnActCoeffMolaldT_Unscaled[k] = 0.0;
+                m_d2lnActCoeffMolaldT2_Unscaled[k] = 0.0;
+                m_dlnActCoeffMolaldP_Unscaled[k] = 0.0;
+            }
+        }
+        if (CROP_speciesCropped_[0]) {
+            m_dlnActCoeffMolaldT_Unscaled[0] = 0.0;
+            m_d2lnActCoeffMolaldT2_Unscaled[0] = 0.0;
+            m_dlnActCoeffMolaldP_Unscaled[0] = 0.0;
+        }
+
+        /*
+         *  Do the pH scaling to the derivatives
+         */
+        s_updateScaling_pHScaling_dT();
+        s_updateScaling_pHScaling_dT2();
+        s_updateScaling_pHScaling_dP();
+    }
 }
 
 void HMWSoln::calcMolalitiesCropped() const
@@ -1399,6 +1437,96 @@ void HMWSoln::counterIJ_setup(void) const
     }
 }
 
+void HMWSoln::psiSparse_setup()
+{
+    m_PsiStart_ij.assign(m_kk * m_kk + 1, 0);
+    m_PsiIndex_k.clear();
+    size_t nCoeff = m_Psi_ijk_coeff.nRows();
+    for (size_t ij = 0; ij < m_kk * m_kk; ij++) {
+        for (size_t k = 0; k < m_kk; k++) {
+            size_t n = k + ij * m_kk;
+            bool nonzero = (m_Psi_ijk[n] != 0.0);
+            const double* Psi_coeff = m_Psi_ijk_coeff.ptrColumn(n);
+            for (size_t m = 0; m < nCoeff && !nonzero; m++) {
+                nonzero = (Psi_coeff[m] != 0.0);
+            }
+            if (nonzero) {
+                m_PsiIndex_k.push_back(k);
+            }
+        }
+        m_PsiStart_ij[ij+1] = m_PsiIndex_k.size();
+    }
+    m_PsiRows_ij.clear();
+    for (size_t ij = 0; ij < m_kk * m_kk; ij++) {
+        if (m_PsiStart_ij[ij+1] > m_PsiStart_ij[ij]) {
+            m_PsiRows_ij.push_back(ij);
+        }
+    }
+}
+
+//! Return true if the value or any temperature coefficient of a parameter
+//! is nonzero
+static bool hasInteraction(double value, const double* coeff, size_t nCoeff)
+{
+    if (value != 0.0) {
+        return true;
+    }
+    for (size_t m = 0; m < nCoeff; m++) {
+        if (coeff[m] != 0.0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void HMWSoln::pairLists_setup()
+{
+    m_CationAnionPairs.clear();
+    m_LikeChargePairs.clear();
+    for (size_t i = 1; i < m_kk; i++) {
+        for (size_t j = i+1; j < m_kk; j++) {
+            size_t n = m_kk*i + j;
+            size_t counterIJ = m_CounterIJ[n];
+            if (charge(i)*charge(j) < 0.0) {
+                size_t nc = m_Beta0MX_ij_coeff.nRows();
+                if (hasInteraction(m_Beta0MX_ij[counterIJ],
+                                   m_Beta0MX_ij_coeff.ptrColumn(counterIJ), nc) ||
+                    hasInteraction(m_Beta1MX_ij[counterIJ],
+                                   m_Beta1MX_ij_coeff.ptrColumn(counterIJ), nc) ||
+                    hasInteraction(m_Beta2MX_ij[counterIJ],
+                                   m_Beta2MX_ij_coeff.ptrColumn(counterIJ), nc) ||
+                    hasInteraction(m_CphiMX_ij[counterIJ],
+                                   m_CphiMX_ij_coeff.ptrColumn(counterIJ), nc)) {
+                    m_CationAnionPairs.push_back(n);
+                }
+            } else if (charge(i)*charge(j) > 0.0) {
+                // E-theta vanishes for ions with equal charges
+                if (fabs(charge(i)) != fabs(charge(j)) ||
+                    hasInteraction(m_Theta_ij[counterIJ],
+                                   m_Theta_ij_coeff.ptrColumn(counterIJ),
+                                   m_Theta_ij_coeff.nRows())) {
+                    m_LikeChargePairs.push_back(n);
+                }
+            }
+        }
+    }
+
+    m_LambdaStart_n.assign(m_kk + 1, 0);
+    m_LambdaIndex_j.clear();
+    for (size_t i = 0; i < m_kk; i++) {
+        if (i != 0 && charge(i) == 0.0) {
+            for (size_t j = 1; j < m_kk; j++) {
+                if (hasInteraction(m_Lambda_nj(i,j),
+                                   m_Lambda_nj_coeff.ptrColumn(i * m_kk + j),
+                                   m_Lambda_nj_coeff.nRows())) {
+                    m_LambdaIndex_j.push_back(j);
+                }
+            }
+        }
+        m_LambdaStart_n[i+1] = m_LambdaIndex_j.size();
+    }
+}
+
 void HMWSoln::s_updatePitzer_CoeffWRTemp(int doDerivs) const
 {
     double T = temperature();
@@ -1417,255 +1545,257 @@ void HMWSoln::s_updatePitzer_CoeffWRTemp(int doDerivs) const
         tinv = 1.0/T - 1.0/Tr;
     }
 
-    for (size_t i = 1; i < (m_kk - 1); i++) {
-        for (size_t j = (i+1); j < m_kk; j++) {
-
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            const double* beta0MX_coeff = m_Beta0MX_ij_coeff.ptrColumn(counterIJ);
-            const double* beta1MX_coeff = m_Beta1MX_ij_coeff.ptrColumn(counterIJ);
-            const double* beta2MX_coeff = m_Beta2MX_ij_coeff.ptrColumn(counterIJ);
-            const double* CphiMX_coeff = m_CphiMX_ij_coeff.ptrColumn(counterIJ);
-            const double* Theta_coeff = m_Theta_ij_coeff.ptrColumn(counterIJ);
+    /*
+     * The binary parameters are only updated for the pairs in the
+     * interaction lists; they are identically zero for all other pairs.
+     */
+    size_t nCationAnion = m_CationAnionPairs.size();
+    size_t nPairs = nCationAnion + m_LikeChargePairs.size();
+    for (size_t ip = 0; ip < nPairs; ip++) {
+        size_t n = (ip < nCationAnion) ? m_CationAnionPairs[ip]
+                   : m_LikeChargePairs[ip - nCationAnion];
+        size_t counterIJ = m_CounterIJ[n];
+
+        const double* beta0MX_coeff = m_Beta0MX_ij_coeff.ptrColumn(counterIJ);
+        const double* beta1MX_coeff = m_Beta1MX_ij_coeff.ptrColumn(counterIJ);
+        const double* beta2MX_coeff = m_Beta2MX_ij_coeff.ptrColumn(counterIJ);
+        const double* CphiMX_coeff = m_CphiMX_ij_coeff.ptrColumn(counterIJ);
+        const double* Theta_coeff = m_Theta_ij_coeff.ptrColumn(counterIJ);
+
+        switch (m_formPitzerTemp) {
+        case PITZER_TEMP_CONSTANT:
+            break;
+        case PITZER_TEMP_LINEAR:
+
+            m_Beta0MX_ij[counterIJ] = beta0MX_coeff[0]
+                                      + beta0MX_coeff[1]*tlin;
+            m_Beta0MX_ij_L[counterIJ] = beta0MX_coeff[1];
+            m_Beta0MX_ij_LL[counterIJ] = 0.0;
+
+            m_Beta1MX_ij[counterIJ]   = beta1MX_coeff[0]
+                                        + beta1MX_coeff[1]*tlin;
+            m_Beta1MX_ij_L[counterIJ] = beta1MX_coeff[1];
+            m_Beta1MX_ij_LL[counterIJ] = 0.0;
+
+            m_Beta2MX_ij[counterIJ]    = beta2MX_coeff[0]
+                                         + beta2MX_coeff[1]*tlin;
+            m_Beta2MX_ij_L[counterIJ]  = beta2MX_coeff[1];
+            m_Beta2MX_ij_LL[counterIJ] = 0.0;
+
+            m_CphiMX_ij[counterIJ]     = CphiMX_coeff[0]
+                                         + CphiMX_coeff[1]*tlin;
+            m_CphiMX_ij_L[counterIJ]   = CphiMX_coeff[1];
+            m_CphiMX_ij_LL[counterIJ]  = 0.0;
+
+            m_Theta_ij[counterIJ]      = Theta_coeff[0] + Theta_coeff[1]*tlin;
+            m_Theta_ij_L[counterIJ]    = Theta_coeff[1];
+            m_Theta_ij_LL[counterIJ]   = 0.0;
+
+            break;
+
+        case PITZER_TEMP_COMPLEX1:
+            m_Beta0MX_ij[counterIJ] = beta0MX_coeff[0]
+                                      + beta0MX_coeff[1]*tlin
+                                      + beta0MX_coeff[2]*tquad
+                                      + beta0MX_coeff[3]*tinv
+                                      + beta0MX_coeff[4]*tln;
+
+            m_Beta1MX_ij[counterIJ] = beta1MX_coeff[0]
+                                      + beta1MX_coeff[1]*tlin
+                                      + beta1MX_coeff[2]*tquad
+                                      + beta1MX_coeff[3]*tinv
+                                      + beta1MX_coeff[4]*tln;
+
+            m_Beta2MX_ij[counterIJ] = beta2MX_coeff[0]
+                                      + beta2MX_coeff[1]*tlin
+                                      + beta2MX_coeff[2]*tquad
+                                      + beta2MX_coeff[3]*tinv
+                                      + beta2MX_coeff[4]*tln;
+
+            m_CphiMX_ij[counterIJ] = CphiMX_coeff[0]
+                                     + CphiMX_coeff[1]*tlin
+                                     + CphiMX_coeff[2]*tquad
+                                     + CphiMX_coeff[3]*tinv
+                                     + CphiMX_coeff[4]*tln;
+
+            m_Theta_ij[counterIJ] = Theta_coeff[0]
+                                    + Theta_coeff[1]*tlin
+                                    + Theta_coeff[2]*tquad
+                                    + Theta_coeff[3]*tinv
+                                    + Theta_coeff[4]*tln;
+
+            m_Beta0MX_ij_L[counterIJ] =  beta0MX_coeff[1]
+                                         + beta0MX_coeff[2]*twoT
+                                         - beta0MX_coeff[3]*invT2
+                                         + beta0MX_coeff[4]*invT;
+
+            m_Beta1MX_ij_L[counterIJ] =  beta1MX_coeff[1]
+                                         + beta1MX_coeff[2]*twoT
+                                         - beta1MX_coeff[3]*invT2
+                                         + beta1MX_coeff[4]*invT;
+
+            m_Beta2MX_ij_L[counterIJ] =  beta2MX_coeff[1]
+                                         + beta2MX_coeff[2]*twoT
+                                         - beta2MX_coeff[3]*invT2
+                                         + beta2MX_coeff[4]*invT;
+
+            m_CphiMX_ij_L[counterIJ] =  CphiMX_coeff[1]
+                                        + CphiMX_coeff[2]*twoT
+                                        - CphiMX_coeff[3]*invT2
+                                        + CphiMX_coeff[4]*invT;
+
+            m_Theta_ij_L[counterIJ] =   Theta_coeff[1]
+                                        + Theta_coeff[2]*twoT
+                                        - Theta_coeff[3]*invT2
+                                        + Theta_coeff[4]*invT;
+
+            doDerivs = 2;
+            if (doDerivs > 1) {
+                m_Beta0MX_ij_LL[counterIJ] =
+                    + beta0MX_coeff[2]*2.0
+                    + beta0MX_coeff[3]*twoinvT3
+                    - beta0MX_coeff[4]*invT2;
+
+                m_Beta1MX_ij_LL[counterIJ] =
+                    + beta1MX_coeff[2]*2.0
+                    + beta1MX_coeff[3]*twoinvT3
+                    - beta1MX_coeff[4]*invT2;
+
+                m_Beta2MX_ij_LL[counterIJ] =
+                    + beta2MX_coeff[2]*2.0
+                    + beta2MX_coeff[3]*twoinvT3
+                    - beta2MX_coeff[4]*invT2;
+
+                m_CphiMX_ij_LL[counterIJ] =
+                    + CphiMX_coeff[2]*2.0
+                    + CphiMX_coeff[3]*twoinvT3
+                    - CphiMX_coeff[4]*invT2;
+
+                m_Theta_ij_LL[counterIJ] =
+                    + Theta_coeff[2]*2.0
+                    + Theta_coeff[3]*twoinvT3
+                    - Theta_coeff[4]*invT2;
+            }
+            break;
+        }
+    }
 
+    // Lambda interactions and Mu_nnn
+    // i must be neutral for this term to be nonzero, and only the entries
+    // in the sparse lambda list are updated.
+    for (size_t i = 1; i < m_kk; i++) {
+        if (charge(i) != 0.0) {
+            continue;
+        }
+        for (size_t m = m_LambdaStart_n[i]; m < m_LambdaStart_n[i+1]; m++) {
+            size_t j = m_LambdaIndex_j[m];
+            size_t n = i * m_kk + j;
+            const double* Lambda_coeff = m_Lambda_nj_coeff.ptrColumn(n);
             switch (m_formPitzerTemp) {
             case PITZER_TEMP_CONSTANT:
+                m_Lambda_nj(i,j) = Lambda_coeff[0];
                 break;
             case PITZER_TEMP_LINEAR:
-
-                m_Beta0MX_ij[counterIJ] = beta0MX_coeff[0]
-                                          + beta0MX_coeff[1]*tlin;
-                m_Beta0MX_ij_L[counterIJ] = beta0MX_coeff[1];
-                m_Beta0MX_ij_LL[counterIJ] = 0.0;
-
-                m_Beta1MX_ij[counterIJ]   = beta1MX_coeff[0]
-                                            + beta1MX_coeff[1]*tlin;
-                m_Beta1MX_ij_L[counterIJ] = beta1MX_coeff[1];
-                m_Beta1MX_ij_LL[counterIJ] = 0.0;
-
-                m_Beta2MX_ij[counterIJ]    = beta2MX_coeff[0]
-                                             + beta2MX_coeff[1]*tlin;
-                m_Beta2MX_ij_L[counterIJ]  = beta2MX_coeff[1];
-                m_Beta2MX_ij_LL[counterIJ] = 0.0;
-
-                m_CphiMX_ij[counterIJ]     = CphiMX_coeff[0]
-                                             + CphiMX_coeff[1]*tlin;
-                m_CphiMX_ij_L[counterIJ]   = CphiMX_coeff[1];
-                m_CphiMX_ij_LL[counterIJ]  = 0.0;
-
-                m_Theta_ij[counterIJ]      = Theta_coeff[0] + Theta_coeff[1]*tlin;
-                m_Theta_ij_L[counterIJ]    = Theta_coeff[1];
-                m_Theta_ij_LL[counterIJ]   = 0.0;
-
+                m_Lambda_nj(i,j)      = Lambda_coeff[0] + Lambda_coeff[1]*tlin;
+                m_Lambda_nj_L(i,j)    = Lambda_coeff[1];
+                m_Lambda_nj_LL(i,j)   = 0.0;
                 break;
-
             case PITZER_TEMP_COMPLEX1:
-                m_Beta0MX_ij[counterIJ] = beta0MX_coeff[0]
-                                          + beta0MX_coeff[1]*tlin
-                                          + beta0MX_coeff[2]*tquad
-                                          + beta0MX_coeff[3]*tinv
-                                          + beta0MX_coeff[4]*tln;
-
-                m_Beta1MX_ij[counterIJ] = beta1MX_coeff[0]
-                                          + beta1MX_coeff[1]*tlin
-                                          + beta1MX_coeff[2]*tquad
-                                          + beta1MX_coeff[3]*tinv
-                                          + beta1MX_coeff[4]*tln;
-
-                m_Beta2MX_ij[counterIJ] = beta2MX_coeff[0]
-                                          + beta2MX_coeff[1]*tlin
-                                          + beta2MX_coeff[2]*tquad
-                                          + beta2MX_coeff[3]*tinv
-                                          + beta2MX_coeff[4]*tln;
-
-                m_CphiMX_ij[counterIJ] = CphiMX_coeff[0]
-                                         + CphiMX_coeff[1]*tlin
-                                         + CphiMX_coeff[2]*tquad
-                                         + CphiMX_coeff[3]*tinv
-                                         + CphiMX_coeff[4]*tln;
-
-                m_Theta_ij[counterIJ] = Theta_coeff[0]
-                                        + Theta_coeff[1]*tlin
-                                        + Theta_coeff[2]*tquad
-                                        + Theta_coeff[3]*tinv
-                                        + Theta_coeff[4]*tln;
-
-                m_Beta0MX_ij_L[counterIJ] =  beta0MX_coeff[1]
-                                             + beta0MX_coeff[2]*twoT
-                                             - beta0MX_coeff[3]*invT2
-                                             + beta0MX_coeff[4]*invT;
-
-                m_Beta1MX_ij_L[counterIJ] =  beta1MX_coeff[1]
-                                             + beta1MX_coeff[2]*twoT
-                                             - beta1MX_coeff[3]*invT2
-                                             + beta1MX_coeff[4]*invT;
-
-                m_Beta2MX_ij_L[counterIJ] =  beta2MX_coeff[1]
-                                             + beta2MX_coeff[2]*twoT
-                                             - beta2MX_coeff[3]*invT2
-                                             + beta2MX_coeff[4]*invT;
-
-                m_CphiMX_ij_L[counterIJ] =  CphiMX_coeff[1]
-                                            + CphiMX_coeff[2]*twoT
-                                            - CphiMX_coeff[3]*invT2
-                                            + CphiMX_coeff[4]*invT;
-
-                m_Theta_ij_L[counterIJ] =   Theta_coeff[1]
-                                            + Theta_coeff[2]*twoT
-                                            - Theta_coeff[3]*invT2
-                                            + Theta_coeff[4]*invT;
-
-                doDerivs = 2;
-                if (doDerivs > 1) {
-                    m_Beta0MX_ij_LL[counterIJ] =
-                        + beta0MX_coeff[2]*2.0
-                        + beta0MX_coeff[3]*twoinvT3
-                        - beta0MX_coeff[4]*invT2;
-
-                    m_Beta1MX_ij_LL[counterIJ] =
-                        + beta1MX_coeff[2]*2.0
-                        + beta1MX_coeff[3]*twoinvT3
-                        - beta1MX_coeff[4]*invT2;
-
-                    m_Beta2MX_ij_LL[counterIJ] =
-                        + beta2MX_coeff[2]*2.0
-                        + beta2MX_coeff[3]*twoinvT3
-                        - beta2MX_coeff[4]*invT2;
-
-                    m_CphiMX_ij_LL[counterIJ] =
-                        + CphiMX_coeff[2]*2.0
-                        + CphiMX_coeff[3]*twoinvT3
-                        - CphiMX_coeff[4]*invT2;
-
-                    m_Theta_ij_LL[counterIJ] =
-                        + Theta_coeff[2]*2.0
-                        + Theta_coeff[3]*twoinvT3
-                        - Theta_coeff[4]*invT2;
-                }
-                break;
+                m_Lambda_nj(i,j) = Lambda_coeff[0]
+                                   + Lambda_coeff[1]*tlin
+                                   + Lambda_coeff[2]*tquad
+                                   + Lambda_coeff[3]*tinv
+                                   + Lambda_coeff[4]*tln;
+
+                m_Lambda_nj_L(i,j) = Lambda_coeff[1]
+                                     + Lambda_coeff[2]*twoT
+                                     - Lambda_coeff[3]*invT2
+                                     + Lambda_coeff[4]*invT;
+
+                m_Lambda_nj_LL(i,j) =
+                    Lambda_coeff[2]*2.0
+                    + Lambda_coeff[3]*twoinvT3
+                    - Lambda_coeff[4]*invT2;
             }
         }
-    }
 
-    // Lambda interactions and Mu_nnn
-    // i must be neutral for this term to be nonzero. We take advantage of this
-    // here to lower the operation count.
-    for (size_t i = 1; i < m_kk; i++) {
-        if (charge(i) == 0.0) {
-            for (size_t j = 1; j < m_kk; j++) {
-                size_t n = i * m_kk + j;
-                const double* Lambda_coeff = m_Lambda_nj_coeff.ptrColumn(n);
-                switch (m_formPitzerTemp) {
-                case PITZER_TEMP_CONSTANT:
-                    m_Lambda_nj(i,j) = Lambda_coeff[0];
-                    break;
-                case PITZER_TEMP_LINEAR:
-                    m_Lambda_nj(i,j)      = Lambda_coeff[0] + Lambda_coeff[1]*tlin;
-                    m_Lambda_nj_L(i,j)    = Lambda_coeff[1];
-                    m_Lambda_nj_LL(i,j)   = 0.0;
-                    break;
-                case PITZER_TEMP_COMPLEX1:
-                    m_Lambda_nj(i,j) = Lambda_coeff[0]
-                                       + Lambda_coeff[1]*tlin
-                                       + Lambda_coeff[2]*tquad
-                                       + Lambda_coeff[3]*tinv
-                                       + Lambda_coeff[4]*tln;
-
-                    m_Lambda_nj_L(i,j) = Lambda_coeff[1]
-                                         + Lambda_coeff[2]*twoT
-                                         - Lambda_coeff[3]*invT2
-                                         + Lambda_coeff[4]*invT;
-
-                    m_Lambda_nj_LL(i,j) =
-                        Lambda_coeff[2]*2.0
-                        + Lambda_coeff[3]*twoinvT3
-                        - Lambda_coeff[4]*invT2;
-                }
+        const double* Mu_coeff = m_Mu_nnn_coeff.ptrColumn(i);
+        switch (m_formPitzerTemp) {
+        case PITZER_TEMP_CONSTANT:
+            m_Mu_nnn[i] = Mu_coeff[0];
+            break;
+        case PITZER_TEMP_LINEAR:
+            m_Mu_nnn[i]      = Mu_coeff[0] + Mu_coeff[1]*tlin;
+            m_Mu_nnn_L[i]    = Mu_coeff[1];
+            m_Mu_nnn_LL[i]   = 0.0;
+            break;
+        case PITZER_TEMP_COMPLEX1:
+            m_Mu_nnn[i] = Mu_coeff[0]
+                          + Mu_coeff[1]*tlin
+                          + Mu_coeff[2]*tquad
+                          + Mu_coeff[3]*tinv
+                          + Mu_coeff[4]*tln;
 
-                if (j == i) {
-                    const double* Mu_coeff = m_Mu_nnn_coeff.ptrColumn(i);
-                    switch (m_formPitzerTemp) {
-                    case PITZER_TEMP_CONSTANT:
-                        m_Mu_nnn[i] = Mu_coeff[0];
-                        break;
-                    case PITZER_TEMP_LINEAR:
-                        m_Mu_nnn[i]      = Mu_coeff[0] + Mu_coeff[1]*tlin;
-                        m_Mu_nnn_L[i]    = Mu_coeff[1];
-                        m_Mu_nnn_LL[i]   = 0.0;
-                        break;
-                    case PITZER_TEMP_COMPLEX1:
-                        m_Mu_nnn[i] = Mu_coeff[0]
-                                      + Mu_coeff[1]*tlin
-                                      + Mu_coeff[2]*tquad
-                                      + Mu_coeff[3]*tinv
-                                      + Mu_coeff[4]*tln;
-
-                        m_Mu_nnn_L[i] = Mu_coeff[1]
-                                        + Mu_coeff[2]*twoT
-                                        - Mu_coeff[3]*invT2
-                                        + Mu_coeff[4]*invT;
-
-                        m_Mu_nnn_LL[i] =
-                            Mu_coeff[2]*2.0
-                            + Mu_coeff[3]*twoinvT3
-                            - Mu_coeff[4]*invT2;
-                    }
-                }
-            }
+            m_Mu_nnn_L[i] = Mu_coeff[1]
+                            + Mu_coeff[2]*twoT
+                            - Mu_coeff[3]*invT2
+                            + Mu_coeff[4]*invT;
+
+            m_Mu_nnn_LL[i] =
+                Mu_coeff[2]*2.0
+                + Mu_coeff[3]*twoinvT3
+                - Mu_coeff[4]*invT2;
         }
     }
 
+    /*
+     * The psi coefficients are only updated for the ternary
+     * interactions in the sparse list; all others are identically zero.
+     */
     switch(m_formPitzerTemp) {
     case PITZER_TEMP_CONSTANT:
-      for (size_t i = 1; i < m_kk; i++) {
-          for (size_t j = 1; j < m_kk; j++) {
-              for (size_t k = 1; k < m_kk; k++) {
-                  size_t n = i * m_kk *m_kk + j * m_kk + k ;
-                  const double* Psi_coeff = m_Psi_ijk_coeff.ptrColumn(n);
-                  m_Psi_ijk[n] = Psi_coeff[0];
-              }
+      for (size_t ir = 0; ir < m_PsiRows_ij.size(); ir++) {
+          size_t ij = m_PsiRows_ij[ir];
+          for (size_t m = m_PsiStart_ij[ij]; m < m_PsiStart_ij[ij+1]; m++) {
+              size_t n = ij * m_kk + m_PsiIndex_k[m];
+              const double* Psi_coeff = m_Psi_ijk_coeff.ptrColumn(n);
+              m_Psi_ijk[n] = Psi_coeff[0];
           }
       }
       break;
     case PITZER_TEMP_LINEAR:
-      for (size_t i = 1; i < m_kk; i++) {
-          for (size_t j = 1; j < m_kk; j++) {
-              for (size_t k = 1; k < m_kk; k++) {
-                  size_t n = i * m_kk *m_kk + j * m_kk + k ;
-                  const double* Psi_coeff = m_Psi_ijk_coeff.ptrColumn(n);
-                  m_Psi_ijk[n]      = Psi_coeff[0] + Psi_coeff[1]*tlin;
-                  m_Psi_ijk_L[n]    = Psi_coeff[1];
-                  m_Psi_ijk_LL[n]   = 0.0;
-              }
+      for (size_t ir = 0; ir < m_PsiRows_ij.size(); ir++) {
+          size_t ij = m_PsiRows_ij[ir];
+          for (size_t m = m_PsiStart_ij[ij]; m < m_PsiStart_ij[ij+1]; m++) {
+              size_t n = ij * m_kk + m_PsiIndex_k[m];
+              const double* Psi_coeff = m_Psi_ijk_coeff.ptrColumn(n);
+              m_Psi_ijk[n]      = Psi_coeff[0] + Psi_coeff[1]*tlin;
+              m_Psi_ijk_L[n]    = Psi_coeff[1];
+              m_Psi_ijk_LL[n]   = 0.0;
           }
       }
       break;
     case PITZER_TEMP_COMPLEX1:
-      for (size_t i = 1; i < m_kk; i++) {
-          for (size_t j = 1; j < m_kk; j++) {
-              for (size_t k = 1; k < m_kk; k++) {
-                  size_t n = i * m_kk *m_kk + j * m_kk + k ;
-                  const double* Psi_coeff = m_Psi_ijk_coeff.ptrColumn(n);
-                  m_Psi_ijk[n] = Psi_coeff[0]
-                                 + Psi_coeff[1]*tlin
-                                 + Psi_coeff[2]*tquad
-                                 + Psi_coeff[3]*tinv
-                                 + Psi_coeff[4]*tln;
-
-                  m_Psi_ijk_L[n] = Psi_coeff[1]
-                                   + Psi_coeff[2]*twoT
-                                   - Psi_coeff[3]*invT2
-                                   + Psi_coeff[4]*invT;
-
-                  m_Psi_ijk_LL[n] =
-                      Psi_coeff[2]*2.0
-                      + Psi_coeff[3]*twoinvT3
-                      - Psi_coeff[4]*invT2;
-              }
+      for (size_t ir = 0; ir < m_PsiRows_ij.size(); ir++) {
+          size_t ij = m_PsiRows_ij[ir];
+          for (size_t m = m_PsiStart_ij[ij]; m < m_PsiStart_ij[ij+1]; m++) {
+              size_t n = ij * m_kk + m_PsiIndex_k[m];
+              const double* Psi_coeff = m_Psi_ijk_coeff.ptrColumn(n);
+              m_Psi_ijk[n] = Psi_coeff[0]
+                             + Psi_coeff[1]*tlin
+                             + Psi_coeff[2]*tquad
+                             + Psi_coeff[3]*tinv
+                             + Psi_coeff[4]*tln;
+
+              m_Psi_ijk_L[n] = Psi_coeff[1]
+                               + Psi_coeff[2]*twoT
+                               - Psi_coeff[3]*invT2
+                               + Psi_coeff[4]*invT;
+
+              m_Psi_ijk_LL[n] =
+                  Psi_coeff[2]*2.0
+                  + Psi_coeff[3]*twoinvT3
+                  - Psi_coeff[4]*invT2;
           }
       }
       break;
@@ -1673,7 +1803,7 @@ void HMWSoln::s_updatePitzer_CoeffWRTemp(int doDerivs) const
 
 }
 
-void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
+void HMWSoln::s_updatePitzer_lnMolalityActCoeff(bool values, bool derivs) const
 {
     /*
      * HKM -> Assumption is made that the solvent is
@@ -1701,11 +1831,6 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
     const double* alpha1MX =  DATA_PTR(m_Alpha1MX_ij);
     const double* alpha2MX =  DATA_PTR(m_Alpha2MX_ij);
 
-    const double* psi_ijk =  DATA_PTR(m_Psi_ijk);
-    //n = k + j * m_kk + i * m_kk * m_kk;
-
-
-    double* gamma_Unscaled = DATA_PTR(m_gamma_tmp);
     /*
      * Local variables defined by Coltrin
      */
@@ -1721,8 +1846,11 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
     double molarcharge = 0.0;
     /*
      * molalitysum is the sum of the molalities over all solutes,
-     * even those with zero charge.
+     * even those with zero charge. The activity of the solvent is
+     * evaluated from the sum of the uncropped molalities, and its
+     * derivatives from the sum of the cropped molalities.
      */
+    double molalitysum = 0.0;
     double molalitysumUncropped = 0.0;
 
     double* gfunc    =  DATA_PTR(m_gfunc_IJ);
@@ -1740,10 +1868,6 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
     if (DEBUG_MODE_ENABLED && m_debugCalc) {
         printf("\n Debugging information from hmw_act \n");
     }
-    /*
-     * Make sure the counter variables are setup
-     */
-    counterIJ_setup();
 
     /*
      * ---------- Calculate common sums over solutes ---------------------
@@ -1753,6 +1877,7 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
         Is += charge(n) * charge(n) * molality[n];
         //      total molar charge
         molarcharge +=  fabs(charge(n)) * molality[n];
+        molalitysum += molality[n];
         molalitysumUncropped += m_molalities[n];
     }
     Is *= 0.5;
@@ -1769,209 +1894,150 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
     }
 
     /*
-     * The following call to calc_lambdas() calculates all 16 elements
-     * of the elambda and elambda1 arrays, given the value of the
-     * ionic strength (Is)
+     * The sets of interaction terms which are summed up together: the
+     * activity coefficients, followed by their first and second
+     * temperature derivatives and their pressure derivative. Aphi holds
+     * the corresponding Debye-Huckel coefficient or its derivative.
      */
-    calc_lambdas(Is);
+    PitzerTerms t[4];
+    double Aphi[4];
+    size_t nTerms = 0;
 
-    /*
-     * ----- Step 2:  Find the coefficients E-theta and -------------------
-     *                E-thetaprime for all combinations of positive
-     *                unlike charges up to 4
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 2: \n");
-    }
-    for (int z1 = 1; z1 <=4; z1++) {
-        for (int z2 =1; z2 <=4; z2++) {
-            calc_thetas(z1, z2, &etheta[z1][z2], &etheta_prime[z1][z2]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" z1=%3d z2=%3d E-theta(I) = %f, E-thetaprime(I) = %f\n",
-                       z1, z2, etheta[z1][z2], etheta_prime[z1][z2]);
+    if (values) {
+        /*
+         * The following call to calc_lambdas() calculates all 16 elements
+         * of the elambda and elambda1 arrays, given the value of the
+         * ionic strength (Is)
+         */
+        calc_lambdas(Is);
+
+        /*
+         * ----- Step 2:  Find the coefficients E-theta and -------------------
+         *                E-thetaprime for all combinations of positive
+         *                unlike charges up to 4
+         */
+        if (DEBUG_MODE_ENABLED && m_debugCalc) {
+            printf(" Step 2: \n");
+        }
+        for (int z1 = 1; z1 <=4; z1++) {
+            for (int z2 =1; z2 <=4; z2++) {
+                calc_thetas(z1, z2, &etheta[z1][z2], &etheta_prime[z1][z2]);
+                if (DEBUG_MODE_ENABLED && m_debugCalc) {
+                    printf(" z1=%3d z2=%3d E-theta(I) = %f, E-thetaprime(I) = %f\n",
+                           z1, z2, etheta[z1][z2], etheta_prime[z1][z2]);
+                }
             }
         }
-    }
 
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 3: \n");
-        printf(" Species          Species            g(x) "
-               " hfunc(x)   \n");
-    }
+        if (DEBUG_MODE_ENABLED && m_debugCalc) {
+            printf(" Step 3: \n");
+            printf(" Species          Species            g(x) "
+                   " hfunc(x)   \n");
+        }
 
-    /*
-     *  calculate g(x) and hfunc(x) for each cation-anion pair MX
-     *   In the original literature, hfunc, was called gprime. However,
-     *   it's not the derivative of g(x), so I renamed it.
-     */
-    for (size_t i = 1; i < (m_kk - 1); i++) {
-        for (size_t j = (i+1); j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
+        /*
+         *  calculate g(x) and hfunc(x) for each cation-anion pair MX
+         *   In the original literature, hfunc, was called gprime. However,
+         *   it's not the derivative of g(x), so I renamed it.
+         *
+         *  The binary terms are only evaluated for the pairs in the
+         *  interaction lists; they are zero for all other pairs.
+         */
+        for (size_t ip = 0; ip < m_CationAnionPairs.size(); ip++) {
+            size_t n = m_CationAnionPairs[ip];
             size_t counterIJ = m_CounterIJ[n];
-
             /*
-             * Only loop over oppositely charge species
+             * x is a reduced function variable
              */
-            if (charge(i)*charge(j) < 0) {
-                /*
-                 * x is a reduced function variable
-                 */
-                double x1 = sqrtIs * alpha1MX[counterIJ];
-                if (x1 > 1.0E-100) {
-                    gfunc[counterIJ] =  2.0*(1.0-(1.0 + x1) * exp(-x1)) / (x1 * x1);
-                    hfunc[counterIJ] = -2.0 *
-                                       (1.0-(1.0 + x1 + 0.5 * x1 * x1) * exp(-x1)) / (x1 * x1);
-                } else {
-                    gfunc[counterIJ] = 0.0;
-                    hfunc[counterIJ] = 0.0;
-                }
-
-                if (beta2MX[counterIJ] != 0.0) {
-                    double x2 = sqrtIs * alpha2MX[counterIJ];
-                    if (x2 > 1.0E-100) {
-                        g2func[counterIJ] =  2.0*(1.0-(1.0 + x2) * exp(-x2)) / (x2 * x2);
-                        h2func[counterIJ] = -2.0 *
-                                            (1.0-(1.0 + x2 + 0.5 * x2 * x2) * exp(-x2)) / (x2 * x2);
-                    } else {
-                        g2func[counterIJ] = 0.0;
-                        h2func[counterIJ] = 0.0;
-                    }
-                }
+            double x1 = sqrtIs * alpha1MX[counterIJ];
+            if (x1 > 1.0E-100) {
+                gfunc[counterIJ] =  2.0*(1.0-(1.0 + x1) * exp(-x1)) / (x1 * x1);
+                hfunc[counterIJ] = -2.0 *
+                                   (1.0-(1.0 + x1 + 0.5 * x1 * x1) * exp(-x1)) / (x1 * x1);
             } else {
                 gfunc[counterIJ] = 0.0;
                 hfunc[counterIJ] = 0.0;
             }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %9.5f %9.5f \n", sni.c_str(), snj.c_str(),
-                       gfunc[counterIJ], hfunc[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * --------- SUBSECTION TO CALCULATE BMX, BprimeMX, BphiMX ----------
-     * --------- Agrees with Pitzer, Eq. (49), (51), (55)
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 4: \n");
-        printf(" Species          Species            BMX    "
-               "BprimeMX    BphiMX   \n");
-    }
-
-    for (size_t i = 1; i < m_kk - 1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
 
             /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
+             * g2func and h2func are also used by the temperature and
+             * pressure derivatives, so they are needed whenever
+             * beta2 or one of its derivatives is nonzero.
              */
-            if (charge(i)*charge(j) < 0.0) {
-                BMX[counterIJ]  = beta0MX[counterIJ]
-                                  + beta1MX[counterIJ] * gfunc[counterIJ]
-                                  + beta2MX[counterIJ] * g2func[counterIJ];
-
-                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                    printf("%d %g: %g %g %g %g\n",
-                           (int) counterIJ,  BMX[counterIJ], beta0MX[counterIJ],
-                           beta1MX[counterIJ], beta2MX[counterIJ], gfunc[counterIJ]);
-                }
-                if (Is > 1.0E-150) {
-                    BprimeMX[counterIJ] = (beta1MX[counterIJ] * hfunc[counterIJ]/Is +
-                                           beta2MX[counterIJ] * h2func[counterIJ]/Is);
+            if (beta2MX[counterIJ] != 0.0 || m_Beta2MX_ij_L[counterIJ] != 0.0 ||
+                    m_Beta2MX_ij_LL[counterIJ] != 0.0 || m_Beta2MX_ij_P[counterIJ] != 0.0) {
+                double x2 = sqrtIs * alpha2MX[counterIJ];
+                if (x2 > 1.0E-100) {
+                    g2func[counterIJ] =  2.0*(1.0-(1.0 + x2) * exp(-x2)) / (x2 * x2);
+                    h2func[counterIJ] = -2.0 *
+                                        (1.0-(1.0 + x2 + 0.5 * x2 * x2) * exp(-x2)) / (x2 * x2);
                 } else {
-                    BprimeMX[counterIJ] = 0.0;
+                    g2func[counterIJ] = 0.0;
+                    h2func[counterIJ] = 0.0;
                 }
-                BphiMX[counterIJ]   = BMX[counterIJ] + Is*BprimeMX[counterIJ];
-            } else {
-                BMX[counterIJ]      = 0.0;
-                BprimeMX[counterIJ] = 0.0;
-                BphiMX[counterIJ]   = 0.0;
             }
             if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %11.7f %11.7f %11.7f \n",
-                       sni.c_str(), snj.c_str(),
-                       BMX[counterIJ], BprimeMX[counterIJ], BphiMX[counterIJ]);
+                std::string sni = speciesName(n / m_kk);
+                std::string snj = speciesName(n % m_kk);
+                printf(" %-16s %-16s %9.5f %9.5f \n", sni.c_str(), snj.c_str(),
+                       gfunc[counterIJ], hfunc[counterIJ]);
             }
         }
-    }
 
-    /*
-     * --------- SUBSECTION TO CALCULATE CMX ----------
-     * --------- Agrees with Pitzer, Eq. (53).
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 5: \n");
-        printf(" Species          Species            CMX \n");
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
+        /*
+         * --------- SUBSECTION TO CALCULATE BMX, BprimeMX, BphiMX, CMX ----------
+         * --------- Agrees with Pitzer, Eq. (49), (51), (53), (55)
+         */
+        if (DEBUG_MODE_ENABLED && m_debugCalc) {
+            printf(" Step 4: \n");
+            printf(" Species          Species            BMX    "
+                   "BprimeMX    BphiMX      CMX \n");
+        }
+        for (size_t ip = 0; ip < m_CationAnionPairs.size(); ip++) {
+            size_t n = m_CationAnionPairs[ip];
+            size_t i = n / m_kk;
+            size_t j = n % m_kk;
             size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0.0) {
-                CMX[counterIJ] = CphiMX[counterIJ]/
-                                 (2.0* sqrt(fabs(charge(i)*charge(j))));
+            BMX[counterIJ]  = beta0MX[counterIJ]
+                              + beta1MX[counterIJ] * gfunc[counterIJ]
+                              + beta2MX[counterIJ] * g2func[counterIJ];
+            if (Is > 1.0E-150) {
+                BprimeMX[counterIJ] = (beta1MX[counterIJ] * hfunc[counterIJ]/Is +
+                                       beta2MX[counterIJ] * h2func[counterIJ]/Is);
             } else {
-                CMX[counterIJ] = 0.0;
+                BprimeMX[counterIJ] = 0.0;
             }
+            BphiMX[counterIJ]   = BMX[counterIJ] + Is*BprimeMX[counterIJ];
+            CMX[counterIJ] = CphiMX[counterIJ]/
+                             (2.0* sqrt(fabs(charge(i)*charge(j))));
             if (DEBUG_MODE_ENABLED && m_debugCalc) {
                 std::string sni = speciesName(i);
                 std::string snj = speciesName(j);
-                printf(" %-16s %-16s %11.7f \n", sni.c_str(), snj.c_str(),
-                       CMX[counterIJ]);
+                printf(" %-16s %-16s %11.7f %11.7f %11.7f %11.7f \n",
+                       sni.c_str(), snj.c_str(), BMX[counterIJ],
+                       BprimeMX[counterIJ], BphiMX[counterIJ], CMX[counterIJ]);
             }
         }
-    }
 
-    /*
-     * ------- SUBSECTION TO CALCULATE Phi, PhiPrime, and PhiPhi ----------
-     * --------- Agrees with Pitzer, Eq. 72, 73, 74
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 6: \n");
-        printf(" Species          Species            Phi_ij "
-               " Phiprime_ij  Phi^phi_ij \n");
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
+        /*
+         * ------- SUBSECTION TO CALCULATE Phi, PhiPrime, and PhiPhi ----------
+         * --------- Agrees with Pitzer, Eq. 72, 73, 74
+         */
+        if (DEBUG_MODE_ENABLED && m_debugCalc) {
+            printf(" Step 6: \n");
+            printf(" Species          Species            Phi_ij "
+                   " Phiprime_ij  Phi^phi_ij \n");
+        }
+        for (size_t ip = 0; ip < m_LikeChargePairs.size(); ip++) {
+            size_t n = m_LikeChargePairs[ip];
+            size_t i = n / m_kk;
+            size_t j = n % m_kk;
             size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) > 0) {
-                int z1 = (int) fabs(charge(i));
-                int z2 = (int) fabs(charge(j));
-                Phi[counterIJ] = thetaij[counterIJ] + etheta[z1][z2];
-                Phiprime[counterIJ] = etheta_prime[z1][z2];
-                Phiphi[counterIJ] = Phi[counterIJ] + Is * Phiprime[counterIJ];
-            } else {
-                Phi[counterIJ]      = 0.0;
-                Phiprime[counterIJ] = 0.0;
-                Phiphi[counterIJ]   = 0.0;
-            }
+            int z1 = (int) fabs(charge(i));
+            int z2 = (int) fabs(charge(j));
+            Phi[counterIJ] = thetaij[counterIJ] + etheta[z1][z2];
+            Phiprime[counterIJ] = etheta_prime[z1][z2];
+            Phiphi[counterIJ] = Phi[counterIJ] + Is * Phiprime[counterIJ];
             if (DEBUG_MODE_ENABLED && m_debugCalc) {
                 std::string sni = speciesName(i);
                 std::string snj = speciesName(j);
@@ -1980,2894 +2046,371 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
                        Phi[counterIJ], Phiprime[counterIJ], Phiphi[counterIJ]);
             }
         }
+
+        PitzerTerms& tv = t[nTerms];
+        Aphi[nTerms++] = A_Debye_TP() / 3.0;
+        tv.BMX = BMX;
+        tv.BprimeMX = BprimeMX;
+        tv.BphiMX = BphiMX;
+        tv.CMX = CMX;
+        tv.Phi = Phi;
+        tv.Phiprime = Phiprime;
+        tv.Phiphi = Phiphi;
+        tv.psi = DATA_PTR(m_Psi_ijk);
+        tv.lambda = &m_Lambda_nj;
+        tv.mu = DATA_PTR(m_Mu_nnn);
+        tv.lnActCoeff = DATA_PTR(m_lnActCoeffMolal_Unscaled);
+    }
+
+    if (derivs) {
+        /*
+         * The E-theta terms and the g(x) and h(x) functions depend only on
+         * the ionic strength, which is the same for the activity
+         * coefficients and all of their derivatives. They were computed
+         * for the current state along with the activity coefficients,
+         * and are reused here.
+         */
+        s_updatePitzer_binaryDerivs(Is, DATA_PTR(m_Beta0MX_ij_L),
+                                    DATA_PTR(m_Beta1MX_ij_L), DATA_PTR(m_Beta2MX_ij_L),
+                                    DATA_PTR(m_CphiMX_ij_L), DATA_PTR(m_Theta_ij_L),
+                                    DATA_PTR(m_BMX_IJ_L), DATA_PTR(m_BprimeMX_IJ_L),
+                                    DATA_PTR(m_BphiMX_IJ_L), DATA_PTR(m_CMX_IJ_L),
+                                    DATA_PTR(m_Phi_IJ_L), DATA_PTR(m_PhiPhi_IJ_L));
+        PitzerTerms& tT = t[nTerms];
+        Aphi[nTerms++] = dA_DebyedT_TP() / 3.0;
+        tT.BMX = DATA_PTR(m_BMX_IJ_L);
+        tT.BprimeMX = DATA_PTR(m_BprimeMX_IJ_L);
+        tT.BphiMX = DATA_PTR(m_BphiMX_IJ_L);
+        tT.CMX = DATA_PTR(m_CMX_IJ_L);
+        tT.Phi = DATA_PTR(m_Phi_IJ_L);
+        tT.Phiprime = 0;
+        tT.Phiphi = DATA_PTR(m_PhiPhi_IJ_L);
+        tT.psi = DATA_PTR(m_Psi_ijk_L);
+        tT.lambda = &m_Lambda_nj_L;
+        tT.mu = DATA_PTR(m_Mu_nnn_L);
+        tT.lnActCoeff = DATA_PTR(m_dlnActCoeffMolaldT_Unscaled);
+
+        s_updatePitzer_binaryDerivs(Is, DATA_PTR(m_Beta0MX_ij_LL),
+                                    DATA_PTR(m_Beta1MX_ij_LL), DATA_PTR(m_Beta2MX_ij_LL),
+                                    DATA_PTR(m_CphiMX_ij_LL), DATA_PTR(m_Theta_ij_LL),
+                                    DATA_PTR(m_BMX_IJ_LL), DATA_PTR(m_BprimeMX_IJ_LL),
+                                    DATA_PTR(m_BphiMX_IJ_LL), DATA_PTR(m_CMX_IJ_LL),
+                                    DATA_PTR(m_Phi_IJ_LL), DATA_PTR(m_PhiPhi_IJ_LL));
+        PitzerTerms& tTT = t[nTerms];
+        Aphi[nTerms++] = d2A_DebyedT2_TP() / 3.0;
+        tTT.BMX = DATA_PTR(m_BMX_IJ_LL);
+        tTT.BprimeMX = DATA_PTR(m_BprimeMX_IJ_LL);
+        tTT.BphiMX = DATA_PTR(m_BphiMX_IJ_LL);
+        tTT.CMX = DATA_PTR(m_CMX_IJ_LL);
+        tTT.Phi = DATA_PTR(m_Phi_IJ_LL);
+        tTT.Phiprime = 0;
+        tTT.Phiphi = DATA_PTR(m_PhiPhi_IJ_LL);
+        tTT.psi = DATA_PTR(m_Psi_ijk_LL);
+        tTT.lambda = &m_Lambda_nj_LL;
+        tTT.mu = DATA_PTR(m_Mu_nnn_LL);
+        tTT.lnActCoeff = DATA_PTR(m_d2lnActCoeffMolaldT2_Unscaled);
+
+        s_updatePitzer_binaryDerivs(Is, DATA_PTR(m_Beta0MX_ij_P),
+                                    DATA_PTR(m_Beta1MX_ij_P), DATA_PTR(m_Beta2MX_ij_P),
+                                    DATA_PTR(m_CphiMX_ij_P), DATA_PTR(m_Theta_ij_P),
+                                    DATA_PTR(m_BMX_IJ_P), DATA_PTR(m_BprimeMX_IJ_P),
+                                    DATA_PTR(m_BphiMX_IJ_P), DATA_PTR(m_CMX_IJ_P),
+                                    DATA_PTR(m_Phi_IJ_P), DATA_PTR(m_PhiPhi_IJ_P));
+        PitzerTerms& tP = t[nTerms];
+        Aphi[nTerms++] = dA_DebyedP_TP() / 3.0;
+        tP.BMX = DATA_PTR(m_BMX_IJ_P);
+        tP.BprimeMX = DATA_PTR(m_BprimeMX_IJ_P);
+        tP.BphiMX = DATA_PTR(m_BphiMX_IJ_P);
+        tP.CMX = DATA_PTR(m_CMX_IJ_P);
+        tP.Phi = DATA_PTR(m_Phi_IJ_P);
+        tP.Phiprime = 0;
+        tP.Phiphi = DATA_PTR(m_PhiPhi_IJ_P);
+        tP.psi = DATA_PTR(m_Psi_ijk_P);
+        tP.lambda = &m_Lambda_nj_P;
+        tP.mu = DATA_PTR(m_Mu_nnn_P);
+        tP.lnActCoeff = DATA_PTR(m_dlnActCoeffMolaldP_Unscaled);
     }
 
     /*
      * ------------- SUBSECTION FOR CALCULATION OF F ----------------------
      * ------------ Agrees with Pitzer Eqn. (65) --------------------------
+     *
+     * The Debye-Huckel part of F is computed here, and the binary terms
+     * are added in s_updatePitzer_sums().
      */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 7: \n");
+    double DH_F = sqrtIs / (1.0 + 1.2*sqrtIs) + (2.0/1.2) * log(1.0+1.2*sqrtIs);
+    for (size_t it = 0; it < nTerms; it++) {
+        t[it].F = -Aphi[it] * DH_F;
     }
-    double Aphi = A_Debye_TP() / 3.0;
-    double F = -Aphi * (sqrt(Is) / (1.0 + 1.2*sqrt(Is))
-                 + (2.0/1.2) * log(1.0+1.2*(sqrtIs)));
+
+    /*
+     * ------ SUBSECTION FOR CALCULATING THE SOLUTE ACTIVITY COEFFICIENTS ----
+     * -------- -> equations agree with my notes, Eqn. (118), (119).
+     *          -> Equations agree with Pitzer, eqn.(63), (64)
+     */
     if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" initial value of F = %10.6f \n", F);
+        printf(" Step 8: Summing in All Contributions to Activity Coefficients \n");
     }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0) {
-                F = F + molality[i]*molality[j] * BprimeMX[counterIJ];
-            }
-            /*
-             * Both species have a non-zero charge, and they
-             * have the same sign
-             */
-            if (charge(i)*charge(j) > 0) {
-                F = F + molality[i]*molality[j] * Phiprime[counterIJ];
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" F = %10.6f \n", F);
-            }
-        }
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 8: Summing in All Contributions to Activity Coefficients \n");
-    }
-
-    for (size_t i = 1; i < m_kk; i++) {
-
-        /*
-         * -------- SUBSECTION FOR CALCULATING THE ACTCOEFF FOR CATIONS -----
-         * -------- -> equations agree with my notes, Eqn. (118).
-         *          -> Equations agree with Pitzer, eqn.(63)
-         */
-        if (charge(i) > 0.0) {
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf("  Contributions to ln(ActCoeff_%s):\n", sni.c_str());
-            }
-            // species i is the cation (positive) to calc the actcoeff
-            double zsqF = charge(i)*charge(i)*F;
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf("      Unary term:                                      z*z*F = %10.5f\n", zsqF);
-            }
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                /*
-                 * Find the counterIJ for the symmetric binary interaction
-                 */
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                if (charge(j) < 0.0) {
-                    // sum over all anions
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX[counterIJ] + molarcharge*CMX[counterIJ]);
-                    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                        std::string snj = speciesName(j) + ":";
-                        printf("      Bin term with %-13s                  2 m_j BMX = %10.5f\n", snj.c_str(),
-                               molality[j]*2.0*BMX[counterIJ]);
-                        printf("                                                   m_j Z CMX = %10.5f\n",
-                               molality[j]* molarcharge*CMX[counterIJ]);
-                    }
-                    if (j < m_kk-1) {
-                        /*
-                         * This term is the ternary interaction involving the
-                         * non-duplicate sum over double anions, j, k, with
-                         * respect to the cation, i.
-                         */
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all anions
-                            if (charge(k) < 0.0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk[n];
-                                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                    if (psi_ijk[n] != 0.0) {
-                                        std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                        printf("      Psi term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
-                                               molality[j]*molality[k]*psi_ijk[n]);
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-
-
-                if (charge(j) > 0.0) {
-                    // sum over all cations
-                    if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi[counterIJ]);
-                        if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                            if ((molality[j] * Phi[counterIJ])!= 0.0) {
-                                std::string snj = speciesName(j) + ":";
-                                printf("      Phi term with %-12s                2 m_j Phi_cc = %10.5f\n", snj.c_str(),
-                                       molality[j]*(2.0*Phi[counterIJ]));
-                            }
-                        }
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            // two inner sums over anions
-
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk[n];
-                            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                if (psi_ijk[n] != 0.0) {
-                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                    printf("      Psi term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
-                                           molality[j]*molality[k]*psi_ijk[n]);
-                                }
-                            }
-                            /*
-                             * Find the counterIJ for the j,k interaction
-                             */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 + (fabs(charge(i))*
-                                           molality[j]*molality[k]*CMX[counterIJ2]);
-                            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                if ((molality[j]*molality[k]*CMX[counterIJ2]) != 0.0) {
-                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                    printf("      Tern CMX term on %-16s abs(z_i) m_j m_k CMX = %10.5f\n", snj.c_str(),
-                                           fabs(charge(i))* molality[j]*molality[k]*CMX[counterIJ2]);
-                                }
-                            }
-                        }
-                    }
-                }
-
-                /*
-                 * Handle neutral j species
-                 */
-                if (charge(j) == 0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj(j,i);
-                    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                        if ((molality[j]*2.0*m_Lambda_nj(j,i)) != 0.0) {
-                            std::string snj = speciesName(j) + ":";
-                            printf("      Lambda term with %-12s                 2 m_j lam_ji = %10.5f\n", snj.c_str(),
-                                   molality[j]*2.0*m_Lambda_nj(j,i));
-                        }
-                    }
-                    /*
-                     * Zeta interaction term
-                     */
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + k;
-                            double zeta = psi_ijk[n];
-                            if (zeta != 0.0) {
-                                sum5 = sum5 + molality[j]*molality[k]*zeta;
-                                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                    printf("      Zeta term on %-16s         m_n m_a zeta_nMa = %10.5f\n", snj.c_str(),
-                                           molality[j]*molality[k]*psi_ijk[n]);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            /*
-             * Add all of the contributions up to yield the log of the
-             * solute activity coefficients (molality scale)
-             */
-            m_lnActCoeffMolal_Unscaled[i] = zsqF + sum1 + sum2 + sum3 + sum4 + sum5;
-            gamma_Unscaled[i] = exp(m_lnActCoeffMolal_Unscaled[i]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf("      Net %-16s                        lngamma[i] =  %9.5f         gamma[i]=%10.6f \n",
-                       sni.c_str(), m_lnActCoeffMolal_Unscaled[i], gamma_Unscaled[i]);
-            }
-        }
-
-        /*
-         * -------- SUBSECTION FOR CALCULATING THE ACTCOEFF FOR ANIONS ------
-         * -------- -> equations agree with my notes, Eqn. (119).
-         *          -> Equations agree with Pitzer, eqn.(64)
-         */
-        if (charge(i) < 0) {
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf("  Contributions to ln(ActCoeff_%s):\n", sni.c_str());
-            }
-            //          species i is an anion (negative)
-            double zsqF = charge(i)*charge(i)*F;
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf("      Unary term:                                      z*z*F = %10.5f\n", zsqF);
-            }
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                /*
-                 * Find the counterIJ for the symmetric binary interaction
-                 */
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                /*
-                 * For Anions, do the cation interactions.
-                 */
-                if (charge(j) > 0) {
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX[counterIJ]+molarcharge*CMX[counterIJ]);
-                    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                        std::string snj = speciesName(j) + ":";
-                        printf("      Bin term with %-13s                  2 m_j BMX = %10.5f\n", snj.c_str(),
-                               molality[j]*2.0*BMX[counterIJ]);
-                        printf("                                                   m_j Z CMX = %10.5f\n",
-                               molality[j]* molarcharge*CMX[counterIJ]);
-                    }
-                    if (j < m_kk-1) {
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all cations
-                            if (charge(k) > 0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk[n];
-                                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                    if (psi_ijk[n] != 0.0) {
-                                        std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                        printf("      Psi term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
-                                               molality[j]*molality[k]*psi_ijk[n]);
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-
-                /*
-                 * For Anions, do the other anion interactions.
-                 */
-                if (charge(j) < 0.0) {
-                    //  sum over all anions
-                    if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi[counterIJ]);
-                        if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                            if ((molality[j] * Phi[counterIJ])!= 0.0) {
-                                std::string snj = speciesName(j) + ":";
-                                printf("      Phi term with %-12s                2 m_j Phi_aa = %10.5f\n", snj.c_str(),
-                                       molality[j]*(2.0*Phi[counterIJ]));
-                            }
-                        }
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            // two inner sums over cations
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk[n];
-                            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                if (psi_ijk[n] != 0.0) {
-                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                    printf("      Psi term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
-                                           molality[j]*molality[k]*psi_ijk[n]);
-                                }
-                            }
-                            /*
-                             * Find the counterIJ for the symmetric binary interaction
-                             */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 +
-                                   (fabs(charge(i))*
-                                    molality[j]*molality[k]*CMX[counterIJ2]);
-                            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                if ((molality[j]*molality[k]*CMX[counterIJ2]) != 0.0) {
-                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                    printf("      Tern CMX term on %-16s abs(z_i) m_j m_k CMX = %10.5f\n", snj.c_str(),
-                                           fabs(charge(i))* molality[j]*molality[k]*CMX[counterIJ2]);
-                                }
-                            }
-                        }
-                    }
-                }
-
-                /*
-                 * for Anions, do the neutral species interaction
-                 */
-                if (charge(j) == 0.0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj(j,i);
-                    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                        if ((molality[j]*2.0*m_Lambda_nj(j,i)) != 0.0) {
-                            std::string snj = speciesName(j) + ":";
-                            printf("      Lambda term with %-12s                 2 m_j lam_ji = %10.5f\n", snj.c_str(),
-                                   molality[j]*2.0*m_Lambda_nj(j,i));
-                        }
-                    }
-                    /*
-                     * Zeta interaction term
-                     */
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = k;
-                            size_t kzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + kzeta;
-                            double zeta = psi_ijk[n];
-                            if (zeta != 0.0) {
-                                sum5 = sum5 + molality[j]*molality[k]*zeta;
-                                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                    printf("      Zeta term on %-16s         m_n m_c zeta_ncX = %10.5f\n", snj.c_str(),
-                                           molality[j]*molality[k]*psi_ijk[n]);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            m_lnActCoeffMolal_Unscaled[i] = zsqF + sum1 + sum2 + sum3 + sum4 + sum5;
-            gamma_Unscaled[i] = exp(m_lnActCoeffMolal_Unscaled[i]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf("      Net %-16s                        lngamma[i] =  %9.5f             gamma[i]=%10.6f\n",
-                       sni.c_str(), m_lnActCoeffMolal_Unscaled[i], gamma_Unscaled[i]);
-            }
-        }
-        /*
-         * ------ SUBSECTION FOR CALCULATING NEUTRAL SOLUTE ACT COEFF -------
-         * ------ -> equations agree with my notes,
-         *        -> Equations agree with Pitzer,
-         */
-        if (charge(i) == 0.0) {
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf("  Contributions to ln(ActCoeff_%s):\n", sni.c_str());
-            }
-            double sum1 = 0.0;
-            double sum3 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                sum1 = sum1 + molality[j]*2.0*m_Lambda_nj(i,j);
-                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                    if (m_Lambda_nj(i,j) != 0.0) {
-                        std::string snj = speciesName(j) + ":";
-                        printf("      Lambda_n term on %-16s     2 m_j lambda_n_j = %10.5f\n", snj.c_str(),
-                               molality[j]*2.0*m_Lambda_nj(i,j));
-                    }
-                }
-                /*
-                 * Zeta term -> we piggyback on the psi term
-                 */
-                if (charge(j) > 0.0) {
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t n = k + j * m_kk + i * m_kk * m_kk;
-                            sum3 = sum3 + molality[j]*molality[k]*psi_ijk[n];
-                            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                                if (psi_ijk[n] != 0.0) {
-                                    std::string snj = speciesName(j) + "," + speciesName(k) + ":";
-                                    printf("      Zeta term on %-16s           m_j m_k psi_ijk = %10.5f\n", snj.c_str(),
-                                           molality[j]*molality[k]*psi_ijk[n]);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            double sum2 = 3.0 * molality[i]* molality[i] * m_Mu_nnn[i];
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                if (m_Mu_nnn[i] != 0.0) {
-                    printf("      Mu_nnn term              3 m_n m_n Mu_n_n = %10.5f\n",
-                           3.0 * molality[i]* molality[i] * m_Mu_nnn[i]);
-                }
-            }
-            m_lnActCoeffMolal_Unscaled[i] = sum1 + sum2 + sum3;
-            gamma_Unscaled[i] = exp(m_lnActCoeffMolal_Unscaled[i]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf("      Net %-16s                        lngamma[i] =  %9.5f             gamma[i]=%10.6f\n",
-                       sni.c_str(), m_lnActCoeffMolal_Unscaled[i], gamma_Unscaled[i]);
-            }
-        }
-
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 9: \n");
-    }
-    /*
-     * -------- SUBSECTION FOR CALCULATING THE OSMOTIC COEFF ---------
-     * -------- -> equations agree with my notes, Eqn. (117).
-     *          -> Equations agree with Pitzer, eqn.(62)
-     */
-    double sum1 = 0.0;
-    double sum2 = 0.0;
-    double sum3 = 0.0;
-    double sum4 = 0.0;
-    double sum5 = 0.0;
-    double sum6 = 0.0;
-    double sum7 = 0.0;
-    /*
-     * term1 is the DH term in the osmotic coefficient expression
-     * b = 1.2 sqrt(kg/gmol) <- arbitrarily set in all Pitzer
-     *                          implementations.
-     * Is = Ionic strength on the molality scale (units of (gmol/kg))
-     * Aphi = A_Debye / 3   (units of sqrt(kg/gmol))
-     */
-    double term1 = -Aphi * pow(Is,1.5) / (1.0 + 1.2 * sqrt(Is));
-
-    for (size_t j = 1; j < m_kk; j++) {
-        /*
-         * Loop Over Cations
-         */
-        if (charge(j) > 0.0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum1 = sum1 + molality[j]*molality[k]*
-                           (BphiMX[counterIJ] + molarcharge*CMX[counterIJ]);
-                }
-            }
-
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == (m_kk-1)) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_lnMolalityActCoeff",
-                                       "logic error 1 in Step 9 of hmw_act");
-                }
-                if (charge(k) > 0.0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     * between 2 cations.
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum2 = sum2 + molality[j]*molality[k]*Phiphi[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) < 0.0) {
-                            // species m is an anion
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum2 = sum2 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        /*
-         * Loop Over Anions
-         */
-        if (charge(j) < 0) {
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == m_kk-1) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_lnMolalityActCoeff",
-                                       "logic error 2 in Step 9 of hmw_act");
-                }
-                if (charge(k) < 0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     * between two anions
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum3 = sum3 + molality[j]*molality[k]*Phiphi[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum3 = sum3 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        /*
-         * Loop Over Neutral Species
-         */
-        if (charge(j) == 0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    sum4 = sum4 + molality[j]*molality[k]*m_Lambda_nj(j,k);
-                }
-                if (charge(k) > 0.0) {
-                    sum5 = sum5 + molality[j]*molality[k]*m_Lambda_nj(j,k);
-                }
-                if (charge(k) == 0.0) {
-                    if (k > j) {
-                        sum6 = sum6 + molality[j]*molality[k]*m_Lambda_nj(j,k);
-                    } else if (k == j) {
-                        sum6 = sum6 + 0.5 * molality[j]*molality[k]*m_Lambda_nj(j,k);
-                    }
-                }
-                if (charge(k) < 0.0) {
-                    size_t izeta = j;
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            size_t jzeta = m;
-                            size_t n = k + jzeta * m_kk + izeta * m_kk * m_kk;
-                            double zeta = psi_ijk[n];
-                            if (zeta != 0.0) {
-                                sum7 += molality[izeta]*molality[jzeta]*molality[k]*zeta;
-                            }
-                        }
-                    }
-                }
-            }
-            sum7 += molality[j]*molality[j]*molality[j]*m_Mu_nnn[j];
-        }
-    }
-    double sum_m_phi_minus_1 = 2.0 *
-                        (term1 + sum1 + sum2 + sum3 + sum4 + sum5 + sum6 + sum7);
-    /*
-     * Calculate the osmotic coefficient from
-     *       osmotic_coeff = 1 + dGex/d(M0noRT) / sum(molality_i)
-     */
-    double osmotic_coef;
-    if (molalitysumUncropped > 1.0E-150) {
-        osmotic_coef = 1.0 + (sum_m_phi_minus_1 / molalitysumUncropped);
-    } else {
-        osmotic_coef = 1.0;
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" term1=%10.6f sum1=%10.6f sum2=%10.6f "
-               "sum3=%10.6f sum4=%10.6f sum5=%10.6f\n",
-               term1, sum1, sum2, sum3, sum4, sum5);
-        printf("     sum_m_phi_minus_1=%10.6f        osmotic_coef=%10.6f\n",
-               sum_m_phi_minus_1, osmotic_coef);
-        printf(" Step 10: \n");
-    }
-    double lnwateract = -(m_weightSolvent/1000.0) * molalitysumUncropped * osmotic_coef;
-
-    /*
-     * In Cantera, we define the activity coefficient of the solvent as
-     *
-     *     act_0 = actcoeff_0 * Xmol_0
-     *
-     * We have just computed act_0. However, this routine returns
-     *  ln(actcoeff[]). Therefore, we must calculate ln(actcoeff_0).
-     */
-    double xmolSolvent = moleFraction(m_indexSolvent);
-    double xx = std::max(m_xmolSolventMIN, xmolSolvent);
-    m_lnActCoeffMolal_Unscaled[0] = lnwateract - log(xx);
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        double wateract = exp(lnwateract);
-        printf(" Weight of Solvent = %16.7g\n", m_weightSolvent);
-        printf(" molalitySumUncropped = %16.7g\n", molalitysumUncropped);
-        printf(" ln_a_water=%10.6f a_water=%10.6f\n\n",
-               lnwateract, wateract);
-    }
-}
-
-void HMWSoln::s_update_dlnMolalityActCoeff_dT() const
-{
-    static const int cacheId = m_cache.getId();
-    CachedScalar cached = m_cache.getScalar(cacheId);
-    if( cached.validate(temperature(), pressure(), stateMFNumber()) ) {
-        return;
-    }
-
-    /*
-     *  Zero the unscaled 2nd derivatives
-     */
-    m_dlnActCoeffMolaldT_Unscaled.assign(m_kk, 0.0);
-    /*
-     *  Do the actual calculation of the unscaled temperature derivatives
-     */
-    s_updatePitzer_dlnMolalityActCoeff_dT();
-
-    for (size_t k = 1; k < m_kk; k++) {
-        if (CROP_speciesCropped_[k] == 2) {
-            m_dlnActCoeffMolaldT_Unscaled[k] = 0.0;
-        }
-    }
-
-    if (CROP_speciesCropped_[0]) {
-        m_dlnActCoeffMolaldT_Unscaled[0] = 0.0;
-    }
-
-    /*
-     *  Do the pH scaling to the derivatives
-     */
-    s_updateScaling_pHScaling_dT();
-
-
-}
-
-void HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dT() const
-{
-    /*
-     * It may be assumed that the Pitzer activity coefficient routine is
-     * called immediately preceding the calling of this routine. Therefore,
-     * some quantities do not need to be recalculated in this routine.
-     */
-
-    /*
-     * HKM -> Assumption is made that the solvent is
-     *        species 0.
-     */
-#ifdef DEBUG_MODE
-    m_debugCalc = 0;
-#endif
-    if (m_indexSolvent != 0) {
-        throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dT",
-                           "Wrong index solvent value!");
-    }
-
-    const double* molality  =  DATA_PTR(m_molalitiesCropped);
-    const double* beta0MX_L =  DATA_PTR(m_Beta0MX_ij_L);
-    const double* beta1MX_L =  DATA_PTR(m_Beta1MX_ij_L);
-    const double* beta2MX_L =  DATA_PTR(m_Beta2MX_ij_L);
-    const double* CphiMX_L  =  DATA_PTR(m_CphiMX_ij_L);
-    const double* thetaij_L =  DATA_PTR(m_Theta_ij_L);
-    const double* alpha1MX   =  DATA_PTR(m_Alpha1MX_ij);
-    const double* alpha2MX   =  DATA_PTR(m_Alpha2MX_ij);
-    const double* psi_ijk_L =  DATA_PTR(m_Psi_ijk_L);
-    double* d_gamma_dT_Unscaled   =  DATA_PTR(m_gamma_tmp);
-    /*
-     * Local variables defined by Coltrin
-     */
-    double etheta[5][5], etheta_prime[5][5], sqrtIs;
-    /*
-     * Molality based ionic strength of the solution
-     */
-    double Is = 0.0;
-    /*
-     * Molarcharge of the solution: In Pitzer's notation,
-     * this is his variable called "Z".
-     */
-    double molarcharge = 0.0;
-    /*
-     * molalitysum is the sum of the molalities over all solutes,
-     * even those with zero charge.
-     */
-    double molalitysum = 0.0;
-
-    double* gfunc    =  DATA_PTR(m_gfunc_IJ);
-    double* g2func   =  DATA_PTR(m_g2func_IJ);
-    double* hfunc    =  DATA_PTR(m_hfunc_IJ);
-    double* h2func   =  DATA_PTR(m_h2func_IJ);
-    double* BMX_L    =  DATA_PTR(m_BMX_IJ_L);
-    double* BprimeMX_L= DATA_PTR(m_BprimeMX_IJ_L);
-    double* BphiMX_L =  DATA_PTR(m_BphiMX_IJ_L);
-    double* Phi_L    =  DATA_PTR(m_Phi_IJ_L);
-    double* Phiprime =  DATA_PTR(m_Phiprime_IJ);
-    double* Phiphi_L =  DATA_PTR(m_PhiPhi_IJ_L);
-    double* CMX_L    =  DATA_PTR(m_CMX_IJ_L);
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf("\n Debugging information from "
-               "s_Pitzer_dlnMolalityActCoeff_dT()\n");
-    }
-    /*
-     * Make sure the counter variables are setup
-     */
-    counterIJ_setup();
-
-    /*
-     * ---------- Calculate common sums over solutes ---------------------
-     */
-    for (size_t n = 1; n < m_kk; n++) {
-        //      ionic strength
-        Is += charge(n) * charge(n) * molality[n];
-        //      total molar charge
-        molarcharge +=  fabs(charge(n)) * molality[n];
-        molalitysum += molality[n];
-    }
-    Is *= 0.5;
-
-    /*
-     * Store the ionic molality in the object for reference.
-     */
-    m_IionicMolality = Is;
-    sqrtIs = sqrt(Is);
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 1: \n");
-        printf(" ionic strenth      = %14.7le \n total molar "
-               "charge = %14.7le \n", Is, molarcharge);
-    }
-
-    /*
-     * The following call to calc_lambdas() calculates all 16 elements
-     * of the elambda and elambda1 arrays, given the value of the
-     * ionic strength (Is)
-     */
-    calc_lambdas(Is);
-
-    /*
-     * ----- Step 2:  Find the coefficients E-theta and -------------------
-     *                E-thetaprime for all combinations of positive
-     *                unlike charges up to 4
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 2: \n");
-    }
-    for (int z1 = 1; z1 <=4; z1++) {
-        for (int z2 =1; z2 <=4; z2++) {
-            calc_thetas(z1, z2, &etheta[z1][z2], &etheta_prime[z1][z2]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" z1=%3d z2=%3d E-theta(I) = %f, E-thetaprime(I) = %f\n",
-                       z1, z2, etheta[z1][z2], etheta_prime[z1][z2]);
-            }
-        }
-    }
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 3: \n");
-        printf(" Species          Species            g(x) "
-               " hfunc(x)   \n");
-    }
-
-    /*
-     *  calculate g(x) and hfunc(x) for each cation-anion pair MX
-     *   In the original literature, hfunc, was called gprime. However,
-     *   it's not the derivative of g(x), so I renamed it.
-     */
-    for (size_t i = 1; i < (m_kk - 1); i++) {
-        for (size_t j = (i+1); j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * Only loop over oppositely charge species
-             */
-            if (charge(i)*charge(j) < 0) {
-                /*
-                 * x is a reduced function variable
-                 */
-                double x1 = sqrtIs * alpha1MX[counterIJ];
-                if (x1 > 1.0E-100) {
-                    gfunc[counterIJ]     =  2.0*(1.0-(1.0 + x1) * exp(-x1)) / (x1 * x1);
-                    hfunc[counterIJ] = -2.0 *
-                                       (1.0-(1.0 + x1 + 0.5 * x1 *x1) * exp(-x1)) / (x1 * x1);
-                } else {
-                    gfunc[counterIJ] = 0.0;
-                    hfunc[counterIJ] = 0.0;
-                }
-
-                if (beta2MX_L[counterIJ] != 0.0) {
-                    double x2 = sqrtIs * alpha2MX[counterIJ];
-                    if (x2 > 1.0E-100) {
-                        g2func[counterIJ] =  2.0*(1.0-(1.0 + x2) * exp(-x2)) / (x2 * x2);
-                        h2func[counterIJ] = -2.0 *
-                                            (1.0-(1.0 + x2 + 0.5 * x2 * x2) * exp(-x2)) / (x2 * x2);
-                    } else {
-                        g2func[counterIJ] = 0.0;
-                        h2func[counterIJ] = 0.0;
-                    }
-                }
-            } else {
-                gfunc[counterIJ] = 0.0;
-                hfunc[counterIJ] = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %9.5f %9.5f \n", sni.c_str(), snj.c_str(),
-                       gfunc[counterIJ], hfunc[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * ------- SUBSECTION TO CALCULATE BMX_L, BprimeMX_L, BphiMX_L ----------
-     * ------- These are now temperature derivatives of the
-     *         previously calculated quantities.
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 4: \n");
-        printf(" Species          Species            BMX    "
-               "BprimeMX    BphiMX   \n");
-    }
-
-    for (size_t i = 1; i < m_kk - 1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0.0) {
-                BMX_L[counterIJ]  = beta0MX_L[counterIJ]
-                                    + beta1MX_L[counterIJ] * gfunc[counterIJ]
-                                    + beta2MX_L[counterIJ] * gfunc[counterIJ];
-                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                    printf("%d %g: %g %g %g %g\n",
-                           (int) counterIJ,  BMX_L[counterIJ], beta0MX_L[counterIJ],
-                           beta1MX_L[counterIJ],  beta2MX_L[counterIJ], gfunc[counterIJ]);
-                }
-                if (Is > 1.0E-150) {
-                    BprimeMX_L[counterIJ] = (beta1MX_L[counterIJ] * hfunc[counterIJ]/Is +
-                                             beta2MX_L[counterIJ] * h2func[counterIJ]/Is);
-                } else {
-                    BprimeMX_L[counterIJ] = 0.0;
-                }
-                BphiMX_L[counterIJ] = BMX_L[counterIJ] + Is*BprimeMX_L[counterIJ];
-            } else {
-                BMX_L[counterIJ]      = 0.0;
-                BprimeMX_L[counterIJ] = 0.0;
-                BphiMX_L[counterIJ]     = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %11.7f %11.7f %11.7f \n",
-                       sni.c_str(), snj.c_str(),
-                       BMX_L[counterIJ], BprimeMX_L[counterIJ], BphiMX_L[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * --------- SUBSECTION TO CALCULATE CMX_L ----------
-     * ---------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 5: \n");
-        printf(" Species          Species            CMX \n");
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0.0) {
-                CMX_L[counterIJ] = CphiMX_L[counterIJ]/
-                                   (2.0* sqrt(fabs(charge(i)*charge(j))));
-            } else {
-                CMX_L[counterIJ] = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %11.7f \n", sni.c_str(), snj.c_str(),
-                       CMX_L[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * ------- SUBSECTION TO CALCULATE Phi, PhiPrime, and PhiPhi ----------
-     * --------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 6: \n");
-        printf(" Species          Species            Phi_ij "
-               " Phiprime_ij  Phi^phi_ij \n");
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) > 0) {
-                Phi_L[counterIJ] = thetaij_L[counterIJ];
-                Phiprime[counterIJ] = 0.0;
-                Phiphi_L[counterIJ] = Phi_L[counterIJ] + Is * Phiprime[counterIJ];
-            } else {
-                Phi_L[counterIJ]      = 0.0;
-                Phiprime[counterIJ] = 0.0;
-                Phiphi_L[counterIJ]   = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %10.6f %10.6f %10.6f \n",
-                       sni.c_str(), snj.c_str(),
-                       Phi_L[counterIJ], Phiprime[counterIJ], Phiphi_L[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * ----------- SUBSECTION FOR CALCULATION OF dFdT ---------------------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 7: \n");
-    }
-    double dA_DebyedT = dA_DebyedT_TP();
-    double dAphidT = dA_DebyedT /3.0;
-    double dFdT = -dAphidT * (sqrt(Is) / (1.0 + 1.2*sqrt(Is))
-                       + (2.0/1.2) * log(1.0+1.2*(sqrtIs)));
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" initial value of dFdT = %10.6f \n", dFdT);
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0) {
-                dFdT = dFdT + molality[i]*molality[j] * BprimeMX_L[counterIJ];
-            }
-            /*
-             * Both species have a non-zero charge, and they
-             * have the same sign, e.g., both positive or both negative.
-             */
-            if (charge(i)*charge(j) > 0) {
-                dFdT = dFdT + molality[i]*molality[j] * Phiprime[counterIJ];
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" dFdT = %10.6f \n", dFdT);
-            }
-        }
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 8: \n");
-    }
-
-    for (size_t i = 1; i < m_kk; i++) {
-        /*
-         * -------- SUBSECTION FOR CALCULATING THE dACTCOEFFdT FOR CATIONS -----
-         * --
-         */
-        if (charge(i) > 0) {
-            // species i is the cation (positive) to calc the actcoeff
-            double zsqdFdT = charge(i)*charge(i)*dFdT;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                /*
-                 * Find the counterIJ for the symmetric binary interaction
-                 */
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                if (charge(j) < 0.0) {
-                    // sum over all anions
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX_L[counterIJ] + molarcharge*CMX_L[counterIJ]);
-                    if (j < m_kk-1) {
-                        /*
-                         * This term is the ternary interaction involving the
-                         * non-duplicate sum over double anions, j, k, with
-                         * respect to the cation, i.
-                         */
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all anions
-                            if (charge(k) < 0.0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk_L[n];
-                            }
-                        }
-                    }
-                }
-
-
-                if (charge(j) > 0.0) {
-                    // sum over all cations
-                    if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi_L[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            // two inner sums over anions
-
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk_L[n];
-                            /*
-                             * Find the counterIJ for the j,k interaction
-                             */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 + (fabs(charge(i))*
-                                           molality[j]*molality[k]*CMX_L[counterIJ2]);
-                        }
-                    }
-                }
-
-                /*
-                 * Handle neutral j species
-                 */
-                if (charge(j) == 0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj_L(j,i);
-                }
-                /*
-                 * Zeta interaction term
-                 */
-                for (size_t k = 1; k < m_kk; k++) {
-                    if (charge(k) < 0.0) {
-                        size_t izeta = j;
-                        size_t jzeta = i;
-                        n = izeta * m_kk * m_kk + jzeta * m_kk + k;
-                        double zeta_L = psi_ijk_L[n];
-                        if (zeta_L != 0.0) {
-                            sum5 = sum5 + molality[j]*molality[k]*zeta_L;
-                        }
-                    }
-                }
-            }
-            /*
-             * Add all of the contributions up to yield the log of the
-             * solute activity coefficients (molality scale)
-             */
-            m_dlnActCoeffMolaldT_Unscaled[i] =
-                zsqdFdT + sum1 + sum2 + sum3 + sum4 + sum5;
-            d_gamma_dT_Unscaled[i] = exp(m_dlnActCoeffMolaldT_Unscaled[i]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s lngamma[i]=%10.6f gamma[i]=%10.6f \n",
-                       sni.c_str(), m_dlnActCoeffMolaldT_Unscaled[i], d_gamma_dT_Unscaled[i]);
-                printf("                   %12g %12g %12g %12g %12g %12g\n",
-                       zsqdFdT, sum1, sum2, sum3, sum4, sum5);
-            }
-        }
-
-        /*
-         * ------ SUBSECTION FOR CALCULATING THE dACTCOEFFdT FOR ANIONS ------
-         *
-         */
-        if (charge(i) < 0) {
-            //          species i is an anion (negative)
-            double zsqdFdT = charge(i)*charge(i)*dFdT;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                /*
-                 * Find the counterIJ for the symmetric binary interaction
-                 */
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                /*
-                 * For Anions, do the cation interactions.
-                 */
-                if (charge(j) > 0) {
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX_L[counterIJ] + molarcharge*CMX_L[counterIJ]);
-                    if (j < m_kk-1) {
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all cations
-                            if (charge(k) > 0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk_L[n];
-                            }
-                        }
-                    }
-                }
-
-                /*
-                 * For Anions, do the other anion interactions.
-                 */
-                if (charge(j) < 0.0) {
-                    //  sum over all anions
-                    if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi_L[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            // two inner sums over cations
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk_L[n];
-                            /*
-                             * Find the counterIJ for the symmetric binary interaction
-                             */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 +
-                                   (fabs(charge(i))*
-                                    molality[j]*molality[k]*CMX_L[counterIJ2]);
-                        }
-                    }
-                }
-
-                /*
-                 * for Anions, do the neutral species interaction
-                 */
-                if (charge(j) == 0.0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj_L(j,i);
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = k;
-                            size_t kzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + kzeta;
-                            double zeta_L = psi_ijk_L[n];
-                            if (zeta_L != 0.0) {
-                                sum5 = sum5 + molality[j]*molality[k]*zeta_L;
-                            }
-                        }
-                    }
-                }
-            }
-            m_dlnActCoeffMolaldT_Unscaled[i] =
-                zsqdFdT + sum1 + sum2 + sum3 + sum4 + sum5;
-            d_gamma_dT_Unscaled[i] = exp(m_dlnActCoeffMolaldT_Unscaled[i]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s lngamma[i]=%10.6f gamma[i]=%10.6f\n",
-                       sni.c_str(), m_dlnActCoeffMolaldT_Unscaled[i], d_gamma_dT_Unscaled[i]);
-                printf("                   %12g %12g %12g %12g %12g %12g\n",
-                       zsqdFdT, sum1, sum2, sum3, sum4, sum5);
-            }
-        }
-        /*
-         * ------ SUBSECTION FOR CALCULATING NEUTRAL SOLUTE ACT COEFF -------
-         * ------ -> equations agree with my notes,
-         *        -> Equations agree with Pitzer,
-         */
-        if (charge(i) == 0.0) {
-            double sum1 = 0.0;
-            double sum3 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                sum1 = sum1 + molality[j]*2.0*m_Lambda_nj_L(i,j);
-                /*
-                 * Zeta term -> we piggyback on the psi term
-                 */
-                if (charge(j) > 0.0) {
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t n = k + j * m_kk + i * m_kk * m_kk;
-                            sum3 = sum3 + molality[j]*molality[k]*psi_ijk_L[n];
-                        }
-                    }
-                }
-            }
-            double sum2 = 3.0 * molality[i] * molality[i] * m_Mu_nnn_L[i];
-            m_dlnActCoeffMolaldT_Unscaled[i] = sum1 + sum2 + sum3;
-            d_gamma_dT_Unscaled[i] = exp(m_dlnActCoeffMolaldT_Unscaled[i]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s lngamma[i]=%10.6f gamma[i]=%10.6f \n",
-                       sni.c_str(), m_dlnActCoeffMolaldT_Unscaled[i], d_gamma_dT_Unscaled[i]);
-            }
-        }
-
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 9: \n");
-    }
-    /*
-     * ------ SUBSECTION FOR CALCULATING THE d OSMOTIC COEFF dT ---------
-     *
-     */
-    double sum1 = 0.0;
-    double sum2 = 0.0;
-    double sum3 = 0.0;
-    double sum4 = 0.0;
-    double sum5 = 0.0;
-    double sum6 = 0.0;
-    double sum7 = 0.0;
-    /*
-     * term1 is the temperature derivative of the
-     * DH term in the osmotic coefficient expression
-     * b = 1.2 sqrt(kg/gmol) <- arbitrarily set in all Pitzer
-     *                          implementations.
-     * Is = Ionic strength on the molality scale (units of (gmol/kg))
-     * Aphi = A_Debye / 3   (units of sqrt(kg/gmol))
-     */
-    double term1 = -dAphidT * Is * sqrt(Is) / (1.0 + 1.2 * sqrt(Is));
-
-    for (size_t j = 1; j < m_kk; j++) {
-        /*
-         * Loop Over Cations
-         */
-        if (charge(j) > 0.0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum1 = sum1 + molality[j]*molality[k]*
-                           (BphiMX_L[counterIJ] + molarcharge*CMX_L[counterIJ]);
-                }
-            }
-
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == (m_kk-1)) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dT",
-                                       "logic error 1 in Step 9 of hmw_act");
-                }
-                if (charge(k) > 0.0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     * between 2 cations.
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum2 = sum2 + molality[j]*molality[k]*Phiphi_L[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) < 0.0) {
-                            // species m is an anion
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum2 = sum2 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk_L[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        /*
-         * Loop Over Anions
-         */
-        if (charge(j) < 0) {
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == m_kk-1) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dT",
-                                       "logic error 2 in Step 9 of hmw_act");
-                }
-                if (charge(k) < 0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     * between two anions
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum3 = sum3 + molality[j]*molality[k]*Phiphi_L[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum3 = sum3 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk_L[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        /*
-         * Loop Over Neutral Species
-         */
-        if (charge(j) == 0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    sum4 = sum4 + molality[j]*molality[k]*m_Lambda_nj_L(j,k);
-                }
-                if (charge(k) > 0.0) {
-                    sum5 = sum5 + molality[j]*molality[k]*m_Lambda_nj_L(j,k);
-                }
-                if (charge(k) == 0.0) {
-                    if (k > j) {
-                        sum6 = sum6 + molality[j]*molality[k]*m_Lambda_nj_L(j,k);
-                    } else if (k == j) {
-                        sum6 = sum6 + 0.5 * molality[j]*molality[k]*m_Lambda_nj_L(j,k);
-                    }
-                }
-                if (charge(k) < 0.0) {
-                    size_t izeta = j;
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            size_t jzeta = m;
-                            size_t n = k + jzeta * m_kk + izeta * m_kk * m_kk;
-                            double zeta_L = psi_ijk_L[n];
-                            if (zeta_L != 0.0) {
-                                sum7 += molality[izeta]*molality[jzeta]*molality[k]*zeta_L;
-                            }
-                        }
-                    }
-                }
-            }
-            sum7 += molality[j]*molality[j]*molality[j]*m_Mu_nnn_L[j];
-        }
-    }
-    double sum_m_phi_minus_1 = 2.0 *
-                        (term1 + sum1 + sum2 + sum3 + sum4 + sum5 + sum6 + sum7);
-    /*
-     * Calculate the osmotic coefficient from
-     *       osmotic_coeff = 1 + dGex/d(M0noRT) / sum(molality_i)
-     */
-    double d_osmotic_coef_dT;
-    if (molalitysum > 1.0E-150) {
-        d_osmotic_coef_dT = 0.0 + (sum_m_phi_minus_1 / molalitysum);
-    } else {
-        d_osmotic_coef_dT = 0.0;
-    }
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" term1=%10.6f sum1=%10.6f sum2=%10.6f "
-               "sum3=%10.6f sum4=%10.6f sum5=%10.6f\n",
-               term1, sum1, sum2, sum3, sum4, sum5);
-        printf("     sum_m_phi_minus_1=%10.6f        d_osmotic_coef_dT =%10.6f\n",
-               sum_m_phi_minus_1, d_osmotic_coef_dT);
-        printf(" Step 10: \n");
-    }
-    double d_lnwateract_dT = -(m_weightSolvent/1000.0) * molalitysum * d_osmotic_coef_dT;
-
-    /*
-     * In Cantera, we define the activity coefficient of the solvent as
-     *
-     *     act_0 = actcoeff_0 * Xmol_0
-     *
-     * We have just computed act_0. However, this routine returns
-     *  ln(actcoeff[]). Therefore, we must calculate ln(actcoeff_0).
-     */
-    m_dlnActCoeffMolaldT_Unscaled[0] = d_lnwateract_dT;
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        double d_wateract_dT = exp(d_lnwateract_dT);
-        printf(" d_ln_a_water_dT = %10.6f d_a_water_dT=%10.6f\n\n",
-               d_lnwateract_dT, d_wateract_dT);
-    }
-}
-
-void HMWSoln::s_update_d2lnMolalityActCoeff_dT2() const
-{
-    static const int cacheId = m_cache.getId();
-    CachedScalar cached = m_cache.getScalar(cacheId);
-    if( cached.validate(temperature(), pressure(), stateMFNumber()) ) {
-        return;
-    }
-
-    /*
-     *  Zero the unscaled 2nd derivatives
-     */
-    m_d2lnActCoeffMolaldT2_Unscaled.assign(m_kk, 0.0);
-    /*
-     * Calculate the unscaled 2nd derivatives
-     */
-    s_updatePitzer_d2lnMolalityActCoeff_dT2();
-
-    for (size_t k = 1; k < m_kk; k++) {
-        if (CROP_speciesCropped_[k] == 2) {
-            m_d2lnActCoeffMolaldT2_Unscaled[k] = 0.0;
-        }
-    }
-
-    if (CROP_speciesCropped_[0]) {
-        m_d2lnActCoeffMolaldT2_Unscaled[0] = 0.0;
-    }
-
-    /*
-     * Scale the 2nd derivatives
-     */
-    s_updateScaling_pHScaling_dT2();
-}
-
-void HMWSoln::s_updatePitzer_d2lnMolalityActCoeff_dT2() const
-{
-    /*
-     * HKM -> Assumption is made that the solvent is species 0.
-     */
-#ifdef DEBUG_MODE
-    m_debugCalc = 0;
-#endif
-    if (m_indexSolvent != 0) {
-        throw CanteraError("HMWSoln::s_updatePitzer_d2lnMolalityActCoeff_dT2",
-                           "Wrong index solvent value!");
-    }
-
-    const double* molality  =  DATA_PTR(m_molalitiesCropped);
-    const double* beta0MX_LL=  DATA_PTR(m_Beta0MX_ij_LL);
-    const double* beta1MX_LL=  DATA_PTR(m_Beta1MX_ij_LL);
-    const double* beta2MX_LL=  DATA_PTR(m_Beta2MX_ij_LL);
-    const double* CphiMX_LL =  DATA_PTR(m_CphiMX_ij_LL);
-    const double* thetaij_LL=  DATA_PTR(m_Theta_ij_LL);
-    const double* alpha1MX  =  DATA_PTR(m_Alpha1MX_ij);
-    const double* alpha2MX  =  DATA_PTR(m_Alpha2MX_ij);
-    const double* psi_ijk_LL=  DATA_PTR(m_Psi_ijk_LL);
-
-    /*
-     * Local variables defined by Coltrin
-     */
-    double etheta[5][5], etheta_prime[5][5], sqrtIs;
-    /*
-     * Molality based ionic strength of the solution
-     */
-    double Is = 0.0;
-    /*
-     * Molarcharge of the solution: In Pitzer's notation,
-     * this is his variable called "Z".
-     */
-    double molarcharge = 0.0;
-    /*
-     * molalitysum is the sum of the molalities over all solutes,
-     * even those with zero charge.
-     */
-    double molalitysum = 0.0;
-
-    double* gfunc    =  DATA_PTR(m_gfunc_IJ);
-    double* g2func   =  DATA_PTR(m_g2func_IJ);
-    double* hfunc    =  DATA_PTR(m_hfunc_IJ);
-    double* h2func   =  DATA_PTR(m_h2func_IJ);
-    double* BMX_LL   =  DATA_PTR(m_BMX_IJ_LL);
-    double* BprimeMX_LL=DATA_PTR(m_BprimeMX_IJ_LL);
-    double* BphiMX_LL=  DATA_PTR(m_BphiMX_IJ_LL);
-    double* Phi_LL   =  DATA_PTR(m_Phi_IJ_LL);
-    double* Phiprime =  DATA_PTR(m_Phiprime_IJ);
-    double* Phiphi_LL=  DATA_PTR(m_PhiPhi_IJ_LL);
-    double* CMX_LL   =  DATA_PTR(m_CMX_IJ_LL);
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf("\n Debugging information from "
-               "s_Pitzer_d2lnMolalityActCoeff_dT2()\n");
-    }
-    /*
-     * Make sure the counter variables are setup
-     */
-    counterIJ_setup();
-
-
-    /*
-     * ---------- Calculate common sums over solutes ---------------------
-     */
-    for (size_t n = 1; n < m_kk; n++) {
-        //      ionic strength
-        Is += charge(n) * charge(n) * molality[n];
-        //      total molar charge
-        molarcharge +=  fabs(charge(n)) * molality[n];
-        molalitysum += molality[n];
-    }
-    Is *= 0.5;
-
-    /*
-     * Store the ionic molality in the object for reference.
-     */
-    m_IionicMolality = Is;
-    sqrtIs = sqrt(Is);
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 1: \n");
-        printf(" ionic strenth      = %14.7le \n total molar "
-               "charge = %14.7le \n", Is, molarcharge);
-    }
-
-    /*
-     * The following call to calc_lambdas() calculates all 16 elements
-     * of the elambda and elambda1 arrays, given the value of the
-     * ionic strength (Is)
-     */
-    calc_lambdas(Is);
-
-    /*
-     * ----- Step 2:  Find the coefficients E-theta and -------------------
-     *                E-thetaprime for all combinations of positive
-     *                unlike charges up to 4
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 2: \n");
-    }
-    for (int z1 = 1; z1 <=4; z1++) {
-        for (int z2 =1; z2 <=4; z2++) {
-            calc_thetas(z1, z2, &etheta[z1][z2], &etheta_prime[z1][z2]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" z1=%3d z2=%3d E-theta(I) = %f, E-thetaprime(I) = %f\n",
-                       z1, z2, etheta[z1][z2], etheta_prime[z1][z2]);
-            }
-        }
-    }
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 3: \n");
-        printf(" Species          Species            g(x) "
-               " hfunc(x)   \n");
-    }
-
-    /*
-     *
-     *  calculate gfunc(x) and hfunc(x) for each cation-anion pair MX
-     *   In the original literature, hfunc, was called gprime. However,
-     *   it's not the derivative of gfunc(x), so I renamed it.
-     */
-    for (size_t i = 1; i < (m_kk - 1); i++) {
-        for (size_t j = (i+1); j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * Only loop over oppositely charge species
-             */
-            if (charge(i)*charge(j) < 0) {
-                /*
-                 * x is a reduced function variable
-                 */
-                double x1 = sqrtIs * alpha1MX[counterIJ];
-                if (x1 > 1.0E-100) {
-                    gfunc[counterIJ] =  2.0*(1.0-(1.0 + x1) * exp(-x1)) / (x1 *x1);
-                    hfunc[counterIJ] = -2.0*
-                                       (1.0-(1.0 + x1 + 0.5*x1 * x1) * exp(-x1)) / (x1 * x1);
-                } else {
-                    gfunc[counterIJ] = 0.0;
-                    hfunc[counterIJ] = 0.0;
-                }
-
-                if (beta2MX_LL[counterIJ] != 0.0) {
-                    double x2 = sqrtIs * alpha2MX[counterIJ];
-                    if (x2 > 1.0E-100) {
-                        g2func[counterIJ] =  2.0*(1.0-(1.0 + x2) * exp(-x2)) / (x2 * x2);
-                        h2func[counterIJ] = -2.0 *
-                                            (1.0-(1.0 + x2 + 0.5 * x2 * x2) * exp(-x2)) / (x2 * x2);
-                    } else {
-                        g2func[counterIJ] = 0.0;
-                        h2func[counterIJ] = 0.0;
-                    }
-                }
-            } else {
-                gfunc[counterIJ] = 0.0;
-                hfunc[counterIJ] = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %9.5f %9.5f \n", sni.c_str(), snj.c_str(),
-                       gfunc[counterIJ], hfunc[counterIJ]);
-            }
-        }
-    }
-    /*
-     * ------- SUBSECTION TO CALCULATE BMX_L, BprimeMX_LL, BphiMX_L ----------
-     * ------- These are now temperature derivatives of the
-     *         previously calculated quantities.
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 4: \n");
-        printf(" Species          Species            BMX    "
-               "BprimeMX    BphiMX   \n");
-    }
-
-    for (size_t i = 1; i < m_kk - 1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0.0) {
-                BMX_LL[counterIJ]  = beta0MX_LL[counterIJ]
-                                     + beta1MX_LL[counterIJ] * gfunc[counterIJ]
-                                     + beta2MX_LL[counterIJ] * g2func[counterIJ];
-                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                    printf("%d %g: %g %g %g %g\n",
-                           (int) counterIJ,  BMX_LL[counterIJ], beta0MX_LL[counterIJ],
-                           beta1MX_LL[counterIJ], beta2MX_LL[counterIJ], gfunc[counterIJ]);
-                }
-                if (Is > 1.0E-150) {
-                    BprimeMX_LL[counterIJ] = (beta1MX_LL[counterIJ] * hfunc[counterIJ]/Is +
-                                              beta2MX_LL[counterIJ] * h2func[counterIJ]/Is);
-                } else {
-                    BprimeMX_LL[counterIJ] = 0.0;
-                }
-                BphiMX_LL[counterIJ] = BMX_LL[counterIJ] + Is*BprimeMX_LL[counterIJ];
-            } else {
-                BMX_LL[counterIJ]      = 0.0;
-                BprimeMX_LL[counterIJ] = 0.0;
-                BphiMX_LL[counterIJ]     = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %11.7f %11.7f %11.7f \n",
-                       sni.c_str(), snj.c_str(),
-                       BMX_LL[counterIJ], BprimeMX_LL[counterIJ], BphiMX_LL[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * --------- SUBSECTION TO CALCULATE CMX_LL ----------
-     * ---------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 5: \n");
-        printf(" Species          Species            CMX \n");
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0.0) {
-                CMX_LL[counterIJ] = CphiMX_LL[counterIJ]/
-                                    (2.0* sqrt(fabs(charge(i)*charge(j))));
-            } else {
-                CMX_LL[counterIJ] = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %11.7f \n", sni.c_str(), snj.c_str(),
-                       CMX_LL[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * ------- SUBSECTION TO CALCULATE Phi, PhiPrime, and PhiPhi ----------
-     * --------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 6: \n");
-        printf(" Species          Species            Phi_ij "
-               " Phiprime_ij  Phi^phi_ij \n");
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) > 0) {
-                Phi_LL[counterIJ] = thetaij_LL[counterIJ];
-                Phiprime[counterIJ] = 0.0;
-                Phiphi_LL[counterIJ] = Phi_LL[counterIJ];
-            } else {
-                Phi_LL[counterIJ]      = 0.0;
-                Phiprime[counterIJ] = 0.0;
-                Phiphi_LL[counterIJ]   = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %10.6f %10.6f %10.6f \n",
-                       sni.c_str(), snj.c_str(),
-                       Phi_LL[counterIJ], Phiprime[counterIJ], Phiphi_LL[counterIJ]);
-            }
-        }
-    }
-
-    /*
-     * ----------- SUBSECTION FOR CALCULATION OF d2FdT2 ---------------------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 7: \n");
-    }
-    double d2AphidT2 = d2A_DebyedT2_TP() / 3.0;
-    double d2FdT2 = -d2AphidT2 * (sqrt(Is) / (1.0 + 1.2*sqrt(Is))
-                           + (2.0/1.2) * log(1.0+1.2*(sqrtIs)));
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" initial value of d2FdT2 = %10.6f \n", d2FdT2);
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0) {
-                d2FdT2 = d2FdT2 + molality[i]*molality[j] * BprimeMX_LL[counterIJ];
-            }
-            /*
-             * Both species have a non-zero charge, and they
-             * have the same sign, e.g., both positive or both negative.
-             */
-            if (charge(i)*charge(j) > 0) {
-                d2FdT2 = d2FdT2 + molality[i]*molality[j] * Phiprime[counterIJ];
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" d2FdT2 = %10.6f \n", d2FdT2);
-            }
-        }
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 8: \n");
-    }
-
-    for (size_t i = 1; i < m_kk; i++) {
-
-        /*
-         * -------- SUBSECTION FOR CALCULATING THE dACTCOEFFdT FOR CATIONS -----
-         * --
-         */
-        if (charge(i) > 0) {
-            // species i is the cation (positive) to calc the actcoeff
-            double zsqd2FdT2 = charge(i)*charge(i)*d2FdT2;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                /*
-                 * Find the counterIJ for the symmetric binary interaction
-                 */
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                if (charge(j) < 0.0) {
-                    // sum over all anions
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX_LL[counterIJ] + molarcharge*CMX_LL[counterIJ]);
-                    if (j < m_kk-1) {
-                        /*
-                         * This term is the ternary interaction involving the
-                         * non-duplicate sum over double anions, j, k, with
-                         * respect to the cation, i.
-                         */
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all anions
-                            if (charge(k) < 0.0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk_LL[n];
-                            }
-                        }
-                    }
-                }
-
-
-                if (charge(j) > 0.0) {
-                    // sum over all cations
-                    if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi_LL[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            // two inner sums over anions
-
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk_LL[n];
-                            /*
-                             * Find the counterIJ for the j,k interaction
-                             */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 + (fabs(charge(i))*
-                                           molality[j]*molality[k]*CMX_LL[counterIJ2]);
-                        }
-                    }
-                }
-
-                /*
-                 * Handle neutral j species
-                 */
-                if (charge(j) == 0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj_LL(j,i);
-                    /*
-                     * Zeta interaction term
-                     */
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + k;
-                            double zeta_LL = psi_ijk_LL[n];
-                            if (zeta_LL != 0.0) {
-                                sum5 = sum5 + molality[j]*molality[k]*zeta_LL;
-                            }
-                        }
-                    }
-                }
-            }
-            /*
-             * Add all of the contributions up to yield the log of the
-             * solute activity coefficients (molality scale)
-             */
-            m_d2lnActCoeffMolaldT2_Unscaled[i] =
-                zsqd2FdT2 + sum1 + sum2 + sum3 + sum4 + sum5;
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s d2lngammadT2[i]=%10.6f \n",
-                       sni.c_str(), m_d2lnActCoeffMolaldT2_Unscaled[i]);
-                printf("                   %12g %12g %12g %12g %12g %12g\n",
-                       zsqd2FdT2, sum1, sum2, sum3, sum4, sum5);
-            }
-        }
-
-
-        /*
-         * ------ SUBSECTION FOR CALCULATING THE d2ACTCOEFFdT2 FOR ANIONS ------
-         *
-         */
-        if (charge(i) < 0) {
-            //          species i is an anion (negative)
-            double zsqd2FdT2 = charge(i)*charge(i)*d2FdT2;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                /*
-                 * Find the counterIJ for the symmetric binary interaction
-                 */
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                /*
-                 * For Anions, do the cation interactions.
-                 */
-                if (charge(j) > 0) {
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX_LL[counterIJ] + molarcharge*CMX_LL[counterIJ]);
-                    if (j < m_kk-1) {
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all cations
-                            if (charge(k) > 0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk_LL[n];
-                            }
-                        }
-                    }
-                }
-
-                /*
-                 * For Anions, do the other anion interactions.
-                 */
-                if (charge(j) < 0.0) {
-                    //  sum over all anions
-                    if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi_LL[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            // two inner sums over cations
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk_LL[n];
-                            /*
-                             * Find the counterIJ for the symmetric binary interaction
-                             */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 +
-                                   (fabs(charge(i))*
-                                    molality[j]*molality[k]*CMX_LL[counterIJ2]);
-                        }
-                    }
-                }
-
-                /*
-                 * for Anions, do the neutral species interaction
-                 */
-                if (charge(j) == 0.0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj_LL(j,i);
-                    /*
-                     * Zeta interaction term
-                     */
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = k;
-                            size_t kzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + kzeta;
-                            double zeta_LL = psi_ijk_LL[n];
-                            if (zeta_LL != 0.0) {
-                                sum5 = sum5 + molality[j]*molality[k]*zeta_LL;
-                            }
-                        }
-                    }
-                }
-            }
-            m_d2lnActCoeffMolaldT2_Unscaled[i] =
-                zsqd2FdT2 + sum1 + sum2 + sum3 + sum4 + sum5;
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s d2lngammadT2[i]=%10.6f\n",
-                       sni.c_str(), m_d2lnActCoeffMolaldT2_Unscaled[i]);
-                printf("                   %12g %12g %12g %12g %12g %12g\n",
-                       zsqd2FdT2, sum1, sum2, sum3, sum4, sum5);
-            }
-        }
-        /*
-         * ------ SUBSECTION FOR CALCULATING NEUTRAL SOLUTE ACT COEFF -------
-         * ------ -> equations agree with my notes,
-         *        -> Equations agree with Pitzer,
-         */
-        if (charge(i) == 0.0) {
-            double sum1 = 0.0;
-            double sum3 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                sum1 = sum1 + molality[j]*2.0*m_Lambda_nj_LL(i,j);
-                /*
-                 * Zeta term -> we piggyback on the psi term
-                 */
-                if (charge(j) > 0.0) {
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t n = k + j * m_kk + i * m_kk * m_kk;
-                            sum3 = sum3 + molality[j]*molality[k]*psi_ijk_LL[n];
-                        }
-                    }
-                }
-            }
-            double sum2 = 3.0 * molality[i] * molality[i] * m_Mu_nnn_LL[i];
-            m_d2lnActCoeffMolaldT2_Unscaled[i] = sum1 + sum2 + sum3;
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s d2lngammadT2[i]=%10.6f \n",
-                       sni.c_str(), m_d2lnActCoeffMolaldT2_Unscaled[i]);
-            }
-        }
-
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 9: \n");
-    }
-
-    /*
-     * ------ SUBSECTION FOR CALCULATING THE d2 OSMOTIC COEFF dT2 ---------
-     */
-    double sum1 = 0.0;
-    double sum2 = 0.0;
-    double sum3 = 0.0;
-    double sum4 = 0.0;
-    double sum5 = 0.0;
-    double sum6 = 0.0;
-    double sum7 = 0.0;
-    /*
-     * term1 is the temperature derivative of the
-     * DH term in the osmotic coefficient expression
-     * b = 1.2 sqrt(kg/gmol) <- arbitrarily set in all Pitzer
-     *                          implementations.
-     * Is = Ionic strength on the molality scale (units of (gmol/kg))
-     * Aphi = A_Debye / 3   (units of sqrt(kg/gmol))
-     */
-    double term1 = -d2AphidT2 * Is * sqrt(Is) / (1.0 + 1.2 * sqrt(Is));
-
-    for (size_t j = 1; j < m_kk; j++) {
-        /*
-         * Loop Over Cations
-         */
-        if (charge(j) > 0.0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum1 = sum1 + molality[j]*molality[k]*
-                           (BphiMX_LL[counterIJ] + molarcharge*CMX_LL[counterIJ]);
-                }
-            }
-
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == (m_kk-1)) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_d2lnMolalityActCoeff_dT2",
-                                       "logic error 1 in Step 9 of hmw_act");
-                }
-                if (charge(k) > 0.0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     * between 2 cations.
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum2 = sum2 + molality[j]*molality[k]*Phiphi_LL[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) < 0.0) {
-                            // species m is an anion
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum2 = sum2 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk_LL[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        /*
-         * Loop Over Anions
-         */
-        if (charge(j) < 0) {
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == m_kk-1) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_d2lnMolalityActCoeff_dT2",
-                                       "logic error 2 in Step 9 of hmw_act");
-                }
-                if (charge(k) < 0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     * between two anions
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum3 = sum3 + molality[j]*molality[k]*Phiphi_LL[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum3 = sum3 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk_LL[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        /*
-         * Loop Over Neutral Species
-         */
-        if (charge(j) == 0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    sum4 = sum4 + molality[j]*molality[k]*m_Lambda_nj_LL(j,k);
-                }
-                if (charge(k) > 0.0) {
-                    sum5 = sum5 + molality[j]*molality[k]*m_Lambda_nj_LL(j,k);
-                }
-                if (charge(k) == 0.0) {
-                    if (k > j) {
-                        sum6 = sum6 + molality[j]*molality[k]*m_Lambda_nj_LL(j,k);
-                    } else if (k == j) {
-                        sum6 = sum6 + 0.5 * molality[j]*molality[k]*m_Lambda_nj_LL(j,k);
-                    }
-                }
-                if (charge(k) < 0.0) {
-                    size_t izeta = j;
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            size_t jzeta = m;
-                            size_t n = k + jzeta * m_kk + izeta * m_kk * m_kk;
-                            double zeta_LL = psi_ijk_LL[n];
-                            if (zeta_LL != 0.0) {
-                                sum7 += molality[izeta]*molality[jzeta]*molality[k]*zeta_LL;
-                            }
-                        }
-                    }
-                }
-            }
-
-            sum7 += molality[j] * molality[j] * molality[j] * m_Mu_nnn_LL[j];
-        }
-    }
-    double sum_m_phi_minus_1 = 2.0 *
-                        (term1 + sum1 + sum2 + sum3 + sum4 + sum5 + sum6 + sum7);
-    /*
-     * Calculate the osmotic coefficient from
-     *       osmotic_coeff = 1 + dGex/d(M0noRT) / sum(molality_i)
-     */
-    double d2_osmotic_coef_dT2;
-    if (molalitysum > 1.0E-150) {
-        d2_osmotic_coef_dT2 = 0.0 + (sum_m_phi_minus_1 / molalitysum);
-    } else {
-        d2_osmotic_coef_dT2 = 0.0;
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" term1=%10.6f sum1=%10.6f sum2=%10.6f "
-               "sum3=%10.6f sum4=%10.6f sum5=%10.6f\n",
-               term1, sum1, sum2, sum3, sum4, sum5);
-        printf("     sum_m_phi_minus_1=%10.6f        d2_osmotic_coef_dT2=%10.6f\n",
-               sum_m_phi_minus_1, d2_osmotic_coef_dT2);
-        printf(" Step 10: \n");
-    }
-    double d2_lnwateract_dT2 = -(m_weightSolvent/1000.0) * molalitysum * d2_osmotic_coef_dT2;
-
-    /*
-     * In Cantera, we define the activity coefficient of the solvent as
-     *
-     *     act_0 = actcoeff_0 * Xmol_0
-     *
-     * We have just computed act_0. However, this routine returns
-     *  ln(actcoeff[]). Therefore, we must calculate ln(actcoeff_0).
-     */
-    m_d2lnActCoeffMolaldT2_Unscaled[0] = d2_lnwateract_dT2;
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        double d2_wateract_dT2 = exp(d2_lnwateract_dT2);
-        printf(" d2_ln_a_water_dT2 = %10.6f d2_a_water_dT2=%10.6f\n\n",
-               d2_lnwateract_dT2, d2_wateract_dT2);
-    }
-}
-
-void HMWSoln::s_update_dlnMolalityActCoeff_dP() const
-{
-    static const int cacheId = m_cache.getId();
-    CachedScalar cached = m_cache.getScalar(cacheId);
-    if( cached.validate(temperature(), pressure(), stateMFNumber()) ) {
-        return;
-    }
-
-    m_dlnActCoeffMolaldP_Unscaled.assign(m_kk, 0.0);
-    s_updatePitzer_dlnMolalityActCoeff_dP();
-
-    for (size_t k = 1; k < m_kk; k++) {
-        if (CROP_speciesCropped_[k] == 2) {
-            m_dlnActCoeffMolaldP_Unscaled[k] = 0.0;
-        }
-    }
-
-    if (CROP_speciesCropped_[0]) {
-        m_dlnActCoeffMolaldP_Unscaled[0] = 0.0;
-    }
-
-    s_updateScaling_pHScaling_dP();
-}
-
-void HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dP() const
-{
-    /*
-     * HKM -> Assumption is made that the solvent is species 0.
-     */
-#ifdef DEBUG_MODE
-    m_debugCalc = 0;
-#endif
-    if (m_indexSolvent != 0) {
-        throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dP",
-                           "Wrong index solvent value!");
-    }
-
-    const double* molality  =  DATA_PTR(m_molalitiesCropped);
-    const double* beta0MX_P =  DATA_PTR(m_Beta0MX_ij_P);
-    const double* beta1MX_P =  DATA_PTR(m_Beta1MX_ij_P);
-    const double* beta2MX_P =  DATA_PTR(m_Beta2MX_ij_P);
-    const double* CphiMX_P  =  DATA_PTR(m_CphiMX_ij_P);
-    const double* thetaij_P =  DATA_PTR(m_Theta_ij_P);
-    const double* alpha1MX  =  DATA_PTR(m_Alpha1MX_ij);
-    const double* alpha2MX  =  DATA_PTR(m_Alpha2MX_ij);
-    const double* psi_ijk_P =  DATA_PTR(m_Psi_ijk_P);
-
-    /*
-     * Local variables defined by Coltrin
-     */
-    double etheta[5][5], etheta_prime[5][5], sqrtIs;
-    /*
-     * Molality based ionic strength of the solution
-     */
-    double Is = 0.0;
-    /*
-     * Molarcharge of the solution: In Pitzer's notation,
-     * this is his variable called "Z".
-     */
-    double molarcharge = 0.0;
-    /*
-     * molalitysum is the sum of the molalities over all solutes,
-     * even those with zero charge.
-     */
-    double molalitysum = 0.0;
-
-    double* gfunc    =  DATA_PTR(m_gfunc_IJ);
-    double* g2func   =  DATA_PTR(m_g2func_IJ);
-    double* hfunc    =  DATA_PTR(m_hfunc_IJ);
-    double* h2func   =  DATA_PTR(m_h2func_IJ);
-    double* BMX_P    =  DATA_PTR(m_BMX_IJ_P);
-    double* BprimeMX_P= DATA_PTR(m_BprimeMX_IJ_P);
-    double* BphiMX_P =  DATA_PTR(m_BphiMX_IJ_P);
-    double* Phi_P    =  DATA_PTR(m_Phi_IJ_P);
-    double* Phiprime =  DATA_PTR(m_Phiprime_IJ);
-    double* Phiphi_P =  DATA_PTR(m_PhiPhi_IJ_P);
-    double* CMX_P    =  DATA_PTR(m_CMX_IJ_P);
-
-    double currTemp = temperature();
-    double currPres = pressure();
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf("\n Debugging information from "
-               "s_Pitzer_dlnMolalityActCoeff_dP()\n");
-    }
-    /*
-     * Make sure the counter variables are setup
-     */
-    counterIJ_setup();
-
-    /*
-     * ---------- Calculate common sums over solutes ---------------------
-     */
-    for (size_t n = 1; n < m_kk; n++) {
-        //      ionic strength
-        Is += charge(n) * charge(n) * molality[n];
-        //      total molar charge
-        molarcharge +=  fabs(charge(n)) * molality[n];
-        molalitysum += molality[n];
-    }
-    Is *= 0.5;
-
-    /*
-     * Store the ionic molality in the object for reference.
-     */
-    m_IionicMolality = Is;
-    sqrtIs = sqrt(Is);
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 1: \n");
-        printf(" ionic strenth      = %14.7le \n total molar "
-               "charge = %14.7le \n", Is, molarcharge);
-    }
-
-    /*
-     * The following call to calc_lambdas() calculates all 16 elements
-     * of the elambda and elambda1 arrays, given the value of the
-     * ionic strength (Is)
-     */
-    calc_lambdas(Is);
-
-
-    /*
-     * ----- Step 2:  Find the coefficients E-theta and -------------------
-     *                E-thetaprime for all combinations of positive
-     *                unlike charges up to 4
-     */
+    s_updatePitzer_sums(molality, molarcharge, t, nTerms);
     if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 2: \n");
-    }
-    for (int z1 = 1; z1 <=4; z1++) {
-        for (int z2 =1; z2 <=4; z2++) {
-            calc_thetas(z1, z2, &etheta[z1][z2], &etheta_prime[z1][z2]);
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" z1=%3d z2=%3d E-theta(I) = %f, E-thetaprime(I) = %f\n",
-                       z1, z2, etheta[z1][z2], etheta_prime[z1][z2]);
+        for (size_t it = 0; it < nTerms; it++) {
+            printf(" F[%d] = %10.6f \n", (int) it, t[it].F);
+            for (size_t i = 1; i < m_kk; i++) {
+                std::string sni = speciesName(i);
+                printf("      Net %-16s                        lngamma[i] =  %9.5f \n",
+                       sni.c_str(), t[it].lnActCoeff[i]);
             }
         }
-    }
-
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 3: \n");
-        printf(" Species          Species            g(x) "
-               " hfunc(x)   \n");
+        printf(" Step 9: \n");
     }
 
     /*
+     * -------- SUBSECTION FOR CALCULATING THE OSMOTIC COEFF ---------
+     * -------- -> equations agree with my notes, Eqn. (117).
+     *          -> Equations agree with Pitzer, eqn.(62)
      *
-     *  calculate g(x) and hfunc(x) for each cation-anion pair MX
-     *   In the original literature, hfunc, was called gprime. However,
-     *   it's not the derivative of g(x), so I renamed it.
+     * term1 is the DH term in the osmotic coefficient expression
+     * b = 1.2 sqrt(kg/gmol) <- arbitrarily set in all Pitzer
+     *                          implementations.
+     * Is = Ionic strength on the molality scale (units of (gmol/kg))
+     * Aphi = A_Debye / 3   (units of sqrt(kg/gmol))
      */
-    for (size_t i = 1; i < (m_kk - 1); i++) {
-        for (size_t j = (i+1); j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
+    double DH_osm = Is * sqrtIs / (1.0 + 1.2 * sqrtIs);
+    for (size_t it = 0; it < nTerms; it++) {
+        double term1 = -Aphi[it] * DH_osm;
+        double sum_m_phi_minus_1 = 2.0 * (term1 + t[it].osmotic);
+        if (values && it == 0) {
             /*
-             * Only loop over oppositely charge species
+             * Calculate the osmotic coefficient from
+             *       osmotic_coeff = 1 + dGex/d(M0noRT) / sum(molality_i)
              */
-            if (charge(i)*charge(j) < 0) {
-                /*
-                 * x is a reduced function variable
-                 */
-                double x1 = sqrtIs * alpha1MX[counterIJ];
-                if (x1 > 1.0E-100) {
-                    gfunc[counterIJ] =  2.0*(1.0-(1.0 + x1) * exp(-x1)) / (x1 * x1);
-                    hfunc[counterIJ] = -2.0*
-                                       (1.0-(1.0 + x1 + 0.5 * x1 * x1) * exp(-x1)) / (x1 * x1);
-                } else {
-                    gfunc[counterIJ] = 0.0;
-                    hfunc[counterIJ] = 0.0;
-                }
-
-                if (beta2MX_P[counterIJ] != 0.0) {
-                    double x2 = sqrtIs * alpha2MX[counterIJ];
-                    if (x2 > 1.0E-100) {
-                        g2func[counterIJ] =  2.0*(1.0-(1.0 + x2) * exp(-x2)) / (x2 * x2);
-                        h2func[counterIJ] = -2.0 *
-                                            (1.0-(1.0 + x2 + 0.5 * x2 * x2) * exp(-x2)) / (x2 * x2);
-                    } else {
-                        g2func[counterIJ] = 0.0;
-                        h2func[counterIJ] = 0.0;
-                    }
-                }
+            double osmotic_coef;
+            if (molalitysumUncropped > 1.0E-150) {
+                osmotic_coef = 1.0 + (sum_m_phi_minus_1 / molalitysumUncropped);
             } else {
-                gfunc[counterIJ] = 0.0;
-                hfunc[counterIJ] = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %9.5f %9.5f \n", sni.c_str(), snj.c_str(),
-                       gfunc[counterIJ], hfunc[counterIJ]);
+                osmotic_coef = 1.0;
             }
-        }
-    }
-
-    /*
-     * ------- SUBSECTION TO CALCULATE BMX_P, BprimeMX_P, BphiMX_P ----------
-     * ------- These are now temperature derivatives of the
-     *         previously calculated quantities.
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 4: \n");
-        printf(" Species          Species            BMX    "
-               "BprimeMX    BphiMX   \n");
-    }
+            double lnwateract = -(m_weightSolvent/1000.0) * molalitysumUncropped * osmotic_coef;
 
-    for (size_t i = 1; i < m_kk - 1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
             /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
+             * In Cantera, we define the activity coefficient of the solvent as
+             *
+             *     act_0 = actcoeff_0 * Xmol_0
+             *
+             * We have just computed act_0. However, this routine returns
+             *  ln(actcoeff[]). Therefore, we must calculate ln(actcoeff_0).
              */
-            if (charge(i)*charge(j) < 0.0) {
-                BMX_P[counterIJ]  = beta0MX_P[counterIJ]
-                                    + beta1MX_P[counterIJ] * gfunc[counterIJ]
-                                    + beta2MX_P[counterIJ] * g2func[counterIJ];
-                if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                    printf("%d %g: %g %g %g %g\n",
-                           (int) counterIJ,  BMX_P[counterIJ], beta0MX_P[counterIJ],
-                           beta1MX_P[counterIJ], beta2MX_P[counterIJ], gfunc[counterIJ]);
-                }
-                if (Is > 1.0E-150) {
-                    BprimeMX_P[counterIJ] = (beta1MX_P[counterIJ] * hfunc[counterIJ]/Is +
-                                             beta2MX_P[counterIJ] * h2func[counterIJ]/Is);
-                } else {
-                    BprimeMX_P[counterIJ] = 0.0;
-                }
-                BphiMX_P[counterIJ] = BMX_P[counterIJ] + Is*BprimeMX_P[counterIJ];
-            } else {
-                BMX_P[counterIJ]      = 0.0;
-                BprimeMX_P[counterIJ] = 0.0;
-                BphiMX_P[counterIJ]     = 0.0;
-            }
+            double xmolSolvent = moleFraction(m_indexSolvent);
+            double xx = std::max(m_xmolSolventMIN, xmolSolvent);
+            m_lnActCoeffMolal_Unscaled[0] = lnwateract - log(xx);
             if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %11.7f %11.7f %11.7f \n",
-                       sni.c_str(), snj.c_str(),
-                       BMX_P[counterIJ], BprimeMX_P[counterIJ], BphiMX_P[counterIJ]);
+                printf(" term1=%10.6f sum_m_phi_minus_1=%10.6f        osmotic_coef=%10.6f\n",
+                       term1, sum_m_phi_minus_1, osmotic_coef);
+                printf(" ln_a_water=%10.6f a_water=%10.6f\n\n",
+                       lnwateract, exp(lnwateract));
             }
-        }
-    }
-
-    /*
-     * --------- SUBSECTION TO CALCULATE CMX_P ----------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 5: \n");
-        printf(" Species          Species            CMX \n");
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
+        } else {
             /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
+             * The derivatives of the osmotic coefficient and of the log of
+             * the activity of the solvent, which is also the derivative of
+             * ln(actcoeff_0)
              */
-            if (charge(i)*charge(j) < 0.0) {
-                CMX_P[counterIJ] = CphiMX_P[counterIJ]/
-                                   (2.0* sqrt(fabs(charge(i)*charge(j))));
+            double d_osmotic_coef;
+            if (molalitysum > 1.0E-150) {
+                d_osmotic_coef = sum_m_phi_minus_1 / molalitysum;
             } else {
-                CMX_P[counterIJ] = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %11.7f \n", sni.c_str(), snj.c_str(),
-                       CMX_P[counterIJ]);
+                d_osmotic_coef = 0.0;
             }
+            t[it].lnActCoeff[0] = -(m_weightSolvent/1000.0) * molalitysum * d_osmotic_coef;
         }
     }
+}
 
-    /*
-     * ------- SUBSECTION TO CALCULATE Phi, PhiPrime, and PhiPhi ----------
-     * --------
-     */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 6: \n");
-        printf(" Species          Species            Phi_ij "
-               " Phiprime_ij  Phi^phi_ij \n");
+void HMWSoln::s_updatePitzer_binaryDerivs(double Is, const double* beta0,
+        const double* beta1, const double* beta2, const double* Cphi,
+        const double* theta, double* BMX, double* BprimeMX, double* BphiMX,
+        double* CMX, double* Phi, double* Phiphi) const
+{
+    const double* gfunc  =  DATA_PTR(m_gfunc_IJ);
+    const double* g2func =  DATA_PTR(m_g2func_IJ);
+    const double* hfunc  =  DATA_PTR(m_hfunc_IJ);
+    const double* h2func =  DATA_PTR(m_h2func_IJ);
+    for (size_t ip = 0; ip < m_CationAnionPairs.size(); ip++) {
+        size_t n = m_CationAnionPairs[ip];
+        size_t i = n / m_kk;
+        size_t j = n % m_kk;
+        size_t counterIJ = m_CounterIJ[n];
+        BMX[counterIJ] = beta0[counterIJ] + beta1[counterIJ] * gfunc[counterIJ]
+                         + beta2[counterIJ] * g2func[counterIJ];
+        if (Is > 1.0E-150) {
+            BprimeMX[counterIJ] = (beta1[counterIJ] * hfunc[counterIJ]/Is +
+                                   beta2[counterIJ] * h2func[counterIJ]/Is);
+        } else {
+            BprimeMX[counterIJ] = 0.0;
+        }
+        BphiMX[counterIJ] = BMX[counterIJ] + Is*BprimeMX[counterIJ];
+        CMX[counterIJ] = Cphi[counterIJ] / (2.0* sqrt(fabs(charge(i)*charge(j))));
     }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) > 0) {
-                Phi_P[counterIJ] = thetaij_P[counterIJ];
-                Phiprime[counterIJ] = 0.0;
-                Phiphi_P[counterIJ] = Phi_P[counterIJ] + Is * Phiprime[counterIJ];
-            } else {
-                Phi_P[counterIJ]      = 0.0;
-                Phiprime[counterIJ] = 0.0;
-                Phiphi_P[counterIJ]   = 0.0;
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                std::string snj = speciesName(j);
-                printf(" %-16s %-16s %10.6f %10.6f %10.6f \n",
-                       sni.c_str(), snj.c_str(),
-                       Phi_P[counterIJ], Phiprime[counterIJ], Phiphi_P[counterIJ]);
-            }
+    for (size_t ip = 0; ip < m_LikeChargePairs.size(); ip++) {
+        size_t counterIJ = m_CounterIJ[m_LikeChargePairs[ip]];
+        Phi[counterIJ] = theta[counterIJ];
+        Phiphi[counterIJ] = Phi[counterIJ];
+    }
+}
+
+void HMWSoln::s_updatePitzer_sums(const double* molality, double molarcharge,
+                                  PitzerTerms* t, size_t nTerms) const
+{
+    for (size_t it = 0; it < nTerms; it++) {
+        for (size_t i = 1; i < m_kk; i++) {
+            t[it].lnActCoeff[i] = 0.0;
         }
+        t[it].osmotic = 0.0;
+        t[it].sumCMX = 0.0;
     }
 
     /*
-     * ----------- SUBSECTION FOR CALCULATION OF dFdT ---------------------
+     * Cation-anion pairs: the binary B and C terms of both ions, the
+     * BprimeMX part of F, and the ternary sum over all cation-anion pairs
+     * of the C terms, which enters the activity coefficient of every ion
+     * with the same weight.
      */
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 7: \n");
-    }
-    double dA_DebyedP = dA_DebyedP_TP(currTemp, currPres);
-    double dAphidP = dA_DebyedP /3.0;
-    double dFdP = -dAphidP * (sqrt(Is) / (1.0 + 1.2*sqrt(Is))
-                       + (2.0/1.2) * log(1.0+1.2*(sqrtIs)));
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" initial value of dFdP = %10.6f \n", dFdP);
-    }
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            /*
-             * Find the counterIJ for the symmetric binary interaction
-             */
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-            /*
-             * both species have a non-zero charge, and one is positive
-             * and the other is negative
-             */
-            if (charge(i)*charge(j) < 0) {
-                dFdP = dFdP + molality[i]*molality[j] * BprimeMX_P[counterIJ];
-            }
-            /*
-             * Both species have a non-zero charge, and they
-             * have the same sign, e.g., both positive or both negative.
-             */
-            if (charge(i)*charge(j) > 0) {
-                dFdP = dFdP + molality[i]*molality[j] * Phiprime[counterIJ];
-            }
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                printf(" dFdP = %10.6f \n", dFdP);
-            }
+    for (size_t ip = 0; ip < m_CationAnionPairs.size(); ip++) {
+        size_t n = m_CationAnionPairs[ip];
+        size_t i = n / m_kk;
+        size_t j = n % m_kk;
+        size_t c = m_CounterIJ[n];
+        double mm = molality[i] * molality[j];
+        for (size_t it = 0; it < nTerms; it++) {
+            PitzerTerms& ti = t[it];
+            double b = 2.0*ti.BMX[c] + molarcharge*ti.CMX[c];
+            ti.lnActCoeff[i] += molality[j] * b;
+            ti.lnActCoeff[j] += molality[i] * b;
+            ti.F += mm * ti.BprimeMX[c];
+            ti.sumCMX += mm * ti.CMX[c];
+            ti.osmotic += mm * (ti.BphiMX[c] + molarcharge*ti.CMX[c]);
         }
     }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 8: \n");
-    }
-
-    for (size_t i = 1; i < m_kk; i++) {
-
-        /*
-         * -------- SUBSECTION FOR CALCULATING THE dACTCOEFFdP FOR CATIONS -----
-         */
-        if (charge(i) > 0) {
-            // species i is the cation (positive) to calc the actcoeff
-            double zsqdFdP = charge(i)*charge(i)*dFdP;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                /*
-                 * Find the counterIJ for the symmetric binary interaction
-                 */
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                if (charge(j) < 0.0) {
-                    // sum over all anions
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX_P[counterIJ] + molarcharge*CMX_P[counterIJ]);
-                    if (j < m_kk-1) {
-                        /*
-                         * This term is the ternary interaction involving the
-                         * non-duplicate sum over double anions, j, k, with
-                         * respect to the cation, i.
-                         */
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all anions
-                            if (charge(k) < 0.0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk_P[n];
-                            }
-                        }
-                    }
-                }
-
-
-                if (charge(j) > 0.0) {
-                    // sum over all cations
-                    if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi_P[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            // two inner sums over anions
-
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk_P[n];
-                            /*
-                             * Find the counterIJ for the j,k interaction
-                             */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 + (fabs(charge(i))*
-                                           molality[j]*molality[k]*CMX_P[counterIJ2]);
-                        }
-                    }
-                }
-
-                /*
-                 * for Anions, do the neutral species interaction
-                 */
-                if (charge(j) == 0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj_P(j,i);
-                    /*
-                     * Zeta interaction term
-                     */
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + k;
-                            double zeta_P = psi_ijk_P[n];
-                            if (zeta_P != 0.0) {
-                                sum5 = sum5 + molality[j]*molality[k]*zeta_P;
-                            }
-                        }
-                    }
-                }
-            }
-
-            /*
-             * Add all of the contributions up to yield the log of the
-             * solute activity coefficients (molality scale)
-             */
-            m_dlnActCoeffMolaldP_Unscaled[i] =
-                zsqdFdP + sum1 + sum2 + sum3 + sum4 + sum5;
-
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s lngamma[i]=%10.6f \n",
-                       sni.c_str(), m_dlnActCoeffMolaldP_Unscaled[i]);
-                printf("                   %12g %12g %12g %12g %12g %12g\n",
-                       zsqdFdP, sum1, sum2, sum3, sum4, sum5);
-            }
-        }
-
-
-        /*
-         * ------ SUBSECTION FOR CALCULATING THE dACTCOEFFdP FOR ANIONS ------
-         */
-        if (charge(i) < 0) {
-            //          species i is an anion (negative)
-            double zsqdFdP = charge(i)*charge(i)*dFdP;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                /*
-                 * Find the counterIJ for the symmetric binary interaction
-                 */
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                /*
-                 * For Anions, do the cation interactions.
-                 */
-                if (charge(j) > 0) {
-                    sum1 = sum1 + molality[j]*
-                           (2.0*BMX_P[counterIJ] + molarcharge*CMX_P[counterIJ]);
-                    if (j < m_kk-1) {
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all cations
-                            if (charge(k) > 0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 = sum3 + molality[j]*molality[k]*psi_ijk_P[n];
-                            }
-                        }
-                    }
-                }
-
-                /*
-                 * For Anions, do the other anion interactions.
-                 */
-                if (charge(j) < 0.0) {
-                    //  sum over all anions
-                    if (j != i) {
-                        sum2 = sum2 + molality[j]*(2.0*Phi_P[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            // two inner sums over cations
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 = sum2 + molality[j]*molality[k]*psi_ijk_P[n];
-                            /*
-                             * Find the counterIJ for the symmetric binary interaction
-                             */
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 = sum4 +
-                                   (fabs(charge(i))*
-                                    molality[j]*molality[k]*CMX_P[counterIJ2]);
-                        }
-                    }
-                }
-
-                /*
-                 * for Anions, do the neutral species interaction
-                 */
-                if (charge(j) == 0.0) {
-                    sum5 = sum5 + molality[j]*2.0*m_Lambda_nj_P(j,i);
-                    /*
-                     * Zeta interaction term
-                     */
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = k;
-                            size_t kzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + kzeta;
-                            double zeta_P = psi_ijk_P[n];
-                            if (zeta_P != 0.0) {
-                                sum5 = sum5 + molality[j]*molality[k]*zeta_P;
-                            }
-                        }
-                    }
-                }
-            }
-            m_dlnActCoeffMolaldP_Unscaled[i] =
-                zsqdFdP + sum1 + sum2 + sum3 + sum4 + sum5;
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s lndactcoeffmolaldP[i]=%10.6f \n",
-                       sni.c_str(), m_dlnActCoeffMolaldP_Unscaled[i]);
-                printf("                   %12g %12g %12g %12g %12g %12g\n",
-                       zsqdFdP, sum1, sum2, sum3, sum4, sum5);
-            }
-        }
 
-        /*
-         * ------ SUBSECTION FOR CALCULATING d NEUTRAL SOLUTE ACT COEFF dP -------
-         */
-        if (charge(i) == 0.0) {
-            double sum1 = 0.0;
-            double sum3 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                sum1 +=  molality[j]*2.0*m_Lambda_nj_P(i,j);
-                /*
-                 * Zeta term -> we piggyback on the psi term
-                 */
-                if (charge(j) > 0.0) {
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t n = k + j * m_kk + i * m_kk * m_kk;
-                            sum3 = sum3 + molality[j]*molality[k]*psi_ijk_P[n];
-                        }
-                    }
-                }
-            }
-            double sum2 = 3.0 * molality[i] * molality[i] * m_Mu_nnn_P[i];
-            m_dlnActCoeffMolaldP_Unscaled[i] = sum1 + sum2 + sum3;
-            if (DEBUG_MODE_ENABLED && m_debugCalc) {
-                std::string sni = speciesName(i);
-                printf(" %-16s dlnActCoeffMolaldP[i]=%10.6f \n",
-                       sni.c_str(), m_dlnActCoeffMolaldP_Unscaled[i]);
+    /*
+     * Pairs of cations and pairs of anions: the Phi terms
+     */
+    for (size_t ip = 0; ip < m_LikeChargePairs.size(); ip++) {
+        size_t n = m_LikeChargePairs[ip];
+        size_t i = n / m_kk;
+        size_t j = n % m_kk;
+        size_t c = m_CounterIJ[n];
+        double mm = molality[i] * molality[j];
+        for (size_t it = 0; it < nTerms; it++) {
+            PitzerTerms& ti = t[it];
+            ti.lnActCoeff[i] += 2.0 * molality[j] * ti.Phi[c];
+            ti.lnActCoeff[j] += 2.0 * molality[i] * ti.Phi[c];
+            if (ti.Phiprime) {
+                ti.F += mm * ti.Phiprime[c];
             }
+            ti.osmotic += mm * ti.Phiphi[c];
         }
-
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" Step 9: \n");
     }
 
     /*
-     * ------ SUBSECTION FOR CALCULATING THE d OSMOTIC COEFF dP ---------
-     */
-    double sum1 = 0.0;
-    double sum2 = 0.0;
-    double sum3 = 0.0;
-    double sum4 = 0.0;
-    double sum5 = 0.0;
-    double sum6 = 0.0;
-    double sum7 = 0.0;
-    /*
-     * term1 is the temperature derivative of the
-     * DH term in the osmotic coefficient expression
-     * b = 1.2 sqrt(kg/gmol) <- arbitrarily set in all Pitzer
-     *                          implementations.
-     * Is = Ionic strength on the molality scale (units of (gmol/kg))
-     * Aphi = A_Debye / 3   (units of sqrt(kg/gmol))
+     * The unary term and the ternary C term of the ions
      */
-    double term1 = -dAphidP * Is * sqrt(Is) / (1.0 + 1.2 * sqrt(Is));
-
-    for (size_t j = 1; j < m_kk; j++) {
-        /*
-         * Loop Over Cations
-         */
-        if (charge(j) > 0.0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum1 = sum1 + molality[j]*molality[k]*
-                           (BphiMX_P[counterIJ] + molarcharge*CMX_P[counterIJ]);
-                }
-            }
-
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == (m_kk-1)) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dP",
-                                       "logic error 1 in Step 9 of hmw_act");
-                }
-                if (charge(k) > 0.0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     * between 2 cations.
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum2 = sum2 + molality[j]*molality[k]*Phiphi_P[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) < 0.0) {
-                            // species m is an anion
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum2 = sum2 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk_P[n];
-                        }
-                    }
-                }
-            }
-        }
-
-
-        /*
-         * Loop Over Anions
-         */
-        if (charge(j) < 0) {
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == m_kk-1) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dP",
-                                       "logic error 2 in Step 9 of hmw_act");
-                }
-                if (charge(k) < 0) {
-                    /*
-                     * Find the counterIJ for the symmetric j,k binary interaction
-                     * between two anions
-                     */
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum3 = sum3 + molality[j]*molality[k]*Phiphi_P[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum3 = sum3 +
-                                   molality[j]*molality[k]*molality[m]*psi_ijk_P[n];
-                        }
-                    }
-                }
+    for (size_t i = 1; i < m_kk; i++) {
+        if (charge(i) != 0.0) {
+            for (size_t it = 0; it < nTerms; it++) {
+                t[it].lnActCoeff[i] += charge(i)*charge(i)*t[it].F
+                                       + fabs(charge(i))*t[it].sumCMX;
+            }
+        }
+    }
+
+    /*
+     * Ternary interactions psi_ijk between two ions of the same sign, i
+     * and j, and an ion of the other sign, k, and zeta_nca between a
+     * neutral species n, a cation c and an anion a, which is stored as
+     * psi_nca. Each entry contributes to the activity coefficient of
+     * species i, and the entries with j > i, and the zeta entries, to
+     * the osmotic coefficient. The zeta entries also contribute to the
+     * activity coefficients of the cation and the anion.
+     */
+    for (size_t ir = 0; ir < m_PsiRows_ij.size(); ir++) {
+        size_t ij = m_PsiRows_ij[ir];
+        size_t i = ij / m_kk;
+        size_t j = ij % m_kk;
+        for (size_t ip = m_PsiStart_ij[ij]; ip < m_PsiStart_ij[ij+1]; ip++) {
+            size_t k = m_PsiIndex_k[ip];
+            bool self = false, osmotic = false, zeta = false;
+            if (charge(i) > 0.0) {
+                if (charge(j) < 0.0 && charge(k) < 0.0 && k > j) {
+                    // cation i with a pair of anions
+                    self = true;
+                } else if (charge(j) > 0.0 && charge(k) < 0.0) {
+                    // cation i with another cation and an anion
+                    self = true;
+                    osmotic = (j > i);
+                }
+            } else if (charge(i) < 0.0) {
+                if (charge(j) > 0.0 && charge(k) > 0.0 && k > j) {
+                    // anion i with a pair of cations
+                    self = true;
+                } else if (charge(j) < 0.0 && charge(k) > 0.0) {
+                    // anion i with another anion and a cation
+                    self = true;
+                    osmotic = (j > i);
+                }
+            } else if (charge(j) > 0.0 && charge(k) < 0.0) {
+                // zeta: neutral i, cation j, anion k
+                self = osmotic = zeta = true;
+            }
+            if (!self) {
+                continue;
             }
-        }
-
-        /*
-         * Loop Over Neutral Species
-         */
-        if (charge(j) == 0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    sum4 = sum4 + molality[j]*molality[k]*m_Lambda_nj_P(j,k);
-                }
-                if (charge(k) > 0.0) {
-                    sum5 = sum5 + molality[j]*molality[k]*m_Lambda_nj_P(j,k);
-                }
-                if (charge(k) == 0.0) {
-                    if (k > j) {
-                        sum6 = sum6 + molality[j]*molality[k]*m_Lambda_nj_P(j,k);
-                    } else if (k == j) {
-                        sum6 = sum6 + 0.5 * molality[j]*molality[k]*m_Lambda_nj_P(j,k);
-                    }
+            double mjk = molality[j] * molality[k];
+            for (size_t it = 0; it < nTerms; it++) {
+                double psi = t[it].psi[ij * m_kk + k];
+                double* lnac = t[it].lnActCoeff;
+                lnac[i] += mjk * psi;
+                if (osmotic) {
+                    t[it].osmotic += molality[i] * mjk * psi;
                 }
-                if (charge(k) < 0.0) {
-                    size_t izeta = j;
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            size_t jzeta = m;
-                            size_t n = k + jzeta * m_kk + izeta * m_kk * m_kk;
-                            double zeta_P = psi_ijk_P[n];
-                            if (zeta_P != 0.0) {
-                                sum7 += molality[izeta]*molality[jzeta]*molality[k]*zeta_P;
-                            }
-                        }
-                    }
+                if (zeta) {
+                    lnac[j] += molality[i] * molality[k] * psi;
+                    lnac[k] += molality[i] * molality[j] * psi;
                 }
             }
-
-            sum7 += molality[j] * molality[j] * molality[j] * m_Mu_nnn_P[j];
         }
     }
-    double sum_m_phi_minus_1 = 2.0 *
-                        (term1 + sum1 + sum2 + sum3 + sum4 + sum5 + sum6 + sum7);
-
-    /*
-     * Calculate the osmotic coefficient from
-     *       osmotic_coeff = 1 + dGex/d(M0noRT) / sum(molality_i)
-     */
-    double d_osmotic_coef_dP;
-    if (molalitysum > 1.0E-150) {
-        d_osmotic_coef_dP = 0.0 + (sum_m_phi_minus_1 / molalitysum);
-    } else {
-        d_osmotic_coef_dP = 0.0;
-    }
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        printf(" term1=%10.6f sum1=%10.6f sum2=%10.6f "
-               "sum3=%10.6f sum4=%10.6f sum5=%10.6f\n",
-               term1, sum1, sum2, sum3, sum4, sum5);
-        printf("     sum_m_phi_minus_1=%10.6f        d_osmotic_coef_dP =%10.6f\n",
-               sum_m_phi_minus_1, d_osmotic_coef_dP);
-        printf(" Step 10: \n");
-    }
-    double d_lnwateract_dP = -(m_weightSolvent/1000.0) * molalitysum * d_osmotic_coef_dP;
-
 
     /*
-     * In Cantera, we define the activity coefficient of the solvent as
-     *
-     *     act_0 = actcoeff_0 * Xmol_0
-     *
-     * We have just computed act_0. However, this routine returns
-     *  ln(actcoeff[]). Therefore, we must calculate ln(actcoeff_0).
+     * Interactions lambda_nj of the neutral species n with the other
+     * solutes, and the self-interaction mu_nnn
      */
-    m_dlnActCoeffMolaldP_Unscaled[0] = d_lnwateract_dP;
-    if (DEBUG_MODE_ENABLED && m_debugCalc) {
-        double d_wateract_dP = exp(d_lnwateract_dP);
-        printf(" d_ln_a_water_dP = %10.6f d_a_water_dP=%10.6f\n\n",
-               d_lnwateract_dP, d_wateract_dP);
+    for (size_t n = 1; n < m_kk; n++) {
+        if (charge(n) != 0.0) {
+            continue;
+        }
+        for (size_t ip = m_LambdaStart_n[n]; ip < m_LambdaStart_n[n+1]; ip++) {
+            size_t j = m_LambdaIndex_j[ip];
+            double mm = molality[n] * molality[j];
+            for (size_t it = 0; it < nTerms; it++) {
+                double lam = (*t[it].lambda)(n,j);
+                double* lnac = t[it].lnActCoeff;
+                lnac[n] += 2.0 * molality[j] * lam;
+                if (charge(j) != 0.0) {
+                    lnac[j] += 2.0 * molality[n] * lam;
+                    t[it].osmotic += mm * lam;
+                } else if (j > n) {
+                    t[it].osmotic += mm * lam;
+                } else if (j == n) {
+                    t[it].osmotic += 0.5 * mm * lam;
+                }
+            }
+        }
+        double m2 = molality[n] * molality[n];
+        for (size_t it = 0; it < nTerms; it++) {
+            t[it].lnActCoeff[n] += 3.0 * m2 * t[it].mu[n];
+            t[it].osmotic += m2 * molality[n] * t[it].mu[n];
+        }
     }
 }
 
@@ -1505,6 +1505,14 @@ void HMWSoln::initThermoXML(XML_Node& phaseNode, const std::string& id_)
 
     }
 
+    /*
+     * Collect the binary, lambda and ternary interactions that were
+     * actually specified, so that the activity coefficient sums skip
+     * the zero entries.
+     */
+    psiSparse_setup();
+    pairLists_setup();
+
     /*
      * Fill in the vector specifying the electrolyte species
      * type
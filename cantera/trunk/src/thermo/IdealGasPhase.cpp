@@ -7,6 +7,7 @@
 
 #include "cantera/thermo/IdealGasPhase.h"
 #include "cantera/base/vec_functions.h"
+#include "cantera/base/stringUtils.h"
 
 using namespace std;
 
@@ -367,6 +368,92 @@ void IdealGasPhase::setToEquilState(const doublereal* mu_RT)
     setState_PX(pres, &m_pp[0]);
 }
 
+void IdealGasPhase::getTemperatures_HY(size_t nStates, const doublereal* h,
+                                       const doublereal* Y, doublereal* T,
+                                       doublereal tol) const
+{
+    solveTemperatures(nStates, h, Y, T, tol, false);
+}
+
+void IdealGasPhase::getTemperatures_UY(size_t nStates, const doublereal* u,
+                                       const doublereal* Y, doublereal* T,
+                                       doublereal tol) const
+{
+    solveTemperatures(nStates, u, Y, T, tol, true);
+}
+
+void IdealGasPhase::solveTemperatures(size_t nStates, const doublereal* e,
+                                      const doublereal* Y, doublereal* T,
+                                      doublereal tol, bool doUV) const
+{
+    // Y_k/M_k for each state, and 1/M for the mixture
+    vector_fp ym(nStates * m_kk);
+    vector_fp rmmw(nStates, 0.0);
+    for (size_t i = 0; i < nStates; i++) {
+        for (size_t k = 0; k < m_kk; k++) {
+            ym[i*m_kk + k] = Y[i*m_kk + k] / molecularWeight(k);
+            rmmw[i] += ym[i*m_kk + k];
+        }
+        if (T[i] <= 0.0) {
+            T[i] = temperature();
+        }
+    }
+
+    // Indices of the states which have not yet converged
+    std::vector<size_t> active(nStates);
+    for (size_t i = 0; i < nStates; i++) {
+        active[i] = i;
+    }
+
+    // The work arrays are local so that the cached reference state
+    // properties at the current temperature of the phase are untouched. The
+    // properties of all the unconverged states are evaluated together, with
+    // the value for species k and active state j in element k*nT + j.
+    vector_fp Tactive(nStates);
+    vector_fp cp_R(m_kk * nStates), h_RT(m_kk * nStates), s_R(m_kk * nStates);
+    for (int n = 0; n < 500 && !active.empty(); n++) {
+        size_t nT = active.size();
+        for (size_t j = 0; j < nT; j++) {
+            Tactive[j] = T[active[j]];
+        }
+        m_spthermo->update(nT, &Tactive[0], &cp_R[0], &h_RT[0], &s_R[0]);
+        size_t nActive = 0;
+        for (size_t j = 0; j < nT; j++) {
+            size_t i = active[j];
+            const doublereal* yi = &ym[i*m_kk];
+            doublereal Told = T[i];
+            doublereal hsum = 0.0, cpsum = 0.0;
+            for (size_t k = 0; k < m_kk; k++) {
+                hsum += yi[k] * h_RT[k*nT + j];
+                cpsum += yi[k] * cp_R[k*nT + j];
+            }
+            doublereal enew = GasConstant * Told * hsum;
+            doublereal cnew = GasConstant * cpsum;
+            if (doUV) {
+                enew -= GasConstant * Told * rmmw[i];
+                cnew -= GasConstant * rmmw[i];
+            }
+
+            // Newton step, limited to 100 K and to keep T positive
+            doublereal dt = clip((e[i] - enew)/cnew, -100.0, 100.0);
+            T[i] = std::max(Told + dt, Told / 3.0);
+            if (fabs(dt) >= tol) {
+                active[nActive++] = i;
+            }
+        }
+        active.resize(nActive);
+    }
+
+    if (!active.empty()) {
+        size_t i = active[0];
+        throw CanteraError("IdealGasPhase::solveTemperatures",
+            "No convergence in 500 iterations for " + int2str(active.size()) +
+            " states. First unconverged state: " + int2str(i) +
+            (doUV ? ", target internal energy = " : ", target enthalpy = ") +
+            fp2str(e[i]) + ", current temperature = " + fp2str(T[i]));
+    }
+}
+
 void IdealGasPhase::_updateThermo() const
 {
     static const int cacheId = m_cache.getId();
@@ -375,9 +462,8 @@ void IdealGasPhase::_updateThermo() const
 
     // If the temperature has changed since the last time these
     // properties were computed, recompute them.
-    if (cached.state1 != tnow) {
+    if (!cached.validate(stateTNumber())) {
         m_spthermo->update(tnow, &m_cp0_R[0], &m_h0_RT[0], &m_s0_R[0]);
-        cached.state1 = tnow;
 
         // update the species Gibbs functions
         for (size_t k = 0; k < m_kk; k++) {
@@ -330,6 +330,7 @@ void LatticeSolidPhase::installSlavePhases(Cantera::XML_Node* phaseNode)
     size_t kk = 0;
     size_t kstart = 0;
     m_speciesData.clear();
+    m_speciesDataStorage.clear();
 
     XML_Node& la = phaseNode->child("thermo").child("LatticeArray");
     std::vector<XML_Node*> lattices = la.getChildren("phase");
@@ -365,7 +366,7 @@ void LatticeSolidPhase::installSlavePhases(Cantera::XML_Node* phaseNode)
             stit->setIndex(kk);
             stit->validate(spNode[k]->attrib("name"));
             m_spthermo->install_STIT(stit);
-            m_speciesData.push_back(new XML_Node(*(spNode[k])));
+            saveSpeciesData(kk, spNode[k]);
             kk++;
         }
         /*
@@ -20,14 +20,12 @@ using namespace std;
 namespace Cantera
 {
 Nasa9PolyMultiTempRegion::Nasa9PolyMultiTempRegion() :
-    m_numTempRegions(0),
-    m_currRegion(0)
+    m_numTempRegions(0)
 {
 }
 
 Nasa9PolyMultiTempRegion::Nasa9PolyMultiTempRegion(vector<Nasa9Poly1*>& regionPts) :
-    m_numTempRegions(0),
-    m_currRegion(0)
+    m_numTempRegions(0)
 {
     m_numTempRegions = regionPts.size();
     // Do a shallow copy of the pointers. From now on, we will
@@ -64,8 +62,7 @@ Nasa9PolyMultiTempRegion::Nasa9PolyMultiTempRegion(vector<Nasa9Poly1*>& regionPt
 Nasa9PolyMultiTempRegion::Nasa9PolyMultiTempRegion(const Nasa9PolyMultiTempRegion& b) :
     SpeciesThermoInterpType(b),
     m_numTempRegions(b.m_numTempRegions),
-    m_lowerTempBounds(b.m_lowerTempBounds),
-    m_currRegion(b.m_currRegion)
+    m_lowerTempBounds(b.m_lowerTempBounds)
 {
     m_regionPts.resize(m_numTempRegions);
     for (size_t i = 0; i < m_numTempRegions; i++) {
@@ -85,7 +82,6 @@ Nasa9PolyMultiTempRegion::operator=(const Nasa9PolyMultiTempRegion& b)
         }
         m_numTempRegions = b.m_numTempRegions;
         m_lowerTempBounds = b.m_lowerTempBounds;
-        m_currRegion = b.m_currRegion;
         m_regionPts.resize(m_numTempRegions);
         for (size_t i = 0; i < m_numTempRegions; i++) {
             m_regionPts[i] = new Nasa9Poly1(*(b.m_regionPts[i]));
@@ -131,36 +127,33 @@ void Nasa9PolyMultiTempRegion::updateTemperaturePoly(double T, double* T_poly) c
     T_poly[6]  = std::log(T);
 }
 
-void Nasa9PolyMultiTempRegion::updateProperties(const doublereal* tt,
-        doublereal* cp_R,
-        doublereal* h_RT,
-        doublereal* s_R) const
+size_t Nasa9PolyMultiTempRegion::region(doublereal T) const
 {
-    m_currRegion = 0;
+    // The region is found for each call rather than stored, since these
+    // objects may be shared between phases used from different threads
+    size_t n = 0;
     for (size_t i = 1; i < m_numTempRegions; i++) {
-        if (tt[0] < m_lowerTempBounds[i]) {
+        if (T < m_lowerTempBounds[i]) {
             break;
         }
-        m_currRegion++;
+        n++;
     }
+    return n;
+}
 
-    m_regionPts[m_currRegion]->updateProperties(tt, cp_R, h_RT, s_R);
+void Nasa9PolyMultiTempRegion::updateProperties(const doublereal* tt,
+        doublereal* cp_R,
+        doublereal* h_RT,
+        doublereal* s_R) const
+{
+    m_regionPts[region(tt[0])]->updateProperties(tt, cp_R, h_RT, s_R);
 }
 
 void Nasa9PolyMultiTempRegion::updatePropertiesTemp(const doublereal temp,
         doublereal* cp_R, doublereal* h_RT,
         doublereal* s_R) const
 {
-    // Now find the region
-    m_currRegion = 0;
-    for (size_t i = 1; i < m_numTempRegions; i++) {
-        if (temp < m_lowerTempBounds[i]) {
-            break;
-        }
-        m_currRegion++;
-    }
-
-    m_regionPts[m_currRegion]->updatePropertiesTemp(temp, cp_R, h_RT, s_R);
+    m_regionPts[region(temp)]->updatePropertiesTemp(temp, cp_R, h_RT, s_R);
 }
 
 void Nasa9PolyMultiTempRegion::reportParameters(size_t& n, int& type,
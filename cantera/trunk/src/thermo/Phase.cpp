@@ -26,6 +26,8 @@ Phase::Phase() :
     m_dens(0.001),
     m_mmw(0.0),
     m_stateNum(-1),
+    m_stateTNum(-1),
+    m_stateDNum(-1),
     m_mm(0),
     m_elem_type(0),
     realNumberRangeBehavior_(THROWON_OVERFLOW_DEBUGMODEONLY_CTRB)
@@ -42,6 +44,8 @@ Phase::Phase(const Phase& right) :
     m_dens(0.001),
     m_mmw(0.0),
     m_stateNum(-1),
+    m_stateTNum(-1),
+    m_stateDNum(-1),
     m_mm(0),
     m_elem_type(0),
     realNumberRangeBehavior_(THROWON_OVERFLOW_DEBUGMODEONLY_CTRB)
@@ -68,7 +72,11 @@ Phase& Phase::operator=(const Phase& right)
     m_y = right.m_y;
     m_molwts = right.m_molwts;
     m_rmolwts = right.m_rmolwts;
-    m_stateNum = -1;
+    // The state has changed; keep the counters increasing so that values
+    // cached for the previous state are not mistaken for valid ones.
+    m_stateNum++;
+    m_stateTNum++;
+    m_stateDNum++;
 
     m_speciesNames = right.m_speciesNames;
     m_speciesComp = right.m_speciesComp;
@@ -665,7 +673,11 @@ doublereal Phase::molarDensity() const
 
 void Phase::setMolarDensity(const doublereal molar_density)
 {
-    m_dens = molar_density*meanMolecularWeight();
+    doublereal dens = molar_density*meanMolecularWeight();
+    if (dens != m_dens) {
+        m_dens = dens;
+        m_stateDNum++;
+    }
 }
 
 doublereal Phase::molarVolume() const
@@ -14,6 +14,21 @@ bool SpeciesThermo::ready(size_t nSpecies) {
     return true;
 }
 
+void SpeciesThermo::update(size_t nT, const doublereal* T, doublereal* cp_R,
+                           doublereal* h_RT, doublereal* s_R) const
+{
+    size_t kk = m_installed.size();
+    vector_fp cp(kk), h(kk), s(kk);
+    for (size_t n = 0; n < nT; n++) {
+        update(T[n], &cp[0], &h[0], &s[0]);
+        for (size_t k = 0; k < kk; k++) {
+            cp_R[k*nT + n] = cp[k];
+            h_RT[k*nT + n] = h[k];
+            s_R[k*nT + n] = s[k];
+        }
+    }
+}
+
 void SpeciesThermo::markInstalled(size_t k) {
     if (k >= m_installed.size()) {
         m_installed.resize(k+1, false);
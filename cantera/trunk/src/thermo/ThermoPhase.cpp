@@ -38,9 +38,6 @@ ThermoPhase::ThermoPhase() :
 
 ThermoPhase::~ThermoPhase()
 {
-    for (size_t k = 0; k < m_speciesData.size(); k++) {
-        delete m_speciesData[k];
-    }
     delete m_spthermo;
 }
 
@@ -70,9 +67,6 @@ ThermoPhase& ThermoPhase::operator=(const ThermoPhase& right)
     /*
      * We need to destruct first
      */
-    for (size_t k = 0; k < m_speciesData.size(); k++) {
-        delete m_speciesData[k];
-    }
     delete m_spthermo;
 
     /*
@@ -87,12 +81,11 @@ ThermoPhase& ThermoPhase::operator=(const ThermoPhase& right)
     m_spthermo = (right.m_spthermo)->duplMyselfAsSpeciesThermo();
 
     /*
-     * Do a deep copy of species Data, because we own this
+     * The species data is not modified after it is saved, so it is shared
+     * with the copy
      */
-    m_speciesData.resize(m_kk);
-    for (size_t k = 0; k < m_kk; k++) {
-        m_speciesData[k] = new XML_Node(*(right.m_speciesData[k]));
-    }
+    m_speciesDataStorage = right.m_speciesDataStorage;
+    m_speciesData = right.m_speciesData;
 
     m_phi = right.m_phi;
     m_lambdaRRT = right.m_lambdaRRT;
@@ -708,8 +701,10 @@ void ThermoPhase::saveSpeciesData(const size_t k, const XML_Node* const data)
 {
     if (m_speciesData.size() < (k + 1)) {
         m_speciesData.resize(k+1, 0);
+        m_speciesDataStorage.resize(k+1);
     }
-    m_speciesData[k] = new XML_Node(*data);
+    m_speciesDataStorage[k].reset(new XML_Node(*data));
+    m_speciesData[k] = m_speciesDataStorage[k].get();
 }
 
 const std::vector<const XML_Node*> & ThermoPhase::speciesData() const
@@ -5,6 +5,23 @@
 #include "cantera/numerics/polyfit.h"
 #include "cantera/transport/TransportData.h"
 
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifdef THREAD_SAFE_CANTERA
+#include <boost/bind/bind.hpp>
+#include <boost/thread/thread.hpp>
+#endif
+
 namespace Cantera
 {
 
@@ -12,8 +29,77 @@ namespace Cantera
 //! except in CK mode, where the degree is 6.
 #define COLL_INT_POLY_DEGREE 8
 
+//! number of temperatures used in generating the property fits
+#define PROPERTY_FIT_NPOINTS 50
+
+//! Maximum number of fit values stored by GasTransport::getTransportProperties
+//! for one block of points. Blocks are made smaller for large mechanisms,
+//! down to a single point.
+static const size_t MaxFitBlockSize = 131072;
+
+//! Number of fits evaluated at all the points of a block before moving on
+//! to the next fits, so that their coefficients stay in the cache
+static const size_t FitChunkSize = 256;
+
+const size_t GasTransport::FitBlockPoints;
+
+//! Heat capacities of all species at the temperatures used for the
+//! property fits. cp_R(k,n) is the value for species k at point n.
+static void fitHeatCapacities(thermo_t& thermo, Array2D& cp_R)
+{
+    const size_t np = PROPERTY_FIT_NPOINTS;
+    double dt = (thermo.maxTemp() - thermo.minTemp())/(np-1);
+    cp_R.resize(thermo.nSpecies(), np);
+    for (size_t n = 0; n < np; n++) {
+        thermo.setTemperature(thermo.minTemp() + dt*n);
+        thermo.getCp_R_ref(cp_R.ptrColumn(n));
+    }
+}
+
+//! Short hexadecimal digest of a string, used to name fit cache files.
+//! Two 32-bit FNV hashes (FNV-1a and FNV-1) are concatenated.
+static std::string hashString(const std::string& s)
+{
+    unsigned long h1 = 2166136261UL;
+    unsigned long h2 = 2166136261UL;
+    for (size_t i = 0; i < s.size(); i++) {
+        unsigned long c = static_cast<unsigned char>(s[i]);
+        h1 = ((h1 ^ c) * 16777619UL) & 0xffffffffUL;
+        h2 = ((h2 * 16777619UL) & 0xffffffffUL) ^ c;
+    }
+    char buf[20];
+    sprintf(buf, "%08lx%08lx", h1, h2);
+    return buf;
+}
+
+static void writeFits(std::ostream& s, const std::vector<vector_fp>& fits)
+{
+    size_t ncoeffs = (fits.empty() ? 0 : fits[0].size());
+    s << fits.size() << " " << ncoeffs << "\n";
+    for (size_t i = 0; i < fits.size(); i++) {
+        for (size_t n = 0; n < ncoeffs; n++) {
+            s << fits[i][n] << " ";
+        }
+        s << "\n";
+    }
+}
+
+static bool readFits(std::istream& s, std::vector<vector_fp>& fits)
+{
+    size_t nfits = 0, ncoeffs = 0;
+    s >> nfits >> ncoeffs;
+    fits.assign(nfits, vector_fp(ncoeffs));
+    for (size_t i = 0; i < nfits; i++) {
+        for (size_t n = 0; n < ncoeffs; n++) {
+            s >> fits[i][n];
+        }
+    }
+    return !s.fail();
+}
+
 GasTransport::GasTransport(ThermoPhase* thermo) :
     Transport(thermo),
+    m_stateMF(-2),
     m_viscmix(0.0),
     m_visc_ok(false),
     m_viscwt_ok(false),
@@ -33,6 +119,7 @@ GasTransport::GasTransport(ThermoPhase* thermo) :
 }
 
 GasTransport::GasTransport(const GasTransport& right) :
+    m_stateMF(-2),
     m_viscmix(0.0),
     m_visc_ok(false),
     m_viscwt_ok(false),
@@ -54,6 +141,7 @@ GasTransport::GasTransport(const GasTransport& right) :
 GasTransport& GasTransport::operator=(const GasTransport& right)
 {
     m_molefracs = right.m_molefracs;
+    m_stateMF = -2;
     m_viscmix = right.m_viscmix;
     m_visc_ok = right.m_visc_ok;
     m_viscwt_ok = right.m_viscwt_ok;
@@ -66,6 +154,7 @@ GasTransport& GasTransport::operator=(const GasTransport& right)
     m_mw = right.m_mw;
     m_wratjk = right.m_wratjk;
     m_wratkj1 = right.m_wratkj1;
+    m_phifac = right.m_phifac;
     m_sqvisc = right.m_sqvisc;
     m_polytempvec = right.m_polytempvec;
     m_temp = right.m_temp;
@@ -76,6 +165,10 @@ GasTransport& GasTransport::operator=(const GasTransport& right)
     m_t14 = right.m_t14;
     m_t32 = right.m_t32;
     m_diffcoeffs = right.m_diffcoeffs;
+    m_visccoeffs_pack = right.m_visccoeffs_pack;
+    m_diffcoeffs_pack = right.m_diffcoeffs_pack;
+    m_fitwork = right.m_fitwork;
+    m_fitblock = right.m_fitblock;
     m_bdiff = right.m_bdiff;
     m_condcoeffs = right.m_condcoeffs;
     m_poly = right.m_poly;
@@ -83,6 +176,8 @@ GasTransport& GasTransport::operator=(const GasTransport& right)
     m_astar_poly = right.m_astar_poly;
     m_bstar_poly = right.m_bstar_poly;
     m_cstar_poly = right.m_cstar_poly;
+    m_presetFitIndex = right.m_presetFitIndex;
+    m_presetFitCoeffs = right.m_presetFitCoeffs;
     m_zrot = right.m_zrot;
     m_polar = right.m_polar;
     m_alpha = right.m_alpha;
@@ -115,11 +210,7 @@ void GasTransport::update_T(void)
     m_t32 = m_temp * m_sqrt_t;
 
     // compute powers of log(T)
-    m_polytempvec[0] = 1.0;
-    m_polytempvec[1] = m_logt;
-    m_polytempvec[2] = m_logt*m_logt;
-    m_polytempvec[3] = m_logt*m_logt*m_logt;
-    m_polytempvec[4] = m_logt*m_logt*m_logt*m_logt;
+    logTPowers(m_temp, DATA_PTR(m_polytempvec));
 
     // temperature has changed, so polynomial fits will need to be redone
     m_visc_ok = false;
@@ -154,22 +245,31 @@ doublereal GasTransport::viscosity()
 
 void GasTransport::updateViscosity_T()
 {
-    doublereal vratiokj, wratiojk, factor1;
-
     if (!m_spvisc_ok) {
         updateSpeciesViscosities();
     }
 
+    // reciprocal square roots of the species viscosities
+    doublereal* rsqvisc = DATA_PTR(m_fitwork);
+    for (size_t k = 0; k < m_nsp; k++) {
+        rsqvisc[k] = 1.0 / m_sqvisc[k];
+    }
+
     // see Eq. (9-5.15) of Reid, Prausnitz, and Poling
+    const doublereal* sqwrat = m_phifac.ptrColumn(0);
+    const doublereal* rdenom = m_phifac.ptrColumn(1);
+    const doublereal* wratkj = m_phifac.ptrColumn(2);
+    size_t ip = 0;
     for (size_t j = 0; j < m_nsp; j++) {
-        for (size_t k = j; k < m_nsp; k++) {
-            vratiokj = m_visc[k]/m_visc[j];
-            wratiojk = m_mw[j]/m_mw[k];
-
-            // Note that m_wratjk(k,j) holds the square root of m_wratjk(j,k)!
-            factor1 = 1.0 + (m_sqvisc[k]/m_sqvisc[j]) * m_wratjk(k,j);
-            m_phi(k,j) = factor1*factor1 / (sqrt(8.0) * m_wratkj1(j,k));
-            m_phi(j,k) = m_phi(k,j)/(vratiokj * wratiojk);
+        doublereal* phij = m_phi.ptrColumn(j);
+        const doublereal sqvj = m_sqvisc[j];
+        const doublereal rsqvj = rsqvisc[j];
+        for (size_t k = j; k < m_nsp; k++, ip++) {
+            doublereal factor1 = 1.0 + m_sqvisc[k] * rsqvj * sqwrat[ip];
+            phij[k] = factor1 * factor1 * rdenom[ip];
+            // visc[j]/visc[k] == (sqvisc[j]/sqvisc[k])^2
+            doublereal vratjk = sqvj * rsqvisc[k];
+            m_phi(j,k) = phij[k] * vratjk * vratjk * wratkj[ip];
         }
     }
     m_viscwt_ok = true;
@@ -178,15 +278,23 @@ void GasTransport::updateViscosity_T()
 void GasTransport::updateSpeciesViscosities()
 {
     update_T();
+    doublereal* f = DATA_PTR(m_fitwork);
+    evalPackedFits(m_visccoeffs_pack, 0, m_nsp, 1, DATA_PTR(m_polytempvec),
+                   0, f);
+    storeSpeciesViscosities(f);
+}
+
+void GasTransport::storeSpeciesViscosities(const doublereal* f)
+{
     if (m_mode == CK_Mode) {
         for (size_t k = 0; k < m_nsp; k++) {
-            m_visc[k] = exp(dot4(m_polytempvec, m_visccoeffs[k]));
+            m_visc[k] = exp(f[k]);
             m_sqvisc[k] = sqrt(m_visc[k]);
         }
     } else {
         for (size_t k = 0; k < m_nsp; k++) {
             // the polynomial fit is done for sqrt(visc/sqrt(T))
-            m_sqvisc[k] = m_t14 * dot5(m_polytempvec, m_visccoeffs[k]);
+            m_sqvisc[k] = m_t14 * f[k];
             m_visc[k] = (m_sqvisc[k] * m_sqvisc[k]);
         }
     }
@@ -197,28 +305,141 @@ void GasTransport::updateDiff_T()
 {
     update_T();
     // evaluate binary diffusion coefficients at unit pressure
+    doublereal* d = DATA_PTR(m_fitwork);
+    evalPackedFits(m_diffcoeffs_pack, 0, m_diffcoeffs_pack.nRows(), 1,
+                   DATA_PTR(m_polytempvec), 0, d);
+    storeBinaryDiffCoeffs(d);
+}
+
+void GasTransport::storeBinaryDiffCoeffs(const doublereal* f)
+{
     size_t ic = 0;
     if (m_mode == CK_Mode) {
         for (size_t i = 0; i < m_nsp; i++) {
             for (size_t j = i; j < m_nsp; j++) {
-                m_bdiff(i,j) = exp(dot4(m_polytempvec, m_diffcoeffs[ic]));
-                m_bdiff(j,i) = m_bdiff(i,j);
-                ic++;
+                m_bdiff(i,j) = m_bdiff(j,i) = exp(f[ic++]);
             }
         }
     } else {
         for (size_t i = 0; i < m_nsp; i++) {
             for (size_t j = i; j < m_nsp; j++) {
-                m_bdiff(i,j) = m_temp * m_sqrt_t*dot5(m_polytempvec,
-                                                      m_diffcoeffs[ic]);
-                m_bdiff(j,i) = m_bdiff(i,j);
-                ic++;
+                m_bdiff(i,j) = m_bdiff(j,i) = f[ic++] * m_t32;
             }
         }
     }
     m_bindiff_ok = true;
 }
 
+void GasTransport::logTPowers(doublereal T, doublereal* tpoly)
+{
+    doublereal logt = log(T);
+    tpoly[0] = 1.0;
+    tpoly[1] = logt;
+    tpoly[2] = logt*logt;
+    tpoly[3] = logt*logt*logt;
+    tpoly[4] = logt*logt*logt*logt;
+}
+
+void GasTransport::evalPackedFits(const Array2D& coeffs, size_t first,
+                                  size_t last, size_t npoints,
+                                  const doublereal* tpoly, size_t ldf,
+                                  doublereal* f) const
+{
+    // Evaluate a chunk of the fits at every point, one coefficient at a
+    // time, so that the inner loops run over contiguous memory and each
+    // coefficient is read from memory once for all of the points.
+    for (size_t i0 = first; i0 < last; i0 += FitChunkSize) {
+        size_t i1 = std::min(i0 + FitChunkSize, last);
+        for (size_t j = 0; j < npoints; j++) {
+            const doublereal* tp = tpoly + 5*j;
+            doublereal* fj = f + j*ldf;
+            const doublereal* c = coeffs.ptrColumn(0);
+            for (size_t i = i0; i < i1; i++) {
+                fj[i - first] = c[i];
+            }
+            for (size_t n = 1; n < coeffs.nColumns(); n++) {
+                const doublereal tn = tp[n];
+                c = coeffs.ptrColumn(n);
+                for (size_t i = i0; i < i1; i++) {
+                    fj[i - first] += tn * c[i];
+                }
+            }
+        }
+    }
+}
+
+void GasTransport::getTransportProperties(size_t npoints, const doublereal* T,
+                                          const doublereal* P,
+                                          const doublereal* X,
+                                          doublereal* visc, doublereal* cond,
+                                          doublereal* dmix)
+{
+    // The thermal conductivity of MultiTransport depends on the species
+    // viscosities and binary diffusion coefficients, so all the fits are
+    // evaluated if it is requested.
+    bool doVisc = (visc || cond);
+    bool doDiff = (dmix || cond);
+    size_t nvisc = doVisc ? m_nsp : 0;
+    size_t ndiff = doDiff ? m_diffcoeffs_pack.nRows() : 0;
+    size_t stride = nvisc + ndiff;
+    size_t blockSize = FitBlockPoints;
+    if (stride) {
+        blockSize = std::max<size_t>(1, std::min(blockSize,
+                                                 MaxFitBlockSize / stride));
+    }
+    m_fitblock.resize(blockSize * (stride + 5));
+    doublereal* tpoly = &m_fitblock[blockSize * stride];
+
+    for (size_t j0 = 0; j0 < npoints; j0 += blockSize) {
+        size_t j1 = std::min(j0 + blockSize, npoints);
+
+        // Fits are evaluated once for each run of consecutive points with
+        // the same temperature
+        size_t ntemps = 0;
+        for (size_t j = j0; j < j1; j++) {
+            if (j == j0 || T[j] != T[j-1]) {
+                logTPowers(T[j], tpoly + 5*ntemps);
+                ntemps++;
+            }
+        }
+        if (doVisc) {
+            evalPackedFits(m_visccoeffs_pack, 0, m_nsp, ntemps, tpoly, stride,
+                           &m_fitblock[0]);
+        }
+        if (doDiff) {
+            evalPackedFits(m_diffcoeffs_pack, 0, ndiff, ntemps, tpoly,
+                           stride, &m_fitblock[nvisc]);
+        }
+
+        size_t n = 0;
+        for (size_t j = j0; j < j1; j++) {
+            m_thermo->setState_TPX(T[j], P[j], X + j*m_nsp);
+            if (j != j0 && T[j] != T[j-1]) {
+                n++;
+            }
+            if (m_temp != T[j]) {
+                update_T();
+                const doublereal* f = &m_fitblock[n * stride];
+                if (doVisc) {
+                    storeSpeciesViscosities(f);
+                }
+                if (doDiff) {
+                    storeBinaryDiffCoeffs(f + nvisc);
+                }
+            }
+            if (visc) {
+                visc[j] = viscosity();
+            }
+            if (cond) {
+                cond[j] = thermalConductivity();
+            }
+            if (dmix) {
+                getMixDiffCoeffs(dmix + j*m_nsp);
+            }
+        }
+    }
+}
+
 void GasTransport::getBinaryDiffCoeffs(const size_t ld, doublereal* const d)
 {
     update_T();
@@ -334,12 +555,20 @@ void GasTransport::getMixDiffCoeffsMass(doublereal* const d)
     }
 }
 
+void GasTransport::setThermo(thermo_t& thermo)
+{
+    Transport::setThermo(thermo);
+    // the cached mole fractions belong to the previous phase object
+    m_stateMF = -2;
+}
+
 void GasTransport::init(thermo_t* thermo, int mode, int log_level)
 {
     m_thermo = thermo;
     m_nsp = m_thermo->nSpecies();
     m_mode = mode;
     m_log_level = log_level;
+    m_stateMF = -2;
     // set up Monchick and Mason collision integrals
     setupMM();
 
@@ -364,6 +593,16 @@ void GasTransport::init(thermo_t* thermo, int mode, int log_level)
         }
     }
 
+    m_phifac.resize(m_nsp*(m_nsp+1)/2, 3, 0.0);
+    size_t ip = 0;
+    for (size_t j = 0; j < m_nsp; j++) {
+        for (size_t k = j; k < m_nsp; k++, ip++) {
+            m_phifac(ip,0) = m_wratjk(k,j);
+            m_phifac(ip,1) = 1.0 / (sqrt(8.0) * m_wratkj1(j,k));
+            m_phifac(ip,2) = m_mw[k] / m_mw[j];
+        }
+    }
+
     // set flags all false
     m_visc_ok = false;
     m_viscwt_ok = false;
@@ -441,6 +680,35 @@ void GasTransport::setupMM()
         tstar_max = 99.9;
     }
 
+    // Use the fits given by setFits(), if any
+    if (!m_presetFitIndex.empty()) {
+        bool ok = unpackFits(m_presetFitIndex, m_presetFitCoeffs);
+        m_presetFitIndex.clear();
+        m_presetFitCoeffs.clear();
+        if (!ok) {
+            throw CanteraError("GasTransport::setupMM",
+                               "fits given to setFits are inconsistent with "
+                               "the phase or the fit mode");
+        }
+        return;
+    }
+
+    // If a fit cache directory is given, reuse the fits from an earlier run
+    // with the same transport and thermo data
+    std::string cache_key, cache_file;
+    const char* cache_dir = getenv("CANTERA_TRANSPORT_CACHE");
+    if (cache_dir != 0 && cache_dir[0] != '\0') {
+        cache_key = fitCacheKey();
+        cache_file = std::string(cache_dir) + "/gastransport_" +
+                     hashString(cache_key) + ".txt";
+        if (readFitCache(cache_file, cache_key)) {
+            if (DEBUG_MODE_ENABLED && m_log_level) {
+                writelog("*** read property fits from " + cache_file + " ***\n");
+            }
+            return;
+        }
+    }
+
     // initialize the collision integral calculator for the desired T* range
     if (DEBUG_MODE_ENABLED && m_log_level) {
         writelog("*** collision_integrals ***\n");
@@ -459,6 +727,9 @@ void GasTransport::setupMM()
     if (DEBUG_MODE_ENABLED && m_log_level) {
         writelog("*** end of property fits ***\n");
     }
+    if (!cache_file.empty()) {
+        writeFitCache(cache_file, cache_key);
+    }
 }
 
 void GasTransport::getTransportData()
@@ -527,6 +798,10 @@ void GasTransport::fitCollisionIntegrals(MMCollisionInt& integrals)
         }
     }
     vector_fp fitlist;
+    m_omega22_poly.clear();
+    m_astar_poly.clear();
+    m_bstar_poly.clear();
+    m_cstar_poly.clear();
     for (size_t i = 0; i < m_nsp; i++) {
         for (size_t j = i; j < m_nsp; j++)  {
             // Chemkin fits only delta* = 0
@@ -570,20 +845,26 @@ void GasTransport::fitProperties(MMCollisionInt& integrals)
 {
     int ndeg = 0;
     // number of points to use in generating fit data
-    const size_t np = 50;
+    const size_t np = PROPERTY_FIT_NPOINTS;
 
     int degree = (m_mode == CK_Mode ? 3 : 4);
 
     double dt = (m_thermo->maxTemp() - m_thermo->minTemp())/(np-1);
-    vector_fp tlog(np), spvisc(np), spcond(np);
+    vector_fp tfit(np), tlog(np), spvisc(np), spcond(np);
     vector_fp w(np), w2(np);
 
     // generate array of log(t) values
     for (size_t n = 0; n < np; n++) {
-        double t = m_thermo->minTemp() + dt*n;
-        tlog[n] = log(t);
+        tfit[n] = m_thermo->minTemp() + dt*n;
+        tlog[n] = log(tfit[n]);
     }
 
+    // species heat capacities at each of the fit temperatures
+    Array2D cp_R_all;
+    fitHeatCapacities(*m_thermo, cp_R_all);
+    m_visccoeffs.clear();
+    m_condcoeffs.clear();
+
     // vector of polynomial coefficients
     vector_fp c(degree + 1), c2(degree + 1);
 
@@ -610,12 +891,8 @@ void GasTransport::fitProperties(MMCollisionInt& integrals)
     const vector_fp& mw = m_thermo->molecularWeights();
     for (size_t k = 0; k < m_nsp; k++) {
         for (size_t n = 0; n < np; n++) {
-            double t = m_thermo->minTemp() + dt*n;
-
-            m_thermo->setTemperature(t);
-            vector_fp cp_R_all(m_thermo->nSpecies());
-            m_thermo->getCp_R_ref(&cp_R_all[0]);
-            cp_R = cp_R_all[k];
+            double t = tfit[n];
+            cp_R = cp_R_all(k,n);
 
             double tstar = Boltzmann * t/ m_eps[k];
             sqrt_T = sqrt(t);
@@ -742,58 +1019,47 @@ void GasTransport::fitProperties(MMCollisionInt& integrals)
         }
     }
 
+    // fit the binary diffusion coefficients of all species pairs. The rows
+    // of pairs (k,j) with j >= k are dealt out to the worker threads in turn.
+    size_t npairs = m_nsp*(m_nsp+1)/2;
+    m_diffcoeffs.assign(npairs, vector_fp());
+    vector_fp pairerr(2*npairs, 0.0);
+    size_t nthreads = 1;
+#ifdef THREAD_SAFE_CANTERA
+    nthreads = std::max<size_t>(boost::thread::hardware_concurrency(), 1);
+    nthreads = std::min(nthreads, m_nsp/8 + 1);
+#endif
+    std::vector<std::string> errmsg(nthreads);
+    if (nthreads == 1) {
+        fitDiffCoeffs(integrals, tfit, tlog, 0, 1, pairerr, errmsg[0]);
+    } else {
+#ifdef THREAD_SAFE_CANTERA
+        boost::thread_group workers;
+        for (size_t i = 0; i < nthreads; i++) {
+            workers.create_thread(boost::bind(&GasTransport::fitDiffCoeffs,
+                this, boost::ref(integrals), boost::cref(tfit),
+                boost::cref(tlog), i, nthreads, boost::ref(pairerr),
+                boost::ref(errmsg[i])));
+        }
+        workers.join_all();
+#endif
+    }
+    for (size_t i = 0; i < nthreads; i++) {
+        if (!errmsg[i].empty()) {
+            throw CanteraError("GasTransport::fitProperties", errmsg[i]);
+        }
+    }
+
     mxerr = 0.0, mxrelerr = 0.0;
-    vector_fp diff(np + 1);
-    double eps, sigma;
+    size_t ic = 0;
     for (size_t k = 0; k < m_nsp; k++)  {
-        for (size_t j = k; j < m_nsp; j++) {
-            for (size_t n = 0; n < np; n++) {
-                double t = m_thermo->minTemp() + dt*n;
-                eps = m_epsilon(j,k);
-                double tstar = Boltzmann * t/eps;
-                sigma = m_diam(j,k);
-                om11 = integrals.omega11(tstar, m_delta(j,k));
-
-                diffcoeff = 3.0/16.0 * sqrt(2.0 * Pi/m_reducedMass(k,j)) *
-                            pow(Boltzmann * t, 1.5) /
-                            (Pi * sigma * sigma * om11);
-
-                // 2nd order correction
-                // NOTE: THIS CORRECTION IS NOT APPLIED
-                double fkj, fjk;
-                getBinDiffCorrection(t, integrals, k, j, 1.0, 1.0, fkj, fjk);
-
-                if (m_mode == CK_Mode) {
-                    diff[n] = log(diffcoeff);
-                    w[n] = -1.0;
-                } else {
-                    diff[n] = diffcoeff/pow(t, 1.5);
-                    w[n] = 1.0/(diff[n]*diff[n]);
-                }
-            }
-            polyfit(np, DATA_PTR(tlog), DATA_PTR(diff),
-                    DATA_PTR(w), degree, ndeg, 0.0, DATA_PTR(c));
-
-            for (size_t n = 0; n < np; n++) {
-                double val, fit;
-                if (m_mode == CK_Mode) {
-                    val = exp(diff[n]);
-                    fit = exp(poly3(tlog[n], DATA_PTR(c)));
-                } else {
-                    double t = exp(tlog[n]);
-                    double pre = pow(t, 1.5);
-                    val = pre * diff[n];
-                    fit = pre * poly4(tlog[n], DATA_PTR(c));
-                }
-                err = fit - val;
-                relerr = err/val;
-                mxerr = std::max(mxerr, fabs(err));
-                mxrelerr = std::max(mxrelerr, fabs(relerr));
-            }
-            m_diffcoeffs.push_back(c);
+        for (size_t j = k; j < m_nsp; j++, ic++) {
+            mxerr = std::max(mxerr, pairerr[2*ic]);
+            mxrelerr = std::max(mxrelerr, pairerr[2*ic+1]);
             if (DEBUG_MODE_ENABLED && m_log_level >= 2) {
                 writelog(m_thermo->speciesName(k) + "__" +
-                         m_thermo->speciesName(j) + ": [" + vec2str(c) + "]\n");
+                         m_thermo->speciesName(j) + ": [" +
+                         vec2str(m_diffcoeffs[ic]) + "]\n");
             }
         }
     }
@@ -803,6 +1069,314 @@ void GasTransport::fitProperties(MMCollisionInt& integrals)
         writelogf("Maximum binary diffusion coefficient relative error:"
                  "%12.6g", mxrelerr);
     }
+    packFitCoeffs();
+}
+
+void GasTransport::fitDiffCoeffs(MMCollisionInt& integrals,
+                                 const vector_fp& tfit, const vector_fp& tlog,
+                                 size_t kfirst, size_t kstride,
+                                 vector_fp& pairerr, std::string& errmsg)
+{
+    int ndeg = 0;
+    size_t np = tlog.size();
+    int degree = (m_mode == CK_Mode ? 3 : 4);
+    vector_fp diff(np + 1), w(np), c(degree + 1);
+    // polyfit() takes non-const arguments, so each thread gets its own copy
+    vector_fp x(tlog);
+    try {
+        for (size_t k = kfirst; k < m_nsp; k += kstride) {
+            // index of the pair (k,k)
+            size_t ic = k*(2*m_nsp - k + 1)/2;
+            for (size_t j = k; j < m_nsp; j++, ic++) {
+                for (size_t n = 0; n < np; n++) {
+                    double t = tfit[n];
+                    double eps = m_epsilon(j,k);
+                    double tstar = Boltzmann * t/eps;
+                    double sigma = m_diam(j,k);
+                    double om11 = integrals.omega11(tstar, m_delta(j,k));
+
+                    double diffcoeff = 3.0/16.0 *
+                        sqrt(2.0 * Pi/m_reducedMass(k,j)) *
+                        pow(Boltzmann * t, 1.5) / (Pi * sigma * sigma * om11);
+
+                    // The 2nd order correction from getBinDiffCorrection()
+                    // is not applied.
+                    if (m_mode == CK_Mode) {
+                        diff[n] = log(diffcoeff);
+                        w[n] = -1.0;
+                    } else {
+                        diff[n] = diffcoeff/pow(t, 1.5);
+                        w[n] = 1.0/(diff[n]*diff[n]);
+                    }
+                }
+                polyfit(np, DATA_PTR(x), DATA_PTR(diff),
+                        DATA_PTR(w), degree, ndeg, 0.0, DATA_PTR(c));
+
+                double mxerr = 0.0, mxrelerr = 0.0;
+                for (size_t n = 0; n < np; n++) {
+                    double val, fit;
+                    if (m_mode == CK_Mode) {
+                        val = exp(diff[n]);
+                        fit = exp(poly3(tlog[n], DATA_PTR(c)));
+                    } else {
+                        double t = exp(tlog[n]);
+                        double pre = pow(t, 1.5);
+                        val = pre * diff[n];
+                        fit = pre * poly4(tlog[n], DATA_PTR(c));
+                    }
+                    double err = fit - val;
+                    double relerr = err/val;
+                    mxerr = std::max(mxerr, fabs(err));
+                    mxrelerr = std::max(mxrelerr, fabs(relerr));
+                }
+                m_diffcoeffs[ic] = c;
+                pairerr[2*ic] = mxerr;
+                pairerr[2*ic+1] = mxrelerr;
+            }
+        }
+    } catch (CanteraError& err) {
+        // exceptions cannot propagate out of a worker thread
+        errmsg = err.getMessage();
+    }
+}
+
+std::string GasTransport::fitCacheKey()
+{
+    // Everything the fits depend on, in a form that reproduces the values
+    // exactly
+    std::string key = "GasTransport fits 1 mode " + int2str(m_mode) +
+                      " T " + fp2str(m_thermo->minTemp(), "%.17g") + " " +
+                      fp2str(m_thermo->maxTemp(), "%.17g");
+    const vector_fp& mw = m_thermo->molecularWeights();
+    for (size_t k = 0; k < m_nsp; k++) {
+        key += " " + m_thermo->speciesName(k);
+        double params[] = {mw[k], m_sigma[k], m_eps[k], m_dipole(k,k),
+                           m_alpha[k], m_zrot[k], m_crot[k]};
+        for (size_t i = 0; i < 7; i++) {
+            key += " " + fp2str(params[i], "%.17g");
+        }
+    }
+    // The heat capacities at the fit temperatures are represented by their
+    // digest, to keep the key short
+    Array2D cp_R;
+    fitHeatCapacities(*m_thermo, cp_R);
+    std::string cp_text;
+    for (size_t n = 0; n < cp_R.nColumns(); n++) {
+        for (size_t k = 0; k < m_nsp; k++) {
+            cp_text += fp2str(cp_R(k,n), "%.17g") + " ";
+        }
+    }
+    return key + " cp " + hashString(cp_text);
+}
+
+bool GasTransport::readFitCache(const std::string& path,
+                                const std::string& key)
+{
+    std::ifstream in(path.c_str());
+    std::string line;
+    if (!in || !std::getline(in, line) || line != key) {
+        return false;
+    }
+
+    std::vector<vector_int> poly(m_nsp, vector_int(m_nsp));
+    for (size_t i = 0; i < m_nsp; i++) {
+        for (size_t j = 0; j < m_nsp; j++) {
+            in >> poly[i][j];
+        }
+    }
+    std::vector<vector_fp> omega22, astar, bstar, cstar, visc, cond, diff;
+    std::string end;
+    if (!readFits(in, omega22) || !readFits(in, astar) ||
+        !readFits(in, bstar) || !readFits(in, cstar) ||
+        !readFits(in, visc) || !readFits(in, cond) || !readFits(in, diff) ||
+        !(in >> end) || end != "end") {
+        return false;
+    }
+    // reject files which were truncated or are otherwise inconsistent
+    return assignFits(poly, omega22, astar, bstar, cstar, visc, cond, diff);
+}
+
+bool GasTransport::assignFits(const std::vector<vector_int>& poly,
+                              const std::vector<vector_fp>& omega22,
+                              const std::vector<vector_fp>& astar,
+                              const std::vector<vector_fp>& bstar,
+                              const std::vector<vector_fp>& cstar,
+                              const std::vector<vector_fp>& visc,
+                              const std::vector<vector_fp>& cond,
+                              const std::vector<vector_fp>& diff)
+{
+    if (poly.size() != m_nsp || visc.size() != m_nsp ||
+        cond.size() != m_nsp || diff.size() != m_nsp*(m_nsp+1)/2 ||
+        astar.size() != omega22.size() || bstar.size() != omega22.size() ||
+        cstar.size() != omega22.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < m_nsp; i++) {
+        if (poly[i].size() != m_nsp) {
+            return false;
+        }
+        for (size_t j = 0; j < m_nsp; j++) {
+            if (poly[i][j] < 0 || size_t(poly[i][j]) >= omega22.size()) {
+                return false;
+            }
+        }
+    }
+
+    m_poly = poly;
+    m_omega22_poly = omega22;
+    m_astar_poly = astar;
+    m_bstar_poly = bstar;
+    m_cstar_poly = cstar;
+    m_visccoeffs = visc;
+    m_condcoeffs = cond;
+    m_diffcoeffs = diff;
+    packFitCoeffs();
+    return true;
+}
+
+void GasTransport::getFits(vector_int& index, vector_fp& coeffs) const
+{
+    const std::vector<vector_fp>* fits[] = {
+        &m_omega22_poly, &m_astar_poly, &m_bstar_poly, &m_cstar_poly,
+        &m_visccoeffs, &m_condcoeffs, &m_diffcoeffs
+    };
+    index.clear();
+    coeffs.clear();
+    index.push_back(m_mode);
+    index.push_back(int(m_nsp));
+    for (size_t n = 0; n < 7; n++) {
+        const std::vector<vector_fp>& f = *fits[n];
+        size_t ncoeffs = (f.empty() ? 0 : f[0].size());
+        index.push_back(int(f.size()));
+        index.push_back(int(ncoeffs));
+        for (size_t i = 0; i < f.size(); i++) {
+            coeffs.insert(coeffs.end(), f[i].begin(), f[i].begin() + ncoeffs);
+        }
+    }
+    for (size_t i = 0; i < m_poly.size(); i++) {
+        index.insert(index.end(), m_poly[i].begin(), m_poly[i].end());
+    }
+}
+
+void GasTransport::setFits(const vector_int& index, const vector_fp& coeffs)
+{
+    if (m_poly.empty()) {
+        // init() has not been called yet
+        m_presetFitIndex = index;
+        m_presetFitCoeffs = coeffs;
+    } else if (!unpackFits(index, coeffs)) {
+        throw CanteraError("GasTransport::setFits", "fits are inconsistent "
+                           "with the phase or the fit mode");
+    }
+}
+
+bool GasTransport::unpackFits(const vector_int& index, const vector_fp& coeffs)
+{
+    if (index.size() < 16 || index[0] != m_mode || index[1] != int(m_nsp) ||
+        index.size() != 16 + m_nsp*m_nsp) {
+        return false;
+    }
+    std::vector<vector_fp> fits[7];
+    size_t pos = 0;
+    for (size_t n = 0; n < 7; n++) {
+        if (index[2+2*n] < 0 || index[3+2*n] < 0) {
+            return false;
+        }
+        size_t nfits = index[2+2*n];
+        size_t ncoeffs = index[3+2*n];
+        if (pos + nfits*ncoeffs > coeffs.size()) {
+            return false;
+        }
+        fits[n].resize(nfits);
+        for (size_t i = 0; i < nfits; i++, pos += ncoeffs) {
+            fits[n][i].assign(coeffs.begin() + pos,
+                              coeffs.begin() + pos + ncoeffs);
+        }
+    }
+    if (pos != coeffs.size()) {
+        return false;
+    }
+    std::vector<vector_int> poly(m_nsp);
+    for (size_t i = 0; i < m_nsp; i++) {
+        poly[i].assign(index.begin() + 16 + i*m_nsp,
+                       index.begin() + 16 + (i+1)*m_nsp);
+    }
+    return assignFits(poly, fits[0], fits[1], fits[2], fits[3], fits[4],
+                      fits[5], fits[6]);
+}
+
+void GasTransport::writeFitCache(const std::string& path,
+                                 const std::string& key) const
+{
+    // Write to a temporary file and move it into place, so that other
+    // processes never see a partially written cache file. The process id
+    // and the address of this object make the name unique among concurrent
+    // writers in different processes and threads.
+#ifdef _WIN32
+    int pid = _getpid();
+#else
+    int pid = getpid();
+#endif
+    char suffix[64];
+    sprintf(suffix, ".tmp%d_%p", pid, (const void*) this);
+    std::string tmp = path + suffix;
+    {
+        std::ofstream out(tmp.c_str());
+        if (!out) {
+            return;
+        }
+        out.precision(17);
+        out << key << "\n";
+        for (size_t i = 0; i < m_nsp; i++) {
+            for (size_t j = 0; j < m_nsp; j++) {
+                out << m_poly[i][j] << " ";
+            }
+            out << "\n";
+        }
+        writeFits(out, m_omega22_poly);
+        writeFits(out, m_astar_poly);
+        writeFits(out, m_bstar_poly);
+        writeFits(out, m_cstar_poly);
+        writeFits(out, m_visccoeffs);
+        writeFits(out, m_condcoeffs);
+        writeFits(out, m_diffcoeffs);
+        out << "end\n";
+        if (!out) {
+            out.close();
+            std::remove(tmp.c_str());
+            return;
+        }
+    }
+    // Replace any existing cache file atomically
+#ifdef _WIN32
+    bool moved = (MoveFileExA(tmp.c_str(), path.c_str(),
+                              MOVEFILE_REPLACE_EXISTING) != 0);
+#else
+    bool moved = (std::rename(tmp.c_str(), path.c_str()) == 0);
+#endif
+    if (!moved) {
+        std::remove(tmp.c_str());
+    }
+}
+
+void GasTransport::packFitCoeffs()
+{
+    size_t ncoeffs = m_visccoeffs.empty() ? 0 : m_visccoeffs[0].size();
+    m_visccoeffs_pack.resize(m_visccoeffs.size(), ncoeffs, 0.0);
+    for (size_t k = 0; k < m_visccoeffs.size(); k++) {
+        for (size_t n = 0; n < ncoeffs; n++) {
+            m_visccoeffs_pack(k,n) = m_visccoeffs[k][n];
+        }
+    }
+
+    ncoeffs = m_diffcoeffs.empty() ? 0 : m_diffcoeffs[0].size();
+    m_diffcoeffs_pack.resize(m_diffcoeffs.size(), ncoeffs, 0.0);
+    for (size_t ic = 0; ic < m_diffcoeffs.size(); ic++) {
+        for (size_t n = 0; n < ncoeffs; n++) {
+            m_diffcoeffs_pack(ic,n) = m_diffcoeffs[ic][n];
+        }
+    }
+    m_fitwork.resize(std::max(m_visccoeffs.size(), m_diffcoeffs.size()));
 }
 
 void GasTransport::getBinDiffCorrection(double t, MMCollisionInt& integrals,
@@ -90,6 +90,176 @@ doublereal MixTransport::thermalConductivity()
     return m_lambda;
 }
 
+void MixTransport::getTransportProperties(size_t npoints, const doublereal* T,
+                                          const doublereal* P,
+                                          const doublereal* X,
+                                          doublereal* visc, doublereal* cond,
+                                          doublereal* dmix)
+{
+    const size_t nb = FitBlockPoints;
+    const size_t kk = m_nsp;
+    m_fitblock.resize(nb * (5 + 6*kk) + kk);
+    doublereal* tpoly = &m_fitblock[0];
+    doublereal* x = tpoly + 5*nb; // mole fractions at each point
+    doublereal* mu = x + kk*nb; // species viscosities
+    doublereal* sqmu = mu + kk*nb; // square roots of the species viscosities
+    doublereal* sum2 = sqmu + kk*nb; // sum_{j != k} X_j / D_kj
+    doublereal* dself = sum2 + kk*nb; // self-diffusion coefficients
+    doublereal* f = dself + kk*nb; // diffusion fits for one row of pairs
+    doublereal* phisum = f + kk*nb; // sum_j Phi_kj X_j at one point
+    const doublereal* sqwrat = m_phifac.ptrColumn(0);
+    const doublereal* rdenom = m_phifac.ptrColumn(1);
+    const doublereal* wratkj = m_phifac.ptrColumn(2);
+    doublereal mmw[FitBlockPoints], pres[FitBlockPoints];
+
+    for (size_t j0 = 0; j0 < npoints; j0 += nb) {
+        size_t n = std::min(nb, npoints - j0);
+        for (size_t b = 0; b < n; b++) {
+            m_thermo->setState_TPX(T[j0+b], P[j0+b], X + (j0+b)*kk);
+            doublereal* xb = x + b*kk;
+            m_thermo->getMoleFractions(xb);
+            mmw[b] = m_thermo->meanMolecularWeight();
+            pres[b] = m_thermo->pressure();
+            for (size_t k = 0; k < kk; k++) {
+                xb[k] = std::max(Tiny, xb[k]);
+            }
+            logTPowers(T[j0+b], tpoly + 5*b);
+        }
+
+        if (visc) {
+            evalPackedFits(m_visccoeffs_pack, 0, kk, n, tpoly, kk, mu);
+            for (size_t b = 0; b < n; b++) {
+                doublereal* mub = mu + b*kk;
+                doublereal* sqmub = sqmu + b*kk;
+                const doublereal* xb = x + b*kk;
+                doublereal t14 = sqrt(sqrt(T[j0+b]));
+                for (size_t k = 0; k < kk; k++) {
+                    if (m_mode == CK_Mode) {
+                        mub[k] = exp(mub[k]);
+                        sqmub[k] = sqrt(mub[k]);
+                    } else {
+                        sqmub[k] = t14 * mub[k];
+                        mub[k] = sqmub[k] * sqmub[k];
+                    }
+                }
+
+                // Wilke mixture rule, accumulating the products of the
+                // weighting functions and the mole fractions for each pair
+                // instead of storing the weighting functions
+                doublereal* rsqmu = f;
+                for (size_t k = 0; k < kk; k++) {
+                    rsqmu[k] = 1.0 / sqmub[k];
+                    phisum[k] = 0.0;
+                }
+                size_t ip = 0;
+                for (size_t j = 0; j < kk; j++) {
+                    const doublereal sqvj = sqmub[j];
+                    const doublereal rsqvj = rsqmu[j];
+                    const doublereal xj = xb[j];
+                    doublereal factor1 = 1.0 + sqwrat[ip];
+                    doublereal sumj = factor1 * factor1 * rdenom[ip] * xj;
+                    ip++;
+                    for (size_t k = j + 1; k < kk; k++, ip++) {
+                        factor1 = 1.0 + sqmub[k] * rsqvj * sqwrat[ip];
+                        doublereal phikj = factor1 * factor1 * rdenom[ip];
+                        doublereal vratjk = sqvj * rsqmu[k];
+                        sumj += phikj * vratjk * vratjk * wratkj[ip] * xb[k];
+                        phisum[k] += phikj * xj;
+                    }
+                    phisum[j] += sumj;
+                }
+                doublereal vismix = 0.0;
+                for (size_t k = 0; k < kk; k++) {
+                    vismix += xb[k] * mub[k] / phisum[k];
+                }
+                visc[j0+b] = vismix;
+            }
+        }
+
+        if (cond) {
+            for (size_t b = 0; b < n; b++) {
+                const doublereal* tp = tpoly + 5*b;
+                const doublereal* xb = x + b*kk;
+                doublereal sqrt_t = sqrt(T[j0+b]);
+                doublereal sum1 = 0.0, sum2 = 0.0;
+                for (size_t k = 0; k < kk; k++) {
+                    const vector_fp& c = m_condcoeffs[k];
+                    doublereal condk;
+                    if (m_mode == CK_Mode) {
+                        condk = exp(tp[0]*c[0] + tp[1]*c[1] + tp[2]*c[2] +
+                                    tp[3]*c[3]);
+                    } else {
+                        condk = sqrt_t * (tp[0]*c[0] + tp[1]*c[1] +
+                                          tp[2]*c[2] + tp[3]*c[3] +
+                                          tp[4]*c[4]);
+                    }
+                    sum1 += xb[k] * condk;
+                    sum2 += xb[k] / condk;
+                }
+                cond[j0+b] = 0.5*(sum1 + 1.0/sum2);
+            }
+        }
+
+        if (dmix) {
+            // Evaluate the binary diffusion coefficient fits one row of
+            // species pairs at a time, and add each coefficient to the sums
+            // for both species, so that the full matrix is never stored
+            std::fill(sum2, sum2 + n*kk, 0.0);
+            size_t ic = 0;
+            for (size_t i = 0; i < kk; i++) {
+                size_t nj = kk - i;
+                evalPackedFits(m_diffcoeffs_pack, ic, ic + nj, n, tpoly, kk, f);
+                for (size_t b = 0; b < n; b++) {
+                    doublereal* fb = f + b*kk;
+                    const doublereal* xb = x + b*kk + i;
+                    doublereal* sb = sum2 + b*kk + i;
+                    if (m_mode == CK_Mode) {
+                        for (size_t m = 0; m < nj; m++) {
+                            fb[m] = exp(fb[m]);
+                        }
+                    } else {
+                        doublereal t32 = T[j0+b] * sqrt(T[j0+b]);
+                        for (size_t m = 0; m < nj; m++) {
+                            fb[m] *= t32;
+                        }
+                    }
+                    dself[b*kk + i] = fb[0];
+                    doublereal si = 0.0;
+                    for (size_t m = 1; m < nj; m++) {
+                        doublereal rd = 1.0 / fb[m];
+                        si += xb[m] * rd;
+                        sb[m] += xb[0] * rd;
+                    }
+                    sb[0] += si;
+                }
+                ic += nj;
+            }
+
+            for (size_t b = 0; b < n; b++) {
+                const doublereal* xb = x + b*kk;
+                const doublereal* sb = sum2 + b*kk;
+                doublereal* d = dmix + (j0+b)*kk;
+                doublereal p = pres[b];
+                if (kk == 1) {
+                    d[0] = dself[b*kk] / p;
+                    continue;
+                }
+                doublereal sumxw = 0.0;
+                for (size_t k = 0; k < kk; k++) {
+                    sumxw += xb[k] * m_mw[k];
+                }
+                for (size_t k = 0; k < kk; k++) {
+                    if (sb[k] <= 0.0) {
+                        d[k] = dself[b*kk + k] / p;
+                    } else {
+                        d[k] = (sumxw - xb[k] * m_mw[k])/(p * mmw[b] * sb[k]);
+                    }
+                }
+            }
+        }
+    }
+}
+
 void MixTransport::getThermalDiffCoeffs(doublereal* const dt)
 {
     for (size_t k = 0; k < m_nsp; k++) {
@@ -144,6 +314,11 @@ void MixTransport::update_T()
 
 void MixTransport::update_C()
 {
+    if (m_thermo->stateMFNumber() == m_stateMF) {
+        return;
+    }
+    m_stateMF = m_thermo->stateMFNumber();
+
     // signal that concentration-dependent quantities will need to
     // be recomputed before use, and update the local mole
     // fractions.
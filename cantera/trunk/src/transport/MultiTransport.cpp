@@ -35,7 +35,11 @@ inline doublereal Frot(doublereal tr, doublereal sqtr)
 //////////////////// class MultiTransport methods //////////////
 
 MultiTransport::MultiTransport(thermo_t* thermo)
-    : GasTransport(thermo)
+    : GasTransport(thermo),
+      m_iter_rtol(0.0),
+      m_iter_max(200),
+      m_series_rtol(0.0),
+      m_series_max(3)
 {
 }
 
@@ -167,6 +171,11 @@ void MultiTransport::solveLMatrixEquation()
     // Solve it using GMRES or LU decomposition. The last solution
     // in m_a should provide a good starting guess, so convergence
     // should be fast.
+    if (m_iter_rtol > 0.0 && solveLMatrixGMRES()) {
+        m_lmatrix_soln_ok = true;
+        m_molefracs_last = m_molefracs;
+        return;
+    }
 
     copy(m_b.begin(), m_b.end(), m_a.begin());
     try {
@@ -182,6 +191,165 @@ void MultiTransport::solveLMatrixEquation()
     m_l0000_ok = false;
 }
 
+void MultiTransport::setIterativeSolver(doublereal rtol, int maxIterations)
+{
+    if (rtol < 0.0 || maxIterations < 1) {
+        throw CanteraError("MultiTransport::setIterativeSolver",
+                           "tolerance must be non-negative and at least one "
+                           "iteration must be allowed");
+    }
+    m_iter_rtol = rtol;
+    m_iter_max = maxIterations;
+    m_lmatrix_soln_ok = false;
+}
+
+void MultiTransport::setMultiDiffSeries(doublereal rtol, size_t maxTerms)
+{
+    if (rtol < 0.0 || maxTerms < 2) {
+        throw CanteraError("MultiTransport::setMultiDiffSeries",
+                           "tolerance must be non-negative and at least two "
+                           "terms must be allowed");
+    }
+    m_series_rtol = rtol;
+    m_series_max = maxTerms;
+}
+
+bool MultiTransport::solveLMatrixGMRES()
+{
+    size_t n = 3*m_nsp;
+    size_t nrestart = std::min<size_t>(n, 50);
+    m_krylov.resize(n, nrestart + 1);
+    m_hess.resize(nrestart + 1, nrestart);
+    m_precon.resize(n);
+    m_gmres_r.resize(n);
+    m_gmres_z.resize(n);
+    m_gmres_g.resize(nrestart + 1);
+    m_gmres_cs.resize(nrestart);
+    m_gmres_sn.resize(nrestart);
+
+    // Jacobi preconditioner. The diagonal of L00,00 is zero, so those
+    // rows are left unscaled.
+    for (size_t i = 0; i < n; i++) {
+        doublereal d = m_Lmatrix(i,i);
+        m_precon[i] = (d != 0.0) ? 1.0/d : 1.0;
+    }
+
+    doublereal bnorm = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        bnorm += m_b[i]*m_b[i];
+    }
+    bnorm = sqrt(bnorm);
+    if (bnorm == 0.0) {
+        fill(m_a.begin(), m_a.end(), 0.0);
+        return true;
+    }
+    doublereal tol = m_iter_rtol * bnorm;
+
+    int iter = 0;
+    while (true) {
+        // residual of the current estimate, r = b - L a
+        m_Lmatrix.mult(DATA_PTR(m_a), DATA_PTR(m_gmres_r));
+        doublereal beta = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            m_gmres_r[i] = m_b[i] - m_gmres_r[i];
+            beta += m_gmres_r[i]*m_gmres_r[i];
+        }
+        beta = sqrt(beta);
+        if (beta <= tol) {
+            return true;
+        }
+        if (iter >= m_iter_max) {
+            return false;
+        }
+
+        doublereal* v = m_krylov.ptrColumn(0);
+        for (size_t i = 0; i < n; i++) {
+            v[i] = m_gmres_r[i] / beta;
+        }
+        fill(m_gmres_g.begin(), m_gmres_g.end(), 0.0);
+        m_gmres_g[0] = beta;
+
+        // Arnoldi process with modified Gram-Schmidt orthogonalization. The
+        // Hessenberg matrix is reduced to upper triangular form with Givens
+        // rotations as it is built.
+        size_t m = 0;
+        while (m < nrestart && iter < m_iter_max) {
+            v = m_krylov.ptrColumn(m);
+            for (size_t i = 0; i < n; i++) {
+                m_gmres_z[i] = m_precon[i] * v[i];
+            }
+            doublereal* w = m_krylov.ptrColumn(m+1);
+            m_Lmatrix.mult(DATA_PTR(m_gmres_z), w);
+            for (size_t k = 0; k <= m; k++) {
+                const doublereal* vk = m_krylov.ptrColumn(k);
+                doublereal h = 0.0;
+                for (size_t i = 0; i < n; i++) {
+                    h += w[i]*vk[i];
+                }
+                for (size_t i = 0; i < n; i++) {
+                    w[i] -= h*vk[i];
+                }
+                m_hess(k,m) = h;
+            }
+            doublereal h = 0.0;
+            for (size_t i = 0; i < n; i++) {
+                h += w[i]*w[i];
+            }
+            h = sqrt(h);
+            m_hess(m+1,m) = h;
+            if (h != 0.0) {
+                for (size_t i = 0; i < n; i++) {
+                    w[i] /= h;
+                }
+            }
+
+            for (size_t k = 0; k < m; k++) {
+                doublereal t = m_gmres_cs[k]*m_hess(k,m) + m_gmres_sn[k]*m_hess(k+1,m);
+                m_hess(k+1,m) = -m_gmres_sn[k]*m_hess(k,m) + m_gmres_cs[k]*m_hess(k+1,m);
+                m_hess(k,m) = t;
+            }
+            doublereal d = sqrt(m_hess(m,m)*m_hess(m,m) + h*h);
+            if (d == 0.0) {
+                break;
+            }
+            m_gmres_cs[m] = m_hess(m,m) / d;
+            m_gmres_sn[m] = h / d;
+            m_hess(m,m) = d;
+            m_hess(m+1,m) = 0.0;
+            m_gmres_g[m+1] = -m_gmres_sn[m]*m_gmres_g[m];
+            m_gmres_g[m] *= m_gmres_cs[m];
+            m++;
+            iter++;
+            if (fabs(m_gmres_g[m]) <= tol || h == 0.0) {
+                break;
+            }
+        }
+
+        // Back substitution for the Krylov coefficients (stored in place
+        // in m_gmres_g), then update the solution a += P V y.
+        for (size_t k = m; k-- > 0;) {
+            doublereal sum = m_gmres_g[k];
+            for (size_t l = k + 1; l < m; l++) {
+                sum -= m_hess(k,l)*m_gmres_g[l];
+            }
+            m_gmres_g[k] = sum / m_hess(k,k);
+        }
+        fill(m_gmres_z.begin(), m_gmres_z.end(), 0.0);
+        for (size_t k = 0; k < m; k++) {
+            const doublereal* vk = m_krylov.ptrColumn(k);
+            for (size_t i = 0; i < n; i++) {
+                m_gmres_z[i] += m_gmres_g[k]*vk[i];
+            }
+        }
+        for (size_t i = 0; i < n; i++) {
+            m_a[i] += m_precon[i]*m_gmres_z[i];
+        }
+        if (m == 0) {
+            return false;
+        }
+    }
+}
+
 void MultiTransport::getSpeciesFluxes(size_t ndim, const doublereal* const grad_T,
                                       size_t ldx, const doublereal* const grad_X,
                                       size_t ldf, doublereal* const fluxes)
@@ -404,6 +572,10 @@ void MultiTransport::getMultiDiffCoeffs(const size_t ld, doublereal* const d)
     update_T();
     updateThermal_T();
 
+    if (m_series_rtol > 0.0 && multiDiffSeries(ld, d)) {
+        return;
+    }
+
     // evaluate L0000 if the temperature or concentrations have
     // changed since it was last evaluated.
     if (!m_l0000_ok) {
@@ -432,6 +604,126 @@ void MultiTransport::getMultiDiffCoeffs(const size_t ld, doublereal* const d)
     }
 }
 
+bool MultiTransport::multiDiffSeries(size_t ld, doublereal* d)
+{
+    // The flux diffusion matrix D is the generalized inverse of the
+    // Stefan-Maxwell matrix Delta, with Delta(k,l) = -x_k x_l / D_kl for
+    // k != l and zero row sums. Splitting Delta = M - Z with the diagonal
+    // M(k,k) = Delta(k,k) / (1 - y_k) gives the convergent series
+    //
+    //     D = sum_n (P M^-1 Z)^n P M^-1 P^T,   P = I - u y^T,
+    //
+    // where u is a vector of ones. Binary diffusion coefficients are used
+    // at unit pressure; the pressure is divided out at the end.
+    size_t nsp = m_nsp;
+    m_zmat.resize(nsp, nsp);
+    m_sterm.resize(nsp, nsp);
+    m_sprod.resize(nsp, nsp);
+    m_dflux.resize(nsp, nsp);
+    m_swork.resize(3*nsp);
+    const doublereal* x = DATA_PTR(m_molefracs);
+    doublereal* y = DATA_PTR(m_swork);
+    doublereal* a = y + nsp; // diagonal of M^-1
+    doublereal* ay = a + nsp;
+
+    doublereal sum = 0.0;
+    for (size_t k = 0; k < nsp; k++) {
+        y[k] = x[k] * m_mw[k];
+        sum += y[k];
+    }
+    doublereal s = 0.0;
+    for (size_t k = 0; k < nsp; k++) {
+        y[k] /= sum;
+        doublereal diag = 0.0;
+        for (size_t l = 0; l < nsp; l++) {
+            if (l != k) {
+                m_zmat(k,l) = x[k] * x[l] / m_bdiff(k,l);
+                diag += m_zmat(k,l);
+            }
+        }
+        a[k] = std::max(1.0 - y[k], Tiny) / diag;
+        m_zmat(k,k) = 1.0/a[k] - diag;
+        ay[k] = a[k] * y[k];
+        s += ay[k] * y[k];
+    }
+
+    // The first term is diagonal plus rank two, so its product with Z
+    // costs O(K^2) operations.
+    doublereal dmax = 0.0;
+    for (size_t l = 0; l < nsp; l++) {
+        for (size_t k = 0; k < nsp; k++) {
+            m_dflux(k,l) = s - ay[k] - ay[l];
+        }
+        m_dflux(l,l) += a[l];
+        for (size_t k = 0; k < nsp; k++) {
+            dmax = std::max(dmax, x[k] * fabs(m_dflux(k,l)));
+        }
+    }
+    for (size_t k = 0; k < nsp; k++) {
+        sum = 0.0;
+        for (size_t l = 0; l < nsp; l++) {
+            sum += m_zmat(k,l) * ay[l];
+        }
+        // Z u is the diagonal of M, since the rows of Delta sum to zero
+        doublereal zu = 1.0/a[k];
+        for (size_t l = 0; l < nsp; l++) {
+            m_sprod(k,l) = m_zmat(k,l) * a[l] - zu * ay[l] - sum + s * zu;
+        }
+    }
+
+    for (size_t n = 1; ; n++) {
+        // next term = P M^-1 (Z times the previous term)
+        doublereal tmax = 0.0;
+        dmax = 0.0;
+        for (size_t l = 0; l < nsp; l++) {
+            doublereal* t = m_sterm.ptrColumn(l);
+            const doublereal* w = m_sprod.ptrColumn(l);
+            doublereal* dl = m_dflux.ptrColumn(l);
+            sum = 0.0;
+            for (size_t k = 0; k < nsp; k++) {
+                t[k] = a[k] * w[k];
+                sum += y[k] * t[k];
+            }
+            for (size_t k = 0; k < nsp; k++) {
+                t[k] -= sum;
+                dl[k] += t[k];
+                tmax = std::max(tmax, x[k] * fabs(t[k]));
+                dmax = std::max(dmax, x[k] * fabs(dl[k]));
+            }
+        }
+        // Rows for trace species scale as 1/x_k, so the size of each term
+        // is measured relative to the mole fractions, as in the final
+        // coefficients.
+        if (tmax <= m_series_rtol * dmax) {
+            break;
+        } else if (n + 1 >= m_series_max) {
+            return false;
+        }
+        for (size_t l = 0; l < nsp; l++) {
+            doublereal* w = m_sprod.ptrColumn(l);
+            const doublereal* t = m_sterm.ptrColumn(l);
+            std::fill(w, w + nsp, 0.0);
+            for (size_t m = 0; m < nsp; m++) {
+                const doublereal* z = m_zmat.ptrColumn(m);
+                for (size_t k = 0; k < nsp; k++) {
+                    w[k] += z[k] * t[m];
+                }
+            }
+        }
+    }
+
+    // Convert to the ordinary multicomponent diffusion coefficients, which
+    // are defined to vanish on the diagonal.
+    doublereal prefactor = m_thermo->meanMolecularWeight() / pressure_ig();
+    for (size_t j = 0; j < nsp; j++) {
+        doublereal c = prefactor / m_mw[j];
+        for (size_t i = 0; i < nsp; i++) {
+            d[ld*j + i] = c * x[i] * (m_dflux(i,i) - m_dflux(i,j));
+        }
+    }
+    return true;
+}
+
 void MultiTransport::update_T()
 {
     if (m_temp == m_thermo->temperature()) {
@@ -442,6 +734,7 @@ void MultiTransport::update_T()
 
     // temperature has changed, so polynomial fits will need to be
     // redone, and the L matrix reevaluated.
+    m_thermal_tlast = 0.0;
     m_abc_ok  = false;
     m_lmatrix_soln_ok = false;
     m_l0000_ok = false;
@@ -449,6 +742,11 @@ void MultiTransport::update_T()
 
 void MultiTransport::update_C()
 {
+    if (m_thermo->stateMFNumber() == m_stateMF) {
+        return;
+    }
+    m_stateMF = m_thermo->stateMFNumber();
+
     // Update the local mole fraction array
     m_thermo->getMoleFractions(DATA_PTR(m_molefracs));
 
@@ -469,9 +767,15 @@ void MultiTransport::updateThermal_T()
     if (m_thermal_tlast == m_thermo->temperature()) {
         return;
     }
-    // we need species viscosities and binary diffusion coefficients
-    updateSpeciesViscosities();
-    updateDiff_T();
+    // we need species viscosities and binary diffusion coefficients. Fits
+    // which were already evaluated at this temperature are not redone.
+    update_T();
+    if (!m_spvisc_ok) {
+        updateSpeciesViscosities();
+    }
+    if (!m_bindiff_ok) {
+        updateDiff_T();
+    }
 
     // evaluate polynomial fits for A*, B*, C*
     doublereal z;
@@ -75,6 +75,25 @@ void Transport::setParameters(const int type, const int k,
     throw NotImplementedError("Transport::setParameters");
 }
 
+void Transport::getTransportProperties(size_t npoints, const doublereal* T,
+                                       const doublereal* P,
+                                       const doublereal* X, doublereal* visc,
+                                       doublereal* cond, doublereal* dmix)
+{
+    for (size_t j = 0; j < npoints; j++) {
+        m_thermo->setState_TPX(T[j], P[j], X + j*m_nsp);
+        if (visc) {
+            visc[j] = viscosity();
+        }
+        if (cond) {
+            cond[j] = thermalConductivity();
+        }
+        if (dmix) {
+            getMixDiffCoeffs(dmix + j*m_nsp);
+        }
+    }
+}
+
 void Transport::setThermo(thermo_t& thermo)
 {
     if (!ready()) {
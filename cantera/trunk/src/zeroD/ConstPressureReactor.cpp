@@ -121,6 +121,12 @@ void ConstPressureReactor::evalEqs(doublereal time, doublereal* y,
     resetSensitivity(params);
 }
 
+void ConstPressureReactor::getProductionAdjoint(const double* lambda,
+                                                double* lamw, double* lams)
+{
+    getSpeciesProductionAdjoint(lambda, 2, lamw, lams);
+}
+
 size_t ConstPressureReactor::componentIndex(const string& nm) const
 {
     size_t k = speciesIndex(nm);
@@ -133,6 +133,97 @@ void IdealGasConstPressureReactor::evalEqs(doublereal time, doublereal* y,
     resetSensitivity(params);
 }
 
+void IdealGasConstPressureReactor::evalJacobianAdjoint(double t,
+        const double* lambda, double* jtl, double* params)
+{
+    m_thermo->restoreState(m_state);
+    double T = m_thermo->temperature();
+    double cp = m_thermo->cp_mass();
+
+    // temperature derivative of the heat capacity, by central differences
+    double dT = 1.0e-6 * T;
+    m_thermo->setTemperature(T + dT);
+    double dcpdT = m_thermo->cp_mass();
+    m_thermo->setTemperature(T - dT);
+    dcpdT = (dcpdT - m_thermo->cp_mass()) / (2.0 * dT);
+    m_thermo->restoreState(m_state);
+
+    applySensitivity(params);
+    evalWalls(t);
+    const vector_fp& mw = m_thermo->molecularWeights();
+    double rho = m_thermo->density();
+    double mmw = m_thermo->meanMolecularWeight();
+    vector_fp cpk(m_nsp);
+    m_thermo->getPartialMolarEnthalpies(&m_hk[0]);
+    m_thermo->getPartialMolarCp(&cpk[0]);
+    if (m_chem) {
+        m_kin->getNetProductionRates(&m_wdot[0]);
+    } else {
+        fill(m_wdot.begin(), m_wdot.end(), 0.0);
+    }
+    vector_fp lamw(m_nsp), lams(m_nsp);
+    getProductionAdjoint(lambda, &lamw[0], &lams[0]);
+    fill(jtl, jtl + m_nv, 0.0);
+
+    // species equations, dY_k/dt = wdot_k * M_k / rho, where 1/rho is
+    // proportional to T * sum(Y_k / M_k)
+    double lf = 0.0;
+    for (size_t k = 0; k < m_nsp; k++) {
+        lf += lambda[k+2] * m_wdot[k] * mw[k] / rho;
+    }
+    jtl[1] += lf / T;
+    for (size_t k = 0; k < m_nsp; k++) {
+        jtl[k+2] += lf * mmw / mw[k];
+    }
+
+    // energy equation, dT/dt = (-Q - V sum(h_k wdot_k)) / (m c_p)
+    if (m_energy) {
+        double mcp = m_mass * cp;
+        double lT = lambda[1] / mcp;
+        double wh = 0.0;
+        double wcp = 0.0;
+        for (size_t k = 0; k < m_nsp; k++) {
+            wh += m_wdot[k] * m_hk[k];
+            wcp += m_wdot[k] * cpk[k];
+        }
+        double dTdt = (- m_Q - m_vol * wh) / mcp;
+        jtl[0] -= lT * (wh / rho + dTdt * cp);
+        jtl[1] -= lT * (m_vol * wh / T + m_vol * wcp +
+                        dTdt * m_mass * dcpdT);
+        for (size_t k = 0; k < m_nsp; k++) {
+            jtl[k+2] -= lT * (m_vol * wh * mmw + dTdt * m_mass * cpk[k]) /
+                        mw[k];
+        }
+    }
+
+    // dependence of the production rates on T and rho
+    if (m_chem) {
+        vector_fp dTdy(m_nv, 0.0), drhody(m_nv, 0.0);
+        dTdy[1] = 1.0;
+        drhody[1] = - rho / T;
+        for (size_t k = 0; k < m_nsp; k++) {
+            drhody[k+2] = - rho * mmw / mw[k];
+        }
+        addProductionRateAdjoint(&lamw[0], &dTdy[0], &drhody[0], 2, jtl);
+    }
+    resetSensitivity(params);
+}
+
+void IdealGasConstPressureReactor::getProductionAdjoint(const double* lambda,
+        double* lamw, double* lams)
+{
+    ConstPressureReactor::getProductionAdjoint(lambda, lamw, lams);
+    if (m_energy) {
+        // heat release from gas phase and surface reactions
+        m_thermo->getPartialMolarEnthalpies(&m_hk[0]);
+        double lT = lambda[1] / (m_mass * m_thermo->cp_mass());
+        for (size_t k = 0; k < m_nsp; k++) {
+            lamw[k] -= lT * m_hk[k] * m_vol;
+            lams[k] -= lT * m_hk[k];
+        }
+    }
+}
+
 size_t IdealGasConstPressureReactor::componentIndex(const string& nm) const
 {
     size_t k = speciesIndex(nm);
@@ -150,6 +150,95 @@ void IdealGasReactor::evalEqs(doublereal time, doublereal* y,
     resetSensitivity(params);
 }
 
+void IdealGasReactor::evalJacobianAdjoint(double t, const double* lambda,
+                                          double* jtl, double* params)
+{
+    m_thermo->restoreState(m_state);
+    double T = m_thermo->temperature();
+    double cv = m_thermo->cv_mass();
+
+    // temperature derivative of the heat capacity, by central differences
+    double dT = 1.0e-6 * T;
+    m_thermo->setTemperature(T + dT);
+    double dcvdT = m_thermo->cv_mass();
+    m_thermo->setTemperature(T - dT);
+    dcvdT = (dcvdT - m_thermo->cv_mass()) / (2.0 * dT);
+    m_thermo->restoreState(m_state);
+
+    applySensitivity(params);
+    evalWalls(t);
+    const vector_fp& mw = m_thermo->molecularWeights();
+    double rho = m_thermo->density();
+    double P = m_thermo->pressure();
+    vector_fp cvk(m_nsp);
+    m_thermo->getPartialMolarIntEnergies(&m_uk[0]);
+    m_thermo->getPartialMolarCp(&cvk[0]);
+    for (size_t k = 0; k < m_nsp; k++) {
+        cvk[k] -= GasConstant;
+    }
+    if (m_chem) {
+        m_kin->getNetProductionRates(&m_wdot[0]);
+    } else {
+        fill(m_wdot.begin(), m_wdot.end(), 0.0);
+    }
+    vector_fp lamw(m_nsp), lams(m_nsp);
+    getProductionAdjoint(lambda, &lamw[0], &lams[0]);
+    fill(jtl, jtl + m_nv, 0.0);
+
+    // species equations, dY_k/dt = wdot_k * V * M_k / m
+    double lf = 0.0;
+    for (size_t k = 0; k < m_nsp; k++) {
+        lf += lambda[k+3] * m_wdot[k] * m_vol * mw[k] / m_mass;
+    }
+    jtl[0] -= lf / m_mass;
+    jtl[1] += lf / m_vol;
+
+    // energy equation, dT/dt = (-P dV/dt - Q - V sum(u_k wdot_k)) / (m c_v)
+    if (m_energy) {
+        double mcv = m_mass * cv;
+        double lT = lambda[2] / mcv;
+        double wu = 0.0;
+        double wcv = 0.0;
+        for (size_t k = 0; k < m_nsp; k++) {
+            wu += m_wdot[k] * m_uk[k];
+            wcv += m_wdot[k] * cvk[k];
+        }
+        double dTdt = (- P * m_vdot - m_Q - m_vol * wu) / mcv;
+        jtl[0] -= lT * (m_vdot * P / m_mass + dTdt * cv);
+        jtl[1] += lT * (m_vdot * P / m_vol - wu);
+        jtl[2] -= lT * (m_vdot * P / T + m_vol * wcv + dTdt * m_mass * dcvdT);
+        for (size_t k = 0; k < m_nsp; k++) {
+            jtl[k+3] -= lT * (m_vdot * rho * GasConstant * T +
+                              dTdt * m_mass * cvk[k]) / mw[k];
+        }
+    }
+
+    // dependence of the production rates on T and rho
+    if (m_chem) {
+        vector_fp dTdy(m_nv, 0.0), drhody(m_nv, 0.0);
+        dTdy[2] = 1.0;
+        drhody[0] = 1.0 / m_vol;
+        drhody[1] = - rho / m_vol;
+        addProductionRateAdjoint(&lamw[0], &dTdy[0], &drhody[0], 3, jtl);
+    }
+    resetSensitivity(params);
+}
+
+void IdealGasReactor::getProductionAdjoint(const double* lambda, double* lamw,
+                                           double* lams)
+{
+    Reactor::getProductionAdjoint(lambda, lamw, lams);
+    if (m_energy) {
+        // heat release from gas phase and surface reactions
+        m_thermo->getPartialMolarIntEnergies(&m_uk[0]);
+        double lT = lambda[2] / (m_mass * m_thermo->cv_mass());
+        for (size_t k = 0; k < m_nsp; k++) {
+            lamw[k] -= lT * m_uk[k] * m_vol;
+            lams[k] -= lT * m_uk[k];
+        }
+    }
+}
+
 size_t IdealGasReactor::componentIndex(const string& nm) const
 {
     size_t k = speciesIndex(nm);
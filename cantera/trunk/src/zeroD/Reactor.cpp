@@ -431,4 +431,141 @@ void Reactor::resetSensitivity(double* params)
     }
 }
 
+bool Reactor::isolated() const
+{
+    if (!m_inlet.empty() || !m_outlet.empty()) {
+        return false;
+    }
+    for (size_t m = 0; m < m_wall.size(); m++) {
+        Wall& w = *m_wall[m];
+        if (w.surface(m_lr[m]) || w.getExpansionRateCoeff() != 0.0 ||
+                w.getHeatTransferCoeff() != 0.0 || w.getEmissivity() != 0.0) {
+            return false;
+        }
+    }
+    return !m_chem || m_kin->type() == cGasKinetics;
+}
+
+void Reactor::evalJacobianAdjoint(double t, const double* lambda,
+                                  double* jtl, double* params)
+{
+    throw NotImplementedError("Reactor::evalJacobianAdjoint");
+}
+
+void Reactor::getProductionAdjoint(const double* lambda, double* lamw,
+                                   double* lams)
+{
+    getSpeciesProductionAdjoint(lambda, 3, lamw, lams);
+}
+
+void Reactor::getSpeciesProductionAdjoint(const double* lambda, size_t offset,
+                                          double* lamw, double* lams)
+{
+    const vector_fp& mw = m_thermo->molecularWeights();
+    const doublereal* Y = m_thermo->massFractions();
+
+    // The net mass flux from the surfaces adds to the total mass and dilutes
+    // all of the species
+    double lmdot = lambda[0];
+    for (size_t k = 0; k < m_nsp; k++) {
+        lmdot -= lambda[offset + k] * Y[k] / m_mass;
+    }
+    for (size_t k = 0; k < m_nsp; k++) {
+        lamw[k] = lambda[offset + k] * m_vol * mw[k] / m_mass;
+        lams[k] = lambda[offset + k] * mw[k] / m_mass + lmdot * mw[k];
+    }
+}
+
+void Reactor::addProductionRateAdjoint(const double* lamw, const double* dTdy,
+                                       const double* drhody, size_t offset,
+                                       double* jtl)
+{
+    const vector_fp& mw = m_thermo->molecularWeights();
+    const doublereal* Y = m_thermo->massFractions();
+    double rho = m_thermo->density();
+
+    // lamw^T (dwdot/dC) and lamw^T (dwdot/dT)
+    m_kin->getNetProductionRates_ddC(m_dwdot);
+    vector_fp b(m_nsp);
+    m_dwdot.multTranspose(lamw, &b[0]);
+    vector_fp dwdT(m_nsp);
+    m_kin->getNetProductionRates_ddT(&dwdT[0]);
+    double bT = 0.0;
+    double brho = 0.0;
+    for (size_t k = 0; k < m_nsp; k++) {
+        bT += lamw[k] * dwdT[k];
+        brho += b[k] * Y[k] / mw[k];
+    }
+
+    // chain rule with C_k = rho * Y_k / M_k
+    for (size_t i = 0; i < m_nv; i++) {
+        jtl[i] += bT * dTdy[i] + brho * drhody[i];
+    }
+    for (size_t k = 0; k < m_nsp; k++) {
+        jtl[offset + k] += b[k] * rho / mw[k];
+    }
+}
+
+void Reactor::evalParamAdjoint(double t, const double* lambda, double* q)
+{
+    m_thermo->restoreState(m_state);
+    vector_fp lamw(m_nsp), lams(m_nsp);
+    getProductionAdjoint(lambda, &lamw[0], &lams[0]);
+
+    // gas phase reactions
+    size_t npar = m_pnum.size();
+    if (npar) {
+        vector_fp rop(m_kin->nReactions()), dlam(m_kin->nReactions());
+        m_kin->getNetRatesOfProgress(&rop[0]);
+        m_kin->getReactionDelta(&lamw[0], &dlam[0]);
+        for (size_t n = 0; n < npar; n++) {
+            q[n] = m_chem ? dlam[m_pnum[n]] * rop[m_pnum[n]] : 0.0;
+        }
+    }
+
+    // surface reactions, with the surface species coverages at the end of
+    // the state vector
+    size_t loc = m_nv;
+    for (size_t m = 0; m < m_wall.size(); m++) {
+        if (m_wall[m]->surface(m_lr[m])) {
+            loc -= m_wall[m]->surface(m_lr[m])->nSpecies();
+        }
+    }
+    size_t ploc = npar;
+    for (size_t m = 0; m < m_wall.size(); m++) {
+        Kinetics* kin = m_wall[m]->kinetics(m_lr[m]);
+        SurfPhase* surf = m_wall[m]->surface(m_lr[m]);
+        if (!surf || !kin) {
+            continue;
+        }
+        size_t nk = surf->nSpecies();
+        if (m_nsens_wall[m]) {
+            surf->setTemperature(m_state[0]);
+            m_wall[m]->syncCoverages(m_lr[m]);
+            vector_fp lamk(kin->nTotalSpecies(), 0.0);
+            double wallarea = m_wall[m]->area();
+            for (size_t k = 0; k < m_nsp; k++) {
+                lamk[k] = lams[k] * wallarea;
+            }
+            double rs0 = 1.0/surf->siteDensity();
+            size_t surfloc = kin->kineticsSpeciesIndex(0,
+                             kin->surfacePhaseIndex());
+            for (size_t k = 1; k < nk; k++) {
+                lamk[surfloc + k] = (lambda[loc + k] - lambda[loc]) * rs0 *
+                                    surf->size(k);
+            }
+            vector_fp rop(kin->nReactions()), dlam(kin->nReactions());
+            kin->getNetRatesOfProgress(&rop[0]);
+            kin->getReactionDelta(&lamk[0], &dlam[0]);
+            const std::vector<size_t>& rxns =
+                m_wall[m]->sensitivityReactions(m_lr[m]);
+            for (size_t n = 0; n < rxns.size(); n++) {
+                q[ploc + n] = dlam[rxns[n]] * rop[rxns[n]];
+            }
+            ploc += m_nsens_wall[m];
+        }
+        loc += nk;
+    }
+}
+
 }
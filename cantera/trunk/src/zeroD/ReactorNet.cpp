@@ -15,7 +15,7 @@ ReactorNet::ReactorNet() :
     m_nv(0), m_rtol(1.0e-9), m_rtolsens(1.0e-4),
     m_atols(1.0e-15), m_atolsens(1.0e-4),
     m_maxstep(-1.0), m_maxErrTestFails(0),
-    m_verbose(false), m_ntotpar(0)
+    m_verbose(false), m_ntotpar(0), m_adjoint(false), m_adjointSteps(100)
 {
     m_integ = newIntegrator("CVODE");
 
@@ -88,6 +88,7 @@ void ReactorNet::initialize()
     m_integ->setSensitivityTolerances(m_rtolsens, m_atolsens);
     m_integ->setMaxStepSize(m_maxstep);
     m_integ->setMaxErrTestFails(m_maxErrTestFails);
+    m_integ->setAdjoint(m_adjoint, m_adjointSteps);
     if (m_verbose) {
         sprintf(buf, "Number of equations: %s\n", int2str(neq()).c_str());
         writelog(buf);
@@ -207,6 +208,78 @@ void ReactorNet::evalJacobian(doublereal t, doublereal* y,
     }
 }
 
+void ReactorNet::evalAdjoint(double t, double* y, const double* lambda,
+                             double* lambdadot, double* p)
+{
+    for (size_t n = 0; n < m_reactors.size(); n++) {
+        if (!m_reactors[n]->analyticJacobianAdjoint()) {
+            FuncEval::evalAdjoint(t, y, lambda, lambdadot, p);
+            return;
+        }
+    }
+
+    size_t pstart = 0;
+    updateState(y);
+    for (size_t n = 0; n < m_reactors.size(); n++) {
+        m_reactors[n]->evalJacobianAdjoint(t, lambda + m_start[n],
+                                           lambdadot + m_start[n], p + pstart);
+        pstart += m_nparams[n];
+    }
+    for (size_t i = 0; i < m_nv; i++) {
+        lambdadot[i] = - lambdadot[i];
+    }
+}
+
+void ReactorNet::evalAdjointQuadrature(double t, double* y,
+                                       const double* lambda, double* qdot,
+                                       double* p)
+{
+    if (m_reactors[0]->type() == FlowReactorType) {
+        FuncEval::evalAdjointQuadrature(t, y, lambda, qdot, p);
+        return;
+    }
+
+    size_t pstart = 0;
+    updateState(y);
+    for (size_t n = 0; n < m_reactors.size(); n++) {
+        m_reactors[n]->evalParamAdjoint(t, lambda + m_start[n], qdot + pstart);
+        pstart += m_nparams[n];
+    }
+}
+
+void ReactorNet::getAdjointSensitivities(const double* dgdy, double* dgdp)
+{
+    if (!m_init) {
+        initialize();
+    }
+    if (!m_adjoint) {
+        throw CanteraError("ReactorNet::getAdjointSensitivities",
+                           "Adjoint sensitivity analysis is not enabled.");
+    }
+    vector_fp lambda(dgdy, dgdy + m_nv);
+    vector_fp q(m_ntotpar);
+    m_integ->integrateAdjoint(DATA_PTR(lambda), DATA_PTR(q));
+    for (size_t p = 0; p < m_ntotpar; p++) {
+        dgdp[p] = q[m_sensIndex[p]];
+    }
+    // the reactors were left in the states used by the backward integration
+    updateState(m_integ->solution());
+}
+
+void ReactorNet::getAdjointSensitivities(size_t k, double* sens)
+{
+    if (!m_init) {
+        initialize();
+    }
+    vector_fp dgdy(m_nv, 0.0);
+    dgdy[k] = 1.0;
+    getAdjointSensitivities(DATA_PTR(dgdy), sens);
+    double y = m_integ->solution(k);
+    for (size_t p = 0; p < m_ntotpar; p++) {
+        sens[p] /= y;
+    }
+}
+
 void ReactorNet::updateState(doublereal* y)
 {
     for (size_t n = 0; n < m_reactors.size(); n++) {
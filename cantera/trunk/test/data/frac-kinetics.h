@@ -0,0 +1,51 @@
+// Kinetics functions for a mechanism with 6 species and 3 reactions.
+// Generated by Cantera::GasKinetics::writeSource.
+
+#include <cmath>
+#include <cstddef>
+
+namespace frac
+{
+
+using std::exp;
+using std::pow;
+
+// Concentrations raised to non-integer reaction orders are taken to
+// be zero for non-positive concentrations
+inline double ppow(double x, double order)
+{
+    return (x > 0.0) ? pow(x, order) : 0.0;
+}
+
+const size_t nSpecies = 6;
+const size_t nReactions = 3;
+
+void updateArrheniusRates(double T, double* kf)
+{
+    kf[0] = 10000000000000;
+    kf[1] = 39810.720000000001;
+    kf[2] = 3.9810720000000002;
+}
+
+void multiplyReactants(const double* c, double* r)
+{
+    r[0] *= c[5];
+    r[1] *= ppow(c[0], 0.80000000000000004) * ppow(c[3], 1) * ppow(c[4], 2);
+    r[2] *= ppow(c[0], 1) * ppow(c[3], -0.25);
+}
+
+void multiplyRevProducts(const double* c, double* r)
+{
+}
+
+void getNetProductionRates(const double* ropnet, double* wdot)
+{
+    wdot[0] = - 0.69999999999999996*ropnet[1] - 1*ropnet[2];
+    wdot[1] = + 1.3999999999999999*ropnet[0];
+    wdot[2] = 0.0;
+    wdot[3] = + 0.20000000000000001*ropnet[0] - 0.20000000000000001*ropnet[1] - 0.5*ropnet[2];
+    wdot[4] = + 0.59999999999999998*ropnet[0] - 0.59999999999999998*ropnet[1];
+    wdot[5] = + ropnet[1] + ropnet[2] - ropnet[0];
+}
+
+} // namespace frac
@@ -0,0 +1,80 @@
+#include "gtest/gtest.h"
+#include "cantera/base/xml.h"
+#include "cantera/base/global.h"
+#include "cantera/base/ctexceptions.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace Cantera
+{
+
+//! Path for a temporary file named `name`, in the system's temporary
+//! directory
+std::string tempPath(const std::string& name)
+{
+    const char* vars[] = {"TMPDIR", "TEMP", "TMP"};
+    for (size_t i = 0; i < 3; i++) {
+        const char* dir = getenv(vars[i]);
+        if (dir && *dir) {
+            return std::string(dir) + "/" + name;
+        }
+    }
+#ifdef _WIN32
+    return "./" + name;
+#else
+    return "/tmp/" + name;
+#endif
+}
+
+TEST(XML_Node, binary_round_trip)
+{
+    XML_Node* src = get_XML_File("../data/air-no-reactions.xml");
+    std::stringstream bin;
+    src->writeBinary(bin);
+
+    XML_Node dest("doc");
+    dest.buildBinary(bin);
+    std::stringstream text1, text2;
+    src->write(text1);
+    dest.write(text2);
+    EXPECT_EQ(text1.str(), text2.str());
+
+    XML_Node* phase = dest.findID("air");
+    ASSERT_TRUE(phase != 0);
+    EXPECT_EQ("phase", phase->name());
+}
+
+TEST(XML_Node, binary_file)
+{
+    XML_Node* src = get_XML_File("../data/air-no-reactions.xml");
+    std::string path = tempPath("cantera-test-air-no-reactions.ctb");
+    {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        ASSERT_TRUE(out.good());
+        src->writeBinary(out);
+    }
+    XML_Node* dest = get_XML_File(path);
+    std::stringstream text1, text2;
+    src->write(text1);
+    dest->write(text2);
+    EXPECT_EQ(text1.str(), text2.str());
+    EXPECT_EQ(0, std::remove(path.c_str()));
+}
+
+TEST(XML_Node, binary_invalid)
+{
+    XML_Node dest("doc");
+    std::stringstream bin("<ctml></ctml>");
+    EXPECT_THROW(dest.buildBinary(bin), CanteraError);
+
+    std::stringstream truncated;
+    get_XML_File("../data/air-no-reactions.xml")->writeBinary(truncated);
+    std::stringstream bin2(truncated.str().substr(0, 100));
+    XML_Node dest2("doc");
+    EXPECT_THROW(dest2.buildBinary(bin2), CanteraError);
+}
+
+}
@@ -0,0 +1,229 @@
+#include "gtest/gtest.h"
+#include "cantera/kinetics/BinaryMechanism.h"
+#include "cantera/kinetics/importKinetics.h"
+#include "cantera/kinetics/GasKinetics.h"
+#include "cantera/thermo/IdealGasPhase.h"
+#include "cantera/transport/TransportFactory.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace Cantera
+{
+
+//! Path for a temporary file named `name`, in the system's temporary
+//! directory
+static std::string tempPath(const std::string& name)
+{
+    const char* vars[] = {"TMPDIR", "TEMP", "TMP"};
+    for (size_t i = 0; i < 3; i++) {
+        const char* dir = getenv(vars[i]);
+        if (dir && *dir) {
+            return std::string(dir) + "/" + name;
+        }
+    }
+#ifdef _WIN32
+    return "./" + name;
+#else
+    return "/tmp/" + name;
+#endif
+}
+
+class BinaryMechanismTest : public testing::Test
+{
+public:
+    BinaryMechanismTest() : thermo(0), kin(0), tran(0) {}
+
+    ~BinaryMechanismTest() {
+        delete tran;
+        delete kin;
+        delete thermo;
+    }
+
+    //! Write the phase, kinetics and transport managers to a binary file and
+    //! read them back into #thermo, #kin and #tran
+    void roundTrip(const std::string& name, ThermoPhase& ref_thermo,
+                   Kinetics* ref_kin, Transport* ref_tran) {
+        std::string path = tempPath(name);
+        writeBinaryMechanism(path, ref_thermo, ref_kin, ref_tran);
+        readBinaryMechanism(path, thermo, kin, tran);
+        EXPECT_EQ(0, std::remove(path.c_str()));
+    }
+
+    //! Compare the thermo properties and reaction rates at a few states
+    void compareKinetics(ThermoPhase& ref_thermo, Kinetics& ref_kin,
+                         const std::string& X, double rtol) {
+        ASSERT_TRUE(thermo != 0);
+        ASSERT_TRUE(kin != 0);
+        ASSERT_EQ(ref_thermo.nSpecies(), thermo->nSpecies());
+        ASSERT_EQ(ref_kin.nReactions(), kin->nReactions());
+        size_t nsp = thermo->nSpecies();
+        size_t nr = kin->nReactions();
+        for (size_t k = 0; k < nsp; k++) {
+            EXPECT_EQ(ref_thermo.speciesName(k), thermo->speciesName(k));
+            EXPECT_EQ(ref_thermo.molecularWeight(k), thermo->molecularWeight(k));
+        }
+        for (size_t i = 0; i < nr; i++) {
+            EXPECT_EQ(ref_kin.reactionString(i), kin->reactionString(i));
+        }
+
+        double T[] = {400, 1100, 2300};
+        double P[] = {2000, OneAtm, 20*OneAtm};
+        for (size_t n = 0; n < 3; n++) {
+            ref_thermo.setState_TPX(T[n], P[n], X);
+            thermo->setState_TPX(T[n], P[n], X);
+            EXPECT_DOUBLE_EQ(ref_thermo.density(), thermo->density());
+            EXPECT_DOUBLE_EQ(ref_thermo.enthalpy_mass(), thermo->enthalpy_mass());
+            EXPECT_DOUBLE_EQ(ref_thermo.entropy_mass(), thermo->entropy_mass());
+            EXPECT_DOUBLE_EQ(ref_thermo.cp_mass(), thermo->cp_mass());
+
+            vector_fp kf_ref(nr), kf(nr), kr_ref(nr), kr(nr);
+            vector_fp wdot_ref(nsp), wdot(nsp);
+            ref_kin.getFwdRateConstants(&kf_ref[0]);
+            kin->getFwdRateConstants(&kf[0]);
+            ref_kin.getRevRateConstants(&kr_ref[0]);
+            kin->getRevRateConstants(&kr[0]);
+            for (size_t i = 0; i < nr; i++) {
+                EXPECT_NEAR(kf_ref[i], kf[i], rtol * std::abs(kf_ref[i]));
+                EXPECT_NEAR(kr_ref[i], kr[i], rtol * std::abs(kr_ref[i]));
+            }
+            ref_kin.getNetProductionRates(&wdot_ref[0]);
+            kin->getNetProductionRates(&wdot[0]);
+            for (size_t k = 0; k < nsp; k++) {
+                EXPECT_NEAR(wdot_ref[k], wdot[k], rtol * std::abs(wdot_ref[k]) + 1e-300);
+            }
+        }
+    }
+
+    ThermoPhase* thermo;
+    Kinetics* kin;
+    Transport* tran;
+};
+
+TEST_F(BinaryMechanismTest, gri30_mix)
+{
+    XML_Node* root = get_XML_File("gri30.xml");
+    IdealGasPhase ref_thermo;
+    GasKinetics ref_kin;
+    buildSolutionFromXML(*root, "gri30", "phase", &ref_thermo, &ref_kin);
+    Transport* ref_tran = newTransportMgr("Mix", &ref_thermo);
+
+    roundTrip("cantera-test-gri30.ctbin", ref_thermo, &ref_kin, ref_tran);
+    EXPECT_EQ(ref_thermo.id(), thermo->id());
+    EXPECT_EQ(ref_thermo.nElements(), thermo->nElements());
+    EXPECT_DOUBLE_EQ(ref_thermo.temperature(), thermo->temperature());
+    EXPECT_DOUBLE_EQ(ref_thermo.pressure(), thermo->pressure());
+
+    std::string X = "CH4:0.1, O2:0.2, N2:0.6, H2O:0.05, CO:0.02, OH:0.01, "
+                    "H:0.01, CH3:0.005, HO2:0.005";
+    compareKinetics(ref_thermo, ref_kin, X, 1e-14);
+
+    ASSERT_TRUE(tran != 0);
+    EXPECT_EQ(ref_tran->model(), tran->model());
+    size_t nsp = thermo->nSpecies();
+    vector_fp d_ref(nsp), d(nsp);
+    double T[] = {350, 1500, 2800};
+    for (size_t n = 0; n < 3; n++) {
+        ref_thermo.setState_TPX(T[n], OneAtm, X);
+        thermo->setState_TPX(T[n], OneAtm, X);
+        EXPECT_DOUBLE_EQ(ref_tran->viscosity(), tran->viscosity());
+        EXPECT_DOUBLE_EQ(ref_tran->thermalConductivity(),
+                         tran->thermalConductivity());
+        ref_tran->getMixDiffCoeffs(&d_ref[0]);
+        tran->getMixDiffCoeffs(&d[0]);
+        for (size_t k = 0; k < nsp; k++) {
+            EXPECT_DOUBLE_EQ(d_ref[k], d[k]);
+        }
+    }
+    delete ref_tran;
+}
+
+TEST_F(BinaryMechanismTest, h2o2_multi)
+{
+    XML_Node* root = get_XML_File("h2o2.xml");
+    IdealGasPhase ref_thermo;
+    GasKinetics ref_kin;
+    buildSolutionFromXML(*root, "ohmech", "phase", &ref_thermo, &ref_kin);
+    Transport* ref_tran = newTransportMgr("Multi", &ref_thermo);
+
+    roundTrip("cantera-test-h2o2.ctbin", ref_thermo, &ref_kin, ref_tran);
+    std::string X = "H2:0.3, O2:0.2, AR:0.4, H2O:0.05, OH:0.02, H:0.03";
+    compareKinetics(ref_thermo, ref_kin, X, 1e-14);
+
+    ASSERT_TRUE(tran != 0);
+    EXPECT_EQ(ref_tran->model(), tran->model());
+    size_t nsp = thermo->nSpecies();
+    vector_fp d_ref(nsp*nsp), d(nsp*nsp), dt_ref(nsp), dt(nsp);
+    ref_thermo.setState_TPX(1200, OneAtm, X);
+    thermo->setState_TPX(1200, OneAtm, X);
+    EXPECT_DOUBLE_EQ(ref_tran->thermalConductivity(),
+                     tran->thermalConductivity());
+    ref_tran->getMultiDiffCoeffs(nsp, &d_ref[0]);
+    tran->getMultiDiffCoeffs(nsp, &d[0]);
+    ref_tran->getThermalDiffCoeffs(&dt_ref[0]);
+    tran->getThermalDiffCoeffs(&dt[0]);
+    for (size_t k = 0; k < nsp; k++) {
+        EXPECT_DOUBLE_EQ(dt_ref[k], dt[k]);
+        for (size_t j = 0; j < nsp; j++) {
+            EXPECT_DOUBLE_EQ(d_ref[nsp*j+k], d[nsp*j+k]);
+        }
+    }
+    delete ref_tran;
+}
+
+TEST_F(BinaryMechanismTest, pdep_reactions)
+{
+    // P-log and Chebyshev reactions; P-log rate constants for pressures
+    // with a single rate expression are stored as log(A), so they are
+    // reproduced only to within rounding
+    XML_Node* root = get_XML_File("../data/pdep-test.xml");
+    IdealGasPhase ref_thermo;
+    GasKinetics ref_kin;
+    buildSolutionFromXML(*root, "gas", "phase", &ref_thermo, &ref_kin);
+
+    roundTrip("cantera-test-pdep.ctbin", ref_thermo, &ref_kin, 0);
+    EXPECT_TRUE(tran == 0);
+    compareKinetics(ref_thermo, ref_kin,
+                    "H:1.0, R1A:1.0, R1B:1.0, R2:1.0, R3:1.0, R4:1.0, "
+                    "R5:1.0, R6:1.0", 1e-12);
+}
+
+TEST_F(BinaryMechanismTest, chemically_activated)
+{
+    XML_Node* root = get_XML_File("../data/chemically-activated-reaction.xml");
+    IdealGasPhase ref_thermo;
+    GasKinetics ref_kin;
+    buildSolutionFromXML(*root, "gas", "phase", &ref_thermo, &ref_kin);
+
+    roundTrip("cantera-test-chemact.ctbin", ref_thermo, &ref_kin, 0);
+    compareKinetics(ref_thermo, ref_kin,
+                    "ch3:0.2, oh:0.1, ch2o:0.1, h2:0.3, n2:0.3", 1e-14);
+}
+
+TEST_F(BinaryMechanismTest, invalid_file)
+{
+    EXPECT_THROW(readBinaryMechanism("../data/pdep-test.xml", thermo, kin, tran),
+                 CanteraError);
+    EXPECT_TRUE(thermo == 0);
+
+    // Truncated file
+    IdealGasPhase ref_thermo("../data/air-no-reactions.xml");
+    std::string path = tempPath("cantera-test-truncated.ctbin");
+    writeBinaryMechanism(path, ref_thermo);
+    std::FILE* f = std::fopen(path.c_str(), "r+b");
+    ASSERT_TRUE(f != 0);
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fclose(f);
+    std::string contents(size, '\0');
+    f = std::fopen(path.c_str(), "rb");
+    ASSERT_EQ(size_t(size), std::fread(&contents[0], 1, size, f));
+    std::fclose(f);
+    f = std::fopen(path.c_str(), "wb");
+    std::fwrite(contents.data(), 1, size - 8, f);
+    std::fclose(f);
+    EXPECT_THROW(readBinaryMechanism(path, thermo, kin, tran), CanteraError);
+    EXPECT_EQ(0, std::remove(path.c_str()));
+}
+
+}
@@ -0,0 +1,305 @@
+#include "gtest/gtest.h"
+#include "cantera/kinetics/importKinetics.h"
+#include "cantera/kinetics/GasKinetics.h"
+#include "cantera/kinetics/InterfaceKinetics.h"
+#include "cantera/kinetics/ImplicitSurfChem.h"
+#include "cantera/thermo/IdealGasPhase.h"
+#include "cantera/thermo/SurfPhase.h"
+
+namespace Cantera
+{
+
+class GasJacobianTest : public testing::Test
+{
+public:
+    void setup(const std::string& file, const std::string& id,
+               const std::string& X, double T, double P) {
+        XML_Node* phase_node = get_XML_File(file);
+        buildSolutionFromXML(*phase_node, id, "phase", &thermo, &kin);
+        thermo.setState_TPX(T, P, X);
+        kk = thermo.nSpecies();
+    }
+
+    //! Compare the analytic concentration derivatives to finite differences
+    void check_ddC(double rtol) {
+        SparseMatrix jac;
+        kin.getNetProductionRates_ddC(jac);
+        ASSERT_EQ(kk, jac.nRows());
+        ASSERT_EQ(kk, jac.nColumns());
+
+        vector_fp conc(kk), conc1(kk), wdot0(kk), wdot1(kk);
+        thermo.getConcentrations(&conc[0]);
+        kin.getNetProductionRates(&wdot0[0]);
+        double ctot = thermo.molarDensity();
+        double scale = 0.0;
+        for (size_t k = 0; k < kk; k++) {
+            scale = std::max(scale, std::abs(wdot0[k]));
+        }
+
+        // Central differences where possible, to keep the truncation error
+        // well below the tolerance for species that appear with second order.
+        // Concentrations can't be made negative, so use a one-sided difference
+        // for species which are absent.
+        for (size_t j = 0; j < kk; j++) {
+            double dc = 1e-5 * (conc[j] + 1e-3 * ctot);
+            conc1 = conc;
+            conc1[j] = std::max(conc[j] - dc, 0.0);
+            double c0 = conc1[j];
+            thermo.setConcentrations(&conc1[0]);
+            kin.getNetProductionRates(&wdot0[0]);
+            conc1[j] = conc[j] + dc;
+            thermo.setConcentrations(&conc1[0]);
+            kin.getNetProductionRates(&wdot1[0]);
+            for (size_t k = 0; k < kk; k++) {
+                double fd = (wdot1[k] - wdot0[k]) / (conc1[j] - c0);
+                EXPECT_NEAR(fd, jac(k,j), rtol * (std::abs(fd) + scale / ctot))
+                    << "species " << k << ", column " << j;
+            }
+        }
+        thermo.setConcentrations(&conc[0]);
+    }
+
+    IdealGasPhase thermo;
+    GasKinetics kin;
+    size_t kk;
+};
+
+TEST_F(GasJacobianTest, gri30_ddC)
+{
+    setup("gri30.xml", "gri30", "CH4:0.1, O2:0.2, H2O:0.1, CO:0.05, H:0.01, OH:0.02, "
+          "O:0.01, HO2:0.001, H2:0.05, CH3:0.002, N2:0.5", 1500, OneAtm);
+    check_ddC(1e-4);
+}
+
+TEST_F(GasJacobianTest, pdep_ddC)
+{
+    setup("../data/pdep-test.xml", "gas", "H:1.0, R1A:1.0, R1B:1.0, R2:1.0, "
+          "R3:1.0, R4:1.0, R5:1.0, R6:1.0", 900, 8 * OneAtm);
+    check_ddC(1e-4);
+}
+
+TEST_F(GasJacobianTest, gri30_ddT)
+{
+    setup("gri30.xml", "gri30", "CH4:0.1, O2:0.2, H2O:0.1, CO:0.05, H:0.01, OH:0.02, "
+          "O:0.01, HO2:0.001, H2:0.05, CH3:0.002, N2:0.5", 1500, OneAtm);
+    vector_fp dwdot(kk), wdot0(kk), wdot1(kk);
+    kin.getNetProductionRates_ddT(&dwdot[0]);
+    EXPECT_DOUBLE_EQ(1500, thermo.temperature());
+
+    double dT = 1e-4;
+    kin.getNetProductionRates(&wdot0[0]);
+    thermo.setTemperature(1500 + dT);
+    kin.getNetProductionRates(&wdot1[0]);
+    for (size_t k = 0; k < kk; k++) {
+        double fd = (wdot1[k] - wdot0[k]) / dT;
+        EXPECT_NEAR(fd, dwdot[k], 1e-4 * std::abs(fd) + 1e-10);
+    }
+}
+
+class InterfaceJacobianTest : public testing::Test
+{
+public:
+    InterfaceJacobianTest()
+        : gas("ptcombust.xml", "gas")
+        , surf("ptcombust.xml", "Pt_surf")
+    {
+        std::vector<ThermoPhase*> phases;
+        phases.push_back(&gas);
+        phases.push_back(&surf);
+        importKinetics(surf.xml(), phases, &kin);
+        gas.setState_TPX(900, OneAtm, "CH4:0.095, O2:0.21, AR:0.695, "
+                         "H2O:0.01, CO2:0.005, H2:0.01, CO:0.005");
+        surf.setState_TP(900, OneAtm);
+        surf.setCoveragesByName("PT(S):0.5, H(S):0.1, O(S):0.2, OH(S):0.05, "
+                                "CO(S):0.1, C(S):0.01, CH3(S):0.02, H2O(S):0.02");
+        kk = kin.nTotalSpecies();
+        ksurf = kin.kineticsSpeciesIndex(0, kin.surfacePhaseIndex());
+    }
+
+    //! Net production rates with the concentration of kinetic species `k`
+    //! set to `c`
+    void rates_at(size_t k, double c, vector_fp& wdot) {
+        size_t n = kin.speciesPhaseIndex(k);
+        ThermoPhase& ph = kin.thermo(n);
+        vector_fp conc(ph.nSpecies());
+        ph.getConcentrations(&conc[0]);
+        double c0 = conc[k - kin.kineticsSpeciesIndex(0, n)];
+        conc[k - kin.kineticsSpeciesIndex(0, n)] = c;
+        ph.setConcentrations(&conc[0]);
+        kin.getNetProductionRates(&wdot[0]);
+        conc[k - kin.kineticsSpeciesIndex(0, n)] = c0;
+        ph.setConcentrations(&conc[0]);
+    }
+
+    IdealGasPhase gas;
+    SurfPhase surf;
+    InterfaceKinetics kin;
+    size_t kk;
+    size_t ksurf;
+};
+
+TEST_F(InterfaceJacobianTest, ddC)
+{
+    SparseMatrix jac;
+    kin.getNetProductionRates_ddC(jac);
+    ASSERT_EQ(kk, jac.nRows());
+    ASSERT_EQ(kk, jac.nColumns());
+
+    vector_fp conc(kk), wdot0(kk), wdot1(kk);
+    for (size_t n = 0; n < kin.nPhases(); n++) {
+        kin.thermo(n).getConcentrations(&conc[kin.kineticsSpeciesIndex(0, n)]);
+    }
+    kin.getNetProductionRates(&wdot0[0]);
+    double scale = 0.0;
+    for (size_t k = 0; k < kk; k++) {
+        scale = std::max(scale, std::abs(wdot0[k]));
+    }
+
+    // Central differences, except for absent species
+    for (size_t j = 0; j < kk; j++) {
+        double ctot = kin.thermo(kin.speciesPhaseIndex(j)).molarDensity();
+        double dc = 1e-6 * (conc[j] + 1e-3 * ctot);
+        double c0 = std::max(conc[j] - dc, 0.0);
+        rates_at(j, c0, wdot0);
+        rates_at(j, conc[j] + dc, wdot1);
+        for (size_t k = 0; k < kk; k++) {
+            double fd = (wdot1[k] - wdot0[k]) / (conc[j] + dc - c0);
+            EXPECT_NEAR(fd, jac(k,j), 1e-5 * (std::abs(fd) + scale / ctot))
+                << "species " << k << ", column " << j;
+        }
+    }
+
+    // Coverage derivatives are the concentration derivatives scaled by the
+    // site density and species sizes
+    SparseMatrix dwdot;
+    kin.getNetProductionRates_ddCoverages(dwdot);
+    ASSERT_EQ(surf.nSpecies(), dwdot.nColumns());
+    for (size_t k = 0; k < kk; k++) {
+        for (size_t j = 0; j < surf.nSpecies(); j++) {
+            EXPECT_NEAR(jac(k, ksurf + j) * surf.siteDensity() / surf.size(j),
+                        dwdot(k, j), 1e-12 * std::abs(dwdot(k, j)));
+        }
+    }
+}
+
+TEST_F(InterfaceJacobianTest, PseudoSteadyState)
+{
+    vector_fp wdot(kk);
+    kin.solvePseudoSteadyStateProblem();
+    kin.getNetProductionRates(&wdot[0]);
+    for (size_t k = 0; k < surf.nSpecies(); k++) {
+        EXPECT_NEAR(0.0, wdot[ksurf + k], 1e-12) << k;
+    }
+
+    // Time integration approaches the same state
+    size_t nsurf = surf.nSpecies();
+    vector_fp theta(nsurf), theta_ss(nsurf);
+    surf.getCoverages(&theta_ss[0]);
+    surf.setCoveragesByName("PT(S):1.0");
+    kin.advanceCoverages(1.0);
+    surf.getCoverages(&theta[0]);
+    for (size_t k = 0; k < nsurf; k++) {
+        EXPECT_NEAR(theta_ss[k], theta[k], 1e-5) << k;
+    }
+}
+
+TEST_F(InterfaceJacobianTest, ImplicitSurfChemJacobian)
+{
+    size_t nsurf = surf.nSpecies();
+    vector_fp y(nsurf), f(nsurf), fp(nsurf), fm(nsurf), J(nsurf * nsurf);
+    std::vector<double*> cols(nsurf);
+    for (size_t k = 0; k < nsurf; k++) {
+        y[k] = (0.05 + 0.01 * k) / (0.05 * nsurf + 0.005 * nsurf * (nsurf - 1));
+        cols[k] = &J[k * nsurf];
+    }
+    std::vector<InterfaceKinetics*> kins(1, &kin);
+    ImplicitSurfChem integ(kins);
+    integ.eval(0.0, &y[0], &f[0], 0);
+    integ.evalJacobian(0.0, &y[0], &f[0], 0, 0, &cols[0]);
+    for (size_t m = 0; m < nsurf; m++) {
+        double ym = y[m];
+        double h = 1e-6 * ym;
+        y[m] = ym + h;
+        integ.eval(0.0, &y[0], &fp[0], 0);
+        y[m] = ym - h;
+        integ.eval(0.0, &y[0], &fm[0], 0);
+        y[m] = ym;
+        for (size_t k = 0; k < nsurf; k++) {
+            double fd = (fp[k] - fm[k]) / (2 * h);
+            EXPECT_NEAR(fd, J[m * nsurf + k], 1e-5 * std::abs(fd) + 1e-6)
+                << k << ", " << m;
+        }
+    }
+
+    // The default finite difference Jacobian uses the increments 1/ewt[m]
+    // given by the integrator's error weights
+    vector_fp ewt(nsurf), J2(nsurf * nsurf);
+    for (size_t m = 0; m < nsurf; m++) {
+        ewt[m] = 1e5 * (m + 1);
+        cols[m] = &J2[m * nsurf];
+    }
+    integ.FuncEval::evalJacobian(0.0, &y[0], &f[0], &ewt[0], 0, &cols[0]);
+    for (size_t m = 0; m < nsurf; m++) {
+        double ym = y[m];
+        y[m] = ym + 1.0 / ewt[m];
+        double h = y[m] - ym;
+        integ.eval(0.0, &y[0], &fp[0], 0);
+        y[m] = ym;
+        for (size_t k = 0; k < nsurf; k++) {
+            EXPECT_DOUBLE_EQ((fp[k] - f[k]) / h, J2[m * nsurf + k])
+                << k << ", " << m;
+        }
+    }
+}
+
+TEST_F(InterfaceJacobianTest, PseudoSteadyStateBatch)
+{
+    const size_t nSites = 6;
+    size_t kg = gas.nSpecies();
+    size_t ns = surf.nSpecies();
+    vector_fp T(nSites), P(nSites, OneAtm), Y(nSites * kg);
+    vector_fp theta0(ns), theta(nSites * ns), theta1(ns), wdot(kk);
+    surf.getCoverages(&theta0[0]);
+    for (size_t n = 0; n < nSites; n++) {
+        T[n] = 850 + 30 * n;
+        gas.getMassFractions(&Y[n * kg]);
+        std::copy(theta0.begin(), theta0.end(), theta.begin() + n * ns);
+    }
+    kin.solvePseudoSteadyStateBatch(nSites, &T[0], &P[0], &Y[0], &theta[0]);
+    EXPECT_DOUBLE_EQ(900, gas.temperature());
+    EXPECT_DOUBLE_EQ(900, surf.temperature());
+
+    for (size_t n = 0; n < nSites; n++) {
+        gas.setState_TPY(T[n], P[n], &Y[n * kg]);
+        surf.setState_TP(T[n], P[n]);
+        surf.setCoverages(&theta[n * ns]);
+        kin.getNetProductionRates(&wdot[0]);
+        for (size_t k = 0; k < ns; k++) {
+            EXPECT_NEAR(0.0, wdot[ksurf + k], 1e-12) << n << ", " << k;
+        }
+
+        surf.setCoverages(&theta0[0]);
+        kin.solvePseudoSteadyStateProblem();
+        surf.getCoverages(&theta1[0]);
+        for (size_t k = 0; k < ns; k++) {
+            EXPECT_NEAR(theta1[k], theta[n * ns + k], 1e-8) << n << ", " << k;
+        }
+    }
+
+    // Solving the blocks in several threads, without restarts from the
+    // neighboring sites, and from the converged coverages
+    vector_fp theta2(nSites * ns), theta3(theta);
+    for (size_t n = 0; n < nSites; n++) {
+        std::copy(theta0.begin(), theta0.end(), theta2.begin() + n * ns);
+    }
+    kin.solvePseudoSteadyStateBatch(nSites, &T[0], &P[0], &Y[0], &theta2[0],
+                                    false, 3);
+    kin.solvePseudoSteadyStateBatch(nSites, &T[0], &P[0], &Y[0], &theta3[0],
+                                    true, 4);
+    for (size_t i = 0; i < nSites * ns; i++) {
+        EXPECT_NEAR(theta[i], theta2[i], 1e-8) << i;
+        EXPECT_NEAR(theta[i], theta3[i], 1e-8) << i;
+    }
+}
+
+}
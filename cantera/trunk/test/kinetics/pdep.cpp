@@ -224,6 +224,71 @@ TEST_F(PdepTest, ChebyshevEdgeCases)
     EXPECT_NEAR(3.354054351e+07, kf[4], 1e-1);
 }
 
+TEST_F(PdepTest, MultipleStates)
+{
+    size_t K = thermo_->nSpecies();
+    double T[] = {500.0, 500.0, 1100.0, 800.0};
+    double P[] = {101325.0, 20 * 101325.0, 20 * 101325.0, 70 * 101325.0};
+    vector_fp Y(4*K), wdot(4*K), wdot1(K);
+    for (size_t n = 0; n < 4; n++) {
+        for (size_t k = 0; k < K; k++) {
+            Y[n*K + k] = 1.0 + k + n;
+        }
+    }
+    double T0 = thermo_->temperature();
+
+    kin_->getNetProductionRates(4, T, P, &Y[0], &wdot[0]);
+    EXPECT_DOUBLE_EQ(T0, thermo_->temperature());
+
+    for (size_t n = 0; n < 4; n++) {
+        thermo_->setState_TPY(T[n], P[n], &Y[n*K]);
+        kin_->getNetProductionRates(&wdot1[0]);
+        for (size_t k = 0; k < K; k++) {
+            EXPECT_NEAR(wdot1[k], wdot[n*K + k], 1e-12 * std::abs(wdot1[k]));
+        }
+    }
+}
+
+TEST(PlogRates, SharedPressureGrids)
+{
+    std::multimap<double, Arrhenius> r1, r2, r3;
+    r1.insert(std::make_pair(1e3, Arrhenius(1.2e10, 0.5, 4000.0)));
+    r1.insert(std::make_pair(1e5, Arrhenius(3.4e11, 0.2, 5000.0)));
+    r1.insert(std::make_pair(1e7, Arrhenius(5.6e12, -0.1, 6000.0)));
+    r2.insert(std::make_pair(1e3, Arrhenius(2.0e9, 1.0, 3000.0)));
+    r2.insert(std::make_pair(1e5, Arrhenius(4.0e9, 0.9, 3500.0)));
+    r2.insert(std::make_pair(1e5, Arrhenius(-1.0e8, 1.1, 2500.0)));
+    r2.insert(std::make_pair(1e7, Arrhenius(8.0e9, 0.8, 4000.0)));
+    r3.insert(std::make_pair(1e4, Arrhenius(7.0e11, 0.0, 8000.0)));
+    r3.insert(std::make_pair(1e6, Arrhenius(9.0e12, -0.5, 9000.0)));
+    std::vector<Plog> plogs;
+    plogs.push_back(Plog(r1));
+    plogs.push_back(Plog(r2));
+    plogs.push_back(Plog(r3));
+
+    Rate1<Plog> rates;
+    rates.install(2, plogs[0]);
+    rates.install(0, plogs[1]);
+    rates.install(1, plogs[2]);
+    EXPECT_EQ((size_t) 3, rates.nReactions());
+    EXPECT_EQ((size_t) 2, rates.nPressureGrids());
+
+    double P[] = {1e2, 1e3, 3e4, 1e5, 2e5, 4e6, 1e7, 1e9, 5e4};
+    double T = 1200.0;
+    vector_fp k(3);
+    for (size_t j = 0; j < 9; j++) {
+        double logP = std::log(P[j]);
+        rates.update_C(&logP);
+        rates.update(T, std::log(T), &k[0]);
+        int rxn[] = {2, 0, 1};
+        for (size_t i = 0; i < 3; i++) {
+            plogs[i].update_C(&logP);
+            double kref = plogs[i].updateRC(std::log(T), 1.0/T);
+            EXPECT_NEAR(kref, k[rxn[i]], 1e-12 * kref);
+        }
+    }
+}
+
 } // namespace Cantera
 
 int main(int argc, char** argv)
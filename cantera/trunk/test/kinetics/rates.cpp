@@ -1,6 +1,10 @@
 #include "gtest/gtest.h"
 #include "cantera/kinetics.h"
 #include "cantera/thermo/IdealGasPhase.h"
+#include <fstream>
+
+// Code generated by GasKinetics::writeSource for frac.xml
+#include "../data/frac-kinetics.h"
 
 namespace Cantera
 {
@@ -144,4 +148,648 @@ TEST_F(FracCoeffTest, EquilibriumConstants)
     EXPECT_NEAR(exp(-deltaG0_1/RT) * pow(pRef/RT, -0.5), Kc[1], 1e-13 * Kc[1]);
 }
 
+TEST_F(FracCoeffTest, WriteSource)
+{
+    std::stringstream s;
+    kin.writeSource(s, "frac");
+    std::string src = s.str();
+
+    EXPECT_NE(std::string::npos, src.find("namespace frac"));
+    EXPECT_NE(std::string::npos, src.find("nReactions = 3;"));
+    EXPECT_NE(std::string::npos, src.find("kf[0] = 10000000000000;"));
+
+    // fractional reaction order for H2 in reaction 1
+    std::string conc = "c[" + int2str(kH2) + "]";
+    EXPECT_NE(std::string::npos,
+              src.find("ppow(" + conc + ", 0.80000000000000004)"));
+
+    // O does not participate in any reactions
+    std::string wO = "wdot[" + int2str(therm.speciesIndex("O")) + "] = 0.0;";
+    EXPECT_NE(std::string::npos, src.find(wO));
+}
+
+TEST_F(FracCoeffTest, GeneratedSource)
+{
+    // The code included from frac-kinetics.h has to match the current
+    // output of writeSource
+    std::stringstream s;
+    kin.writeSource(s, "frac");
+    std::ifstream f(findInputFile("frac-kinetics.h").c_str());
+    std::stringstream ref;
+    ref << f.rdbuf();
+    ASSERT_EQ(ref.str(), s.str()) << "Update test/data/frac-kinetics.h "
+        "with the output of GasKinetics::writeSource for frac.xml";
+
+    size_t nr = kin.nReactions();
+    size_t kk = therm.nSpecies();
+    ASSERT_EQ(frac::nReactions, nr);
+    ASSERT_EQ(frac::nSpecies, kk);
+    vector_fp kf(nr), kf_ref(nr), kr(nr), ropf(nr), ropr(nr), ropnet(nr);
+    vector_fp rop_ref(nr), conc(kk), wdot(kk), wdot_ref(kk);
+
+    // The second and third states have zero concentrations for species
+    // with fractional and negative reaction orders
+    const char* X[] = {"H2O:0.5, OH:.05, H:0.1, O2:0.15, H2:0.2",
+                       "H2O:0.5, OH:.05, H:0.1, O2:0.15",
+                       "H2O:0.5, OH:.05, H:0.1, H2:0.2"};
+    double T[] = {2000.0, 1200.0, 800.0};
+    for (size_t n = 0; n < 3; n++) {
+        therm.setState_TPX(T[n], 4*OneAtm, X[n]);
+        therm.getConcentrations(&conc[0]);
+        kin.getFwdRateConstants(&kf_ref[0]);
+        kin.getRevRateConstants(&kr[0]);
+        kin.getNetRatesOfProgress(&rop_ref[0]);
+        kin.getNetProductionRates(&wdot_ref[0]);
+
+        frac::updateArrheniusRates(T[n], &kf[0]);
+        ropf = kf;
+        ropr = kr;
+        frac::multiplyReactants(&conc[0], &ropf[0]);
+        frac::multiplyRevProducts(&conc[0], &ropr[0]);
+        for (size_t i = 0; i < nr; i++) {
+            EXPECT_NEAR(kf_ref[i], kf[i], 1e-14 * kf_ref[i]) << i;
+            ropnet[i] = ropf[i] - ropr[i];
+            EXPECT_NEAR(rop_ref[i], ropnet[i], 1e-14 * std::abs(rop_ref[i]))
+                << "state " << n << ", reaction " << i;
+        }
+        frac::getNetProductionRates(&ropnet[0], &wdot[0]);
+        for (size_t k = 0; k < kk; k++) {
+            EXPECT_NEAR(wdot_ref[k], wdot[k], 1e-14 * std::abs(wdot_ref[k]))
+                << "state " << n << ", species " << k;
+        }
+    }
+}
+
+//! Check the net stoichiometric coefficients used by getReactionDelta(),
+//! getRevReactionDelta() and getNetProductionRates() against the reactant
+//! and product stoichiometric coefficients of each reaction.
+static void checkStoichMatrices(const std::string& file, const std::string& id)
+{
+    IdealGasPhase thermo(file, id);
+    std::vector<ThermoPhase*> phases(1, &thermo);
+    GasKinetics kin;
+    importKinetics(thermo.xml(), phases, &kin);
+    size_t kk = thermo.nSpecies();
+    size_t nr = kin.nReactions();
+    vector_fp X(kk, 1.0);
+    thermo.setState_TPX(1200.0, OneAtm, &X[0]);
+
+    vector_fp e(kk, 0.0), delta(nr), revDelta(nr);
+    for (size_t k = 0; k < kk; k++) {
+        e[k] = 1.0;
+        kin.getReactionDelta(&e[0], &delta[0]);
+        kin.getRevReactionDelta(&e[0], &revDelta[0]);
+        e[k] = 0.0;
+        for (size_t i = 0; i < nr; i++) {
+            double nu_r = kin.reactantStoichCoeff(k, i);
+            double nu_p = kin.productStoichCoeff(k, i);
+            EXPECT_DOUBLE_EQ(nu_p - nu_r, delta[i]) << k << ", " << i;
+            EXPECT_DOUBLE_EQ(kin.isReversible(i) ? nu_p - nu_r : -nu_r,
+                             revDelta[i]) << k << ", " << i;
+        }
+    }
+
+    vector_fp ropnet(nr), wdot(kk);
+    kin.getNetRatesOfProgress(&ropnet[0]);
+    kin.getNetProductionRates(&wdot[0]);
+    double scale = 0.0;
+    for (size_t i = 0; i < nr; i++) {
+        scale = std::max(scale, std::abs(ropnet[i]));
+    }
+    for (size_t k = 0; k < kk; k++) {
+        double w = 0.0;
+        for (size_t i = 0; i < nr; i++) {
+            w += (kin.productStoichCoeff(k, i) -
+                  kin.reactantStoichCoeff(k, i)) * ropnet[i];
+        }
+        EXPECT_NEAR(w, wdot[k], 1e-13 * scale) << k;
+    }
+}
+
+TEST(GasKinetics, StoichMatrices)
+{
+    // Non-integer stoichiometric coefficients and reaction orders
+    checkStoichMatrices("../data/frac.xml", "gas");
+    checkStoichMatrices("explicit-forward-order.xml", "gas");
+    checkStoichMatrices("gri30.xml", "gri30");
+}
+
+TEST(Rate1, ArrheniusArrays)
+{
+    // Parameter sets covering zero and negative exponents and activation
+    // energies, and a negative pre-exponential factor
+    double params[6][3] = {{3.87e4, 2.7, 3150.0},
+                           {2.0e10, 0.0, 0.0},
+                           {1.2e14, -0.5, 8000.0},
+                           {5.0e6, 1.5, -400.0},
+                           {-1.1e9, 0.3, 1200.0},
+                           {7.3e2, 3.2, 0.0}};
+    size_t rxn[] = {7, 0, 3, 12, 5, 9};
+    Rate1<Arrhenius> rates;
+    std::vector<Arrhenius> ref;
+    for (size_t i = 0; i < 6; i++) {
+        ref.push_back(Arrhenius(params[i][0], params[i][1], params[i][2]));
+        rates.install(rxn[i], ref.back());
+        EXPECT_EQ(rxn[i], rates.reactionIndex(i));
+    }
+
+    size_t nT = 25;
+    vector_fp logT(nT), recipT(nT), kbatch(13 * nT, -1.0);
+    for (size_t n = 0; n < nT; n++) {
+        double T = 200.0 + 200.0 * n;
+        logT[n] = log(T);
+        recipT[n] = 1.0 / T;
+    }
+    rates.update(nT, &logT[0], &recipT[0], &kbatch[0]);
+
+    std::vector<size_t> subset;
+    subset.push_back(1);
+    subset.push_back(4);
+    for (size_t n = 0; n < nT; n++) {
+        double T = 200.0 + 200.0 * n;
+        vector_fp k(13, -1.0), ksub(13, -1.0);
+        rates.update(T, log(T), &k[0]);
+        rates.update(T, log(T), &ksub[0], subset);
+        for (size_t i = 0; i < 6; i++) {
+            double kref = ref[i].updateRC(log(T), 1.0 / T);
+            EXPECT_DOUBLE_EQ(kref, k[rxn[i]]) << i << ", " << T;
+            EXPECT_DOUBLE_EQ(kref, kbatch[rxn[i] * nT + n]) << i << ", " << T;
+            if (i == 1 || i == 4) {
+                EXPECT_DOUBLE_EQ(kref, ksub[rxn[i]]) << i << ", " << T;
+            } else {
+                EXPECT_EQ(-1.0, ksub[rxn[i]]) << i << ", " << T;
+            }
+        }
+        // Entries for reactions without rate coefficients are untouched
+        EXPECT_EQ(-1.0, k[1]);
+        EXPECT_EQ(-1.0, kbatch[1 * nT + n]);
+    }
+}
+
+TEST(FalloffMgr, BatchEvaluation)
+{
+    // Falloff function parameters for: Lindemann, Troe (3 and 4
+    // parameters), SRI (3 and 5 parameters, with c = 0 for the latter)
+    int types[] = {SIMPLE_FALLOFF, TROE_FALLOFF, TROE_FALLOFF, SRI_FALLOFF,
+                   SRI_FALLOFF};
+    double params[5][5] = {{0, 0, 0, 0, 0},
+                           {0.5, 200.0, 900.0, 0, 0},
+                           {0.7, 150.0, 1100.0, 5000.0, 0},
+                           {1.1, 700.0, 1300.0, 0, 0},
+                           {0.9, 500.0, 0.0, 1.2, 0.2}};
+    size_t nparams[] = {0, 3, 4, 3, 5};
+
+    FalloffMgr mgr;
+    std::vector<Falloff*> ref;
+    vector_int rtype;
+    for (size_t i = 0; i < 10; i++) {
+        vector_fp c(params[i % 5], params[i % 5] + nparams[i % 5]);
+        rtype.push_back(i < 5 ? FALLOFF_RXN : CHEMACT_RXN);
+        mgr.install(i, types[i % 5], rtype[i], c);
+        ref.push_back(FalloffFactory::factory()->newFalloff(types[i % 5], c));
+    }
+
+    vector_fp work(mgr.workSize()), work1(2);
+    double T[] = {300.0, 1500.0};
+    double pr[] = {1e-30, 1e-3, 0.7, 20.0, 1e5};
+    for (size_t n = 0; n < 2; n++) {
+        mgr.updateTemp(T[n], &work[0]);
+        for (size_t m = 0; m < 5; m++) {
+            vector_fp values(10, pr[m]);
+            mgr.pr_to_falloff(&values[0], &work[0]);
+            for (size_t i = 0; i < 10; i++) {
+                ref[i]->updateTemp(T[n], &work1[0]);
+                double F = ref[i]->F(pr[m], &work1[0]) / (1.0 + pr[m]);
+                if (rtype[i] == FALLOFF_RXN) {
+                    F *= pr[m];
+                }
+                EXPECT_NEAR(F, values[i], 1e-13 * F) << i << ", " << T[n];
+            }
+        }
+    }
+    for (size_t i = 0; i < 10; i++) {
+        delete ref[i];
+    }
+}
+
+TEST(ThirdBodyCalc, Efficiencies)
+{
+    ThirdBodyCalc calc;
+    std::map<size_t, double> eff1, eff2;
+    eff1[1] = 2.5;
+    eff1[3] = 0.0;
+    eff2[0] = 6.0;
+    calc.install(4, eff1);
+    calc.install(7, std::map<size_t, double>(), 0.5);
+    calc.install(2, eff2, 0.0);
+
+    const SparseMatrix& E = calc.efficiencies();
+    EXPECT_EQ((size_t) 3, E.nRows());
+    EXPECT_EQ((size_t) 3, E.nNonZeros());
+    EXPECT_DOUBLE_EQ(1.5, E(0, 1));
+    EXPECT_DOUBLE_EQ(-1.0, E(0, 3));
+    EXPECT_DOUBLE_EQ(6.0, E(2, 0));
+
+    double c[] = {0.1, 0.2, 0.3, 0.4};
+    vector_fp conc(c, c + 4);
+    double ctot = 1.0;
+    vector_fp work(calc.workSize());
+    calc.update(conc, ctot, &work[0]);
+    EXPECT_DOUBLE_EQ(0.1 + 2.5 * 0.2 + 0.3, work[0]);
+    EXPECT_DOUBLE_EQ(0.5, work[1]);
+    EXPECT_DOUBLE_EQ(0.6, work[2]);
+}
+
+TEST(GasKinetics, RateTabulation)
+{
+    IdealGasPhase thermo("gri30.xml", "gri30");
+    std::vector<ThermoPhase*> phases(1, &thermo);
+    GasKinetics kin, kin_tab;
+    importKinetics(thermo.xml(), phases, &kin);
+    importKinetics(thermo.xml(), phases, &kin_tab);
+    thermo.setState_TPX(500, OneAtm, "CH4:1.0, O2:2.0, N2:7.52");
+    size_t nr = kin.nReactions();
+    vector_fp kf(nr), kr(nr), kf_tab(nr), kr_tab(nr), wdot(thermo.nSpecies());
+
+    kin_tab.setRateTabulation(300, 3000, 1e-9);
+    EXPECT_TRUE(kin_tab.rateTabulation());
+    EXPECT_TRUE(kin_tab.equilibriumTabulation());
+    EXPECT_DOUBLE_EQ(500, thermo.temperature());
+
+    double T[] = {300.0, 712.3, 1000.0, 1854.6, 3000.0, 3500.0};
+    for (size_t n = 0; n < 6; n++) {
+        thermo.setState_TP(T[n], OneAtm);
+        kin.getFwdRateConstants(&kf[0]);
+        kin.getRevRateConstants(&kr[0]);
+        kin_tab.getFwdRateConstants(&kf_tab[0]);
+        kin_tab.getRevRateConstants(&kr_tab[0]);
+        for (size_t i = 0; i < nr; i++) {
+            EXPECT_NEAR(kf[i], kf_tab[i], 2e-9 * kf[i]) << i << ", " << T[n];
+            EXPECT_NEAR(kr[i], kr_tab[i], 4e-9 * kr[i]) << i << ", " << T[n];
+        }
+    }
+
+    kin_tab.clearRateTabulation();
+    EXPECT_FALSE(kin_tab.rateTabulation());
+    kin_tab.getNetProductionRates(&wdot[0]);
+}
+
+TEST(GasKinetics, RateTabulationManyMidpoints)
+{
+    // Give each species of h2o2.xml a different midpoint temperature, so
+    // that the equilibrium constants are stored in many narrow tables.
+    XML_Node doc;
+    get_XML_File("h2o2.xml")->copy(&doc);
+    std::vector<XML_Node*> species = doc.findByName("speciesData")->getChildren("species");
+    for (size_t k = 0; k < species.size(); k++) {
+        std::vector<XML_Node*> fits = species[k]->child("thermo").getChildren("NASA");
+        ASSERT_EQ((size_t) 2, fits.size());
+        double Tmid = 1000.0 + 20.0 * k;
+        bool low = (fpValue(fits[0]->attrib("Tmin")) < 1000.0);
+        fits[low ? 0 : 1]->addAttribute("Tmax", Tmid);
+        fits[low ? 1 : 0]->addAttribute("Tmin", Tmid);
+    }
+    XML_Node* phase = doc.findID("ohmech");
+    IdealGasPhase thermo;
+    importPhase(*phase, &thermo);
+    std::vector<ThermoPhase*> phases(1, &thermo);
+    GasKinetics kin, kin_tab;
+    importKinetics(*phase, phases, &kin);
+    importKinetics(*phase, phases, &kin_tab);
+
+    kin_tab.setRateTabulation(300, 3000, 1e-9);
+    EXPECT_TRUE(kin_tab.rateTabulation());
+    EXPECT_TRUE(kin_tab.equilibriumTabulation());
+
+    size_t nr = kin.nReactions();
+    vector_fp kf(nr), kr(nr), kf_tab(nr), kr_tab(nr);
+    double T[] = {300.0, 712.3, 1000.0, 1050.0, 1130.0, 1854.6, 3000.0};
+    for (size_t n = 0; n < 7; n++) {
+        thermo.setState_TPX(T[n], OneAtm, "H2:2, O2:1, H:0.1, OH:0.1, AR:5");
+        kin.getFwdRateConstants(&kf[0]);
+        kin.getRevRateConstants(&kr[0]);
+        kin_tab.getFwdRateConstants(&kf_tab[0]);
+        kin_tab.getRevRateConstants(&kr_tab[0]);
+        for (size_t i = 0; i < nr; i++) {
+            EXPECT_NEAR(kf[i], kf_tab[i], 2e-9 * kf[i]) << i << ", " << T[n];
+            EXPECT_NEAR(kr[i], kr_tab[i], 2e-9 * kr[i]) << i << ", " << T[n];
+        }
+    }
+}
+
+//! Compare the net production rates evaluated for a batch of states with
+//! those evaluated one state at a time.
+static void checkMultipleStates(const std::string& file, const std::string& id)
+{
+    IdealGasPhase thermo(file, id);
+    std::vector<ThermoPhase*> phases(1, &thermo);
+    GasKinetics kin;
+    importKinetics(thermo.xml(), phases, &kin);
+    thermo.setState_TP(900.0, OneAtm);
+    size_t kk = thermo.nSpecies();
+
+    // More states than are evaluated in one block, with unnormalized and
+    // negative mass fractions
+    size_t nStates = 70;
+    vector_fp T(nStates), P(nStates), Y(nStates * kk);
+    for (size_t n = 0; n < nStates; n++) {
+        T[n] = 300.0 + 37.0 * n;
+        P[n] = OneAtm * (0.05 + 0.5 * (n % 9));
+        for (size_t k = 0; k < kk; k++) {
+            Y[n*kk + k] = 1.0 + sin(1.0 + n + 3.0 * k);
+        }
+        Y[n*kk + n % kk] = -1e-3;
+    }
+    vector_fp wdot(nStates * kk), wdot_ref(kk);
+    kin.getNetProductionRates(nStates, &T[0], &P[0], &Y[0], &wdot[0]);
+    EXPECT_DOUBLE_EQ(900.0, thermo.temperature());
+
+    for (size_t n = 0; n < nStates; n++) {
+        thermo.setState_TPY(T[n], P[n], &Y[n*kk]);
+        kin.getNetProductionRates(&wdot_ref[0]);
+        double scale = 0.0;
+        for (size_t k = 0; k < kk; k++) {
+            scale = std::max(scale, std::abs(wdot_ref[k]));
+        }
+        for (size_t k = 0; k < kk; k++) {
+            EXPECT_NEAR(wdot_ref[k], wdot[n*kk + k],
+                        1e-11 * (std::abs(wdot_ref[k]) + 1e-3 * scale))
+                << "state " << n << ", species " << k;
+        }
+    }
+}
+
+TEST(GasKinetics, MultipleStates)
+{
+    checkMultipleStates("gri30.xml", "gri30");
+    checkMultipleStates("sri-falloff.xml", "gas");
+    checkMultipleStates("chemically-activated-reaction.xml", "gas");
+}
+
+TEST(GasKinetics, Duplicate)
+{
+    IdealGasPhase thermo("gri30.xml", "gri30");
+    std::vector<ThermoPhase*> phases(1, &thermo);
+    GasKinetics kin;
+    importKinetics(thermo.xml(), phases, &kin);
+    thermo.setState_TPX(1200, OneAtm, "CH4:1.0, O2:2.0, N2:7.52");
+
+    size_t kk = thermo.nSpecies();
+    vector_fp wdot1(kk), wdot2(kk);
+    ThermoPhase* thermo2 = thermo.duplMyselfAsThermoPhase();
+    std::vector<ThermoPhase*> phases2(1, thermo2);
+    Kinetics* kin2 = kin.duplMyselfAsKinetics(phases2);
+
+    // The copies are independent of the original
+    thermo2->setState_TPX(1500, 2 * OneAtm, "H2:2.0, O2:1.0, AR:4.0");
+    kin2->getNetProductionRates(&wdot2[0]);
+    thermo.setState_TPX(1500, 2 * OneAtm, "H2:2.0, O2:1.0, AR:4.0");
+    kin.getNetProductionRates(&wdot1[0]);
+    for (size_t k = 0; k < kk; k++) {
+        EXPECT_DOUBLE_EQ(wdot1[k], wdot2[k]) << k;
+    }
+    EXPECT_EQ(thermo.speciesData()[0], thermo2->speciesData()[0]);
+
+    delete kin2;
+    delete thermo2;
+    kin.getNetProductionRates(&wdot2[0]);
+    for (size_t k = 0; k < kk; k++) {
+        EXPECT_DOUBLE_EQ(wdot1[k], wdot2[k]) << k;
+    }
+}
+
+TEST(GasKinetics, StateNumbers)
+{
+    IdealGasPhase thermo("gri30.xml", "gri30");
+    std::vector<ThermoPhase*> phases(1, &thermo);
+    GasKinetics kin, kin_ref;
+    importKinetics(thermo.xml(), phases, &kin);
+    importKinetics(thermo.xml(), phases, &kin_ref);
+    size_t kk = thermo.nSpecies();
+    vector_fp wdot(kk), wdot_ref(kk);
+
+    // Each change of state has to be seen by 'kin', which is re-evaluated
+    // only when the state numbers of the phase change. 'kin_ref' is
+    // forced to start from scratch by changing the temperature back and
+    // forth.
+    const char* X[] = {"CH4:1.0, O2:2.0, N2:7.52", "CH4:1.0, O2:2.0, N2:7.52",
+                       "H2:2.0, O2:1.0, AR:4.0", "H2:2.0, O2:1.0, AR:4.0"};
+    double P[] = {OneAtm, 3 * OneAtm, 3 * OneAtm, 3 * OneAtm};
+    double T[] = {1400, 1400, 1400, 1700};
+    for (size_t n = 0; n < 4; n++) {
+        thermo.setState_TPX(T[n], P[n], X[n]);
+        kin.getNetProductionRates(&wdot[0]);
+        kin.getNetProductionRates(&wdot[0]);
+
+        thermo.setTemperature(T[n] + 1.0);
+        kin_ref.getNetProductionRates(&wdot_ref[0]);
+        thermo.setState_TPX(T[n], P[n], X[n]);
+        kin_ref.getNetProductionRates(&wdot_ref[0]);
+        for (size_t k = 0; k < kk; k++) {
+            EXPECT_NEAR(wdot_ref[k], wdot[k], 1e-12 * std::abs(wdot_ref[k]))
+                << n << ", " << k;
+        }
+    }
+}
+
+TEST(GasKinetics, DynamicReduction)
+{
+    IdealGasPhase thermo("gri30.xml", "gri30");
+    std::vector<ThermoPhase*> phases(1, &thermo);
+    GasKinetics kin, kin_red;
+    importKinetics(thermo.xml(), phases, &kin);
+    importKinetics(thermo.xml(), phases, &kin_red);
+    size_t nsp = thermo.nSpecies();
+    vector_fp wdot(nsp), wdot_red(nsp);
+    thermo.setState_TPX(1600, OneAtm, "CH4:0.05, O2:0.15, N2:0.7, H2O:0.05, "
+        "CO2:0.02, CO:0.01, H2:0.005, H:0.001, O:0.001, OH:0.002, "
+        "CH3:1e-4, HO2:1e-5, CH2O:1e-5");
+
+    std::vector<size_t> targets;
+    targets.push_back(thermo.speciesIndex("CH4"));
+    targets.push_back(thermo.speciesIndex("O2"));
+    targets.push_back(thermo.speciesIndex("CO"));
+    std::vector<size_t> active;
+
+    // With a threshold of zero, all reactions are retained
+    kin_red.setDynamicReduction(targets, 0.0);
+    EXPECT_TRUE(kin_red.dynamicReduction());
+    kin.getNetProductionRates(&wdot[0]);
+    kin_red.getNetProductionRates(&wdot_red[0]);
+    kin_red.getActiveReactions(active);
+    EXPECT_EQ(kin.nReactions(), active.size());
+    for (size_t k = 0; k < nsp; k++) {
+        EXPECT_DOUBLE_EQ(wdot[k], wdot_red[k]) << k;
+    }
+
+    kin_red.setDynamicReduction(targets, 1e-3);
+    kin_red.getNetProductionRates(&wdot_red[0]);
+    kin_red.getActiveReactions(active);
+    EXPECT_LT(active.size(), kin.nReactions());
+    for (size_t j = 0; j < targets.size(); j++) {
+        size_t k = targets[j];
+        EXPECT_NEAR(wdot[k], wdot_red[k], 1e-2 * std::abs(wdot[k])) << k;
+    }
+
+    vector_fp R;
+    kin.getDRGEPCoefficients(targets, R);
+    EXPECT_DOUBLE_EQ(1.0, R[targets[0]]);
+    EXPECT_EQ(0.0, R[thermo.speciesIndex("AR")]);
+
+    // A state in the same bin reuses the reduced mechanism
+    thermo.setState_TP(1610, OneAtm);
+    kin_red.getNetProductionRates(&wdot_red[0]);
+    EXPECT_EQ((size_t) 1, kin_red.nReducedMechanisms());
+    thermo.setState_TP(1700, OneAtm);
+    kin_red.getNetProductionRates(&wdot_red[0]);
+    EXPECT_EQ((size_t) 2, kin_red.nReducedMechanisms());
+
+    kin_red.clearDynamicReduction();
+    EXPECT_FALSE(kin_red.dynamicReduction());
+    kin.getNetProductionRates(&wdot[0]);
+    kin_red.getNetProductionRates(&wdot_red[0]);
+    for (size_t k = 0; k < nsp; k++) {
+        EXPECT_DOUBLE_EQ(wdot[k], wdot_red[k]) << k;
+    }
+}
+
+TEST(GasKinetics, DynamicReductionConsistency)
+{
+    // The reduced mechanism should behave exactly like the full mechanism
+    // with the multipliers of the excluded reactions set to zero, for the
+    // rate constants and rates of progress as well as their derivatives.
+    IdealGasPhase thermo("gri30.xml", "gri30");
+    std::vector<ThermoPhase*> phases(1, &thermo);
+    GasKinetics kin, kin_red;
+    importKinetics(thermo.xml(), phases, &kin);
+    importKinetics(thermo.xml(), phases, &kin_red);
+    size_t nsp = thermo.nSpecies();
+    size_t nr = kin.nReactions();
+    thermo.setState_TPX(1610, OneAtm, "CH4:0.05, O2:0.15, N2:0.7, H2O:0.05, "
+        "CO2:0.02, CO:0.01, H2:0.005, H:0.001, O:0.001, OH:0.002, "
+        "CH3:1e-4, HO2:1e-5, CH2O:1e-5");
+
+    std::vector<size_t> targets;
+    targets.push_back(thermo.speciesIndex("CH4"));
+    targets.push_back(thermo.speciesIndex("O2"));
+    targets.push_back(thermo.speciesIndex("CO"));
+    kin_red.setDynamicReduction(targets, 1e-3);
+
+    // getFwdRateConstants selects the reduced mechanism for the state
+    vector_fp kf(nr), kf_red(nr), kr(nr), kr_red(nr);
+    kin_red.getFwdRateConstants(&kf_red[0]);
+    std::vector<size_t> active;
+    kin_red.getActiveReactions(active);
+    ASSERT_LT(active.size(), nr);
+    ASSERT_EQ((size_t) 1, kin_red.nReducedMechanisms());
+    vector_fp mask(nr, 0.0);
+    for (size_t j = 0; j < active.size(); j++) {
+        mask[active[j]] = 1.0;
+    }
+    for (size_t i = 0; i < nr; i++) {
+        kin.setMultiplier(i, mask[i]);
+    }
+
+    kin.getFwdRateConstants(&kf[0]);
+    kin.getRevRateConstants(&kr[0]);
+    kin_red.getRevRateConstants(&kr_red[0]);
+    vector_fp rop(nr), rop_red(nr);
+    kin.getNetRatesOfProgress(&rop[0]);
+    kin_red.getNetRatesOfProgress(&rop_red[0]);
+    for (size_t i = 0; i < nr; i++) {
+        if (!mask[i]) {
+            EXPECT_EQ(0.0, kf_red[i]) << i;
+            EXPECT_EQ(0.0, kr_red[i]) << i;
+            EXPECT_EQ(0.0, rop_red[i]) << i;
+        }
+        EXPECT_NEAR(kf[i], kf_red[i], 1e-12 * std::abs(kf[i])) << i;
+        EXPECT_NEAR(kr[i], kr_red[i], 1e-12 * std::abs(kr[i])) << i;
+        EXPECT_NEAR(rop[i], rop_red[i], 1e-12 * std::abs(rop[i])) << i;
+    }
+
+    SparseMatrix drop, drop_red;
+    kin.getNetRatesOfProgress_ddC(drop);
+    kin_red.getNetRatesOfProgress_ddC(drop_red);
+    for (size_t i = 0; i < nr; i++) {
+        for (size_t k = 0; k < nsp; k++) {
+            double ref = drop(i,k);
+            if (!mask[i]) {
+                EXPECT_EQ(0.0, drop_red(i,k)) << i << ", " << k;
+            }
+            EXPECT_NEAR(ref, drop_red(i,k), 1e-12 * std::abs(ref))
+                << i << ", " << k;
+        }
+    }
+
+    vector_fp dwdot(nsp), dwdot_red(nsp);
+    kin.getNetProductionRates_ddT(&dwdot[0]);
+    kin_red.getNetProductionRates_ddT(&dwdot_red[0]);
+    double scale = 0.0;
+    for (size_t k = 0; k < nsp; k++) {
+        scale = std::max(scale, std::abs(dwdot[k]));
+    }
+    for (size_t k = 0; k < nsp; k++) {
+        EXPECT_NEAR(dwdot[k], dwdot_red[k], 1e-8 * scale) << k;
+    }
+    EXPECT_EQ((size_t) 1, kin_red.nReducedMechanisms());
+}
+
+TEST(GasKinetics, DynamicReductionCache)
+{
+    // With tabulated rates and a single stored mechanism, returning to a
+    // state regenerates its mechanism and reproduces the production rates
+    // of the full mechanism with the excluded reactions switched off.
+    IdealGasPhase thermo("gri30.xml", "gri30");
+    std::vector<ThermoPhase*> phases(1, &thermo);
+    GasKinetics kin, kin_red;
+    importKinetics(thermo.xml(), phases, &kin);
+    importKinetics(thermo.xml(), phases, &kin_red);
+    size_t nsp = thermo.nSpecies();
+    size_t nr = kin.nReactions();
+    thermo.setState_TPX(1610, OneAtm, "CH4:0.05, O2:0.15, N2:0.7, H2O:0.05, "
+        "CO2:0.02, CO:0.01, H2:0.005, H:0.001, O:0.001, OH:0.002, "
+        "CH3:1e-4, HO2:1e-5, CH2O:1e-5");
+
+    std::vector<size_t> targets;
+    targets.push_back(thermo.speciesIndex("CH4"));
+    targets.push_back(thermo.speciesIndex("O2"));
+    targets.push_back(thermo.speciesIndex("CO"));
+    EXPECT_THROW(kin_red.setDynamicReduction(targets, 1e-3, 25.0, 0.5, 0),
+                 CanteraError);
+    kin_red.setDynamicReduction(targets, 1e-3, 25.0, 0.5, 1);
+    kin.setRateTabulation(300, 3000, 1e-8);
+    kin_red.setRateTabulation(300, 3000, 1e-8);
+
+    vector_fp wdot(nsp), wdot_red(nsp), wdot0(nsp);
+    kin_red.getNetProductionRates(&wdot0[0]);
+    std::vector<size_t> active;
+    kin_red.getActiveReactions(active);
+    ASSERT_LT(active.size(), nr);
+    for (size_t i = 0; i < nr; i++) {
+        kin.setMultiplier(i, 0.0);
+    }
+    for (size_t j = 0; j < active.size(); j++) {
+        kin.setMultiplier(active[j], 1.0);
+    }
+    kin.getNetProductionRates(&wdot[0]);
+    double scale = 0.0;
+    for (size_t k = 0; k < nsp; k++) {
+        scale = std::max(scale, std::abs(wdot[k]));
+    }
+    for (size_t k = 0; k < nsp; k++) {
+        EXPECT_NEAR(wdot[k], wdot0[k], 1e-12 * scale) << k;
+    }
+
+    thermo.setState_TP(1700, OneAtm);
+    kin_red.getNetProductionRates(&wdot_red[0]);
+    EXPECT_EQ((size_t) 1, kin_red.nReducedMechanisms());
+
+    thermo.setState_TP(1610, OneAtm);
+    kin_red.getNetProductionRates(&wdot_red[0]);
+    EXPECT_EQ((size_t) 1, kin_red.nReducedMechanisms());
+    for (size_t k = 0; k < nsp; k++) {
+        EXPECT_NEAR(wdot0[k], wdot_red[k], 1e-12 * scale) << k;
+    }
+}
+
 }
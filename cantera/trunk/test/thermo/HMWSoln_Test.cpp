@@ -0,0 +1,173 @@
+#include "gtest/gtest.h"
+#include "cantera/thermo/HMWSoln.h"
+
+namespace Cantera
+{
+
+// The reference values below were computed with the implementation of the
+// Pitzer sums which looped over all pairs and triplets of species, before
+// the interaction lists were introduced, at a pressure of 5 bar and these
+// temperatures. The temperature derivatives of ln(gamma) were obtained from
+// the partial molar enthalpies and heat capacities, and the pressure
+// derivatives from the partial molar volumes.
+const double T_ref[3] = {298.15, 350.0, 423.15};
+
+// HMW_NaCl_sp1977_alt.xml: logarithms of the molality activity coefficients,
+// for each temperature in T_ref
+const double lnac_sp1977[3][5] = {
+    {-0.082857371243866079, 0.00056214520838962251, 1.5315270477363248, 0.00056233609266062112, -0.60774971724692928},
+    {-0.074794100124687637, -0.057053540282313638, 1.3153125972190611, -0.057053385709109235, -0.82396416776419323},
+    {-0.04923415243034366, -0.38263888674440427, 0.97455448712266612, -0.38263873564499279, -1.1647222778605881}
+};
+
+// HMW_NaCl_sp1977_alt.xml: first temperature derivatives of ln(gamma)
+const double dlnac_dT_sp1977[3][5] = {
+    {-1.2886806362963591e-05, 0.0012571450580433627, -0.0042209230694952148, 0.0012571438038438451, -0.0042209230694952001},
+    {0.00027297070014247734, -0.0029136310105497875, -0.0042330112611994692, -0.0029136313126208891, -0.0042330112611994614},
+    {0.00040596775402163384, -0.0057686760502013538, -0.0052813219107897581, -0.0057686759386219953, -0.0052813219107897573}
+};
+
+// HMW_NaCl_sp1977_alt.xml: second temperature derivatives of ln(gamma)
+const double d2lnac_dT2_sp1977[3][5] = {
+    {9.3168194213629811e-06, -0.00012506327577096503, 1.4171964197588778e-06, -0.00012506324681335712, 1.4171964197587842e-06},
+    {3.2292620269538119e-06, -5.6632957031719182e-05, -1.0037310803011314e-05, -5.6632946363681406e-05, -1.0037310803011361e-05},
+    {1.5661238324791151e-06, -3.8930412167808959e-05, -2.7595267266449334e-05, -3.893040957263615e-05, -2.7595267266449341e-05}
+};
+
+// HMW_NaCl_sp1977_alt.xml: pressure derivatives of ln(gamma)
+const double dlnac_dP_sp1977[3][5] = {
+    {-2.5842078518162905e-11, 5.5107461373397435e-10, 5.5107461373397425e-10, 5.5107461373397435e-10, 5.5107461373397435e-10},
+    {-3.6762372682256337e-11, 7.839466284254113e-10, 7.8394662842541119e-10, 7.839466284254113e-10, 7.839466284254113e-10},
+    {-7.2726456908536979e-11, 1.5508699937175511e-09, 1.5508699937175513e-09, 1.5508699937175511e-09, 1.5508699937175511e-09}
+};
+
+// HMW_NaCl_sp1977_alt.xml: osmotic coefficients
+const double osm_sp1977[3] = {1.2812876532685606, 1.244573117623178, 1.1281908706606432};
+
+// HMW_NaCl_ternary.xml: logarithms of the molality activity coefficients,
+// for each temperature in T_ref
+const double lnac_ternary[3][7] = {
+    {-0.088714932001051267, 0.0018766252083899137, 1.5315270474567848, 0.039876814418015945, -0.60774971724736171, 0.30052359852531424, 1.23708},
+    {-0.081458146921504548, -0.052774521736070779, 1.3402849003278996, -0.013359090826759408, -0.80469987442381941, 0.4239662869850821, 1.2566262945951701},
+    {-0.057088238526690718, -0.37362887107120601, 1.0415522436323243, -0.33283821214867421, -1.1182799120441815, 0.60926623967734284, 1.2797636493257638}
+};
+
+// HMW_NaCl_ternary.xml: first temperature derivatives of ln(gamma). The
+// values for H+ and Na+ differ from those of the old implementation, which
+// added the ternary psi terms of the cations a second time, as if they were
+// zeta terms; these agree with finite differences of ln(gamma).
+const double dlnac_dT_ternary[3][7] = {
+    {-2.8156876764274483e-05, 0.0013112093433960202, -0.0037778257472802059, 0.0013421381178791868, -0.0038493841429612075, 0.0023175561641046796, 0.0004088814355189983},
+    {0.00025712651368099161, -0.0028533447251698324, -0.0037128567651894531, -0.0028296307457132733, -0.0038614723346648045, 0.0024439747311611982, 0.00034830857142858899},
+    {0.00038926812650523133, -0.0056996117647828146, -0.0046524551245147993, -0.0056856632010507347, -0.0049097829842545447, 0.0026223260943278146, 0.00028809641970930664}
+};
+
+// HMW_NaCl_ternary.xml: second temperature derivatives of ln(gamma)
+const double d2lnac_dT2_ternary[3][7] = {
+    {9.3061127903284418e-06, -0.0001249432757704379, 2.9033521364518387e-06, -0.000125085745665318, 1.4171964197751109e-06, 2.4381594417849805e-06, -1.371395054566369e-06},
+    {3.2178776111698999e-06, -5.6512957031191773e-05, -8.5511550903457291e-06, -5.6649272893766266e-05, -1.0037310803001259e-05, 2.4381594417852283e-06, -9.9516734693887667e-07},
+    {1.5541731428089466e-06, -3.8810412167281624e-05, -2.6109111556614187e-05, -3.8941579266872735e-05, -2.7595267266443608e-05, 2.4381594417850474e-06, -6.8083757464088518e-07}
+};
+
+// HMW_NaCl_ternary.xml: pressure derivatives of ln(gamma)
+const double dlnac_dP_ternary[3][7] = {
+    {-2.5842078518162905e-11, 5.5107461373397435e-10, 5.5107461373397425e-10, 5.5107461373397435e-10, 5.5107461373397435e-10, 0, 0},
+    {-3.6762372682256337e-11, 7.839466284254113e-10, 7.8394662842541119e-10, 7.839466284254113e-10, 7.839466284254113e-10, 0, 0},
+    {-7.2726456908536979e-11, 1.5508699937175511e-09, 1.5508699937175513e-09, 1.5508699937175511e-09, 1.5508699937175511e-09, 0, 0}
+};
+
+// HMW_NaCl_ternary.xml: osmotic coefficients
+const double osm_ternary[3] = {1.2923778690917469, 1.2603852408864689, 1.152946835294242};
+
+class HMWSolnTest : public testing::Test
+{
+public:
+    void compare(double ref, double value, double rtol,
+                 const std::string& what, size_t k, size_t n) {
+        EXPECT_NEAR(ref, value, rtol * std::abs(ref) + 1e-14)
+            << what << ", species " << k << ", T = " << T_ref[n];
+    }
+
+    //! Compare ln(gamma), its first two temperature derivatives, its pressure
+    //! derivative and the osmotic coefficient with the reference values. The
+    //! arrays are indexed as [n*kk+k] for temperature n and species k.
+    void check(const std::string& file, size_t kk, const double* lnac,
+               const double* dlnac_dT, const double* d2lnac_dT2,
+               const double* dlnac_dP, const double* osm) {
+        HMWSoln s(file, "");
+        ASSERT_EQ(kk, s.nSpecies());
+        vector_fp ac(kk), h(kk), h0(kk), cp(kk), cp0(kk), v(kk), v0(kk);
+        for (size_t n = 0; n < 3; n++) {
+            double T = T_ref[n];
+            double RT = GasConstant * T;
+            s.setState_TP(T, 5e5);
+            s.getMolalityActivityCoefficients(&ac[0]);
+            s.getPartialMolarEnthalpies(&h[0]);
+            s.getEnthalpy_RT(&h0[0]);
+            s.getPartialMolarCp(&cp[0]);
+            s.getCp_R(&cp0[0]);
+            s.getPartialMolarVolumes(&v[0]);
+            s.getStandardVolumes(&v0[0]);
+            for (size_t k = 0; k < kk; k++) {
+                double dT = -(h[k] - RT * h0[k]) / (RT * T);
+                double d2T = -(cp[k] - GasConstant * cp0[k]
+                               + 2 * GasConstant * T * dT) / (RT * T);
+                compare(lnac[n*kk+k], log(ac[k]), 1e-10, "ln(gamma)", k, n);
+                compare(dlnac_dT[n*kk+k], dT, 1e-8, "dln(gamma)/dT", k, n);
+                compare(d2lnac_dT2[n*kk+k], d2T, 1e-8, "d2ln(gamma)/dT2", k, n);
+                compare(dlnac_dP[n*kk+k], (v[k] - v0[k]) / RT, 1e-8,
+                        "dln(gamma)/dP", k, n);
+            }
+            compare(osm[n], s.osmoticCoefficient(), 1e-10, "osmotic", 0, n);
+        }
+    }
+};
+
+TEST_F(HMWSolnTest, activityCoefficients)
+{
+    check("../data/HMW_NaCl_sp1977_alt.xml", 5, &lnac_sp1977[0][0],
+          &dlnac_dT_sp1977[0][0], &d2lnac_dT2_sp1977[0][0], &dlnac_dP_sp1977[0][0],
+          osm_sp1977);
+}
+
+TEST_F(HMWSolnTest, ternaryActivityCoefficients)
+{
+    // Includes interactions between each pair of cations and each pair of
+    // anions with a common third ion, which are evaluated from the lists of
+    // nonzero psi parameters
+    check("../data/HMW_NaCl_ternary.xml", 7, &lnac_ternary[0][0],
+          &dlnac_dT_ternary[0][0], &d2lnac_dT2_ternary[0][0], &dlnac_dP_ternary[0][0],
+          osm_ternary);
+}
+
+TEST_F(HMWSolnTest, derivativesIndependentOfCallOrder)
+{
+    // The derivatives are computed in the same pass as the activity
+    // coefficients when those are not current, and from the cached
+    // activity coefficients otherwise. Both must give the same results,
+    // also after value-only evaluations at other states.
+    HMWSoln s1("../data/HMW_NaCl_ternary.xml", "");
+    HMWSoln s2("../data/HMW_NaCl_ternary.xml", "");
+    size_t kk = s1.nSpecies();
+    vector_fp ac(kk), cp1(kk), cp2(kk), v1(kk), v2(kk);
+    for (size_t n = 0; n < 3; n++) {
+        s1.setState_TP(T_ref[n], 5e5);
+        s1.getPartialMolarCp(&cp1[0]);
+        s1.getPartialMolarVolumes(&v1[0]);
+
+        s2.setState_TP(T_ref[2-n], 1e6);
+        s2.getMolalityActivityCoefficients(&ac[0]);
+        s2.setState_TP(T_ref[n], 5e5);
+        s2.getMolalityActivityCoefficients(&ac[0]);
+        s2.getPartialMolarVolumes(&v2[0]);
+        s2.getPartialMolarCp(&cp2[0]);
+        // The standard state of water is found iteratively, starting from
+        // the previous density, so it depends slightly on the history.
+        for (size_t k = 0; k < kk; k++) {
+            compare(cp1[k], cp2[k], 1e-8, "cp", k, n);
+            compare(v1[k], v2[k], 1e-8, "volume", k, n);
+        }
+    }
+}
+
+}
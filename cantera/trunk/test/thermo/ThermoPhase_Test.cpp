@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include "cantera/thermo/ThermoPhase.h"
 #include "cantera/thermo/ThermoFactory.h"
+#include "cantera/thermo/IdealGasPhase.h"
 #include <vector>
 
 namespace Cantera
@@ -75,6 +76,46 @@ TEST_F(TestThermoMethods, getMoleFractionsByName)
     EXPECT_EQ(X.size(), (size_t) 3);
 }
 
+TEST_F(TestThermoMethods, stateNumbers)
+{
+    thermo->setState_TPX(500, OneAtm, "O2:0.2, H2:0.3, AR:0.5");
+    int nT = thermo->stateTNumber();
+    int nD = thermo->stateDNumber();
+    int nX = thermo->stateMFNumber();
+
+    // Setting the same values again does not change the temperature and
+    // density numbers
+    thermo->setTemperature(500);
+    thermo->setDensity(thermo->density());
+    EXPECT_EQ(nT, thermo->stateTNumber());
+    EXPECT_EQ(nD, thermo->stateDNumber());
+
+    thermo->setTemperature(600);
+    EXPECT_GT(thermo->stateTNumber(), nT);
+    EXPECT_EQ(nD, thermo->stateDNumber());
+    EXPECT_EQ(nX, thermo->stateMFNumber());
+
+    nT = thermo->stateTNumber();
+    thermo->setPressure(2 * OneAtm);
+    EXPECT_GT(thermo->stateDNumber(), nD);
+    EXPECT_EQ(nT, thermo->stateTNumber());
+
+    vector_fp state;
+    thermo->saveState(state);
+    nD = thermo->stateDNumber();
+    thermo->setMassFractionsByName("H2:1.0");
+    EXPECT_GT(thermo->stateMFNumber(), nX);
+    nX = thermo->stateMFNumber();
+    thermo->setMolarDensity(3.0);
+    EXPECT_GT(thermo->stateDNumber(), nD);
+
+    nD = thermo->stateDNumber();
+    thermo->restoreState(state);
+    EXPECT_GT(thermo->stateMFNumber(), nX);
+    EXPECT_GT(thermo->stateDNumber(), nD);
+    EXPECT_EQ(nT, thermo->stateTNumber());
+}
+
 TEST_F(TestThermoMethods, getMassFractionsByName)
 {
     thermo->setMassFractionsByName("O2:0.2, H2:0.3, AR:0.5");
@@ -91,4 +132,33 @@ TEST_F(TestThermoMethods, getMassFractionsByName)
     EXPECT_EQ(Y.size(), (size_t) 3);
 }
 
+TEST(IdealGasPhase, BatchTemperatures)
+{
+    IdealGasPhase gas("h2o2.xml");
+    size_t kk = gas.nSpecies();
+    const char* X[] = {"O2:0.2, H2:0.3, AR:0.5", "H2O:1.0",
+                       "OH:0.1, H:0.2, O:0.3, H2O:0.4", "AR:1.0"};
+    double Tset[] = {320.0, 1050.0, 2870.0, 1800.0};
+    const size_t n = 4;
+    vector_fp h(n), u(n), Y(n*kk), T_h(n), T_u(n);
+    for (size_t i = 0; i < n; i++) {
+        gas.setState_TPX(Tset[i], OneAtm, X[i]);
+        h[i] = gas.enthalpy_mass();
+        u[i] = gas.intEnergy_mass();
+        gas.getMassFractions(&Y[i*kk]);
+        T_h[i] = 1000.0;
+    }
+    gas.setState_TPX(500.0, OneAtm, "H2:1.0");
+    int nT = gas.stateTNumber();
+    gas.getTemperatures_HY(n, &h[0], &Y[0], &T_h[0], 1e-8);
+    gas.getTemperatures_UY(n, &u[0], &Y[0], &T_u[0], 1e-8);
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_NEAR(Tset[i], T_h[i], 1e-7) << i;
+        EXPECT_NEAR(Tset[i], T_u[i], 1e-7) << i;
+    }
+    // The state of the phase is unchanged
+    EXPECT_EQ(nT, gas.stateTNumber());
+    EXPECT_DOUBLE_EQ(500.0, gas.temperature());
+}
+
 }
@@ -94,3 +94,97 @@ TEST_F(SpeciesThermoInterpTypeTest, install_shomate)
     EXPECT_FLOAT_EQ(p2.entropy_mass(), p.entropy_mass());
     EXPECT_FLOAT_EQ(p2.cp_mass(), p.cp_mass());
 }
+
+TEST(GeneralSpeciesThermo, copy_and_modify)
+{
+    GeneralSpeciesThermo sp;
+    SpeciesThermoInterpType* stit_o2 = new NasaPoly2(200, 3500, 101325, o2_nasa_coeffs);
+    SpeciesThermoInterpType* stit_h2 = new NasaPoly2(200, 3500, 101325, h2_nasa_coeffs);
+    stit_o2->setIndex(0);
+    stit_h2->setIndex(1);
+    sp.install_STIT(stit_o2);
+    sp.install_STIT(stit_h2);
+
+    // The copy shares the parameterizations until one of them is modified
+    GeneralSpeciesThermo sp2(sp);
+    double h0 = sp.reportOneHf298(0);
+    sp2.modifyOneHf298(0, h0 + 1e6);
+    EXPECT_DOUBLE_EQ(h0, sp.reportOneHf298(0));
+    EXPECT_NEAR(h0 + 1e6, sp2.reportOneHf298(0), 1e-6 * std::abs(h0 + 1e6));
+
+    double cp1[2], h1[2], s1[2], cp2[2], h2[2], s2[2];
+    sp.update(1000, cp1, h1, s1);
+    sp2.update(1000, cp2, h2, s2);
+    EXPECT_DOUBLE_EQ(cp1[0], cp2[0]);
+    EXPECT_DOUBLE_EQ(s1[0], s2[0]);
+    EXPECT_NE(h1[0], h2[0]);
+    EXPECT_DOUBLE_EQ(h1[1], h2[1]);
+}
+
+TEST(GeneralSpeciesThermo, nasa2_batch)
+{
+    IdealGasPhase gas("gri30.xml", "gri30");
+    const SpeciesThermo& sp = gas.speciesThermo();
+    size_t kk = gas.nSpecies();
+    vector_fp cp(kk), h(kk), s(kk), cp1(kk), h1(kk), s1(kk);
+    double T[] = {300.0, 999.0, 1000.0, 1001.0, 2500.0};
+    for (size_t n = 0; n < 5; n++) {
+        sp.update(T[n], &cp[0], &h[0], &s[0]);
+        for (size_t k = 0; k < kk; k++) {
+            sp.update_one(k, T[n], &cp1[0], &h1[0], &s1[0]);
+            EXPECT_DOUBLE_EQ(cp1[k], cp[k]) << k << ", " << T[n];
+            EXPECT_DOUBLE_EQ(h1[k], h[k]) << k << ", " << T[n];
+            EXPECT_DOUBLE_EQ(s1[k], s[k]) << k << ", " << T[n];
+        }
+    }
+}
+
+// Compare the properties evaluated for several temperatures at once with
+// those evaluated one temperature at a time
+void checkMultipleTemperatures(const SpeciesThermo& sp, size_t kk)
+{
+    const size_t nT = 7;
+    double T[nT] = {300.0, 999.0, 1000.0, 1001.0, 1200.0, 2500.0, 500.0};
+    vector_fp cp(kk), h(kk), s(kk), cpn(kk*nT), hn(kk*nT), sn(kk*nT);
+    sp.update(nT, T, &cpn[0], &hn[0], &sn[0]);
+    for (size_t n = 0; n < nT; n++) {
+        sp.update(T[n], &cp[0], &h[0], &s[0]);
+        for (size_t k = 0; k < kk; k++) {
+            EXPECT_DOUBLE_EQ(cp[k], cpn[k*nT + n]) << k << ", " << T[n];
+            EXPECT_DOUBLE_EQ(h[k], hn[k*nT + n]) << k << ", " << T[n];
+            EXPECT_DOUBLE_EQ(s[k], sn[k*nT + n]) << k << ", " << T[n];
+        }
+    }
+}
+
+TEST(GeneralSpeciesThermo, multiple_temperatures)
+{
+    IdealGasPhase gas("gri30.xml", "gri30");
+    checkMultipleTemperatures(gas.speciesThermo(), gas.nSpecies());
+
+    // Mixed parameterizations, with NASA2 species which are not contiguous
+    GeneralSpeciesThermo sp;
+    SpeciesThermoInterpType* stit[4];
+    stit[0] = new NasaPoly2(200, 3500, 101325, o2_nasa_coeffs);
+    stit[1] = new ShomatePoly2(200, 6000, 101325, co_shomate_coeffs);
+    stit[2] = new ConstCpPoly(200, 5000, 101325, c_h2o);
+    stit[3] = new NasaPoly2(200, 3500, 101325, h2_nasa_coeffs);
+    for (size_t k = 0; k < 4; k++) {
+        stit[k]->setIndex(k);
+        sp.install_STIT(stit[k]);
+    }
+    checkMultipleTemperatures(sp, 4);
+
+    // The default implementation, which evaluates one temperature at a time
+    double T[2] = {800.0, 1500.0};
+    double cp[8], h[8], s[8], cp1[4], h1[4], s1[4];
+    sp.SpeciesThermo::update(2, T, cp, h, s);
+    for (size_t n = 0; n < 2; n++) {
+        sp.update(T[n], cp1, h1, s1);
+        for (size_t k = 0; k < 4; k++) {
+            EXPECT_EQ(cp1[k], cp[2*k + n]);
+            EXPECT_EQ(h1[k], h[2*k + n]);
+            EXPECT_EQ(s1[k], s[2*k + n]);
+        }
+    }
+}
@@ -0,0 +1,322 @@
+#include "gtest/gtest.h"
+
+#include "cantera/transport/MixTransport.h"
+#include "cantera/transport/MultiTransport.h"
+#include "cantera/transport/TransportFactory.h"
+#include "cantera/thermo/ThermoFactory.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace Cantera
+{
+
+//! Gives the tests access to the property fits of a MixTransport object
+class TestMixTransport : public MixTransport
+{
+public:
+    //! Value of the viscosity fit of species k at the current temperature,
+    //! evaluated directly from its polynomial coefficients
+    double viscosityFit(size_t k) {
+        return evalFit(m_visccoeffs[k]);
+    }
+
+    //! Value of the binary diffusion coefficient fit of species pair ic at
+    //! the current temperature, evaluated directly from its coefficients
+    double diffusionFit(size_t ic) {
+        return evalFit(m_diffcoeffs[ic]);
+    }
+
+    using MixTransport::fitCacheKey;
+    using MixTransport::readFitCache;
+    using MixTransport::writeFitCache;
+    using MixTransport::m_visccoeffs;
+    using MixTransport::m_condcoeffs;
+    using MixTransport::m_diffcoeffs;
+    using MixTransport::m_poly;
+    using MixTransport::m_omega22_poly;
+    using MixTransport::m_astar_poly;
+    using MixTransport::m_bstar_poly;
+    using MixTransport::m_cstar_poly;
+
+protected:
+    double evalFit(const vector_fp& c) {
+        double logt = log(m_thermo->temperature());
+        double f = 0.0;
+        double tn = 1.0;
+        for (size_t n = 0; n < c.size(); n++) {
+            f += tn * c[n];
+            tn *= logt;
+        }
+        return f;
+    }
+};
+
+//! Name for a file in the system's temporary directory
+static std::string tempPath(const std::string& name)
+{
+    const char* vars[] = {"TMPDIR", "TEMP", "TMP"};
+    for (size_t i = 0; i < 3; i++) {
+        const char* dir = getenv(vars[i]);
+        if (dir && *dir) {
+            return std::string(dir) + "/" + name;
+        }
+    }
+#ifdef _WIN32
+    return "./" + name;
+#else
+    return "/tmp/" + name;
+#endif
+}
+
+//! Check that two transport managers have bit-for-bit identical fits
+static void compareFits(TestMixTransport& a, TestMixTransport& b)
+{
+    EXPECT_TRUE(a.m_visccoeffs == b.m_visccoeffs);
+    EXPECT_TRUE(a.m_condcoeffs == b.m_condcoeffs);
+    EXPECT_TRUE(a.m_diffcoeffs == b.m_diffcoeffs);
+    EXPECT_TRUE(a.m_poly == b.m_poly);
+    EXPECT_TRUE(a.m_omega22_poly == b.m_omega22_poly);
+    EXPECT_TRUE(a.m_astar_poly == b.m_astar_poly);
+    EXPECT_TRUE(a.m_bstar_poly == b.m_bstar_poly);
+    EXPECT_TRUE(a.m_cstar_poly == b.m_cstar_poly);
+}
+
+//! Counts the evaluations of the temperature-dependent property fits
+template<class Base>
+class CountingTransport : public Base
+{
+public:
+    CountingTransport() : nvisc(0), ndiff(0) {}
+
+    virtual void updateSpeciesViscosities() {
+        nvisc++;
+        Base::updateSpeciesViscosities();
+    }
+
+    virtual void updateDiff_T() {
+        ndiff++;
+        Base::updateDiff_T();
+    }
+
+    int nvisc;
+    int ndiff;
+};
+
+class GasTransportTest : public testing::Test
+{
+public:
+    GasTransportTest() : gas(newPhase("gri30.xml", "gri30_mix")) {
+        gas->setState_TPX(300.0, OneAtm, "H2:0.4, O2:0.3, CH4:0.1, N2:1.0");
+    }
+
+    shared_ptr<ThermoPhase> gas;
+};
+
+TEST_F(GasTransportTest, packedFits)
+{
+    // The species viscosities and binary diffusion coefficients, which are
+    // evaluated from the packed fit coefficients, match the individual fits
+    int modes[] = {0, CK_Mode};
+    double T[] = {300.0, 777.7, 1500.0, 2900.0};
+    size_t kk = gas->nSpecies();
+    vector_fp visc(kk), bdiff(kk*kk);
+    for (size_t m = 0; m < 2; m++) {
+        TestMixTransport tr;
+        tr.init(gas.get(), modes[m]);
+        for (size_t n = 0; n < 4; n++) {
+            gas->setState_TP(T[n], OneAtm);
+            double t14 = sqrt(sqrt(T[n]));
+            double t32 = T[n] * sqrt(T[n]);
+            tr.getSpeciesViscosities(&visc[0]);
+            tr.getBinaryDiffCoeffs(kk, &bdiff[0]);
+            size_t ic = 0;
+            for (size_t i = 0; i < kk; i++) {
+                double f = tr.viscosityFit(i);
+                double v = (modes[m] == CK_Mode) ? exp(f) : pow(t14 * f, 2);
+                EXPECT_DOUBLE_EQ(v, visc[i]) << m << ", " << T[n] << ", " << i;
+                for (size_t j = i; j < kk; j++) {
+                    f = tr.diffusionFit(ic++);
+                    double d = (modes[m] == CK_Mode) ? exp(f) : t32 * f;
+                    d /= OneAtm;
+                    EXPECT_DOUBLE_EQ(d, bdiff[kk*j+i])
+                        << m << ", " << T[n] << ", " << i << ", " << j;
+                    EXPECT_DOUBLE_EQ(d, bdiff[kk*i+j])
+                        << m << ", " << T[n] << ", " << i << ", " << j;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(GasTransportTest, mixtureViscosity)
+{
+    // The Wilke mixture rule, evaluated from the factors of the weighting
+    // functions which depend only on the molecular weights, matches the rule
+    // evaluated directly from Poling and Prausnitz, Eq. (9-5.14)
+    const char* X[] = {"H2:0.4, O2:0.3, CH4:0.1, N2:1.0",
+                       "H2O:0.2, CO2:0.1, AR:0.5, C3H8:0.01, N2:0.7",
+                       "H:0.1, O:0.1, OH:0.2, HO2:0.01, H2O2:0.03, CH2CHO:1e-3"};
+    double T[] = {300.0, 1200.0, 2500.0};
+    size_t kk = gas->nSpecies();
+    vector_fp visc(kk), x(kk);
+    const vector_fp& mw = gas->molecularWeights();
+    MixTransport tr;
+    tr.init(gas.get());
+    for (size_t n = 0; n < 3; n++) {
+        for (size_t m = 0; m < 3; m++) {
+            gas->setState_TPX(T[n], OneAtm, X[m]);
+            gas->getMoleFractions(&x[0]);
+            tr.getSpeciesViscosities(&visc[0]);
+            double mu = 0.0;
+            for (size_t k = 0; k < kk; k++) {
+                double denom = 0.0;
+                for (size_t j = 0; j < kk; j++) {
+                    double phi = 1.0 + sqrt(visc[k] / visc[j]) *
+                                 pow(mw[j] / mw[k], 0.25);
+                    phi = phi * phi / sqrt(8.0 * (1.0 + mw[k] / mw[j]));
+                    denom += phi * std::max(x[j], Tiny);
+                }
+                mu += std::max(x[k], Tiny) * visc[k] / denom;
+            }
+            EXPECT_NEAR(mu, tr.viscosity(), 1e-13 * mu) << T[n] << ", " << m;
+        }
+    }
+}
+
+TEST_F(GasTransportTest, transportProperties)
+{
+    // The properties of a set of states spanning several blocks match the
+    // values at each state to within rounding error, and the fits are
+    // evaluated for the blocks rather than point by point
+    CountingTransport<MixTransport> trMix;
+    CountingTransport<MultiTransport> trMulti;
+    trMix.init(gas.get());
+    trMulti.init(gas.get());
+    Transport* trans[] = {&trMix, &trMulti};
+    int* nvisc[] = {&trMix.nvisc, &trMulti.nvisc};
+    int* ndiff[] = {&trMix.ndiff, &trMulti.ndiff};
+
+    const size_t N = 37;
+    double T0[5] = {300.0, 1000.0, 1000.0, 1800.0, 300.0};
+    double P0[5] = {OneAtm, 2e5, 5e5, 1e6, 5e4};
+    const char* comp[5] = {"H2:0.4, O2:0.3, CH4:0.1, N2:1.0",
+                           "H2O:0.2, CO2:0.1, AR:0.5, N2:0.7",
+                           "H2O:0.4, CO2:0.2, AR:0.1, N2:0.7",
+                           "H:0.1, O:0.1, OH:0.2, H2O:0.3, N2:0.5",
+                           "O2:1.0"};
+    size_t kk = gas->nSpecies();
+    vector_fp X(N*kk), dmix(N*kk), dref(kk);
+    double T[N], P[N], visc[N], cond[N];
+    for (size_t j = 0; j < N; j++) {
+        T[j] = T0[j % 5] + 10.0 * (j / 5);
+        P[j] = P0[j % 5];
+        gas->setState_TPX(T[j], P[j], comp[j % 5]);
+        gas->getMoleFractions(&X[j*kk]);
+    }
+
+    for (size_t m = 0; m < 2; m++) {
+        gas->setState_TP(500.0, OneAtm);
+        trans[m]->viscosity();
+        *nvisc[m] = *ndiff[m] = 0;
+        trans[m]->getTransportProperties(N, T, P, &X[0], visc, cond, &dmix[0]);
+        EXPECT_EQ(0, *nvisc[m]);
+        EXPECT_EQ(0, *ndiff[m]);
+
+        // the transport manager is left in a consistent state at the last
+        // point
+        EXPECT_NEAR(visc[N-1], trans[m]->viscosity(), 1e-13 * visc[N-1]);
+        EXPECT_NEAR(cond[N-1], trans[m]->thermalConductivity(),
+                    1e-13 * cond[N-1]);
+
+        Transport* tr = newTransportMgr(m ? "Multi" : "Mix", gas.get());
+        for (size_t j = 0; j < N; j++) {
+            gas->setState_TPX(T[j], P[j], &X[j*kk]);
+            double mu = tr->viscosity();
+            double lambda = tr->thermalConductivity();
+            EXPECT_NEAR(mu, visc[j], 1e-13 * mu) << m << ", " << j;
+            EXPECT_NEAR(lambda, cond[j], 1e-13 * lambda) << m << ", " << j;
+            tr->getMixDiffCoeffs(&dref[0]);
+            for (size_t k = 0; k < kk; k++) {
+                EXPECT_NEAR(dref[k], dmix[j*kk+k], 1e-13 * dref[k])
+                    << m << ", " << j << ", " << k;
+            }
+        }
+
+        // properties which were not requested are not evaluated
+        vector_fp visc2(N);
+        trans[m]->getTransportProperties(N, T, P, &X[0], &visc2[0], 0, 0);
+        for (size_t j = 0; j < N; j++) {
+            EXPECT_DOUBLE_EQ(visc[j], visc2[j]) << m << ", " << j;
+        }
+        EXPECT_EQ(0, *ndiff[m]);
+
+        // evaluating the properties point by point afterwards gives the
+        // same results
+        for (size_t j = 0; j < N; j += 6) {
+            gas->setState_TPX(T[j], P[j], &X[j*kk]);
+            EXPECT_DOUBLE_EQ(tr->thermalConductivity(),
+                             trans[m]->thermalConductivity()) << m << ", " << j;
+            trans[m]->getMixDiffCoeffs(&dref[0]);
+            EXPECT_NEAR(dmix[j*kk], dref[0], 1e-13 * dref[0])
+                << m << ", " << j;
+        }
+        delete tr;
+    }
+}
+
+TEST_F(GasTransportTest, fitCache)
+{
+    TestMixTransport tr, tr2;
+    tr.init(gas.get());
+    tr2.init(gas.get());
+    std::string key = tr.fitCacheKey();
+    std::string path = tempPath("cantera-test-gastransport-fits.txt");
+    std::remove(path.c_str());
+    EXPECT_FALSE(tr2.readFitCache(path, key));
+
+    // the fits read back from the cache are identical to the originals
+    tr.writeFitCache(path, key);
+    tr2.m_visccoeffs.clear();
+    tr2.m_diffcoeffs.clear();
+    tr2.m_omega22_poly.clear();
+    ASSERT_TRUE(tr2.readFitCache(path, key));
+    compareFits(tr, tr2);
+    gas->setState_TP(1234.5, OneAtm);
+    EXPECT_DOUBLE_EQ(tr.viscosity(), tr2.viscosity());
+
+    // the cache is not used for fits with different inputs
+    TestMixTransport trCK;
+    trCK.init(gas.get(), CK_Mode);
+    EXPECT_NE(key, trCK.fitCacheKey());
+    EXPECT_FALSE(trCK.readFitCache(path, trCK.fitCacheKey()));
+    EXPECT_FALSE(trCK.readFitCache(path, key + " "));
+    EXPECT_FALSE(trCK.m_visccoeffs == tr.m_visccoeffs);
+
+    // truncated or otherwise corrupt files are rejected without modifying
+    // the current fits
+    std::string contents;
+    {
+        std::ifstream in(path.c_str());
+        std::getline(in, contents, '\0');
+    }
+    ASSERT_GT(contents.size(), (size_t) 1000);
+    std::string corrupt[] = {contents.substr(0, contents.size() / 2),
+                             contents.substr(0, contents.rfind("end")),
+                             contents.substr(0, contents.size() / 3) + "x" +
+                                 contents.substr(contents.size() / 3 + 1),
+                             ""};
+    for (size_t i = 0; i < 4; i++) {
+        {
+            std::ofstream out(path.c_str());
+            out << corrupt[i];
+        }
+        EXPECT_FALSE(trCK.readFitCache(path, key)) << i;
+        TestMixTransport trRef;
+        trRef.init(gas.get(), CK_Mode);
+        compareFits(trRef, trCK);
+    }
+    EXPECT_EQ(0, std::remove(path.c_str()));
+}
+
+}
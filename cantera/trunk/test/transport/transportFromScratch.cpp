@@ -165,6 +165,141 @@ TEST_F(TransportFromScratch, thermalConductivityMulti)
     }
 }
 
+TEST_F(TransportFromScratch, iterativeMulti)
+{
+    // GRI-Mech 3.0 gives an L matrix large enough that GMRES restarts
+    shared_ptr<ThermoPhase> gas(newPhase("gri30.xml", "gri30_mix"));
+    MultiTransport trDirect, trIter, trFallback, trSeries, trTruncated;
+    trDirect.init(gas.get());
+    trIter.init(gas.get());
+    trFallback.init(gas.get());
+    trSeries.init(gas.get());
+    trTruncated.init(gas.get());
+    trIter.setIterativeSolver(1e-12);
+    // Too few iterations or terms to converge, so the LU solution is used
+    trFallback.setIterativeSolver(1e-12, 5);
+    trTruncated.setMultiDiffSeries(1e-12, 2);
+    trSeries.setMultiDiffSeries(1e-10, 100);
+
+    size_t K = gas->nSpecies();
+    vector_fp dtDirect(K), dtIter(K), dtFallback(K);
+    vector_fp dDirect(K*K), dSeries(K*K), dTruncated(K*K);
+    const char* X[] = {"CH4:1.0, O2:2.0, N2:7.52",
+                       "H2O:0.2, CO2:0.1, N2:0.7, OH:0.01, H:0.001",
+                       "H2:0.5, O2:0.3, AR:0.2"};
+    for (size_t i = 0; i < 9; i++) {
+        double T = 300 + 275*i;
+        gas->setState_TPX(T, 5e5, X[i % 3]);
+        double lambda = trDirect.thermalConductivity();
+        EXPECT_NEAR(lambda, trIter.thermalConductivity(), 1e-10 * lambda)
+            << "T = " << T;
+        EXPECT_DOUBLE_EQ(lambda, trFallback.thermalConductivity());
+        trDirect.getThermalDiffCoeffs(&dtDirect[0]);
+        trIter.getThermalDiffCoeffs(&dtIter[0]);
+        trFallback.getThermalDiffCoeffs(&dtFallback[0]);
+        double dtmax = 0.0;
+        for (size_t k = 0; k < K; k++) {
+            dtmax = std::max(dtmax, fabs(dtDirect[k]));
+        }
+        for (size_t k = 0; k < K; k++) {
+            EXPECT_NEAR(dtDirect[k], dtIter[k], 1e-8 * dtmax)
+                << "T = " << T << ", k = " << k;
+            EXPECT_DOUBLE_EQ(dtDirect[k], dtFallback[k]);
+        }
+
+        trDirect.getMultiDiffCoeffs(K, &dDirect[0]);
+        trSeries.getMultiDiffCoeffs(K, &dSeries[0]);
+        trTruncated.getMultiDiffCoeffs(K, &dTruncated[0]);
+        double dmax = 0.0;
+        for (size_t n = 0; n < K*K; n++) {
+            dmax = std::max(dmax, fabs(dDirect[n]));
+        }
+        for (size_t n = 0; n < K*K; n++) {
+            EXPECT_NEAR(dDirect[n], dSeries[n], 1e-8 * dmax)
+                << "T = " << T << ", n = " << n;
+            EXPECT_DOUBLE_EQ(dDirect[n], dTruncated[n]);
+        }
+    }
+
+    // A loose tolerance is met by the first two terms of the series
+    MultiTransport trLoose;
+    trLoose.init(gas.get());
+    trLoose.setMultiDiffSeries(0.1, 2);
+    gas->setState_TPX(1200, 101325, X[0]);
+    trDirect.getMultiDiffCoeffs(K, &dDirect[0]);
+    trLoose.getMultiDiffCoeffs(K, &dSeries[0]);
+    trTruncated.getMultiDiffCoeffs(K, &dTruncated[0]);
+    double dmax = 0.0, dev = 0.0;
+    for (size_t n = 0; n < K*K; n++) {
+        dmax = std::max(dmax, fabs(dDirect[n]));
+        dev = std::max(dev, fabs(dDirect[n] - dSeries[n]));
+        EXPECT_DOUBLE_EQ(dDirect[n], dTruncated[n]);
+    }
+    EXPECT_GT(dev, 0.0);
+    EXPECT_LT(dev, 0.01 * dmax);
+
+    EXPECT_THROW(trLoose.setMultiDiffSeries(1e-3, 1), CanteraError);
+}
+
+TEST_F(TransportFromScratch, compositionChange)
+{
+    MixTransport trMix;
+    MultiTransport trMulti;
+    trMix.init(test.get());
+    trMulti.init(test.get());
+
+    // Only the composition changes between evaluations
+    const char* X[] = {"H2:0.5, O2:0.3, H2O:0.2", "H2:0.1, O2:0.1, H2O:0.8",
+                       "H2:0.1, O2:0.1, H2O:0.8", "O2:1.0"};
+    for (size_t i = 0; i < 4; i++) {
+        test->setState_TPX(800, 5e5, X[i]);
+        ref->setState_TPX(800, 5e5, X[i]);
+        Transport* trRef = newTransportMgr("Multi", ref.get());
+        EXPECT_DOUBLE_EQ(trRef->viscosity(), trMix.viscosity()) << i;
+        EXPECT_DOUBLE_EQ(trRef->thermalConductivity(),
+                         trMulti.thermalConductivity()) << i;
+        delete trRef;
+    }
+}
+
+TEST_F(TransportFromScratch, batchProperties)
+{
+    MixTransport trMix;
+    MultiTransport trMulti;
+    trMix.init(test.get());
+    trMulti.init(test.get());
+    Transport* trans[] = {&trMix, &trMulti};
+
+    const size_t N = 5;
+    double T[N] = {300.0, 650.0, 650.0, 1400.0, 2600.0};
+    double P[N] = {1e5, 5e5, 5e5, 2e5, 1e6};
+    double X[3*N] = {0.5, 0.3, 0.2,
+                     0.1, 0.1, 0.8,
+                     0.6, 0.2, 0.2,
+                     0.0, 1.0, 0.0,
+                     0.2, 0.3, 0.5};
+    double visc[N], cond[N], dmix[3*N], dref[3];
+
+    for (size_t m = 0; m < 2; m++) {
+        trans[m]->getTransportProperties(N, T, P, X, visc, cond, dmix);
+        for (size_t j = 0; j < N; j++) {
+            test->setState_TPX(T[j], P[j], X + 3*j);
+            EXPECT_DOUBLE_EQ(trans[m]->viscosity(), visc[j]) << m << ", " << j;
+            EXPECT_DOUBLE_EQ(trans[m]->thermalConductivity(), cond[j])
+                << m << ", " << j;
+            trans[m]->getMixDiffCoeffs(dref);
+            for (size_t k = 0; k < 3; k++) {
+                EXPECT_DOUBLE_EQ(dref[k], dmix[3*j+k])
+                    << m << ", " << j << ", " << k;
+            }
+        }
+    }
+
+    // Outputs which are not requested are skipped
+    trMix.getTransportProperties(N, T, P, X, 0, cond, 0);
+    EXPECT_DOUBLE_EQ(trMix.thermalConductivity(), cond[N-1]);
+}
+
 int main(int argc, char** argv)
 {
     printf("Running main() from transportFromScratch.cpp\n");
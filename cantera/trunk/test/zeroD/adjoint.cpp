@@ -0,0 +1,279 @@
+#include "gtest/gtest.h"
+#include "cantera/IdealGasMix.h"
+#include "cantera/Interface.h"
+#include "cantera/zeroD/Reactor.h"
+#include "cantera/zeroD/IdealGasReactor.h"
+#include "cantera/zeroD/ConstPressureReactor.h"
+#include "cantera/zeroD/IdealGasConstPressureReactor.h"
+#include "cantera/zeroD/Reservoir.h"
+#include "cantera/zeroD/Wall.h"
+#include "cantera/zeroD/ReactorNet.h"
+
+namespace Cantera
+{
+
+class AdjointTest : public testing::Test
+{
+public:
+    AdjointTest() : gas("h2o2.xml") {
+        gas.setState_TPX(1100.0, OneAtm, "H2:2, O2:1, AR:5");
+    }
+
+    void addReactor(Reactor& r) {
+        r.insert(gas);
+        net.addReactor(r);
+        for (size_t i = 0; i < gas.nReactions(); i += 3) {
+            r.addSensitivityReaction(i);
+        }
+    }
+
+    //! Compare the analytic adjoint products with finite difference
+    //! approximations at the current state of the network.
+    void check(double t, bool jacobian, double rtol) {
+        size_t nv = net.neq();
+        size_t np = net.nparams();
+        vector_fp y(nv), lambda(nv), p(np, 1.0);
+        net.getInitialConditions(t, nv, &y[0]);
+        for (size_t i = 0; i < nv; i++) {
+            lambda[i] = sin(1.0 + i);
+        }
+
+        // The governing equations are linear in the rate multipliers, so a
+        // unit change in each parameter gives the derivative to round-off.
+        vector_fp q1(np), q2(np, 0.0), f0(nv), f1(nv);
+        net.evalAdjointQuadrature(t, &y[0], &lambda[0], &q1[0], &p[0]);
+        net.eval(t, &y[0], &f0[0], &p[0]);
+        for (size_t j = 0; j < np; j++) {
+            p[j] = 2.0;
+            net.eval(t, &y[0], &f1[0], &p[0]);
+            p[j] = 1.0;
+            for (size_t i = 0; i < nv; i++) {
+                q2[j] += lambda[i] * (f1[i] - f0[i]);
+            }
+        }
+        compare(q1, q2, 1e-8);
+
+        if (jacobian) {
+            vector_fp jtl1(nv), jtl2(nv);
+            net.evalAdjoint(t, &y[0], &lambda[0], &jtl1[0], &p[0]);
+            net.FuncEval::evalAdjoint(t, &y[0], &lambda[0], &jtl2[0], &p[0]);
+            compare(jtl1, jtl2, rtol);
+        }
+    }
+
+    void compare(const vector_fp& x, const vector_fp& ref, double rtol) {
+        double scale = 0.0;
+        for (size_t i = 0; i < ref.size(); i++) {
+            scale = std::max(scale, std::abs(ref[i]));
+        }
+        ASSERT_GT(scale, 0.0);
+        for (size_t i = 0; i < ref.size(); i++) {
+            EXPECT_NEAR(ref[i], x[i], rtol * (std::abs(ref[i]) + 1e-4 * scale))
+                << "i = " << i;
+        }
+    }
+
+    IdealGasMix gas;
+    ReactorNet net;
+};
+
+TEST_F(AdjointTest, IdealGasReactor)
+{
+    IdealGasReactor r;
+    addReactor(r);
+    net.advance(1e-4);
+    ASSERT_TRUE(r.analyticJacobianAdjoint());
+    check(1e-4, true, 1e-5);
+}
+
+TEST_F(AdjointTest, IdealGasReactorNoEnergy)
+{
+    IdealGasReactor r;
+    addReactor(r);
+    r.setEnergy(0);
+    net.advance(1e-4);
+    check(1e-4, true, 1e-5);
+}
+
+TEST_F(AdjointTest, IdealGasReactorMovingWall)
+{
+    IdealGasReactor r;
+    addReactor(r);
+    IdealGasMix air("h2o2.xml");
+    Reservoir env;
+    env.insert(air);
+    Wall w;
+    w.install(r, env);
+    Const1 v(0.1);
+    w.setVelocity(&v);
+    Const1 q(-1e4);
+    w.setHeatFlux(&q);
+    net.advance(1e-4);
+    ASSERT_TRUE(r.analyticJacobianAdjoint());
+    check(1e-4, true, 1e-5);
+
+    // heat transfer couples the reactor to its surroundings
+    w.setHeatTransferCoeff(10.0);
+    EXPECT_FALSE(r.analyticJacobianAdjoint());
+}
+
+TEST_F(AdjointTest, IdealGasConstPressureReactor)
+{
+    IdealGasConstPressureReactor r;
+    addReactor(r);
+    net.advance(1e-4);
+    ASSERT_TRUE(r.analyticJacobianAdjoint());
+    check(1e-4, true, 1e-5);
+}
+
+TEST_F(AdjointTest, Reactor)
+{
+    Reactor r;
+    addReactor(r);
+    net.advance(1e-4);
+    EXPECT_FALSE(r.analyticJacobianAdjoint());
+    check(1e-4, false, 0.0);
+}
+
+TEST_F(AdjointTest, ConstPressureReactor)
+{
+    ConstPressureReactor r;
+    addReactor(r);
+    net.advance(1e-4);
+    check(1e-4, false, 0.0);
+}
+
+TEST_F(AdjointTest, WallKinetics)
+{
+    IdealGasMix gas2("ptcombust.xml", "gas");
+    gas2.setState_TPX(900.0, OneAtm, "CH4:0.095, O2:0.21, AR:0.695");
+    std::vector<ThermoPhase*> phases(1, &gas2);
+    Interface surf("ptcombust.xml", "Pt_surf", phases);
+    IdealGasReactor r;
+    r.insert(gas2);
+    net.addReactor(r);
+    r.addSensitivityReaction(0);
+    IdealGasMix gas3("ptcombust.xml", "gas");
+    Reservoir env;
+    env.insert(gas3);
+    Wall w;
+    w.install(r, env);
+    w.setKinetics(&surf, 0);
+    w.setArea(2.0);
+    for (size_t i = 0; i < surf.nReactions(); i += 2) {
+        w.addSensitivityReaction(0, i);
+    }
+    net.advance(1e-3);
+    EXPECT_FALSE(r.analyticJacobianAdjoint());
+    check(1e-3, false, 0.0);
+}
+
+//! Compare the sensitivities of the OH mass fraction during the induction
+//! period to the rate of each reaction, computed from the adjoint equations,
+//! with central differences of the solution
+template <class R>
+void checkGradient(AdjointTest& test)
+{
+    IdealGasMix& gas = test.gas;
+    ReactorNet& net = test.net;
+    R r;
+    test.addReactor(r);
+    net.setAdjointSensitivity(true);
+    net.setTolerances(1e-12, 1e-20);
+    net.setSensitivityTolerances(1e-8, 1e-12);
+    double tf = 5e-5;
+    net.advance(tf);
+    size_t kOH = gas.speciesIndex("OH");
+    double Y = r.massFraction(kOH);
+    size_t np = net.nparams();
+    vector_fp sens(np);
+    net.getAdjointSensitivities(net.globalComponentIndex("OH"), &sens[0]);
+
+    for (size_t n = 0; n < np; n++) {
+        size_t i = 3 * n;
+        double dp = 1e-4;
+        double Yp[2];
+        for (int j = 0; j < 2; j++) {
+            gas.setState_TPX(1100.0, OneAtm, "H2:2, O2:1, AR:5");
+            gas.setMultiplier(i, 1.0 + (2*j - 1) * dp);
+            R r2;
+            r2.insert(gas);
+            ReactorNet net2;
+            net2.addReactor(r2);
+            net2.setTolerances(1e-12, 1e-20);
+            net2.advance(tf);
+            Yp[j] = r2.massFraction(kOH);
+        }
+        gas.setMultiplier(i, 1.0);
+        double fd = (Yp[1] - Yp[0]) / (2 * dp * Y);
+        EXPECT_NEAR(fd, sens[n], 2e-3 * std::abs(fd) + 1e-6) << "n = " << n;
+    }
+}
+
+TEST_F(AdjointTest, Gradient)
+{
+    checkGradient<IdealGasReactor>(*this);
+}
+
+TEST_F(AdjointTest, GradientFiniteDifferenceJacobian)
+{
+    // Reactor uses the finite difference adjoint product
+    checkGradient<Reactor>(*this);
+}
+
+TEST_F(AdjointTest, ContinueIntegration)
+{
+    // The forward integration continues after the adjoint sensitivities are
+    // computed, and the adjoint integration at a later time covers the whole
+    // solution
+    IdealGasReactor r;
+    addReactor(r);
+    net.setAdjointSensitivity(true, 20);
+    net.setTolerances(1e-12, 1e-20);
+    net.setSensitivityTolerances(1e-8, 1e-12);
+    net.setMaxTimeStep(1e-5);
+    size_t kOH = net.globalComponentIndex("OH");
+    size_t np = net.nparams();
+    vector_fp sens1(np), sens2(np);
+    net.advance(3e-5);
+    net.getAdjointSensitivities(kOH, &sens1[0]);
+    net.advance(6e-5);
+    net.getAdjointSensitivities(kOH, &sens2[0]);
+
+    IdealGasMix gas2("h2o2.xml");
+    gas2.setState_TPX(1100.0, OneAtm, "H2:2, O2:1, AR:5");
+    IdealGasReactor r2;
+    r2.insert(gas2);
+    ReactorNet net2;
+    net2.addReactor(r2);
+    for (size_t i = 0; i < gas2.nReactions(); i += 3) {
+        r2.addSensitivityReaction(i);
+    }
+    net2.setAdjointSensitivity(true, 20);
+    net2.setTolerances(1e-12, 1e-20);
+    net2.setSensitivityTolerances(1e-8, 1e-12);
+    net2.setMaxTimeStep(1e-5);
+    net2.advance(6e-5);
+
+    EXPECT_NEAR(r2.temperature(), r.temperature(), 1e-8 * r2.temperature());
+    for (size_t k = 0; k < gas.nSpecies(); k++) {
+        EXPECT_NEAR(r2.massFraction(k), r.massFraction(k),
+                    1e-7 * r2.massFraction(k) + 1e-16) << "k = " << k;
+    }
+
+    vector_fp sens3(np);
+    net2.getAdjointSensitivities(kOH, &sens3[0]);
+    double scale = 0.0;
+    double change = 0.0;
+    for (size_t n = 0; n < np; n++) {
+        scale = std::max(scale, std::abs(sens3[n]));
+        change = std::max(change, std::abs(sens2[n] - sens1[n]));
+    }
+    for (size_t n = 0; n < np; n++) {
+        EXPECT_NEAR(sens3[n], sens2[n], 1e-4 * scale) << "n = " << n;
+    }
+    // the sensitivities change during the induction period
+    EXPECT_GT(change, 0.1 * scale);
+}
+
+}
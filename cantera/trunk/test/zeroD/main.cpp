@@ -0,0 +1,10 @@
+#include "gtest/gtest.h"
+#include "cantera/base/global.h"
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+    Cantera::appdelete();
+    return result;
+}